@@ -7,14 +7,19 @@
  * openblack is licensed under the GNU General Public License version 3.
  *******************************************************************************/
 
+#include <cinttypes>
 #include <cstdlib>
 
+#include <algorithm>
+#include <chrono>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <string>
 
 #include <LHVMFile.h>
+#include <LHVMProfile.h>
 #include <cxxopts.hpp>
 
 using namespace openblack::lhvm;
@@ -34,7 +39,8 @@ struct Arguments
 		Stack,
 		VarValues,
 		Tasks,
-		RuntimeInfo
+		RuntimeInfo,
+		Profile
 	};
 	Mode mode {Mode::Header};
 	struct Read
@@ -479,6 +485,41 @@ int PrintRuntimeInfo(const LHVMFile& file)
 	return EXIT_SUCCESS;
 }
 
+void PrintProfileEntries(const std::vector<VMProfileEntry>& entries, uint32_t ticks)
+{
+	std::vector<size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::erase_if(order, [&entries](size_t i) { return entries[i].calls == 0; });
+	std::ranges::sort(order, [&entries](size_t a, size_t b) { return entries[a].time > entries[b].time; });
+
+	std::printf("%-48s %10s %14s %12s %12s\n", "Name", "Calls", "Instructions", "Total (ms)", "Tick (ms)");
+	for (const auto i : order)
+	{
+		const auto& entry = entries[i];
+		const auto totalMs = std::chrono::duration<double, std::milli>(entry.time).count();
+		std::printf("%-48s %10" PRIu64 " %14" PRIu64 " %12.3f %12.4f\n", entry.name.c_str(), entry.calls, entry.instructions,
+		            totalMs, ticks > 0 ? totalMs / ticks : 0.0);
+	}
+	std::printf("\n");
+}
+
+int PrintProfile(const std::filesystem::path& filename)
+{
+	LHVMProfile profile;
+	if (profile.Read(filename) != EXIT_SUCCESS)
+	{
+		std::printf("Could not read profile\n");
+		return EXIT_FAILURE;
+	}
+
+	std::printf("Ticks count: %u\n\n", profile.ticks);
+	std::printf("Scripts:\n");
+	PrintProfileEntries(profile.scripts, profile.ticks);
+	std::printf("Native functions:\n");
+	PrintProfileEntries(profile.nativeFunctions, profile.ticks);
+	return EXIT_SUCCESS;
+}
+
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
 	cxxopts::Options options("lhvmtool", "Inspect and extract files from LionHead Virtual Machine files.");
@@ -501,6 +542,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("V,values", "Print global var values.", cxxopts::value<std::string>())     //
 	    ("T,tasks", "Print active tasks.", cxxopts::value<std::string>())           //
 	    ("R,rtinfo", "Print runtime info.", cxxopts::value<std::string>())          //
+	    ("P,profile", "Print a VM profile.", cxxopts::value<std::string>())         //
 	    ("n,name", "Object name", cxxopts::value<std::string>()->default_value("")) //
 	    ;
 
@@ -594,6 +636,12 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 			args.read.filename = result["rtinfo"].as<std::string>();
 			return true;
 		}
+		if (result["profile"].count() > 0)
+		{
+			args.mode = Arguments::Mode::Profile;
+			args.read.filename = result["profile"].as<std::string>();
+			return true;
+		}
 	}
 	std::cerr << options.help() << '\n';
 	returnCode = EXIT_FAILURE;
@@ -609,9 +657,16 @@ int main(int argc, char* argv[]) noexcept
 		return returnCode;
 	}
 
-	LHVMFile file;
 	std::printf("Filename: %s\n", args.read.filename.string().c_str());
 
+	// Profiles are saved by the game's LHVM viewer, they aren't LHVM files
+	if (args.mode == Arguments::Mode::Profile)
+	{
+		return PrintProfile(args.read.filename);
+	}
+
+	LHVMFile file;
+
 	// Open file
 	file.Open(args.read.filename);
 
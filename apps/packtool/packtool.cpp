@@ -8,13 +8,17 @@
  *******************************************************************************/
 
 #include <cassert>
+#include <cctype>
 #include <cstdlib>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <system_error>
 
+#include <AssetArchive.h>
 #include <PackFile.h>
 #include <cxxopts.hpp>
 
@@ -385,6 +389,101 @@ int WriteAnimationFile(const std::filesystem::path& outFilename) noexcept
 	return EXIT_SUCCESS;
 }
 
+int ListArchive(const std::filesystem::path& filename) noexcept
+{
+	openblack::pack::AssetArchive archive;
+	const auto result = archive.Open(filename);
+	if (result != openblack::pack::ArchiveResult::Success)
+	{
+		std::fprintf(stderr, "%s\n", openblack::pack::ResultToStr(result).data());
+		return EXIT_FAILURE;
+	}
+
+	const auto entries = archive.GetEntries();
+	std::printf("%u entries\n", static_cast<uint32_t>(entries.size()));
+	for (const auto& entry : entries)
+	{
+		const auto name = archive.GetName(entry);
+		std::printf("\"%.*s\": offset %llu, size %u, stored %u (%s)\n", static_cast<int>(name.size()), name.data(),
+		            static_cast<unsigned long long>(entry.offset), entry.size, entry.storedSize,
+		            entry.compression == openblack::pack::ArchiveCompression::Zlib ? "zlib" : "stored");
+	}
+	std::printf("\n");
+
+	return EXIT_SUCCESS;
+}
+
+int WriteArchive(const std::filesystem::path& outFilename, const std::vector<std::filesystem::path>& roots,
+                 bool compress) noexcept
+{
+	openblack::pack::AssetArchiveWriter archive;
+	const auto compression = compress ? openblack::pack::ArchiveCompression::Zlib : openblack::pack::ArchiveCompression::None;
+
+	for (const auto& root : roots)
+	{
+		// Sorted so files the game loads together, which share a directory, are next to each other in the archive
+		std::vector<std::filesystem::path> filenames;
+		std::error_code ec;
+		for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+		     !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		{
+			// Don't add the archive to itself when it is written into the game directory
+			std::error_code ignored;
+			if (it->is_regular_file(ignored) && !std::filesystem::equivalent(it->path(), outFilename, ignored))
+			{
+				filenames.emplace_back(it->path());
+			}
+		}
+		if (ec)
+		{
+			std::fprintf(stderr, "Could not list \"%s\": %s\n", root.string().c_str(), ec.message().c_str());
+			return EXIT_FAILURE;
+		}
+		std::sort(filenames.begin(), filenames.end());
+
+		for (const auto& filename : filenames)
+		{
+			std::ifstream file(filename, std::ios::binary);
+			if (!file.is_open())
+			{
+				std::fprintf(stderr, "Could not open source file \"%s\"\n", filename.string().c_str());
+				return EXIT_FAILURE;
+			}
+			file.seekg(0, std::ios_base::end);
+			const auto size = file.tellg();
+			file.seekg(0, std::ios_base::beg);
+			std::vector<uint8_t> data(static_cast<size_t>(size));
+			file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+			// Names are the paths the game opens the files with
+			const auto name = filename.lexically_relative(root).generic_string();
+			// Evicted meshes, textures and animations are read again from a small part of their pack, which only stored
+			// entries can do without decompressing the whole pack
+			auto extension = filename.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(),
+			               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			const auto isPack = extension == ".g3d" || extension == ".anm";
+			const auto result =
+			    archive.Add(name, std::move(data), isPack ? openblack::pack::ArchiveCompression::None : compression);
+			if (result != openblack::pack::ArchiveResult::Success)
+			{
+				std::fprintf(stderr, "\"%s\": %s\n", name.c_str(), openblack::pack::ResultToStr(result).data());
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	const auto result = archive.Write(outFilename);
+	if (result != openblack::pack::ArchiveResult::Success)
+	{
+		std::fprintf(stderr, "%s\n", openblack::pack::ResultToStr(result).data());
+		return EXIT_FAILURE;
+	}
+	std::printf("%u files written to %s\n", static_cast<uint32_t>(archive.GetEntryCount()), outFilename.string().c_str());
+
+	return EXIT_SUCCESS;
+}
+
 int WriteSoundFile(const std::filesystem::path& outFilename) noexcept
 {
 	openblack::pack::PackFile pack;
@@ -414,12 +513,15 @@ struct Arguments
 		WriteRaw,
 		WriteMeshPack,
 		WriteAnimationPack,
+		ListArchive,
+		WriteArchive,
 	};
 	std::vector<std::filesystem::path> filenames;
 	Mode mode;
 	std::string block;
 	uint32_t blockId;
 	std::filesystem::path outFilename;
+	bool compress;
 };
 
 std::string parseRange(std::string range, uint32_t currentSize, uint32_t& start, uint32_t& length)
@@ -472,7 +574,7 @@ std::string parseRange(std::string range, uint32_t currentSize, uint32_t& start,
 
 bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexcept
 {
-	cxxopts::Options options("packtool", "Inspect and extract files from LionHead pack files.");
+	cxxopts::Options options("packtool", "Inspect and extract files from LionHead pack files and openblack archives.");
 
 	options.add_options()                                                                                   //
 	    ("h,help", "Display this help message.")                                                            //
@@ -495,6 +597,10 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 	    ("write-mesh", "Create Mesh Pack (file.l3d[[:START]:LENGTH]...).",                                  //
 	     cxxopts::value<std::filesystem::path>())                                                           //
 	    ("write-animation", "Create Mesh Pack.", cxxopts::value<std::filesystem::path>())                   //
+	    ("L,list-archive", "List Asset Archive entries.")                                                   //
+	    ("write-archive", "Create Asset Archive from game directories (game-path...).",                     //
+	     cxxopts::value<std::filesystem::path>())                                                           //
+	    ("archive-store", "Store Asset Archive entries without compressing them.")                          //
 	    ("pack-files", "Pack Files.", cxxopts::value<std::vector<std::filesystem::path>>())                 //
 	    ;
 
@@ -503,6 +609,7 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 
 	auto result = options.parse(argc, argv);
 	args.outFilename = "";
+	args.compress = result["archive-store"].count() == 0;
 	if (result["help"].as<bool>())
 	{
 		std::cout << options.help() << '\n';
@@ -554,6 +661,19 @@ bool parseOptions(int argc, char** argv, Arguments& args, int& returnCode) noexc
 		args.filenames = expandedOutFilename;
 		return true;
 	}
+	if (result["write-archive"].count() > 0)
+	{
+		args.mode = Arguments::Mode::WriteArchive;
+		args.outFilename = result["write-archive"].as<std::filesystem::path>();
+		args.filenames = result["pack-files"].as<std::vector<std::filesystem::path>>();
+		return true;
+	}
+	if (result["list-archive"].count() > 0)
+	{
+		args.mode = Arguments::Mode::ListArchive;
+		args.filenames = result["pack-files"].as<std::vector<std::filesystem::path>>();
+		return true;
+	}
 	if (result["list-blocks"].count() > 0)
 	{
 		args.mode = Arguments::Mode::List;
@@ -695,6 +815,21 @@ int main(int argc, char* argv[]) noexcept
 		return WriteAnimationFile(args.outFilename);
 	}
 
+	if (args.mode == Arguments::Mode::WriteArchive)
+	{
+		return WriteArchive(args.outFilename, args.filenames, args.compress);
+	}
+
+	if (args.mode == Arguments::Mode::ListArchive)
+	{
+		for (const auto& filename : args.filenames)
+		{
+			std::printf("file: %s\n", filename.generic_string().c_str());
+			returnCode |= ListArchive(filename);
+		}
+		return returnCode;
+	}
+
 	for (auto& filename : args.filenames)
 	{
 		openblack::pack::PackFile pack;
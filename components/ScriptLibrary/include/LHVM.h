@@ -12,6 +12,7 @@
 #include <cstdint>
 
 #include <array>
+#include <chrono>
 #include <filesystem>
 #include <functional>
 #include <map>
@@ -19,6 +20,7 @@
 #include <vector>
 
 #include "LHVMFile.h"
+#include "LHVMProfile.h"
 
 namespace openblack::lhvm
 {
@@ -44,6 +46,12 @@ class LHVM
 	uint32_t _highestScriptId {0};
 	uint32_t _executedInstructions {0};
 
+	bool _profiling {false};
+	uint32_t _profiledTicks {0};
+	/// Indexed by script id - 1 and by native function id, names are filled in by GetProfile
+	std::vector<VMProfileEntry> _scriptProfiles;
+	std::vector<VMProfileEntry> _nativeFunctionProfiles;
+
 	const std::vector<NativeFunction>* _functions {nullptr};
 	std::function<void(const uint32_t func)> _nativeCallEnterCallback;
 	std::function<void(const uint32_t func)> _nativeCallExitCallback;
@@ -106,6 +114,8 @@ class LHVM
 	uint32_t GetExceptionHandlersCount();
 	uint32_t GetCurrentExceptionHandlerIp(uint32_t index);
 
+	static VMProfileEntry& GetProfileEntry(std::vector<VMProfileEntry>& entries, size_t index);
+
 	void PrintInstruction(const VMTask& task, const VMInstruction& instruction);
 	void CpuLoop(VMTask& task);
 
@@ -163,6 +173,13 @@ class LHVM
 
 	void StopTasksOfType(ScriptType typesMask);
 
+	/// Record the instructions and time spent per script and per native function, off by default as it reads the clock
+	/// around every task slice and native call
+	void SetProfiling(bool enabled) { _profiling = enabled; }
+	[[nodiscard]] bool IsProfiling() const { return _profiling; }
+	void ResetProfile();
+	[[nodiscard]] LHVMProfile GetProfile() const;
+
 	[[nodiscard]] std::string GetString(uint32_t offset);
 	[[nodiscard]] const std::vector<NativeFunction>* GetFunctions() const { return _functions; };
 
@@ -9,15 +9,23 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include <array>
 #include <filesystem>
+#include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "LHVMTypes.h"
 
+namespace openblack
+{
+class BinaryReader;
+}
+
 namespace openblack::lhvm
 {
 
@@ -48,18 +56,18 @@ class LHVMFile
 	/// Read file from the input source
 	void ReadFile(std::istream& stream);
 
-	int LoadVariablesNames(std::istream& stream, std::vector<std::string>& variables);
-	int LoadCode(std::istream& stream);
-	int LoadAuto(std::istream& stream);
-	int LoadScripts(std::istream& stream);
-	int LoadScript(std::istream& stream, VMScript& script);
-	int LoadData(std::istream& stream);
-	int LoadStatus(std::istream& stream);
-	int LoadStack(std::istream& stream, VMStack& stack);
-	int LoadVariableValues(std::istream& stream, std::vector<VMVar>& variables);
-	int LoadTasks(std::istream& stream);
-	int LoadTask(std::istream& stream, VMTask& task);
-	int LoadRuntimeInfo(std::istream& stream);
+	int LoadVariablesNames(BinaryReader& reader, std::vector<std::string>& variables);
+	int LoadCode(BinaryReader& reader);
+	int LoadAuto(BinaryReader& reader);
+	int LoadScripts(BinaryReader& reader);
+	int LoadScript(BinaryReader& reader, VMScript& script);
+	int LoadData(BinaryReader& reader);
+	int LoadStatus(BinaryReader& reader);
+	int LoadStack(BinaryReader& reader, VMStack& stack);
+	int LoadVariableValues(BinaryReader& reader, std::vector<VMVar>& variables);
+	int LoadTasks(BinaryReader& reader);
+	int LoadTask(BinaryReader& reader, VMTask& task);
+	int LoadRuntimeInfo(BinaryReader& reader);
 
 public:
 	LHVMFile();
@@ -82,6 +90,9 @@ class LHVMFile
 	/// Read lhvm file from a buffer
 	void Open(const std::vector<uint8_t>& buffer);
 
+	/// Read lhvm file from a buffer, the data is copied out so the buffer can be released afterwards
+	void Open(std::span<const std::byte> buffer);
+
 	void Write(const std::filesystem::path& filepath);
 
 	[[nodiscard]] bool IsLoaded() const { return _isLoaded; }
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace openblack::lhvm
+{
+
+/// Time spent in a script's tasks (including the native functions they call) or in a native function
+struct VMProfileEntry
+{
+	std::string name;
+	/// Times the task ran until it yielded, waited or stopped, or times the native function was called
+	uint64_t calls {0};
+	/// Instructions executed, always zero for native functions
+	uint64_t instructions {0};
+	std::chrono::nanoseconds time {0};
+};
+
+/// Snapshot of the VM's profiling counters which can be saved and read back by tools
+class LHVMProfile
+{
+public:
+	/// Ticks (LookIn calls) the counters were recorded over
+	uint32_t ticks {0};
+	/// Indexed by script id - 1
+	std::vector<VMProfileEntry> scripts;
+	/// Indexed by native function id
+	std::vector<VMProfileEntry> nativeFunctions;
+
+	/// Write the entries which were called as tab separated text
+	int Write(const std::filesystem::path& filepath) const;
+
+	int Read(const std::filesystem::path& filepath);
+};
+
+} // namespace openblack::lhvm
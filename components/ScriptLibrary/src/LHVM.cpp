@@ -163,6 +163,7 @@ int LHVM::LoadBinary(const LHVMFile& file)
 	_highestTaskId = 0;
 	_highestScriptId = _scripts.size();
 	_executedInstructions = 0;
+	ResetProfile();
 
 	_auto = file.GetAutostart();
 	for (const auto scriptId : _auto)
@@ -298,6 +299,7 @@ void LHVM::Reboot()
 	_highestScriptId = 0;
 	_currentLineNumber = 0;
 	_executedInstructions = 0;
+	ResetProfile();
 
 	_mainStack.popCount += _mainStack.count;
 	_mainStack.count = 0;
@@ -392,6 +394,10 @@ void LHVM::LookIn(const ScriptType allowedScriptTypesMask)
 	}
 
 	_ticks++;
+	if (_profiling)
+	{
+		_profiledTicks++;
+	}
 	_currentStack = &_mainStack;
 }
 
@@ -620,6 +626,36 @@ bool LHVM::TaskExists(const uint32_t taskId)
 	return _tasks.contains(taskId);
 }
 
+void LHVM::ResetProfile()
+{
+	_profiledTicks = 0;
+	_scriptProfiles.clear();
+	_nativeFunctionProfiles.clear();
+}
+
+LHVMProfile LHVM::GetProfile() const
+{
+	LHVMProfile profile {_profiledTicks, _scriptProfiles, _nativeFunctionProfiles};
+	for (size_t i = 0; i < profile.scripts.size() && i < _scripts.size(); ++i)
+	{
+		profile.scripts[i].name = _scripts[i].name;
+	}
+	for (size_t i = 0; _functions != nullptr && i < profile.nativeFunctions.size() && i < _functions->size(); ++i)
+	{
+		profile.nativeFunctions[i].name = _functions->at(i).name;
+	}
+	return profile;
+}
+
+VMProfileEntry& LHVM::GetProfileEntry(std::vector<VMProfileEntry>& entries, size_t index)
+{
+	if (entries.size() <= index)
+	{
+		entries.resize(index + 1);
+	}
+	return entries[index];
+}
+
 uint32_t LHVM::GetTicksCount()
 {
 	return _ticks;
@@ -718,6 +754,12 @@ void LHVM::PrintInstruction(const VMTask& task, const VMInstruction& instruction
 
 void LHVM::CpuLoop(VMTask& task)
 {
+	// The task may be stopped and destroyed by the time the loop exits
+	const auto profiling = _profiling;
+	const auto scriptId = task.scriptId;
+	const auto startInstructions = _executedInstructions;
+	const auto startTime = profiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {};
+
 	const auto wasExceptionHandler = task.inExceptionHandler;
 	task.iield = false;
 	while (task.waitingTaskId == 0)
@@ -737,6 +779,14 @@ void LHVM::CpuLoop(VMTask& task)
 		task.instructionAddress++;
 	}
 	_currentTask = nullptr;
+
+	if (profiling && scriptId > 0)
+	{
+		auto& entry = GetProfileEntry(_scriptProfiles, scriptId - 1);
+		entry.calls++;
+		entry.instructions += _executedInstructions - startInstructions;
+		entry.time += std::chrono::steady_clock::now() - startTime;
+	}
 }
 
 float LHVM::Fmod(float a, float b)
@@ -857,7 +907,18 @@ void LHVM::Opcode05Sys(VMTask& /*task*/, const VMInstruction& instruction)
 			_currentStack->pushCount = 0;
 			_currentStack->popCount = 0;
 			InvokeNativeCallEnterCallback(id);
-			func.impl();
+			if (_profiling)
+			{
+				const auto startTime = std::chrono::steady_clock::now();
+				func.impl();
+				auto& entry = GetProfileEntry(_nativeFunctionProfiles, id);
+				entry.calls++;
+				entry.time += std::chrono::steady_clock::now() - startTime;
+			}
+			else
+			{
+				func.impl();
+			}
 			InvokeNativeCallExitCallback(id);
 		}
 		else // if impl not provided, then just adjust the stack
@@ -109,53 +109,12 @@
 #include <fstream>
 #include <stdexcept>
 
+#include <BinaryReader.h>
+
 #include "LHVMTypes.h"
 
 using namespace openblack::lhvm;
 
-namespace
-{
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-} // namespace
-
 LHVMFile::LHVMFile()
     : _version(LHVMVersion::BlackAndWhite) {};
 
@@ -195,60 +154,57 @@ LHVMFile::LHVMFile(const LHVMVersion version, const std::vector<std::string>& va
 LHVMFile::~LHVMFile() = default;
 
 void LHVMFile::ReadFile(std::istream& stream)
+{
+	const auto buffer = ReadAllBytes(stream);
+	Open(buffer);
+}
+
+void LHVMFile::Open(std::span<const std::byte> buffer)
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	if (fsize < 8)
+	// First 8 bytes
+	std::array<char, 4> magic;
+	if (!reader.Read(magic) || !reader.Read(_version))
 	{
 		return; // File too small to be a valid LHVM file.
 	}
-
-	// First 8 bytes
-	std::array<char, 4> magic;
-	stream.read(reinterpret_cast<char*>(magic.data()), 4);
 	if (magic != k_Magic)
 	{
 		return; // Unrecognized LHVM header
 	}
 
-	stream.read(reinterpret_cast<char*>(&_version), sizeof(_version));
 	/* only support bw1 at the moment */
 	if (_version != LHVMVersion::BlackAndWhite)
 	{
 		return; // Unsupported LHVM version
 	}
 
-	if (LoadVariablesNames(stream, _variablesNames) != EXIT_SUCCESS)
+	if (LoadVariablesNames(reader, _variablesNames) != EXIT_SUCCESS)
 	{
 		return;
 	}
-	if (LoadCode(stream) != EXIT_SUCCESS)
+	if (LoadCode(reader) != EXIT_SUCCESS)
 	{
 		return;
 	}
-	if (LoadAuto(stream) != EXIT_SUCCESS)
+	if (LoadAuto(reader) != EXIT_SUCCESS)
 	{
 		return;
 	}
-	if (LoadScripts(stream) != EXIT_SUCCESS)
+	if (LoadScripts(reader) != EXIT_SUCCESS)
 	{
 		return;
 	}
-	if (LoadData(stream) != EXIT_SUCCESS)
+	if (LoadData(reader) != EXIT_SUCCESS)
 	{
 		return;
 	}
 
 	// VM status data (.sav files only)
-	if (LoadStatus(stream) != EXIT_SUCCESS)
+	if (LoadStatus(reader) != EXIT_SUCCESS)
 	{
 		return;
 	}
@@ -272,11 +228,7 @@ void LHVMFile::Open(const std::filesystem::path& filepath)
 
 void LHVMFile::Open(const std::vector<uint8_t>& buffer)
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	ReadFile(stream);
+	Open(std::as_bytes(std::span(buffer)));
 }
 
 void LHVMFile::Write([[maybe_unused]] const std::filesystem::path& filepath)
@@ -291,11 +243,11 @@ void LHVMFile::Write([[maybe_unused]] const std::filesystem::path& filepath)
 	}
 }
 
-int LHVMFile::LoadVariablesNames(std::istream& stream, std::vector<std::string>& variables)
+int LHVMFile::LoadVariablesNames(BinaryReader& reader, std::vector<std::string>& variables)
 {
 	int32_t count;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // Error reading variable count
 	}
@@ -306,33 +258,22 @@ int LHVMFile::LoadVariablesNames(std::istream& stream, std::vector<std::string>&
 		return EXIT_SUCCESS;
 	}
 
-	// preallocate a buffer to reuse for each variable
-	std::array<char, 255> buffer;
-
 	variables.reserve(count);
 	for (int32_t i = 0; i < count; i++)
 	{
-		// reset cur pointer to 0
-		char* cur = buffer.data();
-		do
+		if (!reader.ReadString(variables.emplace_back()))
 		{
-			if (!stream.read(cur++, sizeof(*cur)))
-			{
-				return EXIT_FAILURE; // Error reading variable
-			}
-		} while (*(cur - 1) != '\0');
-
-		// throw it into the std::string vector
-		variables.emplace_back(buffer.data());
+			return EXIT_FAILURE; // Error reading variable
+		}
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadCode(std::istream& stream)
+int LHVMFile::LoadCode(BinaryReader& reader)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // Error reading code count
 	}
@@ -343,8 +284,7 @@ int LHVMFile::LoadCode(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
-	_instructions.resize(count);
-	if (!stream.read(reinterpret_cast<char*>(_instructions.data()), sizeof(VMInstruction) * _instructions.size()))
+	if (!reader.ReadVector(_instructions, count))
 	{
 		return EXIT_FAILURE; // Error reading instructions
 	}
@@ -352,10 +292,10 @@ int LHVMFile::LoadCode(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadAuto(std::istream& stream)
+int LHVMFile::LoadAuto(BinaryReader& reader)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // error reading id count
 	}
@@ -366,8 +306,7 @@ int LHVMFile::LoadAuto(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
-	_autostart.resize(count);
-	if (!stream.read(reinterpret_cast<char*>(_autostart.data()), sizeof(_autostart[0]) * _autostart.size()))
+	if (!reader.ReadVector(_autostart, count))
 	{
 		return EXIT_FAILURE; // error reading ids
 	}
@@ -375,10 +314,10 @@ int LHVMFile::LoadAuto(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadScripts(std::istream& stream)
+int LHVMFile::LoadScripts(BinaryReader& reader)
 {
 	int32_t count;
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // error reading script count
 	}
@@ -392,7 +331,7 @@ int LHVMFile::LoadScripts(std::istream& stream)
 	_scripts.reserve(count);
 	for (int32_t i = 0; i < count; i++)
 	{
-		if (LoadScript(stream, _scripts.emplace_back()) != EXIT_SUCCESS)
+		if (LoadScript(reader, _scripts.emplace_back()) != EXIT_SUCCESS)
 		{
 			return EXIT_FAILURE;
 		}
@@ -401,57 +340,44 @@ int LHVMFile::LoadScripts(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadScript(std::istream& stream, VMScript& script)
+int LHVMFile::LoadScript(BinaryReader& reader, VMScript& script)
 {
-	std::array<char, 256> scriptName;
-	std::array<char, 256> filename;
-
-	char* cur = scriptName.data();
-	do
+	if (!reader.ReadString(script.name))
 	{
-		if (!stream.read(cur++, sizeof(*cur)))
-		{
-			return EXIT_FAILURE; // Error script name
-		}
-	} while (*(cur - 1) != '\0');
-	script.name = std::string(scriptName.data());
+		return EXIT_FAILURE; // Error script name
+	}
 
-	cur = filename.data();
-	do
+	if (!reader.ReadString(script.filename))
 	{
-		if (!stream.read(cur++, sizeof(*cur)))
-		{
-			return EXIT_FAILURE; // Error reading script filename
-		}
-	} while (*(cur - 1) != '\0');
-	script.filename = std::string(filename.data());
+		return EXIT_FAILURE; // Error reading script filename
+	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.type), sizeof(script.type)))
+	if (!reader.Read(script.type))
 	{
 		return EXIT_FAILURE; // Error reading script type
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.variablesOffset), sizeof(script.variablesOffset)))
+	if (!reader.Read(script.variablesOffset))
 	{
 		return EXIT_FAILURE; // Error reading script variables offset
 	}
 
-	if (LoadVariablesNames(stream, script.variables) != EXIT_SUCCESS)
+	if (LoadVariablesNames(reader, script.variables) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.instructionAddress), sizeof(script.instructionAddress)))
+	if (!reader.Read(script.instructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.parameterCount), sizeof(script.parameterCount)))
+	if (!reader.Read(script.parameterCount))
 	{
 		return EXIT_FAILURE; // Error reading parameter count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&script.scriptId), sizeof(script.scriptId)))
+	if (!reader.Read(script.scriptId))
 	{
 		return EXIT_FAILURE; // Error reading script_id
 	}
@@ -459,29 +385,25 @@ int LHVMFile::LoadScript(std::istream& stream, VMScript& script)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadData(std::istream& stream)
+int LHVMFile::LoadData(BinaryReader& reader)
 {
 	int32_t size;
-	if (!stream.read(reinterpret_cast<char*>(&size), sizeof(size)))
+	if (!reader.Read(size))
 	{
 		return EXIT_FAILURE; // Error reading data size
 	}
 
-	_data.resize(size);
-	if (size > 0)
+	if (size < 0 || !reader.ReadVector(_data, size))
 	{
-		if (!stream.read(reinterpret_cast<char*>(_data.data()), sizeof(_data[0]) * _data.size()))
-		{
-			return EXIT_FAILURE; // Error reading data
-		}
+		return EXIT_FAILURE; // Error reading data
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadStatus(std::istream& stream)
+int LHVMFile::LoadStatus(BinaryReader& reader)
 {
-	const int rc = LoadStack(stream, _stack);
+	const int rc = LoadStack(reader, _stack);
 	if (rc == EXIT_FAILURE)
 	{
 		return EXIT_FAILURE;
@@ -491,15 +413,15 @@ int LHVMFile::LoadStatus(std::istream& stream)
 		return EXIT_SUCCESS;
 	}
 
-	if (LoadVariableValues(stream, _variableValues) != EXIT_SUCCESS)
+	if (LoadVariableValues(reader, _variableValues) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
-	if (LoadTasks(stream) != EXIT_SUCCESS)
+	if (LoadTasks(reader) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
-	if (LoadRuntimeInfo(stream) != EXIT_SUCCESS)
+	if (LoadRuntimeInfo(reader) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
@@ -508,14 +430,14 @@ int LHVMFile::LoadStatus(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
+int LHVMFile::LoadStack(BinaryReader& reader, VMStack& stack)
 {
-	if (!stream.read(reinterpret_cast<char*>(&stack.count), sizeof(stack.count)))
+	if (reader.AtEnd())
+	{
+		return EOF;
+	}
+	if (!reader.Read(stack.count))
 	{
-		if (stream.eof())
-		{
-			return EOF;
-		}
 		return EXIT_FAILURE; // Error reading stack count
 	}
 	if (stack.count > VMStack::k_Size)
@@ -523,19 +445,19 @@ int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
 		return EXIT_FAILURE; // Invalid stack count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&stack.pushCount), sizeof(stack.pushCount)))
+	if (!reader.Read(stack.pushCount))
 	{
 		return EXIT_FAILURE; // Error reading stack push count
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&stack.popCount), sizeof(stack.popCount)))
+	if (!reader.Read(stack.popCount))
 	{
 		return EXIT_FAILURE; // Error reading stack pop count
 	}
 
 	for (int i = 0; i < stack.count; i++)
 	{
-		if (!stream.read(reinterpret_cast<char*>(&stack.values.at(i)), sizeof(stack.values[0])))
+		if (!reader.Read(stack.values.at(i)))
 		{
 			return EXIT_FAILURE; // Error reading stack values
 		}
@@ -543,7 +465,7 @@ int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
 
 	for (int i = 0; i < stack.count; i++)
 	{
-		if (!stream.read(reinterpret_cast<char*>(&stack.types.at(i)), sizeof(stack.types[0])))
+		if (!reader.Read(stack.types.at(i)))
 		{
 			return EXIT_FAILURE; // Error reading stack types
 		}
@@ -552,14 +474,14 @@ int LHVMFile::LoadStack(std::istream& stream, VMStack& stack)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadVariableValues(std::istream& stream, std::vector<VMVar>& variables)
+int LHVMFile::LoadVariableValues(BinaryReader& reader, std::vector<VMVar>& variables)
 {
 	uint32_t count;
 	uint8_t type;
 	VMValue value;
-	std::array<char, 256> name;
+	std::string name;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // Error reading variables count
 	}
@@ -567,36 +489,32 @@ int LHVMFile::LoadVariableValues(std::istream& stream, std::vector<VMVar>& varia
 	variables.reserve(count);
 	for (int i = 0; i < count; i++)
 	{
-		if (!stream.read(reinterpret_cast<char*>(&type), sizeof(type)))
+		if (!reader.Read(type))
 		{
 			return EXIT_FAILURE; // Error reading variable type
 		}
 
-		if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+		if (!reader.Read(value))
 		{
 			return EXIT_FAILURE; // Error reading variable value
 		}
 
-		char* cur = name.data();
-		do
+		if (!reader.ReadString(name))
 		{
-			if (!stream.read(cur++, sizeof(*cur)))
-			{
-				return EXIT_FAILURE; // Error reading variable name
-			}
-		} while (*(cur - 1) != '\0');
+			return EXIT_FAILURE; // Error reading variable name
+		}
 
-		variables.emplace_back(DataType(type), value, std::string(name.data()));
+		variables.emplace_back(DataType(type), value, name);
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadTasks(std::istream& stream)
+int LHVMFile::LoadTasks(BinaryReader& reader)
 {
 	uint32_t count;
 
-	if (!stream.read(reinterpret_cast<char*>(&count), sizeof(count)))
+	if (!reader.Read(count))
 	{
 		return EXIT_FAILURE; // Error reading tasks count
 	}
@@ -604,7 +522,7 @@ int LHVMFile::LoadTasks(std::istream& stream)
 	_tasks.reserve(count);
 	for (int i = 0; i < count; i++)
 	{
-		if (LoadTask(stream, _tasks.emplace_back()) != EXIT_SUCCESS)
+		if (LoadTask(reader, _tasks.emplace_back()) != EXIT_SUCCESS)
 		{
 			return EXIT_FAILURE;
 		}
@@ -613,90 +531,89 @@ int LHVMFile::LoadTasks(std::istream& stream)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
+int LHVMFile::LoadTask(BinaryReader& reader, VMTask& task)
 {
-	if (LoadVariableValues(stream, task.localVars) != EXIT_SUCCESS)
+	if (LoadVariableValues(reader, task.localVars) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE;
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.id), sizeof(task.id)))
+	if (!reader.Read(task.id))
 	{
 		return EXIT_FAILURE; // Error reading task number
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.instructionAddress), sizeof(task.instructionAddress)))
+	if (!reader.Read(task.instructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.pevInstructionAddress), sizeof(task.pevInstructionAddress)))
+	if (!reader.Read(task.pevInstructionAddress))
 	{
 		return EXIT_FAILURE; // Error reading prev instruction address
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.waitingTaskId), sizeof(task.waitingTaskId)))
+	if (!reader.Read(task.waitingTaskId))
 	{
 		return EXIT_FAILURE; // Error reading waiting task
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.variablesOffset), sizeof(task.variablesOffset)))
+	if (!reader.Read(task.variablesOffset))
 	{
 		return EXIT_FAILURE; // Error reading var offset
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.currentExceptionHandlerIndex), sizeof(task.currentExceptionHandlerIndex)))
+	if (!reader.Read(task.currentExceptionHandlerIndex))
 	{
 		return EXIT_FAILURE; // Error reading current exception handler index
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.ticks), sizeof(task.ticks)))
+	if (!reader.Read(task.ticks))
 	{
 		return EXIT_FAILURE; // Error reading ticks
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.scriptId), sizeof(task.scriptId)))
+	if (!reader.Read(task.scriptId))
 	{
 		return EXIT_FAILURE; // Error reading script id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.type), sizeof(task.type)))
+	if (!reader.Read(task.type))
 	{
 		return EXIT_FAILURE; // Error reading type
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.inExceptionHandler), sizeof(task.inExceptionHandler)))
+	if (!reader.Read(task.inExceptionHandler))
 	{
 		return EXIT_FAILURE; // Error reading 'in exception handler'
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.stop), sizeof(task.stop)))
+	if (!reader.Read(task.stop))
 	{
 		return EXIT_FAILURE; // Error reading stop
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.iield), sizeof(task.iield)))
+	if (!reader.Read(task.iield))
 	{
 		return EXIT_FAILURE; // Error reading yield
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&task.sleeping), sizeof(task.sleeping)))
+	if (!reader.Read(task.sleeping))
 	{
 		return EXIT_FAILURE; // Error reading sleeping
 	}
 
-	if (LoadStack(stream, task.stack) != EXIT_SUCCESS)
+	if (LoadStack(reader, task.stack) != EXIT_SUCCESS)
 	{
 		return EXIT_FAILURE; // Error reading stack
 	}
 
 	uint32_t exceptStructCount;
-	if (!stream.read(reinterpret_cast<char*>(&exceptStructCount), sizeof(exceptStructCount)))
+	if (!reader.Read(exceptStructCount))
 	{
 		return EXIT_FAILURE; // Error reading except struct count
 	}
-	task.exceptionHandlerIps.resize(exceptStructCount);
-	if (!stream.read(reinterpret_cast<char*>(task.exceptionHandlerIps.data()), sizeof(uint32_t) * exceptStructCount))
+	if (!reader.ReadVector(task.exceptionHandlerIps, exceptStructCount))
 	{
 		return EXIT_FAILURE; // Error reading except struct
 	}
@@ -712,29 +629,29 @@ int LHVMFile::LoadTask(std::istream& stream, VMTask& task)
 	return EXIT_SUCCESS;
 }
 
-int LHVMFile::LoadRuntimeInfo(std::istream& stream)
+int LHVMFile::LoadRuntimeInfo(BinaryReader& reader)
 {
-	if (!stream.read(reinterpret_cast<char*>(&_ticks), sizeof(_ticks)))
+	if (!reader.Read(_ticks))
 	{
 		return EXIT_FAILURE; // Error reading clock ticks
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_currentLineNumber), sizeof(_currentLineNumber)))
+	if (!reader.Read(_currentLineNumber))
 	{
 		return EXIT_FAILURE; // Error reading current line number
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_highestTaskId), sizeof(_highestTaskId)))
+	if (!reader.Read(_highestTaskId))
 	{
 		return EXIT_FAILURE; // Error reading highest task id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_highestScriptId), sizeof(_highestScriptId)))
+	if (!reader.Read(_highestScriptId))
 	{
 		return EXIT_FAILURE; // Error reading highest script id
 	}
 
-	if (!stream.read(reinterpret_cast<char*>(&_executedInstructions), sizeof(_executedInstructions)))
+	if (!reader.Read(_executedInstructions))
 	{
 		return EXIT_FAILURE; // Error reading script instruction count
 	}
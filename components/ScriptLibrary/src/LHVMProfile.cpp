@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LHVMProfile.h"
+
+#include <cstdlib>
+
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+using namespace openblack::lhvm;
+
+namespace
+{
+constexpr std::string_view k_Header = "LHVMProfile 1";
+/// Far more scripts and native functions than any game has, a larger index is a corrupt file
+constexpr size_t k_MaxEntries = 0x10000;
+
+void WriteEntries(std::ostream& stream, std::string_view kind, const std::vector<VMProfileEntry>& entries)
+{
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const auto& entry = entries[i];
+		if (entry.calls == 0)
+		{
+			continue;
+		}
+		stream << kind << '\t' << i << '\t' << entry.calls << '\t' << entry.instructions << '\t' << entry.time.count() << '\t'
+		       << entry.name << '\n';
+	}
+}
+} // namespace
+
+int LHVMProfile::Write(const std::filesystem::path& filepath) const
+{
+	std::ofstream stream(filepath);
+	if (!stream.is_open())
+	{
+		return EXIT_FAILURE;
+	}
+
+	stream << k_Header << '\n';
+	stream << "ticks\t" << ticks << '\n';
+	WriteEntries(stream, "script", scripts);
+	WriteEntries(stream, "native", nativeFunctions);
+	return stream.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int LHVMProfile::Read(const std::filesystem::path& filepath)
+{
+	std::ifstream stream(filepath);
+	std::string line;
+	if (!stream.is_open() || !std::getline(stream, line) || line != k_Header)
+	{
+		return EXIT_FAILURE;
+	}
+
+	ticks = 0;
+	scripts.clear();
+	nativeFunctions.clear();
+	while (std::getline(stream, line))
+	{
+		std::istringstream fields(line);
+		std::string kind;
+		fields >> kind;
+		if (kind == "ticks")
+		{
+			if (!(fields >> ticks))
+			{
+				return EXIT_FAILURE; // Error reading ticks
+			}
+			continue;
+		}
+		if (kind != "script" && kind != "native")
+		{
+			return EXIT_FAILURE; // Unknown entry kind
+		}
+
+		size_t index;
+		VMProfileEntry entry;
+		int64_t time;
+		if (!(fields >> index >> entry.calls >> entry.instructions >> time))
+		{
+			return EXIT_FAILURE; // Error reading entry
+		}
+		if (index >= k_MaxEntries)
+		{
+			return EXIT_FAILURE; // Index out of range
+		}
+		entry.time = std::chrono::nanoseconds(time);
+		fields.ignore(1, '\t');
+		std::getline(fields, entry.name);
+
+		auto& entries = kind == "script" ? scripts : nativeFunctions;
+		if (entries.size() <= index)
+		{
+			entries.resize(index + 1);
+		}
+		entries[index] = std::move(entry);
+	}
+	return EXIT_SUCCESS;
+}
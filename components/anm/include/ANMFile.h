@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,6 +26,7 @@ enum class ANMResult : uint8_t
 	Success = 0,
 	ErrCantOpen,
 	ErrFileTooSmall,
+	ErrBadKeyframeOffset,
 };
 
 std::string_view ResultToStr(ANMResult result);
@@ -85,6 +89,9 @@ class ANMFile
 	/// Read anm file from a buffer
 	ANMResult Open(const std::vector<uint8_t>& buffer) noexcept;
 
+	/// Read anm file from a buffer, the data is copied out so the buffer can be released afterwards
+	ANMResult Open(std::span<const std::byte> buffer) noexcept;
+
 	/// Write anm file to path on the filesystem
 	ANMResult Write(const std::filesystem::path& filepath) noexcept;
 
@@ -54,50 +54,9 @@
 #include <fstream>
 #include <utility>
 
-using namespace openblack::anm;
-
-namespace
-{
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
+#include <BinaryReader.h>
 
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-} // namespace
+using namespace openblack::anm;
 
 std::string_view openblack::anm::ResultToStr(ANMResult result)
 {
@@ -109,6 +68,8 @@ std::string_view openblack::anm::ResultToStr(ANMResult result)
 		return "Could not open file.";
 	case ANMResult::ErrFileTooSmall:
 		return "File too small to be a valid ANM file.";
+	case ANMResult::ErrBadKeyframeOffset:
+		return "Keyframe data is beyond the end of the file.";
 	}
 	std::unreachable();
 }
@@ -117,52 +78,45 @@ ANMFile::ANMFile() noexcept = default;
 ANMFile::~ANMFile() noexcept = default;
 
 ANMResult ANMFile::ReadFile(std::istream& stream) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer);
+}
+
+ANMResult ANMFile::Open(std::span<const std::byte> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	if (fsize < sizeof(ANMHeader))
+	// First 84 bytes
+	if (!reader.Read(_header))
 	{
 		return ANMResult::ErrFileTooSmall;
 	}
 
-	// First 84 bytes
-	stream.read(reinterpret_cast<char*>(&_header), sizeof(ANMHeader));
-
+	if (!reader.Contains(_header.framesBase, _header.frameCount * sizeof(uint32_t)))
+	{
+		return ANMResult::ErrBadKeyframeOffset;
+	}
 	_keyframes.resize(_header.frameCount);
 	for (uint32_t i = 0; i < _header.frameCount; ++i)
 	{
-		stream.seekg(_header.framesBase + i * sizeof(uint32_t));
-
-		// In Keyframe offset block
+		// In Keyframe offset block, then the keyframe pointer, then the bone offset block
 		uint32_t offset;
-		stream.read(reinterpret_cast<char*>(&offset), sizeof(offset));
-
-		// Keyframe pointer
-		stream.seekg(offset);
-		stream.read(reinterpret_cast<char*>(&offset), sizeof(offset));
-
-		// Bone offset block
-		stream.seekg(offset);
-		stream.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+		if (!reader.ReadAt(_header.framesBase + i * sizeof(uint32_t), offset) || !reader.ReadAt(offset, offset) ||
+		    !reader.ReadAt(offset, offset))
+		{
+			return ANMResult::ErrBadKeyframeOffset;
+		}
 
 		// Bone block
-		stream.seekg(offset);
 		uint32_t boneCount;
-		stream.read(reinterpret_cast<char*>(&boneCount), sizeof(boneCount));
-
-		stream.read(reinterpret_cast<char*>(&_keyframes[i].time), sizeof(_keyframes[i].time));
-
-		_keyframes[i].bones.resize(boneCount);
-		stream.read(reinterpret_cast<char*>(_keyframes[i].bones.data()),
-		            _keyframes[i].bones.size() * sizeof(_keyframes[i].bones[0]));
+		if (!reader.ReadAt(offset, boneCount) || !reader.Read(_keyframes[i].time) ||
+		    !reader.ReadVector(_keyframes[i].bones, boneCount))
+		{
+			return ANMResult::ErrBadKeyframeOffset;
+		}
 	}
 
 	_isLoaded = true;
@@ -194,11 +148,7 @@ ANMResult ANMFile::Open(const std::filesystem::path& filepath) noexcept
 
 ANMResult ANMFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return Open(std::as_bytes(std::span(buffer)));
 }
 
 ANMResult ANMFile::Write(const std::filesystem::path& filepath) noexcept
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <istream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace openblack
+{
+
+/// Bounds-checked reader over a buffer of bytes, used by the file format parsers.
+/// Values are copied out with memcpy so the buffer needs no particular alignment. Reads which would go past the end fail,
+/// return false and leave the position where it was, so parsers can report an error without exceptions.
+class BinaryReader
+{
+public:
+	explicit BinaryReader(std::span<const std::byte> data) noexcept
+	    : _data(data)
+	{
+	}
+
+	[[nodiscard]] std::span<const std::byte> GetData() const noexcept { return _data; }
+	[[nodiscard]] std::size_t Size() const noexcept { return _data.size(); }
+	[[nodiscard]] std::size_t Tell() const noexcept { return _position; }
+	[[nodiscard]] std::size_t Remaining() const noexcept { return _data.size() - _position; }
+	[[nodiscard]] bool AtEnd() const noexcept { return _position == _data.size(); }
+
+	/// Whether `size` bytes starting at `offset` are within the buffer, without overflowing on corrupt offsets
+	[[nodiscard]] bool Contains(std::size_t offset, std::size_t size) const noexcept
+	{
+		return offset <= _data.size() && size <= _data.size() - offset;
+	}
+
+	bool Seek(std::size_t offset) noexcept
+	{
+		if (offset > _data.size())
+		{
+			return false;
+		}
+		_position = offset;
+		return true;
+	}
+
+	bool Skip(std::size_t count) noexcept { return Contains(_position, count) && Seek(_position + count); }
+
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	bool Read(T& value) noexcept
+	{
+		if (!Contains(_position, sizeof(T)))
+		{
+			return false;
+		}
+		std::memcpy(&value, _data.data() + _position, sizeof(T));
+		_position += sizeof(T);
+		return true;
+	}
+
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	bool ReadAt(std::size_t offset, T& value) noexcept
+	{
+		return Contains(offset, sizeof(T)) && Seek(offset) && Read(value);
+	}
+
+	/// Fill all of `values` with consecutive items
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	bool ReadArray(std::span<T> values) noexcept
+	{
+		// Counts come from the file, check against the remaining bytes before multiplying out
+		if (values.size() > Remaining() / sizeof(T))
+		{
+			return false;
+		}
+		if (!values.empty())
+		{
+			std::memcpy(values.data(), _data.data() + _position, values.size_bytes());
+		}
+		_position += values.size_bytes();
+		return true;
+	}
+
+	/// Resize `values` to `count` and fill it, without allocating when the buffer is too short to hold them
+	template <typename T>
+	    requires std::is_trivially_copyable_v<T>
+	bool ReadVector(std::vector<T>& values, std::size_t count) noexcept
+	{
+		if (count > Remaining() / sizeof(T))
+		{
+			return false;
+		}
+		values.resize(count);
+		return ReadArray(std::span(values));
+	}
+
+	/// Read a null terminated string, the terminator is consumed but not included
+	bool ReadString(std::string& value) noexcept
+	{
+		const auto* begin = reinterpret_cast<const char*>(_data.data() + _position);
+		const auto* end = static_cast<const char*>(std::memchr(begin, '\0', Remaining()));
+		if (end == nullptr)
+		{
+			return false;
+		}
+		value.assign(begin, end);
+		_position += value.size() + 1;
+		return true;
+	}
+
+	/// Borrow the next `size` bytes without copying them and move past them, the view lives as long as the buffer does
+	bool View(std::size_t size, std::span<const std::byte>& view) noexcept
+	{
+		if (!Contains(_position, size))
+		{
+			return false;
+		}
+		view = _data.subspan(_position, size);
+		_position += size;
+		return true;
+	}
+
+private:
+	std::span<const std::byte> _data;
+	std::size_t _position {0};
+};
+
+/// Read what is left of a stream into memory so it can be parsed with a BinaryReader
+inline std::vector<std::byte> ReadAllBytes(std::istream& stream) noexcept
+{
+	std::vector<std::byte> bytes;
+	const auto start = stream.tellg();
+	if (start >= 0 && stream.seekg(0, std::ios_base::end))
+	{
+		const auto end = stream.tellg();
+		stream.seekg(start);
+		bytes.resize(static_cast<std::size_t>(end - start));
+		stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		bytes.resize(static_cast<std::size_t>(stream.gcount()));
+		return bytes;
+	}
+
+	// Streams which can't seek are read in chunks
+	stream.clear();
+	std::array<char, 4096> chunk;
+	while (stream.read(chunk.data(), chunk.size()) || stream.gcount() > 0)
+	{
+		const auto* begin = reinterpret_cast<const std::byte*>(chunk.data());
+		bytes.insert(bytes.end(), begin, begin + stream.gcount());
+	}
+	return bytes;
+}
+
+} // namespace openblack
@@ -9,11 +9,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include <array>
 #include <filesystem>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -93,6 +95,9 @@ class GLWFile
 	/// Read glw file from a buffer
 	GLWResult Open(const std::vector<uint8_t>& buffer) noexcept;
 
+	/// Read glw file from a buffer, the data is copied out so the buffer can be released afterwards
+	GLWResult Open(std::span<const std::byte> buffer) noexcept;
+
 	/// Read file from the input source
 	GLWResult ReadFile(std::istream& stream) noexcept;
 
@@ -22,48 +22,7 @@
 #include <utility>
 #include <vector>
 
-namespace
-{
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-} // namespace
+#include <BinaryReader.h>
 
 using namespace openblack::glw;
 
@@ -82,27 +41,27 @@ std::string_view openblack::glw::ResultToStr(GLWResult result)
 }
 
 GLWResult GLWFile::ReadFile(std::istream& stream) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer);
+}
+
+GLWResult GLWFile::Open(std::span<const std::byte> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	while ((fsize - stream.tellg()) > sizeof(Glow))
+	// The glows are followed by their count
+	Glow glow;
+	while (reader.Remaining() > sizeof(Glow))
 	{
-		Glow glow;
-		stream.read(reinterpret_cast<char*>(&glow), sizeof(glow));
+		reader.Read(glow);
 		_glows.emplace_back(glow);
 	}
 
 	uint32_t glowCount;
-	stream.read(reinterpret_cast<char*>(&glowCount), sizeof(glowCount));
-
-	if (glowCount != _glows.size())
+	if (!reader.Read(glowCount) || glowCount != _glows.size())
 	{
 		return GLWResult::ErrItemCountMismatch;
 	}
@@ -141,11 +100,7 @@ GLWResult GLWFile::Open(const std::filesystem::path& filepath) noexcept
 
 GLWResult GLWFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
-	assert(!_isLoaded);
-
-	auto stream = imemstream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return Open(std::as_bytes(std::span(buffer)));
 }
 
 GLWResult GLWFile::Write(const std::filesystem::path& filepath) noexcept
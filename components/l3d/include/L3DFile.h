@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
@@ -48,6 +50,9 @@ enum class L3DResult : uint8_t
 	ErrBadFootprintMeshOffset,
 	ErrBadFootprintTextureOffset,
 	ErrBadFootprintPixelOffset,
+	ErrBadUv2Offset,
+	ErrBadNameOffset,
+	ErrBadExtraMetricsOffset,
 };
 
 std::string_view ResultToStr(L3DResult result);
@@ -348,6 +353,9 @@ class L3DFile
 	/// Read l3d file from a buffer
 	L3DResult Open(const std::vector<uint8_t>& buffer) noexcept;
 
+	/// Read l3d file from a buffer, the data is copied out so the buffer can be released afterwards
+	L3DResult Open(std::span<const std::byte> buffer) noexcept;
+
 	/// Write l3d file to path on the filesystem
 	L3DResult Write(const std::filesystem::path& filepath) noexcept;
 
@@ -175,50 +175,9 @@
 #include <utility>
 #include <vector>
 
-using namespace openblack::l3d;
-
-namespace
-{
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
+#include <BinaryReader.h>
 
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-} // namespace
+using namespace openblack::l3d;
 
 template <typename Item>
 void add_span(std::vector<std::span<Item>>& container, typename std::vector<Item>& items, size_t offset, size_t length)
@@ -290,6 +249,12 @@ std::string_view openblack::l3d::ResultToStr(L3DResult result)
 		return "Footprint texture data go beyond footprint data.";
 	case L3DResult::ErrBadFootprintPixelOffset:
 		return "Footprint pixel data go beyond footprint data.";
+	case L3DResult::ErrBadUv2Offset:
+		return "UV2 data go beyond file.";
+	case L3DResult::ErrBadNameOffset:
+		return "Name data go beyond file.";
+	case L3DResult::ErrBadExtraMetricsOffset:
+		return "Extra metrics data go beyond file.";
 	}
 	std::unreachable();
 }
@@ -298,24 +263,22 @@ L3DFile::L3DFile() noexcept = default;
 L3DFile::~L3DFile() noexcept = default;
 
 L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer);
+}
+
+L3DResult L3DFile::Open(std::span<const std::byte> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	if (fsize < sizeof(L3DHeader))
+	// First 76 bytes
+	if (!reader.Read(_header))
 	{
 		return L3DResult::ErrFileTooSmall;
 	}
-
-	// First 76 bytes
-	stream.read(reinterpret_cast<char*>(&_header), sizeof(L3DHeader));
 	if (_header.magic != k_Magic)
 	{
 		return L3DResult::ErrBadHeader;
@@ -325,45 +288,29 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	std::vector<uint32_t> submeshOffsets(_header.submeshCount);
 	if (!submeshOffsets.empty() && _header.submeshOffsetsOffset != std::numeric_limits<uint32_t>::max())
 	{
-		if (_header.submeshOffsetsOffset > fsize)
-		{
-			return L3DResult::ErrBadSubmeshOffset;
-		}
-		if (_header.submeshOffsetsOffset + submeshOffsets.size() * sizeof(submeshOffsets[0]) > fsize)
+		if (!reader.Seek(_header.submeshOffsetsOffset) || !reader.ReadArray(std::span(submeshOffsets)))
 		{
 			return L3DResult::ErrBadSubmeshOffset;
 		}
-		stream.seekg(_header.submeshOffsetsOffset);
-		stream.read(reinterpret_cast<char*>(submeshOffsets.data()), submeshOffsets.size() * sizeof(submeshOffsets[0]));
 	}
-	std::vector<uint32_t> skinOffsets;
-	skinOffsets.resize(_header.skinCount);
+	std::vector<uint32_t> skinOffsets(_header.skinCount);
 	if (!skinOffsets.empty() && _header.skinOffsetsOffset != std::numeric_limits<uint32_t>::max())
 	{
-		if (_header.skinOffsetsOffset > fsize)
-		{
-			return L3DResult::ErrBadSkinOffset;
-		}
-		if (_header.skinOffsetsOffset + skinOffsets.size() * sizeof(skinOffsets[0]) > fsize)
+		if (!reader.Seek(_header.skinOffsetsOffset) || !reader.ReadArray(std::span(skinOffsets)))
 		{
 			return L3DResult::ErrBadSkinOffset;
 		}
-		stream.seekg(_header.skinOffsetsOffset);
-		stream.read(reinterpret_cast<char*>(skinOffsets.data()), skinOffsets.size() * sizeof(skinOffsets[0]));
 	}
-	_extraPoints.resize(_header.extraDataCount);
-	if (!_extraPoints.empty() && _header.extraDataOffset != std::numeric_limits<uint32_t>::max())
+	if (_header.extraDataCount > 0 && _header.extraDataOffset != std::numeric_limits<uint32_t>::max())
 	{
-		if (_header.extraDataOffset > fsize)
+		if (!reader.Seek(_header.extraDataOffset) || !reader.ReadVector(_extraPoints, _header.extraDataCount))
 		{
 			return L3DResult::ErrBadPointsOffset;
 		}
-		if (_header.extraDataOffset + _extraPoints.size() * sizeof(_extraPoints[0]) > fsize)
-		{
-			return L3DResult::ErrBadPointsOffset;
-		}
-		stream.seekg(_header.extraDataOffset);
-		stream.read(reinterpret_cast<char*>(_extraPoints.data()), _extraPoints.size() * sizeof(_extraPoints[0]));
+	}
+	else
+	{
+		_extraPoints.resize(_header.extraDataCount);
 	}
 
 	// Reserve space and read submeshes
@@ -372,13 +319,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	_submeshHeaders.reserve(submeshOffsets.size());
 	for (auto offset : submeshOffsets)
 	{
-		if (offset + sizeof(_submeshHeaders[0]) > fsize)
+		auto& header = _submeshHeaders.emplace_back();
+		if (!reader.ReadAt(offset, header))
 		{
 			return L3DResult::ErrBadSubmeshHeaderOffset;
 		}
-		stream.seekg(offset);
-		auto& header = _submeshHeaders.emplace_back();
-		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
 		totalPrimitives += header.numPrimitives;
 		totalBones += header.numBones;
 	}
@@ -390,17 +335,15 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 		// In 1.00, sometimes the offset is the size of the file.
 		// Not certain if it had special significance or a bug.
 		// In any case, skipping it doesn't result in catastrophe.
-		if (offset == fsize)
+		if (offset == reader.Size())
 		{
 			continue;
 		}
-		if (offset + sizeof(_skins[0]) > fsize)
+		auto& skin = _skins.emplace_back();
+		if (!reader.ReadAt(offset, skin))
 		{
 			return L3DResult::ErrBadSkinTextureOffset;
 		}
-		stream.seekg(offset);
-		auto& skin = _skins.emplace_back();
-		stream.read(reinterpret_cast<char*>(&skin), sizeof(skin));
 	}
 
 	// Reserve space for primitive offsets
@@ -408,30 +351,19 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	uint32_t primitiveCounter = 0;
 	for (const auto& header : _submeshHeaders)
 	{
-		stream.seekg(header.primitivesOffset);
 		if (primitiveCounter + header.numPrimitives > totalPrimitives)
 		{
 			return L3DResult::ErrBadPrimitiveCount;
 		}
-
 		if (header.numPrimitives == 0)
 		{
 			continue;
 		}
-		if (primitiveOffsets.size() <= primitiveCounter)
-		{
-			return L3DResult::ErrBadPrimitiveCount;
-		}
-		if (primitiveOffsets[primitiveCounter] > fsize)
-		{
-			return L3DResult::ErrBadPrimitiveOffset;
-		}
-		if (primitiveOffsets[primitiveCounter] + primitiveOffsets[primitiveCounter] * sizeof(primitiveOffsets[0]) > fsize)
+		const auto offsets = std::span(primitiveOffsets).subspan(primitiveCounter, header.numPrimitives);
+		if (!reader.Seek(header.primitivesOffset) || !reader.ReadArray(offsets))
 		{
 			return L3DResult::ErrBadPrimitiveOffset;
 		}
-		stream.read(reinterpret_cast<char*>(&primitiveOffsets[primitiveCounter]),
-		            header.numPrimitives * sizeof(primitiveOffsets[0]));
 		primitiveCounter += header.numPrimitives;
 	}
 	if (primitiveCounter != totalPrimitives)
@@ -447,17 +379,15 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	uint32_t totalBlendValues = 0;
 	for (auto offset : primitiveOffsets)
 	{
-		if (offset + sizeof(_primitiveHeaders[0]) > fsize)
+		auto& header = _primitiveHeaders.emplace_back();
+		if (!reader.ReadAt(offset, header))
 		{
 			return L3DResult::ErrBadPrimitiveHeaderOffset;
 		}
-		stream.seekg(offset);
-		_primitiveHeaders.emplace_back();
-		stream.read(reinterpret_cast<char*>(&_primitiveHeaders.back()), sizeof(_primitiveHeaders[0]));
-		totalVertices += _primitiveHeaders.back().numVertices;
-		totalIndices += _primitiveHeaders.back().numTriangles * 3;
-		totalGroups += _primitiveHeaders.back().numGroups;
-		totalBlendValues += _primitiveHeaders.back().numVertexBlends;
+		totalVertices += header.numVertices;
+		totalIndices += header.numTriangles * 3;
+		totalGroups += header.numGroups;
+		totalBlendValues += header.numVertexBlends;
 	}
 
 	// Reserve space for vertices
@@ -471,12 +401,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.verticesOffset + header.numVertices * sizeof(_vertices[0]) > fsize)
+			const auto vertices = std::span(_vertices).subspan(counter, header.numVertices);
+			if (!reader.Seek(header.verticesOffset) || !reader.ReadArray(vertices))
 			{
 				return L3DResult::ErrBadVertexOffset;
 			}
-			stream.seekg(header.verticesOffset);
-			stream.read(reinterpret_cast<char*>(&_vertices[counter]), header.numVertices * sizeof(_vertices[0]));
 			counter += header.numVertices;
 		}
 		if (counter != totalVertices)
@@ -496,12 +425,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.trianglesOffset + header.numTriangles * 3 * sizeof(_indices[0]) > fsize)
+			const auto indices = std::span(_indices).subspan(counter, header.numTriangles * 3);
+			if (!reader.Seek(header.trianglesOffset) || !reader.ReadArray(indices))
 			{
 				return L3DResult::ErrBadTriangleOffset;
 			}
-			stream.seekg(header.trianglesOffset);
-			stream.read(reinterpret_cast<char*>(&_indices[counter]), header.numTriangles * 3 * sizeof(_indices[0]));
 			counter += header.numTriangles * 3;
 		}
 		if (counter != totalIndices)
@@ -521,12 +449,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.groupsOffset + header.numGroups * sizeof(_vertexGroups[0]) > fsize)
+			const auto vertexGroups = std::span(_vertexGroups).subspan(counter, header.numGroups);
+			if (!reader.Seek(header.groupsOffset) || !reader.ReadArray(vertexGroups))
 			{
 				return L3DResult::ErrBadVertexGroupOffset;
 			}
-			stream.seekg(header.groupsOffset);
-			stream.read(reinterpret_cast<char*>(&_vertexGroups[counter]), header.numGroups * sizeof(_vertexGroups[0]));
 			counter += header.numGroups;
 		}
 		if (counter != totalGroups)
@@ -537,7 +464,6 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 
 	// Reserve space for vertex blend data
 	_blends.resize(totalBlendValues);
-
 	if (!_blends.empty())
 	{
 		uint32_t counter = 0;
@@ -547,12 +473,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.vertexBlendsOffset + header.numVertexBlends * sizeof(_blends[0]) > fsize)
+			const auto blends = std::span(_blends).subspan(counter, header.numVertexBlends);
+			if (!reader.Seek(header.vertexBlendsOffset) || !reader.ReadArray(blends))
 			{
 				return L3DResult::ErrBadBlendOffset;
 			}
-			stream.seekg(header.vertexBlendsOffset);
-			stream.read(reinterpret_cast<char*>(&_blends[counter]), header.numVertexBlends * sizeof(_blends[0]));
 			counter += header.numVertexBlends;
 		}
 		if (counter != totalBlendValues)
@@ -572,12 +497,11 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 			{
 				continue;
 			}
-			if (header.bonesOffset + header.numBones * sizeof(_bones[0]) > fsize)
+			const auto bones = std::span(_bones).subspan(counter, header.numBones);
+			if (!reader.Seek(header.bonesOffset) || !reader.ReadArray(bones))
 			{
 				return L3DResult::ErrBadBoneOffset;
 			}
-			stream.seekg(header.bonesOffset);
-			stream.read(reinterpret_cast<char*>(&_bones[counter]), header.numBones * sizeof(_bones[0]));
 			counter += header.numBones;
 		}
 		if (counter != totalBones)
@@ -589,71 +513,60 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	// Get additional data. Strictly in this order
 	// Footprint data
 	const auto headerFlags = static_cast<uint32_t>(_header.flags);
-	uint32_t additionalDataOffset = 0;
+	const uint32_t additionalDataOffset = _header.footprintDataOffset;
 	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsLandscapeFeature)) != 0u)
 	{
-		stream.seekg(0x48, std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&additionalDataOffset), sizeof(additionalDataOffset));
-		stream.seekg(additionalDataOffset, std::istream::beg);
 		L3DFootprintHeader header;
-		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		std::span<const std::byte> footprintBytes;
+		if (!reader.ReadAt(additionalDataOffset, header) || header.size < sizeof(L3DFootprintHeader) - 8 ||
+		    !reader.View(header.size - sizeof(L3DFootprintHeader) + 8, footprintBytes))
+		{
+			return L3DResult::ErrBadFootprintOffset;
+		}
 		assert(header.unknown == 0); // Make sure that unknown is always 0
-		std::vector<uint8_t> footprintData;
-		footprintData.resize(header.size);
-		stream.read(reinterpret_cast<char*>(footprintData.data()), header.size - sizeof(L3DFootprintHeader) + 8);
 
-		uint32_t offset = 0;
+		// The entries are parsed from a zero padded copy of the block, they can run into the footer
+		std::vector<std::byte> footprintData(header.size);
+		std::memcpy(footprintData.data(), footprintBytes.data(), footprintBytes.size());
+		BinaryReader footprintReader(footprintData);
+
 		std::vector<L3DFootprintEntry> entries;
 		entries.resize(header.count);
 
 		for (auto& entry : entries)
 		{
-			if (static_cast<int>(footprintData.size()) - offset <
-			    sizeof(entry.unknown1) + sizeof(entry.unknown2) + sizeof(entry.triangleCount))
+			if (!footprintReader.Read(entry.unknown1) || !footprintReader.Read(entry.unknown2) ||
+			    !footprintReader.Read(entry.triangleCount))
 			{
 				return L3DResult::ErrBadFootprintOffset;
 			}
-			memcpy(&entry.unknown1, &footprintData[offset],
-			       sizeof(entry.unknown1) + sizeof(entry.unknown2) + sizeof(entry.triangleCount));
-			offset += sizeof(entry.unknown1) + sizeof(entry.unknown2) + sizeof(entry.triangleCount);
 
 			assert(entry.unknown2 == 0); // Make sure that unknown is always 0
 			assert(entry.unknown3 == 0); // Make sure that unknown is always 0
 			assert(entry.unknown4 == 0); // Make sure that unknown is always 0
 			assert(entry.unknown5 == 0); // Make sure that unknown is always 0
 
-			if (static_cast<int>(footprintData.size()) - offset < entry.triangleCount * sizeof(L3DFootprintTriangle))
+			if (!footprintReader.ReadVector(entry.triangles, entry.triangleCount))
 			{
 				return L3DResult::ErrBadFootprintMeshOffset;
 			}
-			entry.triangles.resize(entry.triangleCount);
-			memcpy(entry.triangles.data(), &footprintData[offset], entry.triangleCount * sizeof(L3DFootprintTriangle));
-			offset += entry.triangleCount * sizeof(L3DFootprintTriangle);
-
-			if (static_cast<int>(footprintData.size()) - offset < header.width * header.height * sizeof(uint16_t))
+			if (!footprintReader.ReadVector(entry.pixels, static_cast<size_t>(header.width) * header.height))
 			{
 				return L3DResult::ErrBadFootprintTextureOffset;
 			}
-			entry.pixels.resize(header.width * header.height);
-			memcpy(entry.pixels.data(), &footprintData[offset], header.width * header.height * sizeof(uint16_t));
-			offset += header.width * header.height * sizeof(uint16_t);
-
-			if (static_cast<int>(footprintData.size()) - offset <
-			    sizeof(entry.unknown3) + sizeof(entry.unknown4) + sizeof(entry.unknown5))
+			if (!footprintReader.Read(entry.unknown3) || !footprintReader.Read(entry.unknown4) ||
+			    !footprintReader.Read(entry.unknown5))
 			{
 				return L3DResult::ErrBadFootprintPixelOffset;
 			}
-			memcpy(&entry.unknown3, &footprintData[offset],
-			       sizeof(entry.unknown3) + sizeof(entry.unknown4) + sizeof(entry.unknown5));
-			offset += sizeof(entry.unknown3) + sizeof(entry.unknown4) + sizeof(entry.unknown5);
 		}
 
 		L3DFootprintFooter footer;
-		stream.read(reinterpret_cast<char*>(&footer), sizeof(footer));
-		// NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores): offset used in assert
-		offset += sizeof(footer);
-
-		assert(footprintData.size() == offset);
+		if (!reader.Read(footer))
+		{
+			return L3DResult::ErrBadFootprintOffset;
+		}
+		assert(footprintData.size() == footprintReader.Tell() + sizeof(footer));
 
 		_footprint = std::make_optional(L3DFootprint {header, entries, footer});
 	}
@@ -663,50 +576,41 @@ L3DResult L3DFile::ReadFile(std::istream& stream) noexcept
 	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsUV2)) != 0u)
 	{
 		// TODO(#483): Investigate optional UV2 block
-		stream.seekg(0x48, std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&additionalDataOffset), sizeof(additionalDataOffset));
-		stream.seekg(additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0), std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&uv2DataSize), sizeof(uv2DataSize));
-		stream.seekg(8, std::istream::cur);
-		_uv2Data.resize(uv2DataSize);
-		stream.read(reinterpret_cast<char*>(_uv2Data.data()), _uv2Data.size());
+		const auto offset = additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0);
+		if (!reader.ReadAt(offset, uv2DataSize) || !reader.Skip(8) || !reader.ReadVector(_uv2Data, uv2DataSize))
+		{
+			return L3DResult::ErrBadUv2Offset;
+		}
 	}
 
 	// Name data
 	uint32_t nameDataSize = 0;
 	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsNameData)) != 0u)
 	{
-		stream.seekg(0x48, std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&additionalDataOffset), sizeof(additionalDataOffset));
-		stream.seekg(additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0) + uv2DataSize,
-		             std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&nameDataSize), sizeof(nameDataSize));
-		stream.seekg(8, std::istream::cur);
-		_nameData.resize(nameDataSize);
-		stream.read(_nameData.data(), _nameData.size());
+		const auto offset = additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0) + uv2DataSize;
+		std::span<const std::byte> name;
+		if (!reader.ReadAt(offset, nameDataSize) || !reader.Skip(8) || !reader.View(nameDataSize, name))
+		{
+			return L3DResult::ErrBadNameOffset;
+		}
+		_nameData.assign(reinterpret_cast<const char*>(name.data()), name.size());
 	}
 
 	// Extra Metrics
-	uint32_t extraMetricsSize;
-	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsExtraMetrics)) != 0u)
+	if ((headerFlags & static_cast<uint32_t>(L3DMeshFlags::ContainsExtraMetrics)) != 0u && additionalDataOffset > 0)
 	{
-		stream.seekg(0x48, std::istream::beg);
-		stream.read(reinterpret_cast<char*>(&additionalDataOffset), sizeof(additionalDataOffset));
-		if (additionalDataOffset > 0)
+		const auto offset =
+		    additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0) + uv2DataSize + nameDataSize;
+		uint32_t extraMetricsSize = 0;
+		uint32_t numMetrics = 0;
+		uint32_t blockOffset = 0;
+		if (!reader.ReadAt(offset, extraMetricsSize) || !reader.Read(numMetrics) || !reader.Read(blockOffset) ||
+		    !reader.ReadVector(_extraMetrics, numMetrics))
 		{
-			auto offset =
-			    additionalDataOffset + (_footprint.has_value() ? _footprint->header.size : 0) + uv2DataSize + nameDataSize;
-			stream.seekg(offset, std::istream::beg);
-			stream.read(reinterpret_cast<char*>(&extraMetricsSize), sizeof(extraMetricsSize));
-			uint32_t numMetrics = 0;
-			stream.read(reinterpret_cast<char*>(&numMetrics), sizeof(numMetrics));
-			uint32_t blockOffset = 0;
-			stream.read(reinterpret_cast<char*>(&blockOffset), sizeof(blockOffset));
-			assert(blockOffset == offset + sizeof(extraMetricsSize) + sizeof(numMetrics) + sizeof(blockOffset));
-			_extraMetrics.resize(numMetrics);
-			assert(extraMetricsSize - 8 == sizeof(blockOffset) + sizeof(_extraMetrics[0]) * _extraMetrics.size());
-			stream.read(reinterpret_cast<char*>(_extraMetrics.data()), sizeof(_extraMetrics[0]) * _extraMetrics.size());
+			return L3DResult::ErrBadExtraMetricsOffset;
 		}
+		assert(blockOffset == offset + sizeof(extraMetricsSize) + sizeof(numMetrics) + sizeof(blockOffset));
+		assert(extraMetricsSize - 8 == sizeof(blockOffset) + sizeof(_extraMetrics[0]) * _extraMetrics.size());
 	}
 
 	// Create spans per submesh
@@ -874,11 +778,7 @@ L3DResult L3DFile::Open(const std::filesystem::path& filepath) noexcept
 
 L3DResult L3DFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return Open(std::as_bytes(std::span(buffer)));
 }
 
 L3DResult L3DFile::Write(const std::filesystem::path& filepath) noexcept
@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -26,6 +29,7 @@ enum class LNDResult : uint8_t
 	ErrNonStandardBlockSize,
 	ErrNonStandardMaterialSize,
 	ErrNonStandardCountrySize,
+	ErrBadLowResolutionTextureSize,
 	ErrBadBlockSize,
 	ErrBadMaterialSize,
 	ErrBadCountrySize,
@@ -210,6 +214,9 @@ class LNDFile
 	/// Read lnd file from a buffer
 	LNDResult Open(const std::vector<uint8_t>& buffer) noexcept;
 
+	/// Read lnd file from a buffer, the data is copied out so the buffer can be released afterwards
+	LNDResult Open(std::span<const std::byte> buffer) noexcept;
+
 	/// Write lnd file to path on the filesystem
 	LNDResult Write(const std::filesystem::path& filepath) noexcept;
 
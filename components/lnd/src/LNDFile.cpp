@@ -111,54 +111,13 @@
 #include <stdexcept>
 #include <utility>
 
+#include <BinaryReader.h>
+
 using namespace openblack::lnd;
 
 LNDFile::LNDFile() noexcept = default;
 LNDFile::~LNDFile() noexcept = default;
 
-namespace
-{
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - pos_type(static_cast<off_type>(0)), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-} // namespace
-
 std::string_view openblack::lnd::ResultToStr(LNDResult result)
 {
 	switch (result)
@@ -175,6 +134,8 @@ std::string_view openblack::lnd::ResultToStr(LNDResult result)
 		return "File has non standard material size.";
 	case LNDResult::ErrNonStandardCountrySize:
 		return "File has non standard country size.";
+	case LNDResult::ErrBadLowResolutionTextureSize:
+		return "Low resolution textures are beyond the end of the file.";
 	case LNDResult::ErrBadBlockSize:
 		return "Blocks are beyond the end of the file.";
 	case LNDResult::ErrBadMaterialSize:
@@ -190,25 +151,23 @@ std::string_view openblack::lnd::ResultToStr(LNDResult result)
 }
 
 LNDResult LNDFile::ReadFile(std::istream& stream) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer);
+}
+
+LNDResult LNDFile::Open(std::span<const std::byte> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	if (fsize < sizeof(LNDHeader))
+	// First 1052 bytes
+	if (!reader.Read(_header))
 	{
 		return LNDResult::ErrFileTooSmall;
 	}
 
-	// First 1052 bytes
-	stream.read(reinterpret_cast<char*>(&_header), sizeof(LNDHeader));
-
 	if (_header.blockSize != sizeof(LNDBlock))
 	{
 		return LNDResult::ErrNonStandardBlockSize;
@@ -226,54 +185,40 @@ LNDResult LNDFile::ReadFile(std::istream& stream) noexcept
 	_lowResolutionTextures.resize(_header.lowResolutionCount);
 	for (auto& texture : _lowResolutionTextures)
 	{
-		stream.read(reinterpret_cast<char*>(&texture.header), sizeof(texture.header));
-		texture.texels.resize(texture.header.size - sizeof(texture.header.size));
-		stream.read(reinterpret_cast<char*>(texture.texels.data()), texture.texels.size() * sizeof(texture.texels[0]));
+		if (!reader.Read(texture.header) || texture.header.size < sizeof(texture.header.size) ||
+		    !reader.ReadVector(texture.texels, (texture.header.size - sizeof(texture.header.size)) / sizeof(texture.texels[0])))
+		{
+			return LNDResult::ErrBadLowResolutionTextureSize;
+		}
 	}
 
 	// Read Blocks
 	// take away a block from the count, because it's not in the file?
-	_blocks.resize(_header.blockCount - 1);
-	if (static_cast<std::size_t>(stream.tellg()) + _blocks.size() * sizeof(_blocks[0]) > fsize)
+	if (_header.blockCount == 0 || !reader.ReadVector(_blocks, _header.blockCount - 1))
 	{
 		return LNDResult::ErrBadBlockSize;
 	}
-	stream.read(reinterpret_cast<char*>(_blocks.data()), _blocks.size() * sizeof(_blocks[0]));
 
 	// Read Countries
-	_countries.resize(_header.countryCount);
-	if (static_cast<std::size_t>(stream.tellg()) + _countries.size() * sizeof(_countries[0]) > fsize)
+	if (!reader.ReadVector(_countries, _header.countryCount))
 	{
 		return LNDResult::ErrBadCountrySize;
 	}
-	stream.read(reinterpret_cast<char*>(_countries.data()), _countries.size() * sizeof(_countries[0]));
 
 	// Read Materials
-	_materials.resize(_header.materialCount);
-	if (static_cast<std::size_t>(stream.tellg()) + _materials.size() * sizeof(_materials[0]) > fsize)
+	if (!reader.ReadVector(_materials, _header.materialCount))
 	{
 		return LNDResult::ErrBadMaterialSize;
 	}
-	stream.read(reinterpret_cast<char*>(_materials.data()), _materials.size() * sizeof(_materials[0]));
 
 	// Read Extra textures (noise and bump map)
-	if (static_cast<std::size_t>(stream.tellg()) + sizeof(_extra) > fsize)
+	if (!reader.Read(_extra))
 	{
 		return LNDResult::ErrExtraTextureData;
 	}
-	stream.read(reinterpret_cast<char*>(&_extra), sizeof(_extra));
 
 	// Get all bytes that weren't read
-	if (stream.peek() != EOF)
-	{
-		_unaccounted.resize(static_cast<std::size_t>(fsize - stream.tellg()));
-		stream.read(reinterpret_cast<char*>(_unaccounted.data()), _unaccounted.size() * sizeof(_unaccounted[0]));
-	}
-
-	if (stream.peek() != EOF)
-	{
-		return LNDResult::ErrUnaccountedData;
-	}
+	reader.ReadVector(_unaccounted, reader.Remaining());
 
 	return LNDResult::Success;
 }
@@ -325,11 +270,7 @@ LNDResult LNDFile::Open(const std::filesystem::path& filepath) noexcept
 
 LNDResult LNDFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return Open(std::as_bytes(std::span(buffer)));
 }
 
 LNDResult LNDFile::Write(const std::filesystem::path& filepath) noexcept
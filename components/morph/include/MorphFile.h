@@ -9,11 +9,19 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
+namespace openblack
+{
+class BinaryReader;
+}
+
 namespace openblack::morph
 {
 
@@ -25,6 +33,8 @@ enum class MorphResult : uint8_t
 	ErrSpecFileCantOpen,
 	ErrSpecFileVersionMismatch,
 	ErrSpecFileAnimationsBeforeCategories,
+	ErrBadAnimationOffset,
+	ErrBadHairGroupData,
 };
 
 std::string_view ResultToStr(MorphResult result);
@@ -182,8 +192,9 @@ class MorphFile
 	/// Read file from the input source
 	MorphResult ReadFile(std::istream& stream, const std::filesystem::path& specsDirectory) noexcept;
 	MorphResult ReadSpecFile(const std::filesystem::path& specFilePath) noexcept;
-	std::vector<Animation> ReadAnimations(std::istream& stream, const std::vector<uint32_t>& offsets) noexcept;
-	HairGroup ReadHairGroup(std::istream& stream) noexcept;
+	bool ReadAnimations(BinaryReader& reader, const std::vector<uint32_t>& offsets,
+	                    std::vector<Animation>& animations) noexcept;
+	static bool ReadHairGroup(BinaryReader& reader, HairGroup& hairGroup) noexcept;
 
 public:
 	MorphFile() noexcept;
@@ -195,6 +206,9 @@ class MorphFile
 	/// Read morph file from a buffer
 	MorphResult Open(const std::vector<uint8_t>& buffer, const std::filesystem::path& specsDirectory) noexcept;
 
+	/// Read morph file from a buffer, the data is copied out so the buffer can be released afterwards
+	MorphResult Open(std::span<const std::byte> buffer, const std::filesystem::path& specsDirectory) noexcept;
+
 	[[nodiscard]] const MorphHeader& GetHeader() const noexcept { return _header; }
 	[[nodiscard]] const AnimationSpecs& GetAnimationSpecs() const noexcept { return _animationSpecs; }
 	[[nodiscard]] const std::vector<Animation>& GetBaseAnimationSet() const noexcept { return _baseAnimation; }
@@ -87,50 +87,12 @@
 #include <utility>
 #include <vector>
 
+#include <BinaryReader.h>
+
 using namespace openblack::morph;
 
 namespace
 {
-// Adapted from https://stackoverflow.com/a/13059195/10604387
-//          and https://stackoverflow.com/a/46069245/10604387
-struct membuf: std::streambuf
-{
-	membuf(char const* base, size_t size)
-	{
-		char* p(const_cast<char*>(base));
-		this->setg(p, p, p + size);
-	}
-	std::streampos seekoff(off_type off, std::ios_base::seekdir way, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		if (way == std::ios_base::cur)
-		{
-			gbump(static_cast<int>(off));
-		}
-		else if (way == std::ios_base::end)
-		{
-			setg(eback(), egptr() + off, egptr());
-		}
-		else if (way == std::ios_base::beg)
-		{
-			setg(eback(), eback() + off, egptr());
-		}
-		return gptr() - eback();
-	}
-
-	std::streampos seekpos([[maybe_unused]] pos_type pos, [[maybe_unused]] std::ios_base::openmode which) override
-	{
-		return seekoff(pos - static_cast<off_type>(0), std::ios_base::beg, which);
-	}
-};
-struct imemstream: virtual membuf, std::istream
-{
-	imemstream(char const* base, size_t size)
-	    : membuf(base, size)
-	    , std::istream(dynamic_cast<std::streambuf*>(this))
-	{
-	}
-};
-
 // https://stackoverflow.com/questions/6089231/getting-std-ifstream-to-handle-lf-cr-and-crlf
 std::istream& safe_getline(std::istream& is, std::string& t)
 {
@@ -188,6 +150,10 @@ std::string_view openblack::morph::ResultToStr(MorphResult result)
 		return "Spec file version mismatch.";
 	case MorphResult::ErrSpecFileAnimationsBeforeCategories:
 		return "Spec file has animations before categories.";
+	case MorphResult::ErrBadAnimationOffset:
+		return "Animation data is beyond the end of the file.";
+	case MorphResult::ErrBadHairGroupData:
+		return "Hair group data is beyond the end of the file.";
 	}
 	std::unreachable();
 }
@@ -245,12 +211,11 @@ MorphResult MorphFile::ReadSpecFile(const std::filesystem::path& specFilePath) n
 	return MorphResult::Success;
 }
 
-std::vector<Animation> MorphFile::ReadAnimations(std::istream& stream, const std::vector<uint32_t>& offsets) noexcept
+bool MorphFile::ReadAnimations(BinaryReader& reader, const std::vector<uint32_t>& offsets,
+                               std::vector<Animation>& animations) noexcept
 {
 	assert(!_isLoaded);
 
-	std::vector<Animation> animations;
-
 	uint32_t i = 0;
 	for (auto& animSet : _animationSpecs.animationSets)
 	{
@@ -258,66 +223,59 @@ std::vector<Animation> MorphFile::ReadAnimations(std::istream& stream, const std
 		{
 			if (offsets[i] > 0)
 			{
-				stream.seekg(offsets[i]);
 				auto& animation = animations.emplace_back();
-				stream.read(reinterpret_cast<char*>(&animation.header), sizeof(animation.header));
-
-				animation.rotatedJointIndices.resize(animation.header.rotatedJointCount);
-				stream.read(reinterpret_cast<char*>(animation.rotatedJointIndices.data()),
-				            animation.rotatedJointIndices.size() * sizeof(animation.rotatedJointIndices[0]));
-
-				animation.translatedJointIndices.resize(animation.header.translatedJointCount);
-				stream.read(reinterpret_cast<char*>(animation.translatedJointIndices.data()),
-				            animation.translatedJointIndices.size() * sizeof(animation.translatedJointIndices[0]));
+				if (!reader.ReadAt(offsets[i], animation.header) ||
+				    !reader.ReadVector(animation.rotatedJointIndices, animation.header.rotatedJointCount) ||
+				    !reader.ReadVector(animation.translatedJointIndices, animation.header.translatedJointCount))
+				{
+					return false;
+				}
 
+				// Bound the allocation by the size of the file before trusting the count
+				if (animation.header.frameCount > reader.Remaining())
+				{
+					return false;
+				}
 				animation.keyframes.resize(animation.header.frameCount);
 				for (auto& frame : animation.keyframes)
 				{
-					frame.eulerAngles.resize(animation.header.rotatedJointCount);
-					stream.read(reinterpret_cast<char*>(frame.eulerAngles.data()),
-					            frame.eulerAngles.size() * sizeof(frame.eulerAngles[0]));
-
-					frame.translations.resize(animation.header.translatedJointCount);
-					stream.read(reinterpret_cast<char*>(frame.translations.data()),
-					            frame.translations.size() * sizeof(frame.translations[0]));
+					if (!reader.ReadVector(frame.eulerAngles, animation.header.rotatedJointCount) ||
+					    !reader.ReadVector(frame.translations, animation.header.translatedJointCount))
+					{
+						return false;
+					}
 				}
 			}
 			i++;
 		}
 	}
 
-	return animations;
+	return true;
 }
 
-HairGroup MorphFile::ReadHairGroup(std::istream& stream) noexcept
+bool MorphFile::ReadHairGroup(BinaryReader& reader, HairGroup& hairGroup) noexcept
 {
-	HairGroup hairGroup;
-	stream.read(reinterpret_cast<char*>(&hairGroup.header), sizeof(hairGroup.header));
-	hairGroup.hairs.resize(hairGroup.header.hairCount);
-	stream.read(reinterpret_cast<char*>(hairGroup.hairs.data()), hairGroup.hairs.size() * sizeof(hairGroup.hairs[0]));
-	return hairGroup;
+	return reader.Read(hairGroup.header) && reader.ReadVector(hairGroup.hairs, hairGroup.header.hairCount);
 }
 
 MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::path& specsDirectory) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer, specsDirectory);
+}
+
+MorphResult MorphFile::Open(std::span<const std::byte> buffer, const std::filesystem::path& specsDirectory) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
-	if (fsize < sizeof(MorphHeader))
+	// First 236 bytes
+	if (!reader.Read(_header))
 	{
 		return MorphResult::ErrFileTooSmall;
 	}
 
-	// First 236 bytes
-	stream.read(reinterpret_cast<char*>(&_header), sizeof(MorphHeader));
-
 	assert(_header.binaryVersion > 4); // structure is much different below v5
 
 	// Parse spec file (a separate text file) using the version
@@ -344,41 +302,46 @@ MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::pat
 	}
 
 	// After the header is the anim set, a variable length array of offsets relative to the section offset
-	std::vector<uint32_t> animationOffsets(numAnimations);
-	stream.read(reinterpret_cast<char*>(animationOffsets.data()), animationOffsets.size() * sizeof(animationOffsets[0]));
-
+	std::vector<uint32_t> animationOffsets;
 	// Following the animation offsets are chained offsets which can lead to extra data
 	uint32_t extraOffset = 0;
-	stream.read(reinterpret_cast<char*>(&extraOffset), sizeof(extraOffset));
+	if (!reader.ReadVector(animationOffsets, numAnimations) || !reader.Read(extraOffset))
+	{
+		return MorphResult::ErrBadAnimationOffset;
+	}
 
 	// Read in the base animations using those offsets
-	_baseAnimation = ReadAnimations(stream, animationOffsets);
+	if (!ReadAnimations(reader, animationOffsets, _baseAnimation))
+	{
+		return MorphResult::ErrBadAnimationOffset;
+	}
 
 	// Creature files have different animations for the morph meshes (evil, good, thin, fat) weak, strong are skipped
 	for (uint32_t i = 0; i < 4; ++i)
 	{
 		if (std::strlen(_header.variantMeshNames.at(i).data()) > 0)
 		{
-			// Set file to next animation set
-			stream.seekg(extraOffset);
-
-			std::vector<uint32_t> variantAnimationOffsets(numAnimations);
-			stream.read(reinterpret_cast<char*>(variantAnimationOffsets.data()),
-			            variantAnimationOffsets.size() * sizeof(variantAnimationOffsets[0]));
-
-			// Again, the get pointer to the next part
-			stream.read(reinterpret_cast<char*>(&extraOffset), sizeof(extraOffset));
-
-			_variantAnimations.at(i) = ReadAnimations(stream, variantAnimationOffsets);
+			// Set file to next animation set, then again, the get pointer to the next part
+			std::vector<uint32_t> variantAnimationOffsets;
+			if (!reader.Seek(extraOffset) || !reader.ReadVector(variantAnimationOffsets, numAnimations) ||
+			    !reader.Read(extraOffset) || !ReadAnimations(reader, variantAnimationOffsets, _variantAnimations.at(i)))
+			{
+				return MorphResult::ErrBadAnimationOffset;
+			}
 		}
 	}
 
 	// Once all the animation sets are loaded, the extra offset points to hair groups data (even if there are none)
-	stream.seekg(extraOffset);
-	stream.read(reinterpret_cast<char*>(&_hairHeader), sizeof(_hairHeader));
+	if (!reader.ReadAt(extraOffset, _hairHeader))
+	{
+		return MorphResult::ErrBadHairGroupData;
+	}
 	for (uint32_t i = 0; i < _hairHeader.hairGroupCount; ++i)
 	{
-		_hairGroups.emplace_back(ReadHairGroup(stream));
+		if (!ReadHairGroup(reader, _hairGroups.emplace_back()))
+		{
+			return MorphResult::ErrBadHairGroupData;
+		}
 	}
 
 	// The extra data segment is in relation to the number of animations in the base animation set
@@ -390,10 +353,10 @@ MorphResult MorphFile::ReadFile(std::istream& stream, const std::filesystem::pat
 			continue;
 		}
 		uint32_t hasData; // TODO(#467): unknown if this serves another function
-		while (stream.read(reinterpret_cast<char*>(&hasData), sizeof(hasData)).good() && hasData != 0u)
+		while (reader.Read(hasData) && hasData != 0u)
 		{
 			auto& data = _extraData[i].emplace_back();
-			stream.read(reinterpret_cast<char*>(&data), sizeof(data));
+			reader.Read(data);
 		}
 	}
 
@@ -418,9 +381,5 @@ MorphResult MorphFile::Open(const std::filesystem::path& filepath, const std::fi
 
 MorphResult MorphFile::Open(const std::vector<uint8_t>& buffer, const std::filesystem::path& specsDirectory) noexcept
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream, specsDirectory);
+	return Open(std::as_bytes(std::span(buffer)), specsDirectory);
 }
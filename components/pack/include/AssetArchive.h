@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openblack::pack
+{
+
+enum class ArchiveResult : uint8_t
+{
+	Success = 0,
+	ErrCantOpen,
+	ErrFileTooSmall,
+	ErrUnrecognizedHeader,
+	ErrUnsupportedVersion,
+	ErrDirectoryMalformed,
+	ErrDuplicateEntry,
+	ErrEntryTooLarge,
+	ErrReadFailed,
+	ErrWriteFailed,
+	ErrCompressFailed,
+	ErrDecompressFailed,
+};
+
+std::string_view ResultToStr(ArchiveResult result);
+
+enum class ArchiveCompression : uint32_t
+{
+	None = 0,
+	Zlib = 1,
+};
+
+struct ArchiveHeader
+{
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t namesSize;
+	/// End of the directory, the entries' data starts here
+	uint64_t dataOffset;
+	uint64_t reserved;
+};
+static_assert(sizeof(ArchiveHeader) == 32);
+
+struct ArchiveEntry
+{
+	/// Hash of the lower case name, the directory is sorted by it
+	uint32_t nameHash;
+	/// Offset of the name in the name table, names are relative generic paths which aren't null terminated
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	ArchiveCompression compression;
+	/// Offset of the data from the start of the file
+	uint64_t offset;
+	uint32_t storedSize;
+	uint32_t size;
+};
+static_assert(sizeof(ArchiveEntry) == 32);
+
+/**
+  This class reads openblack asset archives: game files stored one after the other, each compressed on its own, behind a
+  directory which is read in one go and used in place
+ */
+class AssetArchive
+{
+public:
+	static constexpr std::array<char, 4> k_Magic = {'O', 'B', 'A', 'R'};
+	static constexpr uint32_t k_Version = 1;
+
+	/// Hash used to find names, case insensitive like the game's file system
+	[[nodiscard]] static uint32_t HashName(std::string_view name) noexcept;
+
+	AssetArchive() noexcept;
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+	~AssetArchive() noexcept;
+
+	/// Read the directory of an archive, the file is kept open to read entries from
+	ArchiveResult Open(const std::filesystem::path& filepath) noexcept;
+
+	/// Entry with this name, ignoring case, or nullptr
+	[[nodiscard]] const ArchiveEntry* Find(std::string_view name) const noexcept;
+
+	/// Read and decompress an entry, can be called from several threads at once
+	ArchiveResult Read(const ArchiveEntry& entry, std::vector<uint8_t>& data) noexcept;
+	/// Read `data.size()` bytes of an entry from `offset`. Only those bytes are read from stored entries, compressed ones are
+	/// decompressed in full first. Can be called from several threads at once
+	ArchiveResult Read(const ArchiveEntry& entry, size_t offset, std::span<uint8_t> data) noexcept;
+
+	[[nodiscard]] std::span<const ArchiveEntry> GetEntries() const noexcept { return _entries; }
+	[[nodiscard]] std::string_view GetName(const ArchiveEntry& entry) const noexcept;
+	[[nodiscard]] const std::filesystem::path& GetPath() const noexcept { return _path; }
+
+private:
+	std::filesystem::path _path;
+	std::ifstream _stream;
+	std::mutex _streamMutex;
+	/// Header, entries and names exactly as they are in the file
+	std::vector<uint8_t> _directory;
+	std::span<const ArchiveEntry> _entries;
+	std::string_view _names;
+};
+
+/**
+  This class writes openblack asset archives
+ */
+class AssetArchiveWriter
+{
+public:
+	/// Add a file, `name` is the path the game opens it with relative to the game directory
+	ArchiveResult Add(std::string name, std::vector<uint8_t> data, ArchiveCompression compression) noexcept;
+
+	/// Write the directory and every file's data in the order they were added, so loading reads forward
+	ArchiveResult Write(const std::filesystem::path& filepath) const noexcept;
+
+	[[nodiscard]] size_t GetEntryCount() const noexcept { return _files.size(); }
+
+private:
+	struct File
+	{
+		std::string name;
+		ArchiveCompression compression;
+		uint32_t size;
+		/// Compressed if that made it smaller
+		std::vector<uint8_t> stored;
+	};
+
+	std::vector<File> _files;
+};
+
+} // namespace openblack::pack
@@ -9,11 +9,14 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <array>
 #include <filesystem>
 #include <istream>
 #include <map>
 #include <memory>
+#include <span>
 #include <streambuf>
 #include <string>
 #include <vector>
@@ -176,6 +179,13 @@ struct AudioBankSampleHeader
 	uint16_t atmos;           ///<
 };
 
+/// Where an entry's bytes are in the pack file, so it can be read again on its own
+struct PackRange
+{
+	std::size_t offset;
+	std::size_t size;
+};
+
 /**
   This class is used to read LionHead Packs files
  */
@@ -188,12 +198,16 @@ class PackFile
 	bool _isLoaded {false};
 
 	std::map<std::string, std::vector<uint8_t>> _blocks;
+	/// Offset of the contents of each block read from a file
+	std::map<std::string, std::size_t> _blockOffsets;
 	std::vector<InfoBlockLookup> _infoBlockLookup;
 	std::vector<BodyBlockLookup> _bodyBlockLookup;
 	/// Metadata and DDS formatted texture data
 	std::map<std::string, G3DTexture> _textures;
-	/// Bytes of l3d meshes
-	std::vector<std::vector<uint8_t>> _meshes;
+	/// Bytes of l3d meshes, viewing either the MESHES block or the inserted meshes
+	std::vector<std::span<const uint8_t>> _meshes;
+	/// Meshes added with InsertMesh before the MESHES block is created
+	std::vector<std::vector<uint8_t>> _insertedMeshes;
 	/// Bytes of anm meshes
 	std::vector<std::vector<uint8_t>> _animations;
 	/// Headers of snd audio samples
@@ -202,7 +216,7 @@ class PackFile
 	std::vector<std::vector<uint8_t>> _audioSampleData;
 
 	/// Read blocks from pack
-	PackResult ReadBlocks(std::istream& stream) noexcept;
+	PackResult ReadBlocks(std::span<const std::byte> buffer) noexcept;
 
 	/// Write blocks to file
 	PackResult WriteBlocks(std::ostream& stream) const noexcept;
@@ -230,6 +244,8 @@ class PackFile
 
 public:
 	PackFile() noexcept;
+	PackFile(const PackFile&) = delete;
+	PackFile& operator=(const PackFile&) = delete;
 	virtual ~PackFile() noexcept;
 
 	/// Read file from the input source
@@ -241,6 +257,12 @@ class PackFile
 	/// Read g3d file from a buffer
 	PackResult Open(const std::vector<uint8_t>& buffer) noexcept;
 
+	/// Read g3d file from a buffer, the blocks are copied out so the buffer can be released afterwards
+	PackResult Open(std::span<const std::byte> buffer) noexcept;
+
+	/// Parse the contents of a texture block, as given by GetTextureRange
+	static PackResult ReadTexture(std::span<const std::byte> block, G3DTexture& texture) noexcept;
+
 	/// Write pack file to path on the filesystem
 	PackResult Write(const std::filesystem::path& filepath) noexcept;
 
@@ -270,8 +292,12 @@ class PackFile
 	[[nodiscard]] const std::vector<BodyBlockLookup>& GetBodyBlockLookup() const noexcept { return _bodyBlockLookup; }
 	[[nodiscard]] const std::map<std::string, G3DTexture>& GetTextures() const noexcept { return _textures; }
 	[[nodiscard]] const G3DTexture& GetTexture(const std::string& name) const noexcept { return _textures.at(name); }
-	[[nodiscard]] const std::vector<std::vector<uint8_t>>& GetMeshes() const noexcept { return _meshes; }
-	[[nodiscard]] const std::vector<uint8_t>& GetMesh(uint32_t index) const noexcept { return _meshes[index]; }
+	[[nodiscard]] const std::vector<std::span<const uint8_t>>& GetMeshes() const noexcept { return _meshes; }
+	[[nodiscard]] std::span<const uint8_t> GetMesh(uint32_t index) const noexcept { return _meshes[index]; }
+	/// Bytes of the mesh in the file the pack was opened from
+	[[nodiscard]] PackRange GetMeshRange(uint32_t index) const noexcept;
+	/// Bytes of the texture's block in the file the pack was opened from, to be parsed with ReadTexture
+	[[nodiscard]] PackRange GetTextureRange(const std::string& name) const noexcept;
 	[[nodiscard]] const std::vector<std::vector<uint8_t>>& GetAnimations() const noexcept { return _animations; }
 	[[nodiscard]] const std::vector<uint8_t>& GetAnimation(uint32_t index) const noexcept { return _animations[index]; }
 	[[nodiscard]] const std::vector<AudioBankSampleHeader>& GetAudioSampleHeaders() const noexcept
@@ -0,0 +1,365 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+/*
+ *
+ * The layout of an Asset Archive is as follows:
+ *
+ * - 32 byte header containing:
+ *         4 byte magic, containing the chars "OBAR"
+ *         4 byte version
+ *         4 byte number of entries
+ *         4 byte size of the name table
+ *         8 byte offset of the end of the directory
+ *         8 bytes reserved
+ * - 32 byte entry * number of entries, sorted by name hash, containing:
+ *         name hash - FNV-1a of the lower case name
+ *         name offset - offset of the name in the name table
+ *         name length
+ *         compression - 0 for stored, 1 for zlib
+ *         offset - 8 byte offset of the data from the start of the file
+ *         stored size - size of the data in the file
+ *         size - size of the data once decompressed
+ * - name table, the names one after the other without terminators
+ *
+ * ------------------------- end of directory ----------------------------------
+ *
+ * - data of every entry one after the other, in the order the files were added
+ *
+ * ------------------------- end of file ---------------------------------------
+ *
+ * The header, entries and names are laid out so they are used in place once
+ * read, the directory is one read and never parsed entry by entry.
+ *
+ */
+
+#include "AssetArchive.h"
+
+#include <cctype>
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include <zlib.h>
+
+using namespace openblack::pack;
+
+namespace
+{
+char LowerCase(char c)
+{
+	return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+bool EqualsIgnoringCase(std::string_view left, std::string_view right)
+{
+	return std::ranges::equal(left, right, [](char l, char r) { return LowerCase(l) == LowerCase(r); });
+}
+
+bool LessIgnoringCase(std::string_view left, std::string_view right)
+{
+	return std::ranges::lexicographical_compare(left, right, [](char l, char r) { return LowerCase(l) < LowerCase(r); });
+}
+} // namespace
+
+std::string_view openblack::pack::ResultToStr(ArchiveResult result)
+{
+	switch (result)
+	{
+	case ArchiveResult::Success:
+		return "Success";
+	case ArchiveResult::ErrCantOpen:
+		return "Could not open file.";
+	case ArchiveResult::ErrFileTooSmall:
+		return "File too small to be a valid Asset Archive.";
+	case ArchiveResult::ErrUnrecognizedHeader:
+		return "Unrecognized Asset Archive header.";
+	case ArchiveResult::ErrUnsupportedVersion:
+		return "Asset Archive is from another version.";
+	case ArchiveResult::ErrDirectoryMalformed:
+		return "Asset Archive directory points outside the file.";
+	case ArchiveResult::ErrDuplicateEntry:
+		return "Duplicate entry name.";
+	case ArchiveResult::ErrEntryTooLarge:
+		return "Entry larger than 4 GiB.";
+	case ArchiveResult::ErrReadFailed:
+		return "Could not read file.";
+	case ArchiveResult::ErrWriteFailed:
+		return "Could not write file.";
+	case ArchiveResult::ErrCompressFailed:
+		return "Could not compress entry.";
+	case ArchiveResult::ErrDecompressFailed:
+		return "Could not decompress entry.";
+	}
+	return "Unknown error.";
+}
+
+uint32_t AssetArchive::HashName(std::string_view name) noexcept
+{
+	uint32_t hash = 2166136261U;
+	for (const char c : name)
+	{
+		hash = (hash ^ static_cast<uint8_t>(c == '\\' ? '/' : LowerCase(c))) * 16777619U;
+	}
+	return hash;
+}
+
+AssetArchive::AssetArchive() noexcept = default;
+AssetArchive::~AssetArchive() noexcept = default;
+
+ArchiveResult AssetArchive::Open(const std::filesystem::path& filepath) noexcept
+{
+	_stream.open(filepath, std::ios::binary);
+	if (!_stream.is_open())
+	{
+		return ArchiveResult::ErrCantOpen;
+	}
+	_stream.seekg(0, std::ios::end);
+	const auto fileSize = static_cast<uint64_t>(_stream.tellg());
+	_stream.seekg(0, std::ios::beg);
+
+	ArchiveHeader header;
+	if (fileSize < sizeof(header))
+	{
+		return ArchiveResult::ErrFileTooSmall;
+	}
+	_stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (header.magic != k_Magic)
+	{
+		return ArchiveResult::ErrUnrecognizedHeader;
+	}
+	if (header.version != k_Version)
+	{
+		return ArchiveResult::ErrUnsupportedVersion;
+	}
+	const uint64_t directorySize =
+	    sizeof(header) + static_cast<uint64_t>(header.entryCount) * sizeof(ArchiveEntry) + header.namesSize;
+	if (header.dataOffset != directorySize || directorySize > fileSize)
+	{
+		return ArchiveResult::ErrDirectoryMalformed;
+	}
+
+	// The rest of the directory is read in one go
+	_directory.resize(directorySize);
+	std::memcpy(_directory.data(), &header, sizeof(header));
+	_stream.read(reinterpret_cast<char*>(_directory.data() + sizeof(header)),
+	             static_cast<std::streamsize>(directorySize - sizeof(header)));
+	if (!_stream)
+	{
+		return ArchiveResult::ErrReadFailed;
+	}
+
+	_entries = {reinterpret_cast<const ArchiveEntry*>(_directory.data() + sizeof(header)), header.entryCount};
+	_names = {reinterpret_cast<const char*>(_directory.data() + directorySize - header.namesSize), header.namesSize};
+	for (const auto& entry : _entries)
+	{
+		if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize ||
+		    entry.offset < header.dataOffset || entry.offset + entry.storedSize > fileSize ||
+		    (entry.compression == ArchiveCompression::None && entry.storedSize != entry.size))
+		{
+			_entries = {};
+			return ArchiveResult::ErrDirectoryMalformed;
+		}
+	}
+	if (!std::ranges::is_sorted(_entries, {}, &ArchiveEntry::nameHash))
+	{
+		_entries = {};
+		return ArchiveResult::ErrDirectoryMalformed;
+	}
+
+	_path = filepath;
+	return ArchiveResult::Success;
+}
+
+const ArchiveEntry* AssetArchive::Find(std::string_view name) const noexcept
+{
+	const auto hash = HashName(name);
+	auto [first, last] = std::ranges::equal_range(_entries, hash, {}, &ArchiveEntry::nameHash);
+	for (auto it = first; it != last; ++it)
+	{
+		const auto entryName = GetName(*it);
+		if (entryName.size() == name.size() &&
+		    std::ranges::equal(entryName, name, [](char l, char r) { return LowerCase(l) == LowerCase(r == '\\' ? '/' : r); }))
+		{
+			return &*it;
+		}
+	}
+	return nullptr;
+}
+
+std::string_view AssetArchive::GetName(const ArchiveEntry& entry) const noexcept
+{
+	return _names.substr(entry.nameOffset, entry.nameLength);
+}
+
+ArchiveResult AssetArchive::Read(const ArchiveEntry& entry, std::vector<uint8_t>& data) noexcept
+{
+	data.resize(entry.size);
+	std::vector<uint8_t> stored;
+	auto* target = data.data();
+	if (entry.compression != ArchiveCompression::None)
+	{
+		stored.resize(entry.storedSize);
+		target = stored.data();
+	}
+
+	{
+		std::lock_guard lock(_streamMutex);
+		_stream.clear();
+		_stream.seekg(static_cast<std::streamoff>(entry.offset));
+		_stream.read(reinterpret_cast<char*>(target), entry.storedSize);
+		if (!_stream)
+		{
+			return ArchiveResult::ErrReadFailed;
+		}
+	}
+
+	// Decompressed outside the lock so other threads can read meanwhile
+	if (entry.compression == ArchiveCompression::Zlib)
+	{
+		auto size = static_cast<uLongf>(entry.size);
+		if (uncompress(data.data(), &size, stored.data(), entry.storedSize) != Z_OK || size != entry.size)
+		{
+			return ArchiveResult::ErrDecompressFailed;
+		}
+	}
+	else if (entry.compression != ArchiveCompression::None)
+	{
+		return ArchiveResult::ErrDecompressFailed;
+	}
+
+	return ArchiveResult::Success;
+}
+
+ArchiveResult AssetArchive::Read(const ArchiveEntry& entry, size_t offset, std::span<uint8_t> data) noexcept
+{
+	if (offset > entry.size || data.size() > entry.size - offset)
+	{
+		return ArchiveResult::ErrReadFailed;
+	}
+
+	if (entry.compression != ArchiveCompression::None)
+	{
+		std::vector<uint8_t> decompressed;
+		const auto result = Read(entry, decompressed);
+		if (result == ArchiveResult::Success)
+		{
+			std::copy_n(decompressed.begin() + static_cast<std::ptrdiff_t>(offset), data.size(), data.begin());
+		}
+		return result;
+	}
+
+	std::lock_guard lock(_streamMutex);
+	_stream.clear();
+	_stream.seekg(static_cast<std::streamoff>(entry.offset + offset));
+	_stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	return _stream ? ArchiveResult::Success : ArchiveResult::ErrReadFailed;
+}
+
+ArchiveResult AssetArchiveWriter::Add(std::string name, std::vector<uint8_t> data, ArchiveCompression compression) noexcept
+{
+	if (data.size() > std::numeric_limits<uint32_t>::max())
+	{
+		return ArchiveResult::ErrEntryTooLarge;
+	}
+	std::replace(name.begin(), name.end(), '\\', '/');
+
+	File file {std::move(name), ArchiveCompression::None, static_cast<uint32_t>(data.size()), {}};
+	if (compression == ArchiveCompression::Zlib && !data.empty())
+	{
+		auto storedSize = compressBound(static_cast<uLong>(data.size()));
+		file.stored.resize(storedSize);
+		if (compress2(file.stored.data(), &storedSize, data.data(), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) !=
+		    Z_OK)
+		{
+			return ArchiveResult::ErrCompressFailed;
+		}
+		// Files which are already compressed such as .zzz meshes are stored as they are
+		if (storedSize < data.size())
+		{
+			file.stored.resize(storedSize);
+			file.compression = ArchiveCompression::Zlib;
+		}
+	}
+	if (file.compression == ArchiveCompression::None)
+	{
+		file.stored = std::move(data);
+	}
+
+	_files.emplace_back(std::move(file));
+	return ArchiveResult::Success;
+}
+
+ArchiveResult AssetArchiveWriter::Write(const std::filesystem::path& filepath) const noexcept
+{
+	ArchiveHeader header {};
+	header.magic = AssetArchive::k_Magic;
+	header.version = AssetArchive::k_Version;
+	header.entryCount = static_cast<uint32_t>(_files.size());
+
+	std::string names;
+	std::vector<ArchiveEntry> entries(_files.size());
+	for (size_t i = 0; i < _files.size(); ++i)
+	{
+		const auto& file = _files[i];
+		auto& entry = entries[i];
+		entry.nameHash = AssetArchive::HashName(file.name);
+		entry.nameOffset = static_cast<uint32_t>(names.size());
+		entry.nameLength = static_cast<uint32_t>(file.name.size());
+		entry.compression = file.compression;
+		entry.storedSize = static_cast<uint32_t>(file.stored.size());
+		entry.size = file.size;
+		names += file.name;
+	}
+	header.namesSize = static_cast<uint32_t>(names.size());
+	header.dataOffset = sizeof(header) + entries.size() * sizeof(ArchiveEntry) + names.size();
+
+	// Data is laid out in the order the files were added
+	uint64_t offset = header.dataOffset;
+	for (auto& entry : entries)
+	{
+		entry.offset = offset;
+		offset += entry.storedSize;
+	}
+
+	std::vector<size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::sort(order, [&entries, this](size_t l, size_t r) {
+		return entries[l].nameHash != entries[r].nameHash ? entries[l].nameHash < entries[r].nameHash
+		                                                  : LessIgnoringCase(_files[l].name, _files[r].name);
+	});
+	const auto duplicate = std::ranges::adjacent_find(order, [&entries, this](size_t l, size_t r) {
+		return entries[l].nameHash == entries[r].nameHash && EqualsIgnoringCase(_files[l].name, _files[r].name);
+	});
+	if (duplicate != order.end())
+	{
+		return ArchiveResult::ErrDuplicateEntry;
+	}
+
+	std::ofstream stream(filepath, std::ios::binary);
+	if (!stream.is_open())
+	{
+		return ArchiveResult::ErrCantOpen;
+	}
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (const auto i : order)
+	{
+		stream.write(reinterpret_cast<const char*>(&entries[i]), sizeof(entries[i]));
+	}
+	stream.write(names.data(), static_cast<std::streamsize>(names.size()));
+	for (const auto& file : _files)
+	{
+		stream.write(reinterpret_cast<const char*>(file.stored.data()), static_cast<std::streamsize>(file.stored.size()));
+	}
+
+	return stream ? ArchiveResult::Success : ArchiveResult::ErrWriteFailed;
+}
@@ -129,6 +129,8 @@
 #include <fstream>
 #include <utility>
 
+#include <BinaryReader.h>
+
 using namespace openblack::pack;
 
 namespace
@@ -230,53 +232,45 @@ std::string_view openblack::pack::ResultToStr(PackResult result)
 	std::unreachable();
 }
 
-PackResult PackFile::ReadBlocks(std::istream& stream) noexcept
+PackResult PackFile::ReadBlocks(std::span<const std::byte> buffer) noexcept
 {
 	assert(!_isLoaded);
 
-	// Total file size
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
-	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
-	}
+	BinaryReader reader(buffer);
 
 	std::array<char, k_Magic.size()> magic;
-	if (fsize < magic.size() + sizeof(PackBlockHeader))
+	if (reader.Size() < magic.size() + sizeof(PackBlockHeader))
 	{
 		return PackResult::ErrFileTooSmall;
 	}
 
 	// First 8 bytes
-	stream.read(magic.data(), magic.size());
+	reader.Read(magic);
 	if (std::memcmp(magic.data(), k_Magic.data(), magic.size()) != 0)
 	{
 		return PackResult::ErrUnrecognizedHeader;
 	}
 
-	if (fsize < static_cast<std::size_t>(stream.tellg()) + sizeof(PackBlockHeader))
-	{
-		return PackResult::ErrFileTooSmall;
-	}
-
 	PackBlockHeader header;
-	while (fsize - sizeof(PackBlockHeader) > static_cast<std::size_t>(stream.tellg()))
+	while (reader.Remaining() > sizeof(PackBlockHeader))
 	{
-		stream.read(reinterpret_cast<char*>(&header), sizeof(PackBlockHeader));
+		reader.Read(header);
 
-		if (_blocks.contains(header.blockName.data()))
+		const auto name = std::string(header.blockName.data(), strnlen(header.blockName.data(), header.blockName.size()));
+		if (_blocks.contains(name))
 		{
 			return PackResult::ErrDuplicateBlockName;
 		}
 
-		_blocks[std::string(header.blockName.data())] = std::vector<uint8_t>(header.blockSize);
-		stream.read(reinterpret_cast<char*>(_blocks[header.blockName.data()].data()), header.blockSize);
-	}
-
-	if (fsize < static_cast<std::size_t>(stream.tellg()))
-	{
-		return PackResult::ErrFileNotEvenlySplit;
+		const auto offset = reader.Tell();
+		std::span<const std::byte> contents;
+		if (!reader.View(header.blockSize, contents))
+		{
+			return PackResult::ErrFileNotEvenlySplit;
+		}
+		const auto* begin = reinterpret_cast<const uint8_t*>(contents.data());
+		_blocks.emplace(name, std::vector<uint8_t>(begin, begin + contents.size()));
+		_blockOffsets.emplace(name, offset);
 	}
 
 	return PackResult::Success;
@@ -289,15 +283,19 @@ PackResult PackFile::ResolveInfoBlock() noexcept
 		return PackResult::ErrMissingInfoBlock;
 	}
 
-	auto data = GetBlock("INFO");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
+	BinaryReader reader(std::as_bytes(std::span(GetBlock("INFO"))));
 
 	uint32_t totalTextures;
-	stream.read(reinterpret_cast<char*>(&totalTextures), sizeof(uint32_t));
+	if (!reader.Read(totalTextures))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
 
 	// Read lookup
-	_infoBlockLookup.resize(totalTextures);
-	stream.read(reinterpret_cast<char*>(_infoBlockLookup.data()), _infoBlockLookup.size() * sizeof(_infoBlockLookup[0]));
+	if (!reader.ReadVector(_infoBlockLookup, totalTextures))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
 
 	return PackResult::Success;
 }
@@ -309,23 +307,26 @@ PackResult PackFile::ResolveBodyBlock() noexcept
 		return PackResult::ErrMissingBodyBlock;
 	}
 
-	auto data = GetBlock("Body");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
+	BinaryReader reader(std::as_bytes(std::span(GetBlock("Body"))));
 
 	// Greetings Jean-Claude Cottier
 	std::array<char, k_BlockMagic.size()> magic;
-	stream.read(magic.data(), magic.size());
-	if (std::memcmp(magic.data(), k_BlockMagic.data(), magic.size()) != 0)
+	if (!reader.Read(magic) || std::memcmp(magic.data(), k_BlockMagic.data(), magic.size()) != 0)
 	{
 		return PackResult::ErrUnrecognizedBlockHeader;
 	}
 
 	uint32_t totalAnimations;
-	stream.read(reinterpret_cast<char*>(&totalAnimations), sizeof(uint32_t));
+	if (!reader.Read(totalAnimations))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
 
 	// Read lookup offsets
-	_bodyBlockLookup.resize(totalAnimations);
-	stream.read(reinterpret_cast<char*>(_bodyBlockLookup.data()), _bodyBlockLookup.size() * sizeof(_bodyBlockLookup[0]));
+	if (!reader.ReadVector(_bodyBlockLookup, totalAnimations))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
 
 	return PackResult::Success;
 }
@@ -337,47 +338,80 @@ PackResult PackFile::ResolveAudioBankSampleTableBlock() noexcept
 		return PackResult::ErrMissingAudioBankSampleTableBlock;
 	}
 
-	auto data = GetBlock("LHAudioBankSampleTable");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
-	std::size_t fsize = 0;
-	if (stream.seekg(0, std::ios_base::end))
+	BinaryReader reader(std::as_bytes(std::span(GetBlock("LHAudioBankSampleTable"))));
+
+	uint16_t sampleCount;
+	uint16_t unknown;
+	if (!reader.Read(sampleCount) || !reader.Read(unknown))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
+
+	if (sampleCount == 0)
 	{
-		fsize = static_cast<std::size_t>(stream.tellg());
-		stream.seekg(0);
+		return PackResult::ErrNoEntries;
 	}
 
-	if (fsize < sizeof(uint32_t))
+	if (reader.Remaining() != sampleCount * sizeof(AudioBankSampleHeader))
 	{
 		return PackResult::ErrFileTooSmall;
 	}
 
-	uint16_t sampleCount;
-	stream.read(reinterpret_cast<char*>(&sampleCount), sizeof(sampleCount));
+	reader.ReadVector(_audioSampleHeaders, sampleCount);
 
-	uint16_t unknown;
-	stream.read(reinterpret_cast<char*>(&unknown), sizeof(unknown));
+	return PackResult::Success;
+}
 
-	if (sampleCount == 0)
+PackResult PackFile::ReadTexture(std::span<const std::byte> block, G3DTexture& texture) noexcept
+{
+	BinaryReader reader(block);
+
+	// The DDS file is parsed in place, only its texels are copied out
+	std::span<const std::byte> dds;
+	if (!reader.Read(texture.header) || !reader.View(texture.header.size, dds))
 	{
-		return PackResult::ErrNoEntries;
+		return PackResult::ErrFileTooSmall;
 	}
 
-	_audioSampleHeaders.resize(sampleCount);
+	BinaryReader ddsReader(dds);
 
-	if (fsize != sizeof(uint32_t) + _audioSampleHeaders.size() * sizeof(_audioSampleHeaders[0]))
+	// Verify the header to validate the DDS file
+	auto& ddsHeader = texture.ddsHeader;
+	if (!ddsReader.Read(ddsHeader) || ddsHeader.size != sizeof(DdsHeader) || ddsHeader.format.size != sizeof(DdsPixelFormat))
 	{
-		return PackResult::ErrFileTooSmall;
+		return PackResult::ErrTextureInvalidDDSHeaderSize;
 	}
 
-	stream.read(reinterpret_cast<char*>(_audioSampleHeaders.data()),
-	            _audioSampleHeaders.size() * sizeof(_audioSampleHeaders[0]));
+	// Handle cases where this field is not provided
+	// https://docs.microsoft.com/en-us/windows/win32/direct3ddds/dx-graphics-dds-pguide
+	// Some Creature Isle DXT5 textures lack this field
+	if (ddsHeader.pitchOrLinearSize == 0)
+	{
+		// The block-size is 8 bytes for DXT1, BC1, and BC4 formats, and 16 bytes for other block-compressed formats
+		int blockSize;
+		auto format = std::string(ddsHeader.format.fourCC.data(), ddsHeader.format.fourCC.size());
+		if (format == "DXT1" || format == "BC1" || format == "BC4")
+		{
+			blockSize = 8;
+		}
+		else
+		{
+			blockSize = 16;
+		}
+
+		ddsHeader.pitchOrLinearSize = ((ddsHeader.width + 3) / 4) * ((ddsHeader.height + 3) / 4) * blockSize;
+	}
+
+	if (!ddsReader.ReadVector(texture.ddsData, ddsHeader.pitchOrLinearSize))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
 
 	return PackResult::Success;
 }
 
 PackResult PackFile::ExtractTexturesFromBlock() noexcept
 {
-	G3DTextureHeader header;
 	constexpr uint32_t blockNameSize = 0x20;
 	std::array<char, blockNameSize> blockName;
 	for (const auto& item : _infoBlockLookup)
@@ -390,13 +424,14 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 			return PackResult::ErrMissingTextureBlock;
 		}
 
-		auto stream = GetBlockAsStream(blockName.data());
-
-		stream->read(reinterpret_cast<char*>(&header), sizeof(header));
-		std::vector<uint8_t> dds(header.size);
-		stream->read(reinterpret_cast<char*>(dds.data()), dds.size() * sizeof(dds[0]));
+		G3DTexture texture;
+		const auto result = ReadTexture(std::as_bytes(std::span(GetBlock(blockName.data()))), texture);
+		if (result != PackResult::Success)
+		{
+			return result;
+		}
 
-		if (header.id != item.blockId)
+		if (texture.header.id != item.blockId)
 		{
 			return PackResult::ErrTextureBlockIdMismatch;
 		}
@@ -406,41 +441,7 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 			return PackResult::ErrTextureDuplicate;
 		}
 
-		imemstream ddsStream(reinterpret_cast<const char*>(dds.data()), dds.size());
-
-		DdsHeader ddsHeader;
-		ddsStream.read(reinterpret_cast<char*>(&ddsHeader), sizeof(DdsHeader));
-
-		// Verify the header to validate the DDS file
-		if (ddsHeader.size != sizeof(DdsHeader) || ddsHeader.format.size != sizeof(DdsPixelFormat))
-		{
-			return PackResult::ErrTextureInvalidDDSHeaderSize;
-		}
-
-		// Handle cases where this field is not provided
-		// https://docs.microsoft.com/en-us/windows/win32/direct3ddds/dx-graphics-dds-pguide
-		// Some Creature Isle DXT5 textures lack this field
-		if (ddsHeader.pitchOrLinearSize == 0)
-		{
-			// The block-size is 8 bytes for DXT1, BC1, and BC4 formats, and 16 bytes for other block-compressed formats
-			int blockSize;
-			auto format = std::string(ddsHeader.format.fourCC.data(), ddsHeader.format.fourCC.size());
-			if (format == "DXT1" || format == "BC1" || format == "BC4")
-			{
-				blockSize = 8;
-			}
-			else
-			{
-				blockSize = 16;
-			}
-
-			ddsHeader.pitchOrLinearSize = ((ddsHeader.width + 3) / 4) * ((ddsHeader.height + 3) / 4) * blockSize;
-		}
-
-		std::vector<uint8_t> dssTexels(ddsHeader.pitchOrLinearSize);
-		ddsStream.read(reinterpret_cast<char*>(dssTexels.data()), dssTexels.size());
-
-		_textures[blockName.data()] = {header, ddsHeader, dssTexels};
+		_textures[blockName.data()] = std::move(texture);
 	}
 
 	return PackResult::Success;
@@ -448,8 +449,7 @@ PackResult PackFile::ExtractTexturesFromBlock() noexcept
 
 PackResult PackFile::ExtractAnimationsFromBlock() noexcept
 {
-	auto data = GetBlock("Body");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
+	BinaryReader reader(std::as_bytes(std::span(GetBlock("Body"))));
 
 	// Read lookup
 	constexpr uint32_t blockNameSize = 0x20;
@@ -465,12 +465,15 @@ PackResult PackFile::ExtractAnimationsFromBlock() noexcept
 			return PackResult::ErrMissingTextureBlock;
 		}
 
-		auto animationData = GetBlock(blockName.data());
+		const auto& animationData = GetBlock(blockName.data());
 		_animations[i].resize(animationHeaderSize + animationData.size());
 
-		stream.seekg(_bodyBlockLookup[i].offset);
-		stream.read(reinterpret_cast<char*>(_animations[i].data()), animationHeaderSize);
-		memcpy(_animations[i].data() + animationHeaderSize, animationData.data(), animationData.size());
+		if (!reader.Seek(_bodyBlockLookup[i].offset) ||
+		    !reader.ReadArray(std::span(_animations[i]).first(animationHeaderSize)))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
+		std::memcpy(_animations[i].data() + animationHeaderSize, animationData.data(), animationData.size());
 	}
 
 	return PackResult::Success;
@@ -483,28 +486,18 @@ PackResult PackFile::ExtractSoundsFromBlock() noexcept
 		return PackResult::ErrMissingAudioWaveDataBlock;
 	}
 
-	auto data = GetBlock("LHAudioWaveData");
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
+	BinaryReader reader(std::as_bytes(std::span(GetBlock("LHAudioWaveData"))));
 	//	auto isSector = false;
 	//	auto isPrevSector = false;
 
 	_audioSampleData.resize(_audioSampleHeaders.size());
 	for (int i = 0; const auto& sample : _audioSampleHeaders)
 	{
-		if (sample.offset > data.size())
-		{
-			return PackResult::ErrFileTooSmall;
-		}
-		if (sample.offset + sample.size > data.size())
+		if (!reader.Seek(sample.offset) || !reader.ReadVector(_audioSampleData[i], sample.size))
 		{
 			return PackResult::ErrFileTooSmall;
 		}
 
-		_audioSampleData[i].resize(sample.size);
-
-		stream.seekg(sample.offset);
-		stream.read(reinterpret_cast<char*>(_audioSampleData[i].data()), sample.size);
-
 		++i;
 	}
 
@@ -517,33 +510,50 @@ PackResult PackFile::ResolveMeshBlock() noexcept
 	{
 		return PackResult::ErrMissingMeshBlock;
 	}
-	auto data = GetBlock("MESHES");
+	const auto& data = GetBlock("MESHES");
+	BinaryReader reader(std::as_bytes(std::span(data)));
 
-	imemstream stream(reinterpret_cast<const char*>(data.data()), data.size());
 	// Greetings Jean-Claude Cottier
 	std::array<char, k_BlockMagic.size()> magic;
-	stream.read(magic.data(), magic.size());
-	if (std::memcmp(magic.data(), k_BlockMagic.data(), magic.size()) != 0)
+	if (!reader.Read(magic) || std::memcmp(magic.data(), k_BlockMagic.data(), magic.size()) != 0)
 	{
 		return PackResult::ErrMeshBlockHeaderMalformed;
 	}
 
 	uint32_t meshCount;
-	stream.read(reinterpret_cast<char*>(&meshCount), sizeof(meshCount));
-	std::vector<uint32_t> meshOffsets(meshCount);
-	stream.read(reinterpret_cast<char*>(meshOffsets.data()), meshOffsets.size() * sizeof(meshOffsets[0]));
+	std::vector<uint32_t> meshOffsets;
+	if (!reader.Read(meshCount) || !reader.ReadVector(meshOffsets, meshCount))
+	{
+		return PackResult::ErrMeshBlockHeaderMalformed;
+	}
 
+	// Meshes are views into the block, they are only copied when parsed
 	_meshes.resize(meshOffsets.size());
 	for (std::size_t i = 0; i < _meshes.size(); i++)
 	{
-		auto size = (i == _meshes.size() - 1 ? data.size() : meshOffsets[i + 1]) - meshOffsets[i];
-		_meshes[i].resize(size);
-		stream.read(reinterpret_cast<char*>(_meshes[i].data()), _meshes[i].size() * sizeof(_meshes[i][0]));
+		const auto end = i == _meshes.size() - 1 ? data.size() : meshOffsets[i + 1];
+		if (meshOffsets[i] < reader.Tell() || meshOffsets[i] > end || end > data.size())
+		{
+			return PackResult::ErrMeshBlockHeaderMalformed;
+		}
+		_meshes[i] = std::span(data).subspan(meshOffsets[i], end - meshOffsets[i]);
 	}
 
 	return PackResult::Success;
 }
 
+PackRange PackFile::GetMeshRange(uint32_t index) const noexcept
+{
+	const auto& block = GetBlock("MESHES");
+	const auto mesh = _meshes[index];
+	return {_blockOffsets.at("MESHES") + static_cast<std::size_t>(mesh.data() - block.data()), mesh.size()};
+}
+
+PackRange PackFile::GetTextureRange(const std::string& name) const noexcept
+{
+	return {_blockOffsets.at(name), GetBlock(name).size()};
+}
+
 PackResult PackFile::WriteBlocks(std::ostream& stream) const noexcept
 {
 	assert(!_isLoaded);
@@ -633,7 +643,7 @@ PackResult PackFile::CreateMeshBlock() noexcept
 
 PackResult PackFile::InsertMesh(std::vector<uint8_t> data) noexcept
 {
-	_meshes.emplace_back(std::move(data));
+	_meshes.emplace_back(_insertedMeshes.emplace_back(std::move(data)));
 
 	return PackResult::Success;
 }
@@ -679,10 +689,16 @@ PackFile::PackFile() noexcept = default;
 PackFile::~PackFile() noexcept = default;
 
 PackResult PackFile::ReadFile(std::istream& stream) noexcept
+{
+	const auto buffer = ReadAllBytes(stream);
+	return Open(buffer);
+}
+
+PackResult PackFile::Open(std::span<const std::byte> buffer) noexcept
 {
 	PackResult result;
 
-	result = ReadBlocks(stream);
+	result = ReadBlocks(buffer);
 	if (result != PackResult::Success)
 	{
 		return result;
@@ -766,11 +782,7 @@ PackResult PackFile::Open(const std::filesystem::path& filepath) noexcept
 
 PackResult PackFile::Open(const std::vector<uint8_t>& buffer) noexcept
 {
-	assert(!_isLoaded);
-
-	imemstream stream(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(buffer[0]));
-
-	return ReadFile(stream);
+	return Open(std::as_bytes(std::span(buffer)));
 }
 
 PackResult PackFile::Write(const std::filesystem::path& filepath) noexcept
@@ -13,12 +13,12 @@
 #include <string>
 #include <vector>
 
-#include <entt/core/hashed_string.hpp>
 #include <fmt/ranges.h>
 #include <spdlog/spdlog.h>
 
 #include "Common/StringUtils.h"
 #include "Enums.h"
+#include "Resources/ResourceId.h"
 
 using namespace openblack;
 using namespace openblack::creature;
@@ -49,8 +49,7 @@ const std::map<std::string, CreatureBody::Appearance> k_MeshNameToAppearance = {
 
 entt::id_type creature::GetIdFromType(CreatureType species, CreatureBody::Appearance appearance)
 {
-	return entt::hashed_string(
-	    fmt::format("creature/{}/{}", static_cast<uint8_t>(species), static_cast<uint32_t>(appearance)).c_str());
+	return resources::MakeResourceId("creature/", static_cast<uint8_t>(species), "/", static_cast<uint32_t>(appearance));
 }
 
 entt::id_type creature::GetIdFromMeshName(const std::string& name)
@@ -82,6 +81,5 @@ entt::id_type creature::GetIdFromMeshName(const std::string& name)
 		species = speciesFound->second;
 	}
 
-	return entt::hashed_string(
-	    fmt::format("creature/{}/{}", static_cast<uint8_t>(species), static_cast<uint32_t>(appearance)).c_str());
+	return resources::MakeResourceId("creature/", static_cast<uint8_t>(species), "/", static_cast<uint32_t>(appearance));
 }
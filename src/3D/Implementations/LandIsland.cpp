@@ -12,6 +12,8 @@
 
 #include "LandIsland.h"
 
+#include <algorithm>
+#include <optional>
 #include <stdexcept>
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
@@ -22,16 +24,45 @@
 #include <stb_image_write.h>
 
 #include "3D/LandBlock.h"
+#include "Common/TaskScheduler.h"
 #include "Dynamics/LandBlockBulletMeshInterface.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/Mesh.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Profiler.h"
 
 using namespace openblack;
 using namespace openblack::graphics;
 
+namespace
+{
+/// Materials cover the whole island so they get every level for the distant ground not to shimmer
+std::vector<MipChain> CreateMaterialChains(const std::vector<lnd::LNDMaterial>& materials)
+{
+	std::vector<std::optional<MipChain>> chains(materials.size());
+	Locator::taskScheduler::value().ParallelFor(0, materials.size(), 1, [&materials, &chains](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			chains[i] = MipChain::Generate(
+			    Format::BGR5A1, lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height,
+			    {reinterpret_cast<const uint8_t*>(materials[i].texels.data()), sizeof(materials[i].texels)});
+		}
+	});
+
+	std::vector<MipChain> result;
+	result.reserve(chains.size());
+	for (auto& chain : chains)
+	{
+		// Materials are sized by the format so the chain can always be generated
+		result.emplace_back(std::move(*chain));
+	}
+	return result;
+}
+} // namespace
+
 const uint8_t LandIslandInterface::k_CellCount = 16;
 const float LandIslandInterface::k_HeightUnit = 0.67f;
 const float LandIslandInterface::k_CellSize = 10.0f;
@@ -48,7 +79,7 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading Land from file: {}", path.string());
 	lnd::LNDFile lnd;
 
-	const auto result = lnd.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = lnd.Open(Locator::filesystem::value().ReadAll(path));
 	if (result != lnd::LNDResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open lnd file from filesystem {}: {}", path.string(),
@@ -56,6 +87,12 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 		throw lnd::ResultToStr(result);
 	}
 
+	// Material levels are generated on the workers while the blocks are built below, then every texture is uploaded.
+	// The task keeps its own copy of the materials in case loading fails and the file goes away before it is done.
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "[LandIsland] loading {} textures", lnd.GetMaterials().size());
+	auto materialChains = Locator::taskScheduler::value().Submit(
+	    [materials = lnd.GetMaterials()]() { return CreateMaterialChains(materials); });
+
 	_blockIndexLookup = lnd.GetHeader().lookUpTable;
 
 	const auto& lndBlocks = lnd.GetBlocks();
@@ -97,10 +134,15 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 
 	const auto indexSize = _extentIndexMax - _extentIndexMin + glm::u16vec2(1, 1);
 
+	// Created without memory so that terrain edits can update parts of it
 	_heightMap = std::make_unique<Texture2D>("Height Map");
 	const auto heightMapData = CreateHeightMap();
-	_heightMap->Create(indexSize.x * k_CellCount + 1, indexSize.y * k_CellCount + 1, 1, graphics::Format::R8,
-	                   Wrapping::ClampEdge, Filter::Linear, heightMapData.data(), static_cast<uint32_t>(heightMapData.size()));
+	const auto heightMapWidth = static_cast<uint16_t>(indexSize.x * k_CellCount + 1);
+	const auto heightMapHeight = static_cast<uint16_t>(indexSize.y * k_CellCount + 1);
+	_heightMap->Create(heightMapWidth, heightMapHeight, 1, graphics::Format::R8, Wrapping::ClampEdge, Filter::Linear,
+	                   static_cast<const bgfx::Memory*>(nullptr));
+	_heightMap->Update(0, 0, 0, heightMapWidth, heightMapHeight, heightMapData.data(),
+	                   static_cast<uint32_t>(heightMapData.size()));
 
 	const auto res = indexSize * glm::u16vec2(lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height);
 	_footprintFrameBuffer = std::make_unique<FrameBuffer>("Footprints", res.x, res.y, graphics::Format::RGBA8);
@@ -111,20 +153,23 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "[LandIsland] loading {} countries", lnd.GetCountries().size());
 	_countries = lnd.GetCountries();
 
-	auto materialCount = static_cast<uint16_t>(lnd.GetMaterials().size());
-	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "[LandIsland] loading {} textures", materialCount);
-	std::vector<uint16_t> rgba5TextureData;
-	rgba5TextureData.resize(lnd::LNDMaterial::k_Width * lnd::LNDMaterial::k_Height * lnd.GetMaterials().size());
-	for (size_t i = 0; i < lnd.GetMaterials().size(); i++)
+	// build the meshes (we could move this elsewhere)
+	// Vertex lists and physics BVHs only read the island so blocks are built in parallel, bgfx buffers and rigid bodies are
+	// then created here
+	Locator::taskScheduler::value().ParallelFor(0, _landBlocks.size(), 1, [this](size_t begin, size_t end) {
+		auto zone = Locator::profiler::value().BeginScoped("Build Land Block Meshes");
+		for (size_t i = begin; i < end; ++i)
+		{
+			_landBlocks[i].BuildPhysicsMesh(*this);
+		}
+	});
+	for (auto& block : _landBlocks)
 	{
-		std::memcpy(&rgba5TextureData[lnd::LNDMaterial::k_Width * lnd::LNDMaterial::k_Height * i],
-		            lnd.GetMaterials()[i].texels.data(),
-		            sizeof(lnd.GetMaterials()[i].texels[0]) * lnd.GetMaterials()[i].texels.size());
+		block.UploadMesh();
 	}
+
 	_materialArray = std::make_unique<Texture2D>("LandIslandMaterialArray");
-	_materialArray->Create(lnd::LNDMaterial::k_Width, lnd::LNDMaterial::k_Height, materialCount, Format::BGR5A1,
-	                       Wrapping::ClampEdge, Filter::Linear, rgba5TextureData.data(),
-	                       static_cast<uint32_t>(rgba5TextureData.size() * sizeof(rgba5TextureData[0])));
+	_materialArray->Create(materialChains.get(), Wrapping::ClampEdge, Filter::LinearMipmapLinear);
 
 	// read noise map into Texture2D
 	_noiseMap = lnd.GetExtra().noise.texels;
@@ -137,13 +182,9 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	_textureBumpMap->Create(lnd::LNDBumpMap::k_Width, lnd::LNDBumpMap::k_Height, 1, Format::R8, Wrapping::Repeat,
 	                        Filter::Linear, lnd.GetExtra().bump.texels.data(),
 	                        static_cast<uint32_t>(sizeof(lnd.GetExtra().bump.texels[0]) * lnd.GetExtra().bump.texels.size()));
-
-	// build the meshes (we could move this elsewhere)
-	for (auto& block : _landBlocks)
-	{
-		block.BuildMesh(*this);
-	}
 	bgfx::frame();
+
+	_rayCaster.Build(*this);
 }
 
 float LandIsland::GetHeightAt(glm::vec2 vec) const
@@ -231,6 +272,121 @@ const lnd::LNDCell& LandIsland::GetCell(const glm::u16vec2& coordinates) const
 	return _landBlocks[blockIndex - 1].GetCells()[cellIndex];
 }
 
+std::optional<LandRayHit> LandIsland::RayCast(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+{
+	return _rayCaster.RayCast(origin, direction, tMax);
+}
+
+void LandIsland::RayCast(std::span<const LandRay> rays, std::span<std::optional<LandRayHit>> hits) const
+{
+	assert(rays.size() == hits.size());
+	Locator::taskScheduler::value().ParallelFor(0, rays.size(), 16, [this, rays, hits](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			hits[i] = _rayCaster.RayCast(rays[i].origin, rays[i].direction, rays[i].tMax);
+		}
+	});
+}
+
+lnd::LNDCell* LandIsland::GetEditableCell(const glm::u16vec2& coordinates)
+{
+	if (coordinates.x > 511 || coordinates.y > 511)
+	{
+		return nullptr;
+	}
+
+	const auto mapCoordinates = coordinates >> static_cast<uint16_t>(0x4);
+	const auto cellCoordinates = static_cast<glm::u8vec2>(coordinates) & static_cast<uint8_t>(0xF);
+	const auto lookupIndex = mapCoordinates.x << 5u | mapCoordinates.y;
+	const auto cellIndex = cellCoordinates.x * 0x11u + cellCoordinates.y;
+
+	const uint8_t blockIndex = _blockIndexLookup.at(lookupIndex);
+	if (blockIndex == 0)
+	{
+		return nullptr;
+	}
+	return &_landBlocks.at(blockIndex - 1).GetCells()[cellIndex];
+}
+
+void LandIsland::MarkBlocksDirty(const glm::u16vec2& coordinates)
+{
+	// Blocks also use the first row and column of cells of the next blocks as their far edge
+	const auto first = (glm::max(coordinates, glm::u16vec2(1)) - glm::u16vec2(1)) >> static_cast<uint16_t>(0x4);
+	const auto last = coordinates >> static_cast<uint16_t>(0x4);
+	for (uint16_t x = first.x; x <= last.x; ++x)
+	{
+		for (uint16_t z = first.y; z <= last.y; ++z)
+		{
+			const uint8_t blockIndex = _blockIndexLookup.at(x << 5u | z);
+			if (blockIndex != 0)
+			{
+				_dirtyBlocks.push_back(blockIndex - 1);
+			}
+		}
+	}
+}
+
+void LandIsland::SetAltitude(const glm::u16vec2& coordinates, uint8_t altitude)
+{
+	auto* cell = GetEditableCell(coordinates);
+	if (cell == nullptr)
+	{
+		return;
+	}
+
+	cell->altitude = altitude;
+	MarkBlocksDirty(coordinates);
+	_dirtyHeightMin = glm::min(_dirtyHeightMin, coordinates);
+	_dirtyHeightMax = glm::max(_dirtyHeightMax, coordinates);
+}
+
+void LandIsland::SetCountry(const glm::u16vec2& coordinates, uint8_t country)
+{
+	auto* cell = GetEditableCell(coordinates);
+	if (cell == nullptr || country >= _countries.size())
+	{
+		return;
+	}
+
+	cell->properties.country = country;
+	MarkBlocksDirty(coordinates);
+}
+
+void LandIsland::ApplyEdits()
+{
+	std::ranges::sort(_dirtyBlocks);
+	const auto [first, last] = std::ranges::unique(_dirtyBlocks);
+	_dirtyBlocks.erase(first, last);
+	for (const auto i : _dirtyBlocks)
+	{
+		_landBlocks[i].UpdateMesh(*this);
+	}
+	_dirtyBlocks.clear();
+
+	if (_dirtyHeightMin.x > _dirtyHeightMax.x || _dirtyHeightMin.y > _dirtyHeightMax.y)
+	{
+		return;
+	}
+
+	_rayCaster.Update(*this, _dirtyHeightMin, _dirtyHeightMax);
+
+	// Only upload the region of the height map covering the edited cells, laid out as in CreateHeightMap
+	const auto textureMin = _dirtyHeightMin - _extentIndexMin * static_cast<uint16_t>(k_CellCount);
+	const auto size = _dirtyHeightMax - _dirtyHeightMin + glm::u16vec2(1);
+	std::vector<uint8_t> data(static_cast<size_t>(size.x) * size.y);
+	for (uint16_t y = 0; y < size.y; ++y)
+	{
+		for (uint16_t x = 0; x < size.x; ++x)
+		{
+			data[static_cast<size_t>(y) * size.x + x] = GetCell(_dirtyHeightMin + glm::u16vec2(x, y)).altitude;
+		}
+	}
+	_heightMap->Update(0, textureMin.x, textureMin.y, size.x, size.y, data.data(), static_cast<uint32_t>(data.size()));
+
+	_dirtyHeightMin = glm::u16vec2(std::numeric_limits<uint16_t>::max());
+	_dirtyHeightMax = glm::u16vec2(0);
+}
+
 void LandIsland::DumpTextures() const
 {
 	_materialArray->DumpTexture();
@@ -11,11 +11,13 @@
 
 #include <array>
 #include <filesystem>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "3D/LandIslandInterface.h"
+#include "3D/LandRayCaster.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
@@ -36,17 +38,35 @@ class LandIsland final: public LandIslandInterface
 	[[nodiscard]] const LandBlock* GetBlock(const glm::u8vec2& coordinates) const;
 	[[nodiscard]] const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const override;
 
+	[[nodiscard]] std::optional<LandRayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+	                                                float tMax) const override;
+	void RayCast(std::span<const LandRay> rays, std::span<std::optional<LandRayHit>> hits) const override;
+
+	void SetAltitude(const glm::u16vec2& coordinates, uint8_t altitude) override;
+	void SetCountry(const glm::u16vec2& coordinates, uint8_t country) override;
+	void ApplyEdits() override;
+
 	// Debug
 	void DumpTextures() const override;
 	void DumpMaps() const override;
 
 private:
 	[[nodiscard]] std::vector<uint8_t> CreateHeightMap() const;
+	[[nodiscard]] lnd::LNDCell* GetEditableCell(const glm::u16vec2& coordinates);
+	void MarkBlocksDirty(const glm::u16vec2& coordinates);
 	std::vector<LandBlock> _landBlocks;
 	std::vector<lnd::LNDCountry> _countries;
 
 	std::array<uint8_t, 1024> _blockIndexLookup {0};
 
+	/// Indices of the blocks whose vertices read a cell edited since the last ApplyEdits
+	std::vector<size_t> _dirtyBlocks;
+	/// Inclusive cell bounds of the altitude edits since the last ApplyEdits, empty when min > max
+	glm::u16vec2 _dirtyHeightMin {std::numeric_limits<uint16_t>::max()};
+	glm::u16vec2 _dirtyHeightMax {0};
+
+	LandRayCaster _rayCaster;
+
 	// Renderer, Dynamics
 public:
 	[[nodiscard]] std::vector<LandBlock>& GetBlocks() override { return _landBlocks; }
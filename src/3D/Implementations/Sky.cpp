@@ -11,6 +11,10 @@
 
 #include "Sky.h"
 
+#include <cstring>
+
+#include <algorithm>
+
 #include <glm/vec3.hpp>
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
@@ -18,6 +22,7 @@
 #include "3D/L3DMesh.h"
 #include "Common/Bitmap16B.h"
 #include "Common/StringUtils.h"
+#include "Common/TaskScheduler.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
@@ -34,41 +39,49 @@ Sky::Sky() noexcept
 
 	SetDayNightTimes(4.5, 7.0, 7.5, 8.25);
 
-	// load in the mesh
-	_mesh = std::make_unique<graphics::L3DMesh>("Sky");
-	_mesh->LoadFromFilesystem(fileSystem.GetPath<filesystem::Path::WeatherSystem>() / "sky.l3d");
-
-	// TODO (#749) Maybe use std::views::enumerate
-	for (uint32_t idx = 0; const auto& alignment : k_Alignments)
-	{
-		for (const auto& timeView : k_Times)
-		{
-			auto time = std::string(timeView);
-			auto prefix = std::string("sky");
-			if (idx >= k_Times.size() && idx < 2 * k_Times.size())
+	// The bitmaps are read and decoded into their layers on the workers while the mesh loads
+	const auto directory = fileSystem.GetPath<filesystem::Path::WeatherSystem>();
+	auto bitmaps = Locator::taskScheduler::value().Submit([this, directory]() {
+		Locator::taskScheduler::value().ParallelFor(0, k_TextureResolution[2], 1, [this, &directory](size_t begin, size_t end) {
+			for (size_t layer = begin; layer < end; ++layer)
 			{
-				time = string_utils::Capitalise(time);
-				prefix = string_utils::Capitalise(prefix);
+				LoadBitmap(directory, layer);
 			}
-			const auto filename = fmt::format("{}_{}_{}.555", prefix, alignment, time);
-			const auto path = fileSystem.GetPath<filesystem::Path::WeatherSystem>() / filename;
-			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading sky texture: {}", path.generic_string());
-
-			Bitmap16B* bitmap = Bitmap16B::LoadFromFile(path);
-			memcpy(&_bitmaps.at(idx * k_TextureResolution[0] * k_TextureResolution[1]), bitmap->Data(), bitmap->Size());
-			delete bitmap;
-			++idx;
-		}
-	}
+		});
+	});
+
+	// load in the mesh
+	_mesh = std::make_unique<graphics::L3DMesh>("Sky");
+	_mesh->LoadFromFilesystem(directory / "sky.l3d");
 
 	_texture = std::make_unique<Texture2D>("Sky");
 	_timeOfDay = 1.0f;
 
+	bitmaps.get();
 	_texture->Create(k_TextureResolution[0], k_TextureResolution[1], k_TextureResolution[2], Format::BGR5A1,
 	                 Wrapping::ClampEdge, Filter::Linear, _bitmaps.data(),
 	                 static_cast<uint32_t>(_bitmaps.size() * sizeof(_bitmaps[0])));
 }
 
+void Sky::LoadBitmap(const std::filesystem::path& directory, size_t layer)
+{
+	const auto alignment = k_Alignments.at(layer / k_Times.size());
+	auto time = std::string(k_Times.at(layer % k_Times.size()));
+	auto prefix = std::string("sky");
+	if (layer >= k_Times.size() && layer < 2 * k_Times.size())
+	{
+		time = string_utils::Capitalise(time);
+		prefix = string_utils::Capitalise(prefix);
+	}
+	const auto filename = fmt::format("{}_{}_{}.555", prefix, alignment, time);
+	const auto path = directory / filename;
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading sky texture: {}", path.generic_string());
+
+	const std::unique_ptr<Bitmap16B> bitmap(Bitmap16B::LoadFromFile(path));
+	const auto layerSize = static_cast<size_t>(k_TextureResolution[0]) * k_TextureResolution[1];
+	std::memcpy(&_bitmaps.at(layer * layerSize), bitmap->Data(), std::min(bitmap->Size(), layerSize * sizeof(_bitmaps[0])));
+}
+
 Sky::~Sky() noexcept = default;
 
 void Sky::SetDayNightTimes(float nightFull, float duskStart, float duskEnd, float dayFull) noexcept
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <array>
+#include <filesystem>
 #include <memory>
 
 #include <glm/fwd.hpp>
@@ -50,6 +51,9 @@ class Sky final: public SkyInterface
 	[[nodiscard]] graphics::Texture2D& GetTexture() const noexcept override { return *_texture; }
 
 private:
+	/// Read the bitmap of a layer and copy it in place in _bitmaps, called from the task scheduler's workers
+	void LoadBitmap(const std::filesystem::path& directory, size_t layer);
+
 	static constexpr std::array<std::string_view, 3> k_Alignments = {
 	    "evil",
 	    "Ntrl",
@@ -25,6 +25,7 @@
 #include "ECS/Systems/Implementations/RenderingSystemTemple.h"
 #include "EngineConfig.h"
 #include "Locator.h"
+#include "Resources/ResourceId.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack;
@@ -86,7 +87,7 @@ inline void addRoomToRegistry(std::string_view assetName, Indoors templeRoom, gl
                               glm::vec3 scale)
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	auto meshId = entt::hashed_string(fmt::format("temple/interior/{}", assetName).c_str());
+	const auto meshId = resources::MakeResourceId("temple/interior/", assetName);
 	auto entity = registry.Create();
 	registry.Assign<ecs::components::TempleInteriorPart>(entity, templeRoom);
 	registry.Assign<ecs::components::Transform>(entity, position, rotation, scale);
@@ -96,8 +97,7 @@ inline void addRoomToRegistry(std::string_view assetName, Indoors templeRoom, gl
 inline void addGlowsToRegistry(Indoors templeRoom)
 {
 	const auto& glowManager = Locator::resources::value().GetGlows();
-	const auto glowId =
-	    entt::hashed_string(fmt::format("temple/interior/glow/{}", k_TempleInteriorGlows.at(templeRoom)).c_str());
+	const auto glowId = resources::MakeResourceId("temple/interior/glow/", k_TempleInteriorGlows.at(templeRoom));
 	const auto glows = glowManager.Handle(glowId);
 	for (const auto& glow : glows->emitters)
 	{
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "3D/LandIslandInterface.h"
 
 namespace openblack
@@ -37,6 +39,28 @@ class UnloadedIsland final: public LandIslandInterface
 		throw std::runtime_error("Cannot get landscape before any are loaded");
 	}
 
+	[[nodiscard]] std::optional<LandRayHit> RayCast(const glm::vec3&, const glm::vec3&, float) const override
+	{
+		return std::nullopt;
+	}
+
+	void RayCast(std::span<const LandRay>, std::span<std::optional<LandRayHit>> hits) const override
+	{
+		std::fill(hits.begin(), hits.end(), std::nullopt);
+	}
+
+	void SetAltitude(const glm::u16vec2&, uint8_t) override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
+	void SetCountry(const glm::u16vec2&, uint8_t) override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
+	void ApplyEdits() override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
+
 	void DumpTextures() const override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
 
 	void DumpMaps() const override { throw std::runtime_error("Cannot get landscape before any are loaded"); }
@@ -61,7 +61,7 @@ bool L3DAnim::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DAnim from file: {}", path.generic_string());
 	anm::ANMFile anm;
 
-	const auto result = anm.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = anm.Open(Locator::filesystem::value().ReadAll(path));
 
 	if (result != anm::ANMResult::Success)
 	{
@@ -78,7 +78,17 @@ bool L3DAnim::LoadFromFile(const std::filesystem::path& path) noexcept
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DAnim from file: {}", path.generic_string());
 	anm::ANMFile anm;
 
-	const auto result = anm.Open(Locator::filesystem::value().FindPath(path));
+	anm::ANMResult result;
+	try
+	{
+		result = anm.Open(Locator::filesystem::value().ReadAll(path));
+	}
+	catch (std::runtime_error& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from filesystem {}: {}", path.generic_string(),
+		                    err.what());
+		return false;
+	}
 	if (result != anm::ANMResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from filesystem {}: {}", path.generic_string(),
@@ -21,6 +21,7 @@
 
 #include "3D/L3DSubMesh.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Texture2D.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
@@ -45,9 +46,10 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 	for (const auto& skin : l3d.GetSkins())
 	{
 		_skins[skin.id] = std::make_unique<Texture2D>(_debugName.c_str());
-		_skins[skin.id]->Create(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, Format::BGRA4, Wrapping::Repeat,
-		                        Filter::Linear, skin.texels.data(),
-		                        static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0])));
+		// Skins are sized by the format so the chain can always be generated
+		const auto chain = MipChain::Generate(Format::BGRA4, l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height,
+		                                      {reinterpret_cast<const uint8_t*>(skin.texels.data()), sizeof(skin.texels)});
+		_skins[skin.id]->Create({&*chain, 1}, Wrapping::Repeat, Filter::LinearMipmapLinear);
 	}
 
 	if (HasDoorPosition() && !l3d.GetExtraPoints().empty())
@@ -173,6 +175,41 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 	return result;
 }
 
+size_t L3DMesh::GetCpuSizeInBytes() const
+{
+	size_t size = sizeof(*this);
+	size += _bonesParents.size() * sizeof(_bonesParents[0]);
+	size += _bonesDefaultMatrices.size() * sizeof(_bonesDefaultMatrices[0]);
+	size += _extraMetrics.size() * sizeof(_extraMetrics[0]);
+	for (const auto& subMesh : _subMeshes)
+	{
+		size += sizeof(*subMesh) + subMesh->GetPrimitives().size() * sizeof(subMesh->GetPrimitives()[0]);
+	}
+	if (_physicsMesh != nullptr)
+	{
+		size += static_cast<size_t>(static_cast<const btConvexHullShape&>(*_physicsMesh).getNumPoints()) * sizeof(btVector3);
+	}
+	return size;
+}
+
+size_t L3DMesh::GetGpuSizeInBytes() const
+{
+	size_t size = 0;
+	for (const auto& subMesh : _subMeshes)
+	{
+		size += subMesh->GetMesh().GetSizeInBytes();
+	}
+	for (const auto& [id, skin] : _skins)
+	{
+		size += skin->GetSizeInBytes();
+	}
+	for (const auto& footprint : _footprints)
+	{
+		size += footprint.texture->GetSizeInBytes() + footprint.mesh->GetSizeInBytes();
+	}
+	return size;
+}
+
 bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 {
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DMesh from file: {}", path.generic_string());
@@ -180,7 +217,7 @@ bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
 
 	try
 	{
-		l3d.ReadFile(*Locator::filesystem::value().GetData(path));
+		l3d.Open(Locator::filesystem::value().ReadAll(path));
 	}
 	catch (std::runtime_error& err)
 	{
@@ -198,7 +235,17 @@ bool L3DMesh::LoadFromFile(const std::filesystem::path& path) noexcept
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading L3DMesh from file: {}", path.generic_string());
 	l3d::L3DFile l3d;
 
-	const auto result = l3d.Open(Locator::filesystem::value().FindPath(path));
+	l3d::L3DResult result;
+	try
+	{
+		result = l3d.Open(Locator::filesystem::value().ReadAll(path));
+	}
+	catch (std::runtime_error& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from filesystem {}: {}", path.generic_string(),
+		                    err.what());
+		return false;
+	}
 	if (result != l3d::L3DResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from filesystem {}: {}", path.generic_string(),
@@ -215,11 +262,11 @@ bool L3DMesh::LoadFromFile(const std::filesystem::path& path) noexcept
 	return true;
 }
 
-bool L3DMesh::LoadFromBuffer(const std::vector<uint8_t>& data) noexcept
+bool L3DMesh::LoadFromBuffer(std::span<const uint8_t> data) noexcept
 {
 	l3d::L3DFile l3d;
 
-	const auto result = l3d.Open(data);
+	const auto result = l3d.Open(std::as_bytes(data));
 	if (result != l3d::L3DResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh from buffer: {}", l3d::ResultToStr(result));
@@ -12,6 +12,7 @@
 #include <filesystem>
 #include <limits>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -94,7 +95,7 @@ class L3DMesh
 	bool Load(const l3d::L3DFile& l3d) noexcept;
 	bool LoadFromFilesystem(const std::filesystem::path& path) noexcept;
 	bool LoadFromFile(const std::filesystem::path& path) noexcept;
-	bool LoadFromBuffer(const std::vector<uint8_t>& data) noexcept;
+	bool LoadFromBuffer(std::span<const uint8_t> data) noexcept;
 
 	[[nodiscard]] uint8_t GetNumSubMeshes() const { return static_cast<uint8_t>(_subMeshes.size()); }
 	[[nodiscard]] const std::vector<std::unique_ptr<L3DSubMesh>>& GetSubMeshes() const { return _subMeshes; }
@@ -109,6 +110,10 @@ class L3DMesh
 	[[nodiscard]] const btConvexShape& GetPhysicsMesh() const { return *_physicsMesh; }
 	[[nodiscard]] float GetMass() const { return _physicsMass; }
 	[[nodiscard]] AxisAlignedBoundingBox GetBoundingBox() const { return _boundingBox; }
+	/// Memory held by the mesh outside of the renderer, mostly its physics hull and bones
+	[[nodiscard]] size_t GetCpuSizeInBytes() const;
+	/// Memory held by the mesh's buffers and textures in the renderer
+	[[nodiscard]] size_t GetGpuSizeInBytes() const;
 
 private:
 	l3d::L3DMeshFlags _flags;
@@ -35,13 +35,10 @@ LandVertex::LandVertex(const glm::vec3& position, const glm::vec3& weight, const
 {
 }
 
-void LandBlock::BuildMesh(LandIslandInterface& island)
+namespace
+{
+VertexDecl LandVertexDecl()
 {
-	if (_mesh != nullptr)
-	{
-		_mesh.reset();
-	}
-
 	VertexDecl decl;
 	decl.reserve(7);
 	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
@@ -57,16 +54,31 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	decl.emplace_back(VertexAttrib::Attribute::Color0, static_cast<uint8_t>(4), VertexAttrib::Type::Uint8, true);
 	// water alpha
 	decl.emplace_back(VertexAttrib::Attribute::Color3, static_cast<uint8_t>(1), VertexAttrib::Type::Float, true);
+	return decl;
+}
+} // namespace
 
-	const auto* verts = BuildVertexList(island);
+void LandBlock::BuildMesh(LandIslandInterface& island)
+{
+	BuildPhysicsMesh(island);
+	UploadMesh();
+}
 
-	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, decl);
-	_mesh = std::make_unique<Mesh>(vertexBuffer);
+void LandBlock::BuildPhysicsMesh(LandIslandInterface& island)
+{
+	_pendingVertices = BuildVertexList(island);
 
-	_dynamicsMeshInterface =
-	    std::make_unique<dynamics::LandBlockBulletMeshInterface>(verts->data, verts->size, vertexBuffer->GetStrideBytes());
+	_dynamicsMeshInterface = std::make_unique<dynamics::LandBlockBulletMeshInterface>(
+	    _pendingVertices->data, _pendingVertices->size, sizeof(LandVertex));
 
 	_physicsMesh = std::make_unique<btBvhTriangleMeshShape>(_dynamicsMeshInterface.get(), true);
+}
+
+void LandBlock::UploadMesh()
+{
+	assert(_pendingVertices != nullptr);
+	assert(_physicsMesh != nullptr);
+
 	_rigidBody = std::make_unique<btRigidBody>(0.0f, nullptr, _physicsMesh.get());
 	btTransform transform;
 	transform.setIdentity();
@@ -74,6 +86,27 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 	_rigidBody->setWorldTransform(transform);
 	_rigidBody->setContactStiffnessAndDamping(300, 10);
 	_rigidBody->setUserIndex(-1);
+
+	auto* vertexBuffer = new VertexBuffer("LandBlock", _pendingVertices, LandVertexDecl());
+	_mesh = std::make_unique<Mesh>(vertexBuffer);
+	_pendingVertices = nullptr;
+}
+
+void LandBlock::UpdateMesh(LandIslandInterface& island)
+{
+	assert(_physicsMesh != nullptr);
+
+	const auto* verts = BuildVertexList(island);
+
+	auto* vertexBuffer = new VertexBuffer("LandBlock", verts, LandVertexDecl());
+	_mesh = std::make_unique<Mesh>(vertexBuffer);
+
+	// The triangle layout of a block never changes, so the existing BVH only needs its bounds refit to the new positions
+	_dynamicsMeshInterface->UpdateVertices(verts->data, vertexBuffer->GetStrideBytes());
+	btVector3 aabbMin;
+	btVector3 aabbMax;
+	_dynamicsMeshInterface->calculateAabbBruteForce(aabbMin, aabbMax);
+	_physicsMesh->refitTree(aabbMin, aabbMax);
 }
 
 const bgfx::Memory* LandBlock::BuildVertexList(LandIslandInterface& island)
@@ -213,6 +246,12 @@ const lnd::LNDCell* LandBlock::GetCells() const
 	return _block ? _block->cells.data() : nullptr;
 }
 
+lnd::LNDCell* LandBlock::GetCells()
+{
+	assert(_block);
+	return _block ? _block->cells.data() : nullptr;
+}
+
 glm::ivec2 LandBlock::GetBlockPosition() const
 {
 	assert(_block);
@@ -63,9 +63,17 @@ class LandBlock
 public:
 	LandBlock() = default;
 	void BuildMesh(LandIslandInterface& island);
+	/// First half of BuildMesh which only reads the island, it may run for several blocks at once on worker threads
+	void BuildPhysicsMesh(LandIslandInterface& island);
+	/// Second half of BuildMesh, creates the renderable mesh from the vertices of BuildPhysicsMesh and the rigid body around
+	/// its BVH on the main thread. Constructing a btRigidBody isn't thread safe as Bullet numbers them from a global counter.
+	void UploadMesh();
+	/// Rebuild the vertices of an already built block after its cells were edited, the physics BVH is refit in place
+	void UpdateMesh(LandIslandInterface& island);
 
 	[[nodiscard]] const graphics::Mesh& GetMesh() const { return *_mesh; }
 	[[nodiscard]] const lnd::LNDCell* GetCells() const;
+	[[nodiscard]] lnd::LNDCell* GetCells();
 	[[nodiscard]] glm::ivec2 GetBlockPosition() const;
 	[[nodiscard]] glm::vec2 GetMapPosition() const;
 	[[nodiscard]] std::unique_ptr<btRigidBody>& GetRigidBody() { return _rigidBody; };
@@ -78,6 +86,8 @@ class LandBlock
 	std::unique_ptr<dynamics::LandBlockBulletMeshInterface> _dynamicsMeshInterface;
 	std::unique_ptr<btBvhTriangleMeshShape> _physicsMesh;
 	std::unique_ptr<btRigidBody> _rigidBody;
+	/// Vertices built by BuildPhysicsMesh, ownership goes to the vertex buffer in UploadMesh
+	const bgfx::Memory* _pendingVertices {nullptr};
 
 	const bgfx::Memory* BuildVertexList(LandIslandInterface& island);
 };
@@ -10,6 +10,8 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <entt/core/hashed_string.hpp>
@@ -30,6 +32,22 @@ namespace lnd
 struct LNDCell;
 struct LNDCountry;
 } // namespace lnd
+
+struct LandRay
+{
+	glm::vec3 origin;
+	glm::vec3 direction;
+	float tMax;
+};
+
+struct LandRayHit
+{
+	glm::vec3 position;
+	glm::vec3 normal;
+	/// Distance along the ray in multiples of its direction's length
+	float distance;
+};
+
 class LandIslandInterface
 {
 public:
@@ -42,6 +60,17 @@ class LandIslandInterface
 	[[nodiscard]] virtual glm::vec3 GetNormalAt(glm::vec2) const = 0;
 	[[nodiscard]] virtual const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const = 0;
 
+	// Ray casts against the land's triangles without going through the physics world
+	[[nodiscard]] virtual std::optional<LandRayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+	                                                        float tMax) const = 0;
+	/// Cast several rays at once, hits must be as long as rays
+	virtual void RayCast(std::span<const LandRay> rays, std::span<std::optional<LandRayHit>> hits) const = 0;
+
+	// Terrain edits, they are only uploaded to the block meshes, physics and height map once ApplyEdits is called
+	virtual void SetAltitude(const glm::u16vec2& coordinates, uint8_t altitude) = 0;
+	virtual void SetCountry(const glm::u16vec2& coordinates, uint8_t country) = 0;
+	virtual void ApplyEdits() = 0;
+
 	// Debug
 	virtual void DumpTextures() const = 0;
 	virtual void DumpMaps() const = 0;
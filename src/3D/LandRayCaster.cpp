@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LandRayCaster.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <LNDFile.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtx/component_wise.hpp>
+#include <glm/gtx/intersect.hpp>
+
+#include "LandBlock.h"
+
+using namespace openblack;
+
+namespace
+{
+/// Keeps flat nodes from having an empty height range
+constexpr float k_HeightEpsilon = 0.01f;
+
+float SafeInverse(float value)
+{
+	return 1.0f / (glm::abs(value) > std::numeric_limits<float>::min() ? value : std::numeric_limits<float>::min());
+}
+} // namespace
+
+void LandRayCaster::Build(const LandIslandInterface& island)
+{
+	_altitudes.assign(static_cast<size_t>(k_CornersPerSide) * k_CornersPerSide, 0);
+	_splits.assign(static_cast<size_t>(k_CellsPerSide) * k_CellsPerSide, false);
+	_levels[0].assign(static_cast<size_t>(k_BlocksPerSide) * k_BlocksPerSide, Node {0, 0, false});
+
+	for (const auto& block : island.GetBlocks())
+	{
+		const auto position = block.GetBlockPosition();
+		_levels[0][position.x * k_BlocksPerSide + position.y].hasLand = true;
+	}
+
+	Update(island, glm::u16vec2(0), glm::u16vec2(k_CornersPerSide - 1));
+}
+
+void LandRayCaster::Update(const LandIslandInterface& island, glm::u16vec2 min, glm::u16vec2 max)
+{
+	max = glm::min(max, glm::u16vec2(k_CornersPerSide - 1));
+	for (uint16_t x = min.x; x <= max.x; ++x)
+	{
+		for (uint16_t z = min.y; z <= max.y; ++z)
+		{
+			const auto& cell = island.GetCell({x, z});
+			_altitudes[x * k_CornersPerSide + z] = cell.altitude;
+			if (x < k_CellsPerSide && z < k_CellsPerSide)
+			{
+				_splits[x * k_CellsPerSide + z] = cell.properties.split != 0;
+			}
+		}
+	}
+
+	// A corner on a block's first row or column is also the far edge of the previous block
+	const auto firstBlock = (glm::max(min, glm::u16vec2(1)) - glm::u16vec2(1)) / k_CellsPerBlock;
+	const auto lastBlock = glm::min(max / k_CellsPerBlock, glm::u16vec2(k_BlocksPerSide - 1));
+	for (uint16_t x = firstBlock.x; x <= lastBlock.x; ++x)
+	{
+		for (uint16_t z = firstBlock.y; z <= lastBlock.y; ++z)
+		{
+			UpdateBlockNode(x, z);
+		}
+	}
+	UpdateUpperLevels();
+}
+
+void LandRayCaster::UpdateBlockNode(uint16_t blockX, uint16_t blockZ)
+{
+	auto& node = _levels[0][blockX * k_BlocksPerSide + blockZ];
+	node.minAltitude = std::numeric_limits<uint8_t>::max();
+	node.maxAltitude = 0;
+	for (uint16_t x = blockX * k_CellsPerBlock; x <= (blockX + 1) * k_CellsPerBlock; ++x)
+	{
+		for (uint16_t z = blockZ * k_CellsPerBlock; z <= (blockZ + 1) * k_CellsPerBlock; ++z)
+		{
+			node.minAltitude = std::min(node.minAltitude, GetAltitude(x, z));
+			node.maxAltitude = std::max(node.maxAltitude, GetAltitude(x, z));
+		}
+	}
+}
+
+void LandRayCaster::UpdateUpperLevels()
+{
+	for (size_t level = 1; level < k_LevelCount; ++level)
+	{
+		const auto side = static_cast<uint16_t>(k_BlocksPerSide >> level);
+		const auto& children = _levels[level - 1];
+		auto& nodes = _levels[level];
+		nodes.assign(static_cast<size_t>(side) * side, Node {std::numeric_limits<uint8_t>::max(), 0, false});
+		for (uint16_t x = 0; x < side; ++x)
+		{
+			for (uint16_t z = 0; z < side; ++z)
+			{
+				auto& node = nodes[x * side + z];
+				for (uint16_t i = 0; i < 4; ++i)
+				{
+					const auto& child = children[(x * 2 + i / 2) * side * 2 + z * 2 + i % 2];
+					if (child.hasLand)
+					{
+						node.minAltitude = std::min(node.minAltitude, child.minAltitude);
+						node.maxAltitude = std::max(node.maxAltitude, child.maxAltitude);
+						node.hasLand = true;
+					}
+				}
+			}
+		}
+	}
+}
+
+std::optional<LandRayHit> LandRayCaster::RayCast(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+{
+	if (_levels[k_LevelCount - 1].empty())
+	{
+		return std::nullopt;
+	}
+
+	const Ray ray {origin, direction,
+	               glm::vec3(SafeInverse(direction.x), SafeInverse(direction.y), SafeInverse(direction.z))};
+	float tMin = 0.0f;
+	if (!ClipToNode(ray, k_LevelCount - 1, 0, 0, tMin, tMax))
+	{
+		return std::nullopt;
+	}
+	return TraverseNode(ray, k_LevelCount - 1, 0, 0, tMin, tMax);
+}
+
+bool LandRayCaster::ClipToNode(const Ray& ray, size_t level, uint16_t nodeX, uint16_t nodeZ, float& tMin, float& tMax) const
+{
+	const auto side = static_cast<uint16_t>(k_BlocksPerSide >> level);
+	const auto& node = _levels[level][nodeX * side + nodeZ];
+	if (!node.hasLand)
+	{
+		return false;
+	}
+
+	const auto nodeSize = static_cast<float>(k_CellsPerBlock << level) * LandIslandInterface::k_CellSize;
+	const auto boxMin = glm::vec3(nodeX * nodeSize, node.minAltitude * LandIslandInterface::k_HeightUnit - k_HeightEpsilon,
+	                              nodeZ * nodeSize);
+	const auto boxMax = glm::vec3((nodeX + 1) * nodeSize,
+	                              node.maxAltitude * LandIslandInterface::k_HeightUnit + k_HeightEpsilon,
+	                              (nodeZ + 1) * nodeSize);
+
+	const auto t0 = (boxMin - ray.origin) * ray.inverseDirection;
+	const auto t1 = (boxMax - ray.origin) * ray.inverseDirection;
+	tMin = std::max(tMin, glm::compMax(glm::min(t0, t1)));
+	tMax = std::min(tMax, glm::compMin(glm::max(t0, t1)));
+	return tMin <= tMax;
+}
+
+std::optional<LandRayHit> LandRayCaster::TraverseNode(const Ray& ray, size_t level, uint16_t nodeX, uint16_t nodeZ,
+                                                      float tMin, float tMax) const
+{
+	if (level == 0)
+	{
+		return MarchBlock(ray, nodeX, nodeZ, tMin, tMax);
+	}
+
+	// The children's ranges along the ray don't overlap, visiting them by entry distance finds the closest hit first
+	struct Child
+	{
+		uint16_t x;
+		uint16_t z;
+		float tMin;
+		float tMax;
+	};
+	std::array<Child, 4> children;
+	size_t childCount = 0;
+	for (uint16_t i = 0; i < 4; ++i)
+	{
+		Child child {static_cast<uint16_t>(nodeX * 2 + i / 2), static_cast<uint16_t>(nodeZ * 2 + i % 2), tMin, tMax};
+		if (ClipToNode(ray, level - 1, child.x, child.z, child.tMin, child.tMax))
+		{
+			children.at(childCount++) = child;
+		}
+	}
+	std::sort(children.begin(), children.begin() + static_cast<std::ptrdiff_t>(childCount),
+	          [](const Child& a, const Child& b) { return a.tMin < b.tMin; });
+
+	for (size_t i = 0; i < childCount; ++i)
+	{
+		const auto& child = children.at(i);
+		if (auto hit = TraverseNode(ray, level - 1, child.x, child.z, child.tMin, child.tMax))
+		{
+			return hit;
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<LandRayHit> LandRayCaster::MarchBlock(const Ray& ray, uint16_t blockX, uint16_t blockZ, float tMin,
+                                                    float tMax) const
+{
+	const auto blockMin = glm::ivec2(blockX, blockZ) * static_cast<int>(k_CellsPerBlock);
+	const auto blockMax = blockMin + glm::ivec2(k_CellsPerBlock - 1);
+	const auto origin = glm::vec2(ray.origin.x, ray.origin.z);
+	const auto direction = glm::vec2(ray.direction.x, ray.direction.z);
+	const auto inverseDirection = glm::vec2(ray.inverseDirection.x, ray.inverseDirection.z);
+
+	// Walk the cells the ray crosses in order (2D DDA), starting where it enters the block
+	const auto entry = (origin + direction * tMin) / LandIslandInterface::k_CellSize;
+	auto cell = glm::clamp(glm::ivec2(glm::floor(entry)), blockMin, blockMax);
+	const auto step = glm::ivec2(direction.x < 0.0f ? -1 : 1, direction.y < 0.0f ? -1 : 1);
+	const auto tDelta = glm::abs(LandIslandInterface::k_CellSize * inverseDirection);
+	const auto nextBoundary = glm::vec2(cell + glm::max(step, glm::ivec2(0))) * LandIslandInterface::k_CellSize;
+	auto tNext = (nextBoundary - origin) * inverseDirection;
+
+	while (cell.x >= blockMin.x && cell.x <= blockMax.x && cell.y >= blockMin.y && cell.y <= blockMax.y)
+	{
+		if (auto hit = IntersectCell(ray, static_cast<uint16_t>(cell.x), static_cast<uint16_t>(cell.y), tMax))
+		{
+			return hit;
+		}
+
+		const auto axis = tNext.x < tNext.y ? 0 : 1;
+		if (tNext[axis] > tMax)
+		{
+			break;
+		}
+		cell[axis] += step[axis];
+		tNext[axis] += tDelta[axis];
+	}
+	return std::nullopt;
+}
+
+std::optional<LandRayHit> LandRayCaster::IntersectCell(const Ray& ray, uint16_t cellX, uint16_t cellZ, float tMax) const
+{
+	const auto corner = [this, cellX, cellZ](uint16_t dx, uint16_t dz) {
+		return glm::vec3((cellX + dx) * LandIslandInterface::k_CellSize,
+		                 GetAltitude(cellX + dx, cellZ + dz) * LandIslandInterface::k_HeightUnit,
+		                 (cellZ + dz) * LandIslandInterface::k_CellSize);
+	};
+	const auto topLeft = corner(0, 0);
+	const auto topRight = corner(1, 0);
+	const auto bottomLeft = corner(0, 1);
+	const auto bottomRight = corner(1, 1);
+
+	// Same triangulation as LandBlock::BuildVertexList
+	std::array<std::array<glm::vec3, 3>, 2> triangles;
+	if (!_splits[cellX * k_CellsPerSide + cellZ])
+	{
+		triangles = {{{topLeft, topRight, bottomRight}, {topLeft, bottomLeft, bottomRight}}};
+	}
+	else
+	{
+		triangles = {{{bottomLeft, topLeft, topRight}, {bottomLeft, bottomRight, topRight}}};
+	}
+
+	std::optional<LandRayHit> closest;
+	for (const auto& [a, b, c] : triangles)
+	{
+		glm::vec2 barycentric;
+		float distance = 0.0f;
+		if (!glm::intersectRayTriangle(ray.origin, ray.direction, a, b, c, barycentric, distance) || distance < 0.0f ||
+		    distance > tMax || (closest && closest->distance <= distance))
+		{
+			continue;
+		}
+		auto normal = glm::normalize(glm::cross(b - a, c - a));
+		if (normal.y < 0.0f)
+		{
+			normal = -normal;
+		}
+		closest = LandRayHit {ray.origin + ray.direction * distance, normal, distance};
+	}
+	return closest;
+}
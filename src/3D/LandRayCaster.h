@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "LandIslandInterface.h"
+
+namespace openblack
+{
+
+/// Ray marcher over the island's cell grid which finds the same triangles as the block meshes given to the physics world.
+/// A quadtree of the altitude range under each group of blocks lets rays skip the parts of the island they pass over,
+/// leaf blocks are then walked cell by cell along the ray.
+class LandRayCaster
+{
+public:
+	/// Copy the altitudes and split flags of the island's cells and build the quadtree over its blocks
+	void Build(const LandIslandInterface& island);
+	/// Refresh the cells in the inclusive range and the quadtree nodes covering them after an edit
+	void Update(const LandIslandInterface& island, glm::u16vec2 min, glm::u16vec2 max);
+
+	[[nodiscard]] std::optional<LandRayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction, float tMax) const;
+
+private:
+	static constexpr uint16_t k_BlocksPerSide = 32;
+	static constexpr uint16_t k_CellsPerBlock = 16;
+	static constexpr uint16_t k_CellsPerSide = k_BlocksPerSide * k_CellsPerBlock;
+	/// Cells use the altitude of their neighbours for their far corners, so there is one more corner than cells per side
+	static constexpr uint16_t k_CornersPerSide = k_CellsPerSide + 1;
+	/// Level 0 has a node per block, each level above halves the side until a single root
+	static constexpr size_t k_LevelCount = 6;
+
+	struct Node
+	{
+		uint8_t minAltitude;
+		uint8_t maxAltitude;
+		bool hasLand;
+	};
+
+	struct Ray
+	{
+		glm::vec3 origin;
+		glm::vec3 direction;
+		glm::vec3 inverseDirection;
+	};
+
+	void UpdateBlockNode(uint16_t blockX, uint16_t blockZ);
+	void UpdateUpperLevels();
+	[[nodiscard]] uint8_t GetAltitude(uint16_t x, uint16_t z) const { return _altitudes[x * k_CornersPerSide + z]; }
+	[[nodiscard]] bool ClipToNode(const Ray& ray, size_t level, uint16_t nodeX, uint16_t nodeZ, float& tMin,
+	                              float& tMax) const;
+	[[nodiscard]] std::optional<LandRayHit> TraverseNode(const Ray& ray, size_t level, uint16_t nodeX, uint16_t nodeZ,
+	                                                     float tMin, float tMax) const;
+	[[nodiscard]] std::optional<LandRayHit> MarchBlock(const Ray& ray, uint16_t blockX, uint16_t blockZ, float tMin,
+	                                                   float tMax) const;
+	[[nodiscard]] std::optional<LandRayHit> IntersectCell(const Ray& ray, uint16_t cellX, uint16_t cellZ, float tMax) const;
+
+	std::array<std::vector<Node>, k_LevelCount> _levels;
+	std::vector<uint8_t> _altitudes;
+	std::vector<bool> _splits;
+};
+
+} // namespace openblack
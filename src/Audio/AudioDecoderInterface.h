@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <span>
 #include <string>
 #include <vector>
 
@@ -19,8 +22,15 @@ namespace openblack::audio
 class AudioDecoderInterface
 {
 public:
+	virtual ~AudioDecoderInterface() = default;
+	/// The buffer is decoded in place and must outlive the decoder
 	virtual bool Open(const std::vector<uint8_t>& buffer) = 0;
 	virtual void Read(std::vector<int16_t>& buffer) = 0;
+	/// Decode the next frames into `frames`, which holds a whole number of frames. Returns the number of frames decoded,
+	/// less than asked for only at the end of the stream
+	virtual size_t ReadFrames(std::span<int16_t> frames) = 0;
+	/// Number of frames in the whole stream, which may take a pass over all of it
+	[[nodiscard]] virtual uint64_t GetFrameCount() = 0;
 	[[nodiscard]] virtual ChannelLayout GetChannelLayout() = 0;
 };
 } // namespace openblack::audio
@@ -11,9 +11,13 @@
 
 #include "AudioManager.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <utility>
 
 #include <PackFile.h>
+#include <glm/geometric.hpp>
 #include <glm/gtc/constants.hpp>
 #include <spdlog/spdlog.h>
 
@@ -22,9 +26,7 @@
 #include "ECS/Registry.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Locator.h"
-#include "MpegAudioDecoder.h"
 #include "Resources/Resources.h"
-#include "WavAudioDecoder.h"
 
 using namespace openblack::ecs::components;
 
@@ -32,61 +34,149 @@ namespace openblack::audio
 {
 
 AudioManager::AudioManager()
-    : _audioPlayer(new AudioPlayer())
+    : AudioManager(std::make_unique<AudioPlayer>())
+{
+}
+
+AudioManager::AudioManager(std::unique_ptr<AudioPlayerInterface> player)
+    : _audioPlayer(std::move(player))
+    , _soundCache(*_audioPlayer)
+    , _voiceManager(*_audioPlayer)
 {
 	_audioPlayer->Initialize();
 }
 
 AudioManager::~AudioManager()
 {
-	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, AudioEmitter>([this](entt::entity entity, const Transform&, const AudioEmitter& emitter) {
-		DestroyEmitter(entity);
-		auto sound = Locator::resources::value().GetSounds().Handle(emitter.soundId);
-		_audioPlayer->DeleteBuffer(sound->bufferId);
-	});
+	StopMusic();
 
-	if (registry.Valid(_musicEntity))
-	{
-		DestroyEmitter(_musicEntity);
-	}
+	auto& registry = Locator::entitiesRegistry::value();
+	registry.Each<Transform, AudioEmitter>(
+	    [this](entt::entity entity, const Transform&, const AudioEmitter&) { DestroyEmitter(entity); });
+	_soundCache.Clear();
 }
 
 void AudioManager::Stop()
 {
+	StopMusic();
 	auto& registry = Locator::entitiesRegistry::value();
 	registry.Each<Transform, AudioEmitter>(
 	    [this](entt::entity entity, const Transform&, const AudioEmitter&) { DestroyEmitter(entity); });
-	StopMusic();
 }
 
 void AudioManager::Update()
 {
 	auto& camera = Locator::camera::value();
-	auto pos = camera.GetOrigin();
-	auto vel = camera.GetOriginVelocity();
-	auto forward = camera.GetForward();
-	auto top = camera.GetUp();
-	_audioPlayer->UpdateListener(pos, vel, forward, top);
+	const Listener listener {camera.GetOrigin(), camera.GetOriginVelocity(), camera.GetForward(), camera.GetUp()};
+	if (listener != _listener)
+	{
+		_listener = listener;
+		_audioPlayer->UpdateListener(listener.position, listener.velocity, listener.forward, listener.up);
+	}
+	UpdateMusic();
+	_soundCache.Update();
+	_soundCache.Trim();
+
+	const auto now = std::chrono::steady_clock::now();
+	const auto deltaTime = std::chrono::duration<float>(now - _lastUpdate).count();
+	_lastUpdate = now;
+
+	// Sources are only polled when their sound should have ended, and one more in turn each update to catch the rest
+	const auto polledEntity =
+	    _voicedEmitters.empty() ? entt::null : _voicedEmitters[_statusPollIndex++ % _voicedEmitters.size()];
+
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, AudioEmitter>(
-	    [this](entt::entity entity, const Transform& transform, const AudioEmitter& emitter) {
-		    auto volume = _globalVolume * emitter.volume;
-		    if (entity == _musicEntity)
-		    {
-			    volume *= _musicVolume;
-		    }
-		    else
-		    {
-			    volume *= _sfxVolume;
-		    }
-		    _audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, emitter.loop == PlayType::Repeat);
-		    auto audioStatus = _audioPlayer->GetStatus(emitter.sourceId);
-		    if (audioStatus == AudioStatus::Stopped)
-		    {
-			    DestroyEmitter(entity);
-		    }
-	    });
+	auto& sounds = Locator::resources::value().GetSounds();
+	std::vector<entt::entity> finished;
+	_voiceCandidates.clear();
+	registry.Each<Transform, AudioEmitter>([&](entt::entity entity, const Transform& transform, AudioEmitter& emitter) {
+		if (entity == _musicEntity)
+		{
+			return;
+		}
+
+		auto sound = sounds.Handle(emitter.soundId);
+		const auto resident = sound->bufferId != 0;
+		if (emitter.state == AudioStatus::Playing && resident)
+		{
+			// Emitters keep time so virtual ones carry on from the right place when they get a source back
+			emitter.playbackTime += deltaTime;
+			const auto ended = emitter.playbackTime >= sound->duration;
+			if (ended && emitter.loop == PlayType::Repeat && sound->duration > 0.0f)
+			{
+				emitter.playbackTime = std::fmod(emitter.playbackTime, sound->duration);
+			}
+			else if (emitter.sourceId == VoiceManager::k_NoSource)
+			{
+				emitter.state = ended ? AudioStatus::Stopped : emitter.state;
+			}
+			else if ((ended || entity == polledEntity) && _audioPlayer->GetStatus(emitter.sourceId) == AudioStatus::Stopped)
+			{
+				// A playing source only stops by itself at the end of its sound
+				emitter.state = AudioStatus::Stopped;
+			}
+		}
+
+		if (emitter.state == AudioStatus::Stopped)
+		{
+			finished.push_back(entity);
+			return;
+		}
+		if (emitter.state != AudioStatus::Playing || !resident)
+		{
+			return;
+		}
+		const auto listenerPosition = emitter.relative ? glm::zero<glm::vec3>() : listener.position;
+		const auto gain = VoiceManager::GetGain(GetEmitterVolume(entity, emitter),
+		                                        glm::distance(listenerPosition, transform.position), emitter.radius.y);
+		if (gain > VoiceManager::k_InaudibleGain)
+		{
+			_voiceCandidates.push_back({entity, emitter.priority, gain});
+		}
+	});
+	for (const auto entity : finished)
+	{
+		DestroyEmitter(entity);
+	}
+
+	// The most important emitters which can be heard get a source, all others are virtual
+	const auto voices = _voiceManager.Prioritise(_voiceCandidates);
+	_voicedEmitters.clear();
+	for (size_t i = 0; i < voices; ++i)
+	{
+		_voicedEmitters.push_back(_voiceCandidates[i].entity);
+	}
+	std::sort(_voicedEmitters.begin(), _voicedEmitters.end());
+
+	// Sources are taken back first so they can go to the emitters which were given a voice
+	registry.Each<AudioEmitter>([this](entt::entity entity, AudioEmitter& emitter) {
+		if (entity != _musicEntity && emitter.sourceId != VoiceManager::k_NoSource &&
+		    !std::binary_search(_voicedEmitters.cbegin(), _voicedEmitters.cend(), entity))
+		{
+			ReleaseVoice(emitter);
+		}
+	});
+
+	// Only the sources whose position, volume or looping changed are sent, all together
+	_sourceBatch.Clear();
+	for (const auto entity : _voicedEmitters)
+	{
+		auto& emitter = registry.Get<AudioEmitter>(entity);
+		const auto& transform = registry.Get<Transform>(entity);
+		if (emitter.sourceId == VoiceManager::k_NoSource)
+		{
+			AssignVoice(entity, emitter, transform);
+		}
+		else
+		{
+			BatchSourceUpdate(entity, emitter, transform);
+		}
+	}
+	if (EmitterExists(_musicEntity))
+	{
+		BatchSourceUpdate(_musicEntity, registry.Get<AudioEmitter>(_musicEntity), registry.Get<Transform>(_musicEntity));
+	}
+	_audioPlayer->UpdateSources(_sourceBatch);
 }
 
 BufferId AudioManager::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
@@ -94,13 +184,77 @@ BufferId AudioManager::CreateBuffer(ChannelLayout layout, const std::vector<int1
 	return _audioPlayer->CreateBuffer(layout, buffer, sampleRate);
 }
 
+float AudioManager::GetEmitterVolume(entt::entity entity, const AudioEmitter& emitter) const
+{
+	return _globalVolume * (entity == _musicEntity ? _musicVolume : _sfxVolume) * emitter.volume;
+}
+
+bool AudioManager::GetEmitterLoop(entt::entity entity, const AudioEmitter& emitter) const
+{
+	// The stream loops the music itself, looping the source would replay the queued buffers
+	return emitter.loop == PlayType::Repeat && entity != _musicEntity;
+}
+
+void AudioManager::StartSource(entt::entity entity, AudioEmitter& emitter, const Transform& transform)
+{
+	emitter.sourcePosition = transform.position;
+	emitter.sourceVolume = GetEmitterVolume(entity, emitter);
+	emitter.sourceLoop = GetEmitterLoop(entity, emitter);
+	_audioPlayer->PlaySource(emitter.sourceId, emitter.sourcePosition, emitter.sourceVolume, emitter.sourceLoop);
+}
+
+void AudioManager::BatchSourceUpdate(entt::entity entity, AudioEmitter& emitter, const Transform& transform)
+{
+	const auto volume = GetEmitterVolume(entity, emitter);
+	const auto loop = GetEmitterLoop(entity, emitter);
+	if (transform.position == emitter.sourcePosition && volume == emitter.sourceVolume && loop == emitter.sourceLoop)
+	{
+		return;
+	}
+	emitter.sourcePosition = transform.position;
+	emitter.sourceVolume = volume;
+	emitter.sourceLoop = loop;
+	_sourceBatch.Add(emitter.sourceId, transform.position, volume, loop);
+}
+
+void AudioManager::AssignVoice(entt::entity entity, AudioEmitter& emitter, const Transform& transform)
+{
+	const auto bufferId = Locator::resources::value().GetSounds().Handle(emitter.soundId)->bufferId;
+	emitter.sourceId = _voiceManager.Acquire(emitter.relative);
+	_audioPlayer->QueueBuffer(emitter.sourceId, bufferId);
+	_audioPlayer->SetOffset(emitter.sourceId, emitter.playbackTime);
+	StartSource(entity, emitter, transform);
+}
+
+void AudioManager::ReleaseVoice(AudioEmitter& emitter)
+{
+	emitter.playbackTime = _audioPlayer->GetOffset(emitter.sourceId);
+	_voiceManager.Release(emitter.sourceId);
+	emitter.sourceId = VoiceManager::k_NoSource;
+}
+
 void AudioManager::PlayEmitter(entt::entity emitter)
 {
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& emitterComponent = registry.Get<AudioEmitter>(emitter);
 	auto& transform = registry.Get<Transform>(emitter);
-	_audioPlayer->PlaySource(emitterComponent.sourceId, transform.position, 1.f, emitterComponent.loop == PlayType::Repeat);
+	if (emitter == _musicEntity)
+	{
+		StartSource(emitter, emitterComponent, transform);
+		return;
+	}
+
+	emitterComponent.state = AudioStatus::Playing;
+	if (emitterComponent.sourceId != VoiceManager::k_NoSource)
+	{
+		StartSource(emitter, emitterComponent, transform);
+	}
+	else if (GetSound(emitterComponent.soundId).bufferId != 0 && _voiceManager.HasFreeVoice())
+	{
+		// Start right away rather than on the next update when there is a voice to spare
+		AssignVoice(emitter, emitterComponent, transform);
+	}
 }
 
 void AudioManager::PauseEmitter(entt::entity emitter)
@@ -108,23 +262,48 @@ void AudioManager::PauseEmitter(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->PauseSource(component.sourceId);
+	if (emitter != _musicEntity)
+	{
+		component.state = AudioStatus::Paused;
+	}
+	if (component.sourceId != VoiceManager::k_NoSource)
+	{
+		_audioPlayer->PauseSource(component.sourceId);
+	}
 }
 
 void AudioManager::StopEmitter(entt::entity emitter)
 {
+	if (emitter == _musicEntity)
+	{
+		StopMusic();
+		return;
+	}
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->StopSource(component.sourceId);
+	component.state = AudioStatus::Stopped;
+	if (component.sourceId != VoiceManager::k_NoSource)
+	{
+		_audioPlayer->StopSource(component.sourceId);
+	}
 }
 
 void AudioManager::DestroyEmitter(entt::entity emitter)
 {
+	if (emitter == _musicEntity)
+	{
+		StopMusic();
+		return;
+	}
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
-	_audioPlayer->DeleteSource(component.sourceId);
+	if (component.sourceId != VoiceManager::k_NoSource)
+	{
+		_voiceManager.Release(component.sourceId);
+	}
+	_soundCache.Release(component.soundId);
 	registry.Destroy(emitter);
 }
 
@@ -134,57 +313,15 @@ entt::entity AudioManager::CreateEmitter(entt::id_type id, PlayType playType, gl
 	auto sound = Locator::resources::value().GetSounds().Handle(id);
 	auto& registry = Locator::entitiesRegistry::value();
 	auto entity = registry.Create();
-	auto sourceId = _audioPlayer->CreateSource(static_cast<float>(sound->pitch), relative);
-	if (!sound->buffer.empty())
-	{
-		CreateBuffer(sound);
-	}
-	_audioPlayer->QueueBuffer(sourceId, sound->bufferId);
-	registry.Assign<AudioEmitter>(entity, sourceId, id, 0, position, direction, radius, volume, playType, status, relative);
+	// Emitters start virtual, they get a source once their sound is decoded and if they are important enough
+	_soundCache.Request(id);
+	_soundCache.Retain(id);
+	registry.Assign<AudioEmitter>(entity, VoiceManager::k_NoSource, id, sound->priority, position, direction, radius, volume,
+	                              playType, status, relative);
 	registry.Assign<Transform>(entity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
 	return entity;
 }
 
-void AudioManager::CreateBuffer(Sound& sound)
-{
-	std::vector<int16_t> decodeBuffer;
-	for (auto& buffer : sound.buffer)
-	{
-		bool success;
-		std::vector<int16_t> decoded;
-		{
-			auto decoder = audio::MpegAudioDecoder();
-			success = decoder.Open(buffer);
-			if (success)
-			{
-				decoder.Read(decoded);
-				sound.channelLayout = decoder.GetChannelLayout();
-			}
-		}
-		if (!success)
-		{
-			auto decoder = audio::WavAudioDecoder();
-			success = decoder.Open(buffer);
-			if (success)
-			{
-				decoder.Read(decoded);
-				sound.channelLayout = decoder.GetChannelLayout();
-			}
-		}
-		if (success)
-		{
-			decodeBuffer.insert(decodeBuffer.end(), decoded.begin(), decoded.end());
-		}
-		else
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode sound");
-		}
-	}
-	sound.bufferId = CreateBuffer(sound.channelLayout, decodeBuffer, sound.sampleRate);
-	sound.duration = _audioPlayer->GetDuration(sound.bufferId);
-	sound.sizeInBytes = decodeBuffer.size() * sizeof(decodeBuffer[0]);
-}
-
 bool AudioManager::EmitterExists(entt::entity emitter)
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -193,11 +330,19 @@ bool AudioManager::EmitterExists(entt::entity emitter)
 
 float AudioManager::GetProgress(entt::entity entity)
 {
+	if (entity == _musicEntity && _musicStream != nullptr)
+	{
+		return _musicStream->GetProgress();
+	}
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(entity));
 	auto& emitter = registry.Get<AudioEmitter>(entity);
-	auto sizeInBytes = Locator::resources::value().GetSounds().Handle(emitter.soundId)->sizeInBytes;
-	return _audioPlayer->GetProgress(sizeInBytes, emitter.sourceId);
+	const auto& sound = GetSound(emitter.soundId);
+	if (emitter.sourceId != VoiceManager::k_NoSource && sound.sizeInBytes != 0)
+	{
+		return _audioPlayer->GetProgress(sound.sizeInBytes, emitter.sourceId);
+	}
+	return sound.duration > 0.0f ? emitter.playbackTime / sound.duration : 0.0f;
 }
 
 AudioStatus AudioManager::GetStatus(entt::entity emitter)
@@ -205,6 +350,10 @@ AudioStatus AudioManager::GetStatus(entt::entity emitter)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(emitter));
 	auto& component = registry.Get<AudioEmitter>(emitter);
+	if (component.sourceId == VoiceManager::k_NoSource)
+	{
+		return component.state;
+	}
 	return _audioPlayer->GetStatus(component.sourceId);
 }
 
@@ -223,6 +372,24 @@ void AudioManager::PlaySound(entt::id_type id, PlayType playType)
 	PlayEmitter(entity);
 }
 
+void AudioManager::PrefetchSound(entt::id_type id)
+{
+	_soundCache.Prefetch(id);
+}
+
+void AudioManager::PrefetchSoundGroup(const std::string& name)
+{
+	auto group = _soundGroups.find(name);
+	if (group == _soundGroups.end())
+	{
+		return;
+	}
+	for (const auto id : group->second.sounds)
+	{
+		_soundCache.Prefetch(id);
+	}
+}
+
 void AudioManager::CreateSoundGroup(const std::string& name)
 {
 	_soundGroups[name] = SoundGroup();
@@ -251,39 +418,88 @@ const std::map<std::string, SoundGroup>& AudioManager::GetSoundGroups()
 void AudioManager::PlayMusic(const std::string& packPath, PlayType type)
 {
 	StopMusic();
-	const entt::id_type id = entt::hashed_string(fmt::format("{}", packPath).c_str());
-	if (!Locator::resources::value().GetSounds().Contains(packPath))
+	// The pack is opened and decoded on the task scheduler, the emitter is created by Update once there is something to play
+	_musicStream = std::make_unique<MusicStream>(*_audioPlayer, packPath, type == PlayType::Repeat);
+	_musicPath = packPath;
+	_musicPlayType = type;
+}
+
+void AudioManager::UpdateMusic()
+{
+	if (_musicStream == nullptr)
 	{
-		pack::PackFile soundPack;
-		soundPack.Open(packPath);
-		const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		const auto& audioData = soundPack.GetAudioSamplesData();
-		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[0], audioData);
+		return;
+	}
+
+	_musicStream->Update();
+	if (_musicStream->HasFailed())
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to stream music from {}", _musicPath);
+		StopMusic();
+		return;
+	}
+	if (_musicStream->IsFinished())
+	{
+		StopMusic();
+		return;
+	}
+
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& sounds = Locator::resources::value().GetSounds();
+	const entt::id_type id = entt::hashed_string(_musicPath.c_str());
+	if (!registry.Valid(_musicEntity))
+	{
+		if (!_musicStream->IsReady())
+		{
+			return;
+		}
+
+		// The resource only describes the track for the debug GUI, the samples stay in the stream
+		sounds.Load(id, resources::SoundLoader::FromBufferTag {}, _musicStream->GetHeader(),
+		            std::vector<std::vector<uint8_t>> {});
+		auto sound = sounds.Handle(id);
+		sound->bufferId = 0;
+		sound->duration = _musicStream->GetDuration();
+		sound->sizeInBytes = 0;
+
+		auto position = glm::one<glm::vec3>();
+		auto direction = glm::zero<glm::vec3>();
+		auto radius = glm::zero<glm::vec2>();
+		_musicEntity = registry.Create();
+		registry.Assign<AudioEmitter>(_musicEntity, _musicStream->GetSource(), id, 0, position, direction, radius,
+		                              sound->volume, _musicPlayType, AudioStatus::Playing, true);
+		registry.Assign<Transform>(_musicEntity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
+		PlayEmitter(_musicEntity);
+		return;
+	}
+
+	// The length is worked out in the background after playback started
+	auto sound = sounds.Handle(id);
+	if (sound->duration < 0)
+	{
+		sound->duration = _musicStream->GetDuration();
+	}
+
+	if (_musicStream->HasRunDry())
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Music decoding fell behind playback of {}", _musicPath);
+		PlayEmitter(_musicEntity);
 	}
-	auto sound = Locator::resources::value().GetSounds().Handle(id);
-	auto position = glm::one<glm::vec3>();
-	auto direction = glm::zero<glm::vec3>();
-	auto radius = glm::zero<glm::vec3>();
-	_musicEntity = CreateEmitter(id, type, position, direction, radius, sound->volume, AudioStatus::Playing, true);
-	PlayEmitter(_musicEntity);
 }
 
 void AudioManager::StopMusic()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	if (!EmitterExists(_musicEntity))
+	if (EmitterExists(_musicEntity))
 	{
-		return;
+		auto& emitter = registry.Get<AudioEmitter>(_musicEntity);
+		//	Erase the music resource as it is no longer being played
+		Locator::resources::value().GetSounds().Erase(emitter.soundId);
+		//	Remove the entity
+		registry.Destroy(_musicEntity);
 	}
-	auto& emitter = registry.Get<AudioEmitter>(_musicEntity);
-	// Clean up the audio player's music resources
-	_audioPlayer->StopSource(emitter.sourceId);
-	_audioPlayer->DeleteSource(emitter.sourceId);
-	[[maybe_unused]] auto music = Locator::resources::value().GetSounds().Handle(emitter.soundId);
-	//	Erase the music resource as it is no longer being played
-	Locator::resources::value().GetSounds().Erase(emitter.soundId);
-	//	Remove the entity
-	registry.Destroy(_musicEntity);
 	_musicEntity = entt::null;
+	// Stops the source and releases it along with the stream's buffers
+	_musicStream.reset();
 }
 } // namespace openblack::audio
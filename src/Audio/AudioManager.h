@@ -9,7 +9,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -21,7 +24,10 @@
 #include "AudioDecoderInterface.h"
 #include "AudioManagerInterface.h"
 #include "AudioPlayer.h"
+#include "MusicStream.h"
+#include "SoundCache.h"
 #include "SoundGroup.h"
+#include "VoiceManager.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
@@ -32,6 +38,11 @@ namespace openblack
 class Game;
 }
 
+namespace openblack::ecs::components
+{
+struct Transform;
+}
+
 namespace openblack::audio
 {
 
@@ -39,9 +50,9 @@ class AudioManager final: public AudioManagerInterface
 {
 public:
 	AudioManager();
+	explicit AudioManager(std::unique_ptr<AudioPlayerInterface> player);
 	~AudioManager();
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
-	void CreateBuffer(Sound& sound) override;
 	void PlayEmitter(entt::entity emitter) override;
 	void PauseEmitter(entt::entity emitter) override;
 	void StopEmitter(entt::entity emitter) override;
@@ -55,6 +66,10 @@ class AudioManager final: public AudioManagerInterface
 	void StopMusic() override;
 	const Sound& GetSound(entt::id_type id) override;
 	void PlaySound(entt::id_type id, PlayType type) override;
+	void PrefetchSound(entt::id_type id) override;
+	void PrefetchSoundGroup(const std::string& name) override;
+	[[nodiscard]] SoundCacheStats GetSoundCacheStats() const override { return _soundCache.GetStats(); }
+	[[nodiscard]] VoiceStats GetVoiceStats() const override { return _voiceManager.GetStats(); }
 	void SetGlobalVolume(float volume) override { _globalVolume = volume; }
 	void SetSfxVolume(float volume) override { _sfxVolume = volume; }
 	void SetMusicVolume(float volume) override { _musicVolume = volume; }
@@ -71,7 +86,46 @@ class AudioManager final: public AudioManagerInterface
 	const std::map<std::string, SoundGroup>& GetSoundGroups() override;
 
 private:
+	struct Listener
+	{
+		glm::vec3 position;
+		glm::vec3 velocity;
+		glm::vec3 forward;
+		glm::vec3 up;
+
+		bool operator==(const Listener&) const = default;
+	};
+
+	[[nodiscard]] float GetEmitterVolume(entt::entity entity, const ecs::components::AudioEmitter& emitter) const;
+	[[nodiscard]] bool GetEmitterLoop(entt::entity entity, const ecs::components::AudioEmitter& emitter) const;
+	/// Play the emitter's source with its current parameters, which are remembered for change detection
+	void StartSource(entt::entity entity, ecs::components::AudioEmitter& emitter,
+	                 const ecs::components::Transform& transform);
+	/// Add the emitter's source to the batch sent at the end of the update, if its parameters changed since they were sent
+	void BatchSourceUpdate(entt::entity entity, ecs::components::AudioEmitter& emitter,
+	                       const ecs::components::Transform& transform);
+	/// Give the emitter a source from the pool and play it from where it got to while it was virtual
+	void AssignVoice(entt::entity entity, ecs::components::AudioEmitter& emitter, const ecs::components::Transform& transform);
+	/// Take the emitter's source back, it carries on virtually from the source's position
+	void ReleaseVoice(ecs::components::AudioEmitter& emitter);
+	/// Feed the music stream and create its emitter once the first blocks are queued
+	void UpdateMusic();
+
 	std::unique_ptr<AudioPlayerInterface> _audioPlayer;
+	/// Owns the sound effect buffers, declared after the player so it is destroyed first
+	SoundCache _soundCache;
+	VoiceManager _voiceManager;
+	/// Playing emitters which could be heard, reused each update
+	std::vector<VoiceManager::Candidate> _voiceCandidates;
+	/// Emitters which have a source after the last update, sorted
+	std::vector<entt::entity> _voicedEmitters;
+	std::chrono::steady_clock::time_point _lastUpdate {std::chrono::steady_clock::now()};
+	/// Round robin over the voiced emitters, one of which has its source polled each update
+	size_t _statusPollIndex {0};
+	/// Parameters of the sources which changed this update, reused each update
+	SourceBatch _sourceBatch;
+	/// Last listener sent to the player, it isn't sent again while the camera doesn't move
+	std::optional<Listener> _listener;
 	/// All sounds are loaded
 	std::map<std::string, SoundGroup> _soundGroups;
 	/// Music resources are loaded on demand to avoid storing large audio buffers. There are no resource IDs yet
@@ -80,6 +134,10 @@ class AudioManager final: public AudioManagerInterface
 	float _musicVolume {1.0f};
 	float _sfxVolume {1.0f};
 	entt::entity _musicEntity {entt::null};
+	/// Owns the music emitter's source and buffers, which are not shared with the sound resource
+	std::unique_ptr<MusicStream> _musicStream;
+	std::string _musicPath;
+	PlayType _musicPlayType {PlayType::Once};
 };
 
 } // namespace openblack::audio
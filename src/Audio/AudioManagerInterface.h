@@ -17,6 +17,8 @@
 #include "AudioPlayerInterface.h"
 #include "ECS/Components/AudioEmitter.h"
 #include "Sound.h"
+#include "SoundCache.h"
+#include "VoiceManager.h"
 #include "SoundGroup.h"
 
 namespace openblack
@@ -31,7 +33,6 @@ class AudioManagerInterface
 	virtual void Stop() = 0;
 	virtual void Update() = 0;
 	virtual BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
-	virtual void CreateBuffer(Sound& sound) = 0;
 	virtual void PlayEmitter(entt::entity emitter) = 0;
 	virtual void PauseEmitter(entt::entity emitter) = 0;
 	virtual void StopEmitter(entt::entity emitter) = 0;
@@ -50,6 +51,11 @@ class AudioManagerInterface
 	virtual void PlayMusic(const std::string& packPath, PlayType type) = 0;
 	virtual void StopMusic() = 0;
 	virtual void PlaySound(entt::id_type id, PlayType type) = 0;
+	/// Decode the sound in the background so that it can start right away when it is played
+	virtual void PrefetchSound(entt::id_type id) = 0;
+	virtual void PrefetchSoundGroup(const std::string& name) = 0;
+	[[nodiscard]] virtual SoundCacheStats GetSoundCacheStats() const = 0;
+	[[nodiscard]] virtual VoiceStats GetVoiceStats() const = 0;
 	virtual const Sound& GetSound(entt::id_type id) = 0;
 	virtual void CreateSoundGroup(const std::string& name) = 0;
 	virtual void AddToSoundGroup(const std::string& name, entt::id_type id) = 0;
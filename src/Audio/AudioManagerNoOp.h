@@ -26,7 +26,6 @@ class AudioManagerNoOp final: public AudioManagerInterface
 	{
 		return 0;
 	}
-	void CreateBuffer([[maybe_unused]] Sound& sound) override {}
 	void PlayEmitter([[maybe_unused]] entt::entity emitter) override {}
 	void PauseEmitter([[maybe_unused]] entt::entity emitter) override {}
 	void StopEmitter([[maybe_unused]] entt::entity emitter) override {}
@@ -49,6 +48,10 @@ class AudioManagerNoOp final: public AudioManagerInterface
 		return result;
 	}
 	void PlaySound([[maybe_unused]] entt::id_type id, [[maybe_unused]] PlayType type) override {}
+	void PrefetchSound([[maybe_unused]] entt::id_type id) override {}
+	void PrefetchSoundGroup([[maybe_unused]] const std::string& name) override {}
+	[[nodiscard]] SoundCacheStats GetSoundCacheStats() const override { return {}; }
+	[[nodiscard]] VoiceStats GetVoiceStats() const override { return {}; }
 	void SetGlobalVolume([[maybe_unused]] float volume) override {}
 	void SetSfxVolume([[maybe_unused]] float volume) override {}
 	void SetMusicVolume([[maybe_unused]] float volume) override {}
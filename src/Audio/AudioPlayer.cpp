@@ -100,6 +100,20 @@ void AudioPlayer::Initialize()
 	alcGetIntegerv(_device.get(), ALC_MINOR_VERSION, 1, &minorVersion);
 	SPDLOG_LOGGER_INFO(spdlog::get("audio"), "ALC Version {}.{}", majorVersion, minorVersion);
 	alCheckCall(alcMakeContextCurrent(_context.get()));
+
+	// alcSuspendContext does nothing in OpenAL Soft, batches are only applied at once with this extension
+	if (alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE)
+	{
+		_deferUpdates = reinterpret_cast<decltype(_deferUpdates)>(alGetProcAddress("alDeferUpdatesSOFT"));
+		_processUpdates = reinterpret_cast<decltype(_processUpdates)>(alGetProcAddress("alProcessUpdatesSOFT"));
+	}
+	SPDLOG_LOGGER_INFO(spdlog::get("audio"), "Source batches are {}",
+	                   HasDeferredUpdates() ? "deferred with AL_SOFT_deferred_updates" : "applied with a suspended context");
+}
+
+bool AudioPlayer::HasDeferredUpdates() const
+{
+	return _deferUpdates != nullptr && _processUpdates != nullptr;
 }
 
 void AudioPlayer::UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const
@@ -111,6 +125,14 @@ void AudioPlayer::UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front,
 }
 
 BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
+{
+	BufferId id;
+	alCheckCall(alGenBuffers(1, &id));
+	SetBufferData(id, layout, buffer, sampleRate);
+	return id;
+}
+
+void AudioPlayer::SetBufferData(BufferId id, ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
 {
 	int playerLayout;
 	if (layout == ChannelLayout::Mono)
@@ -125,11 +147,8 @@ BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16
 	{
 		throw std::runtime_error("Unknown channel layout");
 	}
-	BufferId id;
-	alCheckCall(alGenBuffers(1, &id));
 	auto bufferSize = static_cast<ALsizei>(buffer.size() * sizeof(buffer[0]));
 	alCheckCall(alBufferData(id, playerLayout, buffer.data(), bufferSize, sampleRate));
-	return id;
 }
 
 void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
@@ -137,6 +156,18 @@ void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
 	alCheckCall(alSourceQueueBuffers(sourceId, 1, &bufferId));
 }
 
+std::vector<BufferId> AudioPlayer::UnqueueProcessedBuffers(SourceId sourceId)
+{
+	ALint processed;
+	alCheckCall(alGetSourcei(sourceId, AL_BUFFERS_PROCESSED, &processed));
+	std::vector<BufferId> buffers(static_cast<size_t>(processed));
+	if (!buffers.empty())
+	{
+		alCheckCall(alSourceUnqueueBuffers(sourceId, processed, buffers.data()));
+	}
+	return buffers;
+}
+
 void AudioPlayer::DeleteBuffer(BufferId id)
 {
 	alCheckCall(alDeleteBuffers(1, &id));
@@ -156,6 +187,26 @@ void AudioPlayer::DeleteSource(SourceId id)
 	alCheckCall(alDeleteSources(1, &id));
 }
 
+void AudioPlayer::ResetSource(SourceId id, bool relative)
+{
+	alCheckCall(alSourceStop(id));
+	alCheckCall(alSourcei(id, AL_BUFFER, AL_NONE));
+	alCheckCall(alSourcei(id, AL_SOURCE_RELATIVE, relative));
+	alCheckCall(alSourcef(id, AL_PITCH, 1.f));
+}
+
+void AudioPlayer::SetOffset(SourceId id, float seconds)
+{
+	alCheckCall(alSourcef(id, AL_SEC_OFFSET, seconds));
+}
+
+float AudioPlayer::GetOffset(SourceId id) const
+{
+	ALfloat offset;
+	alCheckCall(alGetSourcef(id, AL_SEC_OFFSET, &offset));
+	return offset;
+}
+
 void AudioPlayer::UpdateSource(SourceId id, glm::vec3 pos, float volume, bool loop)
 {
 	alCheckCall(alSource3f(id, AL_POSITION, pos.z, pos.y, pos.x));
@@ -171,6 +222,40 @@ void AudioPlayer::UpdateSource(SourceId id, float volume, bool loop)
 	alCheckCall(alSourcef(id, AL_PITCH, 1.f));
 }
 
+void AudioPlayer::UpdateSources(const SourceBatch& batch)
+{
+	if (batch.ids.empty())
+	{
+		return;
+	}
+
+	// Mixing is deferred until every source in the batch was changed
+	const bool deferred = HasDeferredUpdates();
+	if (deferred)
+	{
+		_deferUpdates();
+	}
+	else
+	{
+		alcSuspendContext(_context.get());
+	}
+	for (size_t i = 0; i < batch.ids.size(); ++i)
+	{
+		const auto& pos = batch.positions[i];
+		alCheckCall(alSource3f(batch.ids[i], AL_POSITION, pos.z, pos.y, pos.x));
+		alCheckCall(alSourcef(batch.ids[i], AL_GAIN, batch.volumes[i] * _volume));
+		alCheckCall(alSourcei(batch.ids[i], AL_LOOPING, batch.loops[i]));
+	}
+	if (deferred)
+	{
+		_processUpdates();
+	}
+	else
+	{
+		alcProcessContext(_context.get());
+	}
+}
+
 float AudioPlayer::GetDuration(BufferId id)
 {
 	ALint sizeInBytes;
@@ -27,11 +27,17 @@ class AudioPlayer final: public AudioPlayerInterface
 	void Initialize() override;
 	void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const override;
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
+	void SetBufferData(BufferId id, ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
 	void QueueBuffer(SourceId sourceId, BufferId buffer) override;
+	std::vector<BufferId> UnqueueProcessedBuffers(SourceId sourceId) override;
 	void DeleteBuffer(BufferId id) override;
 	void DeleteSource(SourceId id) override;
+	void ResetSource(SourceId id, bool relative) override;
+	void SetOffset(SourceId id, float seconds) override;
+	[[nodiscard]] float GetOffset(SourceId id) const override;
 	void UpdateSource(SourceId id, glm::vec3 pos, float volume, bool loop) override;
 	void UpdateSource(SourceId id, float volume, bool loop) override;
+	void UpdateSources(const SourceBatch& batch) override;
 	float GetDuration(BufferId id) override;
 	SourceId CreateSource(float pitch, bool relative) override;
 	void PlaySource(SourceId id, glm::vec3 pos, float volume, bool loop) override;
@@ -42,6 +48,8 @@ class AudioPlayer final: public AudioPlayerInterface
 	[[nodiscard]] float GetVolume() const override;
 	[[nodiscard]] AudioStatus GetStatus(SourceId id) const override;
 	[[nodiscard]] float GetProgress(size_t sizeInBytes, SourceId sourceId) const override;
+	/// Whether source batches are applied at once with AL_SOFT_deferred_updates, known once initialized
+	[[nodiscard]] bool HasDeferredUpdates() const;
 
 private:
 	static void SetupLogging();
@@ -50,5 +58,8 @@ class AudioPlayer final: public AudioPlayerInterface
 	std::unique_ptr<ALCdevice, decltype(&DeleteDevice)> _device;
 	std::unique_ptr<ALCcontext, decltype(&DeleteContext)> _context;
 	float _volume {1.0f};
+	/// alDeferUpdatesSOFT and alProcessUpdatesSOFT, null without AL_SOFT_deferred_updates
+	void(AL_APIENTRY* _deferUpdates)() {nullptr};
+	void(AL_APIENTRY* _processUpdates)() {nullptr};
 };
 } // namespace openblack::audio
@@ -25,6 +25,31 @@ extern "C" {
 namespace openblack::audio
 {
 
+/// Parameters for several sources, one array per parameter, applied in one pass by UpdateSources
+struct SourceBatch
+{
+	std::vector<SourceId> ids;
+	std::vector<glm::vec3> positions;
+	std::vector<float> volumes;
+	std::vector<uint8_t> loops;
+
+	void Add(SourceId id, glm::vec3 position, float volume, bool loop)
+	{
+		ids.push_back(id);
+		positions.push_back(position);
+		volumes.push_back(volume);
+		loops.push_back(static_cast<uint8_t>(loop));
+	}
+
+	void Clear()
+	{
+		ids.clear();
+		positions.clear();
+		volumes.clear();
+		loops.clear();
+	}
+};
+
 class AudioPlayerInterface
 {
 public:
@@ -32,12 +57,23 @@ class AudioPlayerInterface
 	virtual void Initialize() = 0;
 	virtual void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const = 0;
 	[[nodiscard]] virtual BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
+	/// Replace the contents of a buffer which isn't queued on any source
+	virtual void SetBufferData(BufferId id, ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
 	virtual void QueueBuffer(SourceId sourceId, BufferId buffer) = 0;
+	/// Remove the buffers which finished playing from the front of the source's queue, in the order they were queued
+	[[nodiscard]] virtual std::vector<BufferId> UnqueueProcessedBuffers(SourceId sourceId) = 0;
 	virtual void DeleteBuffer(BufferId id) = 0;
 	[[nodiscard]] virtual SourceId CreateSource(float pitch, bool relative) = 0;
 	virtual void DeleteSource(SourceId id) = 0;
+	/// Stop a source and detach its buffers so it can be reused by another emitter
+	virtual void ResetSource(SourceId id, bool relative) = 0;
+	/// Position in the queued buffer in seconds, applied on the next play when the source isn't playing
+	virtual void SetOffset(SourceId id, float seconds) = 0;
+	[[nodiscard]] virtual float GetOffset(SourceId id) const = 0;
 	virtual void UpdateSource(SourceId id, glm::vec3 pos, float volume, bool loop) = 0;
 	virtual void UpdateSource(SourceId id, float volume, bool loop) = 0;
+	/// Update the sources in the batch together, without the mixer picking up some of the changes before the others
+	virtual void UpdateSources(const SourceBatch& batch) = 0;
 	[[nodiscard]] virtual float GetDuration(BufferId id) = 0;
 	virtual void PlaySource(SourceId id, glm::vec3 pos, float volume, bool loop) = 0;
 	virtual void PlaySource(SourceId id, float volume, bool loop) = 0;
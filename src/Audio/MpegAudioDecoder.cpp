@@ -27,10 +27,19 @@ extern "C" {
 
 using namespace openblack::audio;
 
+MpegAudioDecoder::~MpegAudioDecoder()
+{
+	if (_isOpen)
+	{
+		drmp3_uninit(&_mp3);
+	}
+}
+
 bool MpegAudioDecoder::Open(const std::vector<uint8_t>& buffer)
 {
 	const auto status = drmp3_init_memory(&_mp3, buffer.data(), buffer.size(), nullptr);
-	return static_cast<bool>(status);
+	_isOpen = static_cast<bool>(status);
+	return _isOpen;
 }
 
 void MpegAudioDecoder::Read(std::vector<int16_t>& buffer)
@@ -40,6 +49,16 @@ void MpegAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] const auto framesRead = drmp3_read_pcm_frames_s16(&_mp3, frameCount, buffer.data());
 }
 
+size_t MpegAudioDecoder::ReadFrames(std::span<int16_t> frames)
+{
+	return static_cast<size_t>(drmp3_read_pcm_frames_s16(&_mp3, frames.size() / _mp3.channels, frames.data()));
+}
+
+uint64_t MpegAudioDecoder::GetFrameCount()
+{
+	return drmp3_get_pcm_frame_count(&_mp3);
+}
+
 ChannelLayout MpegAudioDecoder::GetChannelLayout()
 {
 	switch (_mp3.channels)
@@ -19,12 +19,20 @@ namespace openblack::audio
 class MpegAudioDecoder final: public AudioDecoderInterface
 {
 public:
+	MpegAudioDecoder() = default;
+	~MpegAudioDecoder() override;
+	MpegAudioDecoder(const MpegAudioDecoder&) = delete;
+	MpegAudioDecoder& operator=(const MpegAudioDecoder&) = delete;
+
 	bool Open(const std::vector<uint8_t>& buffer) override;
 	void Read(std::vector<int16_t>& buffer) override;
+	size_t ReadFrames(std::span<int16_t> frames) override;
+	[[nodiscard]] uint64_t GetFrameCount() override;
 	[[nodiscard]] ChannelLayout GetChannelLayout() override;
 
 private:
 	drmp3 _mp3;
+	bool _isOpen {false};
 };
 
 } // namespace openblack::audio
@@ -0,0 +1,307 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MusicStream.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+
+#include <PackFile.h>
+
+#include "AudioPlayerInterface.h"
+#include "Common/TaskScheduler.h"
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+#include "MpegAudioDecoder.h"
+#include "WavAudioDecoder.h"
+
+using namespace openblack::audio;
+
+namespace
+{
+/// Music packs hold mp3 data, fall back on wav like the sound packs do
+std::unique_ptr<AudioDecoderInterface> OpenDecoder(const std::vector<uint8_t>& data)
+{
+	std::unique_ptr<AudioDecoderInterface> decoder = std::make_unique<MpegAudioDecoder>();
+	if (decoder->Open(data))
+	{
+		return decoder;
+	}
+	decoder = std::make_unique<WavAudioDecoder>();
+	if (decoder->Open(data))
+	{
+		return decoder;
+	}
+	return nullptr;
+}
+} // namespace
+
+struct MusicStream::State
+{
+	State(std::filesystem::path packPath, bool loop)
+	    : packPath(std::move(packPath))
+	    , loop(loop)
+	{
+	}
+
+	const std::filesystem::path packPath;
+	const bool loop;
+	std::atomic<bool> cancelled {false};
+
+	// Decode task only
+	pack::PackFile pack;
+	std::unique_ptr<AudioDecoderInterface> decoder;
+	size_t chunk {0};
+	bool counted {false};
+
+	// Written by the decode task before `opened` is set and only read afterwards
+	pack::AudioBankSampleHeader header {};
+	ChannelLayout channelLayout {ChannelLayout::Stereo};
+	std::atomic<uint64_t> frameCount {0};
+
+	std::mutex mutex;
+	bool opened {false};
+	bool failed {false};
+	bool endOfStream {false};
+	/// Decoded blocks waiting for a free buffer, in play order
+	std::deque<std::vector<int16_t>> blocks;
+	/// Blocks which were copied to a buffer, kept to decode into without allocating
+	std::vector<std::vector<int16_t>> spareBlocks;
+};
+
+MusicStream::MusicStream(AudioPlayerInterface& player, std::filesystem::path packPath, bool loop)
+    : _player(player)
+    , _state(std::make_shared<State>(std::move(packPath), loop))
+    , _source(player.CreateSource(1.0f, true))
+{
+	StartDecode();
+}
+
+MusicStream::~MusicStream()
+{
+	// A decode task which is still running holds on to the state and stops at the next block
+	_state->cancelled = true;
+	_player.StopSource(_source);
+	// Deleting the source releases the buffers queued on it
+	_player.DeleteSource(_source);
+	for (const auto id : _buffers)
+	{
+		_player.DeleteBuffer(id);
+	}
+}
+
+void MusicStream::StartDecode()
+{
+	_decodeTask = Locator::taskScheduler::value().Submit([state = _state]() { Decode(*state); });
+}
+
+void MusicStream::Decode(State& state)
+{
+	try
+	{
+		if (state.decoder == nullptr)
+		{
+			const auto result = state.pack.Open(Locator::filesystem::value().ReadAll(state.packPath));
+			const auto& headers = state.pack.GetAudioSampleHeaders();
+			const auto& data = state.pack.GetAudioSamplesData();
+			if (result == pack::PackResult::Success && !headers.empty() && !data.empty())
+			{
+				state.decoder = OpenDecoder(data.front());
+			}
+			if (state.decoder == nullptr)
+			{
+				const std::lock_guard lock(state.mutex);
+				state.failed = true;
+				return;
+			}
+			state.header = headers.front();
+			state.channelLayout = state.decoder->GetChannelLayout();
+
+			const std::lock_guard lock(state.mutex);
+			state.opened = true;
+		}
+
+		// A track is made of the pack's chunks played one after the other
+		const auto& data = state.pack.GetAudioSamplesData();
+		const size_t channels = state.channelLayout == ChannelLayout::Stereo ? 2 : 1;
+		while (!state.cancelled)
+		{
+			std::vector<int16_t> block;
+			{
+				const std::lock_guard lock(state.mutex);
+				if (state.endOfStream || state.blocks.size() >= k_BufferCount)
+				{
+					break;
+				}
+				if (!state.spareBlocks.empty())
+				{
+					block = std::move(state.spareBlocks.back());
+					state.spareBlocks.pop_back();
+				}
+			}
+
+			block.resize(k_FramesPerBuffer * channels);
+			size_t frames = 0;
+			bool endOfStream = false;
+			// So that looping over chunks which decode to nothing ends
+			size_t emptyChunks = 0;
+			while (frames < k_FramesPerBuffer && !endOfStream)
+			{
+				const auto read = state.decoder->ReadFrames(std::span(block).subspan(frames * channels));
+				frames += read;
+				if (frames == k_FramesPerBuffer)
+				{
+					break;
+				}
+
+				// The chunk ended, carry on with the next one, or with the first one again when looping
+				emptyChunks = read == 0 ? emptyChunks + 1 : 0;
+				auto next = state.chunk + 1;
+				if (next == data.size() && state.loop)
+				{
+					next = 0;
+				}
+				auto decoder = next < data.size() && emptyChunks <= data.size() ? OpenDecoder(data[next]) : nullptr;
+				endOfStream = decoder == nullptr;
+				if (decoder != nullptr)
+				{
+					state.decoder = std::move(decoder);
+					state.chunk = next;
+				}
+			}
+			block.resize(frames * channels);
+
+			const std::lock_guard lock(state.mutex);
+			if (!block.empty())
+			{
+				state.blocks.push_back(std::move(block));
+			}
+			state.endOfStream = endOfStream;
+		}
+
+		// The length needs a pass over the whole track, do it once the first blocks are out so it doesn't delay the start
+		if (!state.counted && !state.cancelled)
+		{
+			state.counted = true;
+			uint64_t frameCount = 0;
+			for (const auto& chunk : data)
+			{
+				if (auto decoder = OpenDecoder(chunk))
+				{
+					frameCount += decoder->GetFrameCount();
+				}
+			}
+			state.frameCount = frameCount;
+		}
+	}
+	catch (const std::exception&)
+	{
+		const std::lock_guard lock(state.mutex);
+		state.failed = true;
+	}
+}
+
+void MusicStream::Update()
+{
+	// Take back the buffers which finished playing
+	for (const auto id : _player.UnqueueProcessedBuffers(_source))
+	{
+		_freeBuffers.push_back(id);
+		_playedFrames += _queuedFrames.front();
+		_queuedFrames.pop_front();
+	}
+
+	std::vector<std::vector<int16_t>> blocks;
+	bool endOfStream;
+	size_t pendingBlocks;
+	{
+		const std::lock_guard lock(_state->mutex);
+		_failed = _state->failed;
+		endOfStream = _state->endOfStream;
+		const auto freeBuffers = _freeBuffers.size() + k_BufferCount - _buffers.size();
+		while (!_state->blocks.empty() && blocks.size() < freeBuffers)
+		{
+			blocks.emplace_back(std::move(_state->blocks.front()));
+			_state->blocks.pop_front();
+		}
+		pendingBlocks = _state->blocks.size();
+	}
+
+	if (!blocks.empty())
+	{
+		const auto layout = _state->channelLayout;
+		const auto sampleRate = static_cast<int>(_state->header.sampleRate);
+		const size_t channels = layout == ChannelLayout::Stereo ? 2 : 1;
+		for (const auto& block : blocks)
+		{
+			BufferId id;
+			if (!_freeBuffers.empty())
+			{
+				id = _freeBuffers.back();
+				_freeBuffers.pop_back();
+				_player.SetBufferData(id, layout, block, sampleRate);
+			}
+			else
+			{
+				id = _player.CreateBuffer(layout, block, sampleRate);
+				_buffers.push_back(id);
+			}
+			_player.QueueBuffer(_source, id);
+			_queuedFrames.push_back(block.size() / channels);
+		}
+		_ready = true;
+
+		const std::lock_guard lock(_state->mutex);
+		for (auto& block : blocks)
+		{
+			_state->spareBlocks.emplace_back(std::move(block));
+		}
+	}
+
+	_finished = endOfStream && pendingBlocks == 0 && _queuedFrames.empty();
+
+	const auto decoding =
+	    _decodeTask.valid() && _decodeTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	if (!_failed && !endOfStream && !decoding && pendingBlocks < k_BufferCount)
+	{
+		StartDecode();
+	}
+}
+
+bool MusicStream::HasRunDry() const
+{
+	return _ready && !_finished && !_queuedFrames.empty() && _player.GetStatus(_source) == AudioStatus::Stopped;
+}
+
+const openblack::pack::AudioBankSampleHeader& MusicStream::GetHeader() const
+{
+	return _state->header;
+}
+
+float MusicStream::GetDuration() const
+{
+	const auto frameCount = _state->frameCount.load();
+	if (!_ready || frameCount == 0 || _state->header.sampleRate == 0)
+	{
+		return -1.0f;
+	}
+	return static_cast<float>(frameCount) / static_cast<float>(_state->header.sampleRate);
+}
+
+float MusicStream::GetProgress() const
+{
+	const auto frameCount = _state->frameCount.load();
+	if (frameCount == 0)
+	{
+		return 0.0f;
+	}
+	return static_cast<float>(_playedFrames % frameCount) / static_cast<float>(frameCount);
+}
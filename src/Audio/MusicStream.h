@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "Sound.h"
+
+namespace openblack::pack
+{
+struct AudioBankSampleHeader;
+}
+
+namespace openblack::audio
+{
+class AudioPlayerInterface;
+
+/// Plays a music pack by decoding it a little at a time on the task scheduler into a ring of small buffers, which are
+/// queued on the source and refilled as they finish playing. Starting a track doesn't open or decode the pack on the main
+/// thread and only a few seconds of PCM are held at any time.
+class MusicStream
+{
+public:
+	/// Number of buffers queued on the source, as many decoded blocks may wait for one of them to be free
+	static constexpr size_t k_BufferCount = 4;
+	/// About a third of a second at 44.1 kHz
+	static constexpr size_t k_FramesPerBuffer = 16384;
+
+	MusicStream(AudioPlayerInterface& player, std::filesystem::path packPath, bool loop);
+	~MusicStream();
+
+	MusicStream(const MusicStream&) = delete;
+	MusicStream& operator=(const MusicStream&) = delete;
+
+	/// Queue the decoded blocks in the buffers which finished playing and decode more in the background. Main thread only.
+	void Update();
+
+	[[nodiscard]] SourceId GetSource() const { return _source; }
+	/// Whether the pack was opened and the first blocks were queued, so the source can start playing
+	[[nodiscard]] bool IsReady() const { return _ready; }
+	[[nodiscard]] bool HasFailed() const { return _failed; }
+	/// Whether a track which doesn't loop played to its end
+	[[nodiscard]] bool IsFinished() const { return _finished; }
+	/// Whether the source stopped because decoding fell behind and needs to be played again
+	[[nodiscard]] bool HasRunDry() const;
+	/// Header of the track, valid once the stream is ready
+	[[nodiscard]] const pack::AudioBankSampleHeader& GetHeader() const;
+	/// Length of the track in seconds, negative until it was worked out
+	[[nodiscard]] float GetDuration() const;
+	/// Position in the track between 0 and 1, to the nearest buffer
+	[[nodiscard]] float GetProgress() const;
+
+private:
+	struct State;
+
+	/// Runs on a worker with the only reference to the decoder, at most one at a time
+	static void Decode(State& state);
+	void StartDecode();
+
+	AudioPlayerInterface& _player;
+	std::shared_ptr<State> _state;
+	std::future<void> _decodeTask;
+	SourceId _source;
+	/// Every buffer created for the source, some of which may be waiting for data in _freeBuffers
+	std::vector<BufferId> _buffers;
+	std::vector<BufferId> _freeBuffers;
+	/// Frames in each of the buffers queued on the source, in the order they play
+	std::deque<size_t> _queuedFrames;
+	uint64_t _playedFrames {0};
+	bool _ready {false};
+	bool _failed {false};
+	bool _finished {false};
+};
+
+} // namespace openblack::audio
@@ -228,9 +228,11 @@ class Sound
 	int pitchDeviation;
 	ChannelLayout channelLayout;
 	PlayType playType;
-	BufferId bufferId;
-	float duration;
+	/// Zero while the sound isn't resident in the SoundCache
+	BufferId bufferId {0};
+	/// Negative while the sound isn't resident
+	float duration {-1.0f};
 	std::vector<std::vector<uint8_t>> buffer;
-	size_t sizeInBytes;
+	size_t sizeInBytes {0};
 };
 } // namespace openblack::audio
@@ -0,0 +1,240 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SoundCache.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include "AudioPlayerInterface.h"
+#include "Common/TaskScheduler.h"
+#include "EngineConfig.h"
+#include "Locator.h"
+#include "MpegAudioDecoder.h"
+#include "Resources/ResourcesInterface.h"
+#include "WavAudioDecoder.h"
+
+using namespace openblack::audio;
+
+namespace
+{
+/// 16-bit PCM at the sample rates of the game's sound banks is about eleven times larger than their MP3 data
+constexpr size_t k_MpegExpansion = 11;
+} // namespace
+
+SoundCache::SoundCache(AudioPlayerInterface& player)
+    : _player(player)
+{
+}
+
+SoundCache::~SoundCache()
+{
+	Clear();
+}
+
+SoundCache::Decoded SoundCache::Decode(const Sound& sound)
+{
+	Decoded result;
+	result.channelLayout = sound.channelLayout;
+	std::vector<int16_t> decoded;
+	for (const auto& buffer : sound.buffer)
+	{
+		bool success;
+		decoded.clear();
+		{
+			auto decoder = audio::MpegAudioDecoder();
+			success = decoder.Open(buffer);
+			if (success)
+			{
+				decoder.Read(decoded);
+				result.channelLayout = decoder.GetChannelLayout();
+			}
+		}
+		if (!success)
+		{
+			auto decoder = audio::WavAudioDecoder();
+			success = decoder.Open(buffer);
+			if (success)
+			{
+				decoder.Read(decoded);
+				result.channelLayout = decoder.GetChannelLayout();
+			}
+		}
+		if (success)
+		{
+			result.samples.insert(result.samples.end(), decoded.begin(), decoded.end());
+		}
+		else
+		{
+			++result.failedChunks;
+		}
+	}
+	return result;
+}
+
+size_t SoundCache::EstimateDecodedSize(const Sound& sound)
+{
+	size_t size = 0;
+	for (const auto& buffer : sound.buffer)
+	{
+		// Wave chunks carry their length in the header, MP3 ones would need a pass over every frame
+		auto decoder = audio::WavAudioDecoder();
+		if (decoder.Open(buffer))
+		{
+			const auto channels = decoder.GetChannelLayout() == ChannelLayout::Stereo ? 2 : 1;
+			size += static_cast<size_t>(decoder.GetFrameCount()) * channels * sizeof(int16_t);
+		}
+		else
+		{
+			size += buffer.size() * k_MpegExpansion;
+		}
+	}
+	return size;
+}
+
+bool SoundCache::Request(entt::id_type id)
+{
+	auto& entry = _entries[id];
+	if (entry.resident)
+	{
+		_lru.splice(_lru.begin(), _lru, entry.lru);
+		return true;
+	}
+	if (!entry.task.valid())
+	{
+		// The task shares ownership so the compressed data outlives it even if the sound is erased in the meantime
+		const std::shared_ptr<const Sound> sound = Locator::resources::value().GetSounds().Handle(id).handle();
+		entry.pendingBytes = EstimateDecodedSize(*sound);
+		_pendingBytes += entry.pendingBytes;
+		entry.task = Locator::taskScheduler::value().Submit([sound]() { return Decode(*sound); });
+		++_decodingCount;
+	}
+	return false;
+}
+
+void SoundCache::Prefetch(entt::id_type id)
+{
+	const auto entry = _entries.find(id);
+	if (entry != _entries.end() && (entry->second.resident || entry->second.task.valid()))
+	{
+		Request(id);
+		return;
+	}
+	// Sounds still decoding count toward the budget, otherwise a whole group would be decoded only to be trimmed again
+	const auto sound = Locator::resources::value().GetSounds().Handle(id);
+	if (_residentBytes + _pendingBytes + EstimateDecodedSize(*sound) > Locator::config::value().soundCacheBudget)
+	{
+		return;
+	}
+	Request(id);
+}
+
+void SoundCache::Retain(entt::id_type id)
+{
+	++_entries[id].users;
+}
+
+void SoundCache::Release(entt::id_type id)
+{
+	auto entry = _entries.find(id);
+	assert(entry != _entries.end() && entry->second.users > 0);
+	--entry->second.users;
+}
+
+void SoundCache::Update()
+{
+	auto& sounds = Locator::resources::value().GetSounds();
+	for (auto& [id, entry] : _entries)
+	{
+		if (!entry.task.valid() || entry.task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			continue;
+		}
+
+		const auto decoded = entry.task.get();
+		--_decodingCount;
+		_pendingBytes -= entry.pendingBytes;
+		entry.pendingBytes = 0;
+		if (!sounds.Contains(id))
+		{
+			continue;
+		}
+		auto sound = sounds.Handle(id);
+		if (decoded.failedChunks > 0)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode {} of {} chunks of sound {}", decoded.failedChunks,
+			                    sound->buffer.size(), sound->name);
+		}
+
+		entry.bufferId = _player.CreateBuffer(decoded.channelLayout, decoded.samples, sound->sampleRate);
+		entry.sizeInBytes = decoded.samples.size() * sizeof(decoded.samples[0]);
+		entry.resident = true;
+		_lru.push_front(id);
+		entry.lru = _lru.begin();
+		_residentBytes += entry.sizeInBytes;
+
+		sound->channelLayout = decoded.channelLayout;
+		sound->bufferId = entry.bufferId;
+		sound->duration = _player.GetDuration(entry.bufferId);
+		sound->sizeInBytes = entry.sizeInBytes;
+	}
+}
+
+void SoundCache::Trim()
+{
+	const auto budget = Locator::config::value().soundCacheBudget;
+	auto& sounds = Locator::resources::value().GetSounds();
+	for (auto it = _lru.end(); it != _lru.begin() && _residentBytes > budget;)
+	{
+		--it;
+		const auto entry = _entries.find(*it);
+		if (entry->second.users > 0)
+		{
+			continue;
+		}
+
+		_player.DeleteBuffer(entry->second.bufferId);
+		_residentBytes -= entry->second.sizeInBytes;
+		if (sounds.Contains(*it))
+		{
+			auto sound = sounds.Handle(*it);
+			sound->bufferId = 0;
+			sound->duration = -1.0f;
+			sound->sizeInBytes = 0;
+		}
+		_entries.erase(entry);
+		it = _lru.erase(it);
+	}
+}
+
+void SoundCache::Clear()
+{
+	for (const auto id : _lru)
+	{
+		_player.DeleteBuffer(_entries[id].bufferId);
+	}
+	_entries.clear();
+	_lru.clear();
+	_residentBytes = 0;
+	_pendingBytes = 0;
+	_decodingCount = 0;
+}
+
+SoundCacheStats SoundCache::GetStats() const
+{
+	const auto retained =
+	    std::count_if(_entries.cbegin(), _entries.cend(), [](const auto& entry) { return entry.second.users > 0; });
+	return {_residentBytes, Locator::config::value().soundCacheBudget, _lru.size(), _decodingCount, _pendingBytes,
+	        static_cast<size_t>(retained)};
+}
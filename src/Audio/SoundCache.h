@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <future>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/fwd.hpp>
+
+#include "Sound.h"
+
+namespace openblack::audio
+{
+class AudioPlayerInterface;
+
+struct SoundCacheStats
+{
+	size_t residentBytes;
+	size_t budgetBytes;
+	size_t residentCount;
+	size_t decodingCount;
+	/// Estimated size of the sounds still decoding, which counts toward the budget ahead of them becoming resident
+	size_t pendingBytes;
+	/// Sounds with an emitter using them, which can't be evicted
+	size_t retainedCount;
+};
+
+/// Decodes sound effects on the task scheduler and keeps their PCM in buffers until the total goes over
+/// EngineConfig::soundCacheBudget, at which point the least recently requested sounds which no emitter uses are evicted.
+/// Evicted sounds keep their compressed data and are decoded again the next time they are requested.
+class SoundCache
+{
+public:
+	struct Decoded
+	{
+		std::vector<int16_t> samples;
+		ChannelLayout channelLayout {ChannelLayout::Mono};
+		size_t failedChunks {0};
+	};
+
+	explicit SoundCache(AudioPlayerInterface& player);
+	~SoundCache();
+
+	SoundCache(const SoundCache&) = delete;
+	SoundCache& operator=(const SoundCache&) = delete;
+
+	/// Decode the sound's chunks one after the other, safe to call from any thread
+	static Decoded Decode(const Sound& sound);
+	/// Size of the sound's PCM once decoded, exact for wave chunks and estimated from the compressed size for MP3 ones
+	static size_t EstimateDecodedSize(const Sound& sound);
+
+	/// Start decoding the sound unless it is resident or already decoding. Returns whether its buffer can be used now.
+	bool Request(entt::id_type id);
+	/// Decode the sound ahead of it being played, unless the cache is full and it would only push out other sounds
+	void Prefetch(entt::id_type id);
+	/// The sound's buffer is queued on a source and can't be evicted until every user released it
+	void Retain(entt::id_type id);
+	void Release(entt::id_type id);
+	/// Create the buffers of the sounds which finished decoding. Main thread only.
+	void Update();
+	/// Evict the least recently requested sounds until the cache fits in the budget
+	void Trim();
+	/// Delete every buffer on shutdown, sounds which are still decoding are dropped
+	void Clear();
+
+	[[nodiscard]] SoundCacheStats GetStats() const;
+
+private:
+	struct Entry
+	{
+		std::future<Decoded> task;
+		bool resident {false};
+		BufferId bufferId {0};
+		size_t sizeInBytes {0};
+		/// Bytes reserved in _pendingBytes while the sound decodes
+		size_t pendingBytes {0};
+		uint32_t users {0};
+		std::list<entt::id_type>::iterator lru;
+	};
+
+	AudioPlayerInterface& _player;
+	std::unordered_map<entt::id_type, Entry> _entries;
+	/// Resident sounds, most recently requested first
+	std::list<entt::id_type> _lru;
+	size_t _residentBytes {0};
+	size_t _pendingBytes {0};
+	size_t _decodingCount {0};
+};
+
+} // namespace openblack::audio
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "VoiceManager.h"
+
+#include <cassert>
+
+#include <algorithm>
+
+#include "AudioPlayerInterface.h"
+#include "EngineConfig.h"
+#include "Locator.h"
+
+using namespace openblack::audio;
+
+VoiceManager::VoiceManager(AudioPlayerInterface& player)
+    : _player(player)
+{
+}
+
+VoiceManager::~VoiceManager()
+{
+	for (const auto id : _pool)
+	{
+		_player.DeleteSource(id);
+	}
+}
+
+float VoiceManager::GetGain(float volume, float distance, float outerRadius)
+{
+	if (outerRadius > 0.0f && distance > outerRadius)
+	{
+		return 0.0f;
+	}
+	// AL_INVERSE_DISTANCE_CLAMPED with the default reference distance and rolloff of 1
+	return volume / std::max(distance, 1.0f);
+}
+
+size_t VoiceManager::Prioritise(std::vector<Candidate>& candidates) const
+{
+	const auto voices = std::min<size_t>(candidates.size(), Locator::config::value().audioMaxVoices);
+	std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(voices), candidates.end(),
+	                  [](const Candidate& lhs, const Candidate& rhs) {
+		                  return lhs.priority != rhs.priority ? lhs.priority > rhs.priority : lhs.gain > rhs.gain;
+	                  });
+	return voices;
+}
+
+bool VoiceManager::HasFreeVoice() const
+{
+	return _realVoices < Locator::config::value().audioMaxVoices;
+}
+
+SourceId VoiceManager::Acquire(bool relative)
+{
+	++_realVoices;
+	if (_pool.empty())
+	{
+		return _player.CreateSource(1.0f, relative);
+	}
+	const auto id = _pool.back();
+	_pool.pop_back();
+	_player.ResetSource(id, relative);
+	return id;
+}
+
+void VoiceManager::Release(SourceId id)
+{
+	assert(_realVoices > 0);
+	--_realVoices;
+	// Only keep as many sources as could be in use at once, the rest were freed by lowering the limit
+	if (_pool.size() + _realVoices >= Locator::config::value().audioMaxVoices)
+	{
+		_player.DeleteSource(id);
+		return;
+	}
+	// Detach the buffer right away so the sound cache can evict it
+	_player.ResetSource(id, false);
+	_pool.push_back(id);
+}
+
+VoiceStats VoiceManager::GetStats() const
+{
+	return {_realVoices, Locator::config::value().audioMaxVoices, _pool.size()};
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+
+#include "Sound.h"
+
+namespace openblack::audio
+{
+class AudioPlayerInterface;
+
+struct VoiceStats
+{
+	size_t realVoices;
+	size_t maxVoices;
+	size_t pooledSources;
+};
+
+/// Hands out at most EngineConfig::audioMaxVoices sources to the emitters which matter most. The other emitters are
+/// virtual: they keep time without a source and get one back when they are among the most important again. Sources are
+/// recycled through a pool rather than created and deleted with each emitter.
+class VoiceManager
+{
+public:
+	/// Source id of an emitter which is virtual, OpenAL never names a source 0
+	static constexpr SourceId k_NoSource = 0;
+	/// Below this gain an emitter can't be heard and isn't worth a source
+	static constexpr float k_InaudibleGain = 0.001f;
+
+	struct Candidate
+	{
+		entt::entity entity;
+		/// Sound::priority, higher comes first
+		int priority;
+		/// Gain the emitter would be heard at, breaks ties between emitters of the same priority
+		float gain;
+	};
+
+	explicit VoiceManager(AudioPlayerInterface& player);
+	~VoiceManager();
+
+	VoiceManager(const VoiceManager&) = delete;
+	VoiceManager& operator=(const VoiceManager&) = delete;
+
+	/// Gain of an emitter at `distance` from the listener, following OpenAL's inverse distance model and cut off beyond
+	/// the emitter's outer radius when it has one
+	[[nodiscard]] static float GetGain(float volume, float distance, float outerRadius);
+
+	/// Order the candidates by importance and return how many of the first ones should have a real voice
+	[[nodiscard]] size_t Prioritise(std::vector<Candidate>& candidates) const;
+	[[nodiscard]] bool HasFreeVoice() const;
+	/// Take a source from the pool, or create one if the pool is empty
+	[[nodiscard]] SourceId Acquire(bool relative);
+	/// Stop the source, detach its buffers and put it back in the pool
+	void Release(SourceId id);
+
+	[[nodiscard]] VoiceStats GetStats() const;
+
+private:
+	AudioPlayerInterface& _player;
+	std::vector<SourceId> _pool;
+	size_t _realVoices {0};
+};
+
+} // namespace openblack::audio
@@ -18,10 +18,19 @@ extern "C" {
 
 using namespace openblack::audio;
 
+WavAudioDecoder::~WavAudioDecoder()
+{
+	if (_isOpen)
+	{
+		drwav_uninit(&_wav);
+	}
+}
+
 bool WavAudioDecoder::Open(const std::vector<uint8_t>& buffer)
 {
 	const auto status = drwav_init_memory(&_wav, buffer.data(), buffer.size(), nullptr);
-	return static_cast<bool>(status);
+	_isOpen = static_cast<bool>(status);
+	return _isOpen;
 }
 
 void WavAudioDecoder::Read(std::vector<int16_t>& buffer)
@@ -32,6 +41,18 @@ void WavAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] auto framesRead = drwav_read_pcm_frames_s16(&_wav, frameCount, buffer.data());
 }
 
+size_t WavAudioDecoder::ReadFrames(std::span<int16_t> frames)
+{
+	return static_cast<size_t>(drwav_read_pcm_frames_s16(&_wav, frames.size() / _wav.channels, frames.data()));
+}
+
+uint64_t WavAudioDecoder::GetFrameCount()
+{
+	drwav_uint64 frameCount;
+	drwav_get_length_in_pcm_frames(&_wav, &frameCount);
+	return frameCount;
+}
+
 ChannelLayout WavAudioDecoder::GetChannelLayout()
 {
 	switch (_wav.channels)
@@ -19,12 +19,20 @@ namespace openblack::audio
 class WavAudioDecoder final: public AudioDecoderInterface
 {
 public:
+	WavAudioDecoder() = default;
+	~WavAudioDecoder() override;
+	WavAudioDecoder(const WavAudioDecoder&) = delete;
+	WavAudioDecoder& operator=(const WavAudioDecoder&) = delete;
+
 	bool Open(const std::vector<uint8_t>& buffer) override;
 	void Read(std::vector<int16_t>& buffer) override;
+	size_t ReadFrames(std::span<int16_t> frames) override;
+	[[nodiscard]] uint64_t GetFrameCount() override;
 	[[nodiscard]] ChannelLayout GetChannelLayout() override;
 
 private:
 	drwav _wav;
+	bool _isOpen {false};
 };
 
 } // namespace openblack::audio
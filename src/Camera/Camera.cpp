@@ -9,14 +9,18 @@
 
 #include "Camera.h"
 
+#include <cassert>
+
+#include <vector>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/intersect.hpp>
+#include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/vec_swizzle.hpp>
 
 #include "3D/LandIslandInterface.h"
 #include "ECS/Registry.h"
-#include "ECS/Systems/DynamicsSystemInterface.h"
 #include "Input/GameActionMapInterface.h"
 #include "Locator.h"
 #include "ReflectionXZCamera.h"
@@ -78,26 +82,52 @@ std::optional<ecs::components::Transform> Camera::RaycastMouseToLand(bool includ
 std::optional<ecs::components::Transform> Camera::RaycastScreenCoordToLand(glm::vec2 screenCoord, bool includeWater,
                                                                            Interpolation interpolation) const
 {
-	// get the hit by raycasting to the land down via the pixel coordinate
-	ecs::components::Transform intersectionTransform;
-	float intersectDistance = 0.0f;
-	glm::vec3 rayOrigin;
-	glm::vec3 rayDirection;
-	DeprojectScreenToWorld(screenCoord, rayOrigin, rayDirection, interpolation);
-	const auto& dynamicsSystem = Locator::dynamicsSystem::value();
-	if (auto hit = dynamicsSystem.RayCastClosestHit(rayOrigin, rayDirection, 1e10f))
+	std::optional<ecs::components::Transform> hit;
+	RaycastScreenCoordsToLand({&screenCoord, 1}, {&hit, 1}, includeWater, interpolation);
+	return hit;
+}
+
+void Camera::RaycastScreenCoordsToLand(std::span<const glm::vec2> screenCoords,
+                                       std::span<std::optional<ecs::components::Transform>> hits, bool includeWater,
+                                       Interpolation interpolation) const
+{
+	assert(screenCoords.size() == hits.size());
+
+	// get the hits by raycasting to the land down via the pixel coordinates, all rays are marched together
+	std::vector<LandRay> rays(screenCoords.size());
+	for (size_t i = 0; i < screenCoords.size(); ++i)
 	{
-		intersectionTransform = hit->first;
-		return std::make_optional(intersectionTransform);
+		DeprojectScreenToWorld(screenCoords[i], rays[i].origin, rays[i].direction, interpolation);
+		rays[i].tMax = 1e10f;
 	}
-	if (includeWater && glm::intersectRayPlane(rayOrigin, rayDirection, glm::vec3(0.0f, 0.0f, 0.0f),
-	                                           glm::vec3(0.0f, 1.0f, 0.0f), intersectDistance))
+	std::vector<std::optional<LandRayHit>> landHits(rays.size());
+	Locator::terrainSystem::value().RayCast(rays, landHits);
+
+	const auto up = glm::vec3(0.0f, 1.0f, 0.0f);
+	for (size_t i = 0; i < rays.size(); ++i)
 	{
-		intersectionTransform.position = rayOrigin + rayDirection * intersectDistance;
-		intersectionTransform.rotation = glm::mat3(1.0f);
-		return std::make_optional(intersectionTransform);
+		ecs::components::Transform intersectionTransform {glm::vec3(0.0f), glm::mat3(1.0f), glm::vec3(1.0f)};
+		float intersectDistance = 0.0f;
+		if (landHits[i].has_value())
+		{
+			intersectionTransform.position = landHits[i]->position;
+			if (glm::abs(landHits[i]->normal) != up)
+			{
+				intersectionTransform.rotation = glm::orientation(landHits[i]->normal, up);
+			}
+			hits[i] = intersectionTransform;
+		}
+		else if (includeWater && glm::intersectRayPlane(rays[i].origin, rays[i].direction, glm::vec3(0.0f, 0.0f, 0.0f), up,
+		                                                intersectDistance))
+		{
+			intersectionTransform.position = rays[i].origin + rays[i].direction * intersectDistance;
+			hits[i] = intersectionTransform;
+		}
+		else
+		{
+			hits[i] = std::nullopt;
+		}
 	}
-	return std::nullopt;
 }
 
 Camera& Camera::SetProjectionMatrixPerspective(float xFov, float aspect, float nearClip, float farClip)
@@ -12,6 +12,7 @@
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <span>
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
@@ -54,6 +55,10 @@ class Camera
 	[[nodiscard]] std::optional<ecs::components::Transform>
 	RaycastScreenCoordToLand(glm::vec2 screenCoord, bool includeWater,
 	                         Interpolation interpolation = Camera::Interpolation::Current) const;
+	/// Batched RaycastScreenCoordToLand, hits must be as long as screenCoords
+	void RaycastScreenCoordsToLand(std::span<const glm::vec2> screenCoords,
+	                               std::span<std::optional<ecs::components::Transform>> hits, bool includeWater,
+	                               Interpolation interpolation = Camera::Interpolation::Current) const;
 
 	[[nodiscard]] glm::vec3 GetOrigin(Interpolation interpolation = Interpolation::Current) const;
 	[[nodiscard]] glm::vec3 GetOriginVelocity(Interpolation interpolation = Interpolation::Current) const;
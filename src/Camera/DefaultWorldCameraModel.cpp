@@ -9,7 +9,9 @@
 
 #include "DefaultWorldCameraModel.h"
 
+#include <array>
 #include <numeric>
+#include <optional>
 #include <ranges>
 
 #include <glm/gtc/constants.hpp>
@@ -154,14 +156,19 @@ void DefaultWorldCameraModel::TiltZoom(glm::vec3& eulerAngles, float scalingFact
 
 float DefaultWorldCameraModel::GetVerticalLineInverseDistanceWeighingRayCast(const Camera& camera) const
 {
+	std::array<glm::vec2, 0x10> coords;
+	for (size_t i = 0; i < coords.size(); ++i)
+	{
+		coords.at(i) = glm::vec2(0.5f, i / 16.0f);
+	}
+	std::array<std::optional<ecs::components::Transform>, 0x10> hits;
+	camera.RaycastScreenCoordsToLand(coords, hits, false, Camera::Interpolation::Target);
+
 	std::vector<float> inverseHitDistances;
 	inverseHitDistances.reserve(0x10);
-
-	for (int i = 0; i < 0x10; ++i)
+	for (const auto& hit : hits)
 	{
-		const glm::vec2 coord = glm::vec2(0.5f, i / 16.0f);
-
-		if (const auto hit = camera.RaycastScreenCoordToLand(coord, false, Camera::Interpolation::Target))
+		if (hit.has_value())
 		{
 			inverseHitDistances.push_back(1.0f / glm::length(hit->position - _targetOrigin));
 		}
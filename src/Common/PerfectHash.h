@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace openblack
+{
+
+/// FNV-1a over a string, salted with a seed and finished with a murmur3 avalanche so the low bits can be used as an index
+[[nodiscard]] constexpr uint32_t SeededStringHash(std::string_view str, uint32_t seed) noexcept
+{
+	uint32_t hash = 0x811C9DC5u ^ (seed * 0x01000193u);
+	for (const char c : str)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x01000193u;
+	}
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+/// Perfect hash table built at compile time for a fixed set of unique keys (hash and displace).
+/// Every key is first hashed into a bucket. Buckets are then placed from largest to smallest, each one searching for a seed
+/// which lands all of its keys on free slots. A lookup is therefore two hashes and one string comparison.
+template <size_t N>
+class PerfectHash
+{
+public:
+	static constexpr size_t k_SlotCount = std::bit_ceil(N * 2);
+	static constexpr size_t k_BucketCount = std::max<size_t>(N / 2, 1);
+	static constexpr uint16_t k_EmptySlot = 0xFFFF;
+	static constexpr uint32_t k_MaxSeed = 0x10000;
+
+	static_assert(N < k_EmptySlot, "Too many keys for the slot index type");
+
+	explicit constexpr PerfectHash(const std::array<std::string_view, N>& keys)
+	    : _keys(keys)
+	{
+		std::array<size_t, N> bucketOf {};
+		std::array<size_t, k_BucketCount> bucketSizes {};
+		for (size_t i = 0; i < N; ++i)
+		{
+			bucketOf.at(i) = SeededStringHash(_keys.at(i), 0) % k_BucketCount;
+			++bucketSizes.at(bucketOf.at(i));
+		}
+
+		std::array<size_t, k_BucketCount> order {};
+		for (size_t i = 0; i < k_BucketCount; ++i)
+		{
+			order.at(i) = i;
+		}
+		std::sort(order.begin(), order.end(),
+		          [&bucketSizes](size_t a, size_t b) { return bucketSizes.at(a) > bucketSizes.at(b); });
+
+		_slots.fill(k_EmptySlot);
+		for (const auto bucket : order)
+		{
+			if (bucketSizes.at(bucket) == 0)
+			{
+				break;
+			}
+
+			bool placed = false;
+			for (uint32_t seed = 1; !placed && seed < k_MaxSeed; ++seed)
+			{
+				std::array<size_t, N> candidates {};
+				size_t candidateCount = 0;
+				placed = true;
+				for (size_t i = 0; placed && i < N; ++i)
+				{
+					if (bucketOf.at(i) != bucket)
+					{
+						continue;
+					}
+					const auto slot = SeededStringHash(_keys.at(i), seed) % k_SlotCount;
+					const auto end = candidates.begin() + static_cast<std::ptrdiff_t>(candidateCount);
+					if (_slots.at(slot) != k_EmptySlot || std::find(candidates.begin(), end, slot) != end)
+					{
+						placed = false;
+					}
+					candidates.at(candidateCount++) = slot;
+				}
+
+				if (placed)
+				{
+					_seeds.at(bucket) = seed;
+					for (size_t i = 0, c = 0; i < N; ++i)
+					{
+						if (bucketOf.at(i) == bucket)
+						{
+							_slots.at(candidates.at(c++)) = static_cast<uint16_t>(i);
+						}
+					}
+				}
+			}
+
+			if (!placed)
+			{
+				throw std::logic_error("Could not build a perfect hash for the given keys, are they unique?");
+			}
+		}
+	}
+
+	/// Get the index of key in the array given at construction
+	[[nodiscard]] constexpr std::optional<size_t> Find(std::string_view key) const noexcept
+	{
+		const auto bucket = SeededStringHash(key, 0) % k_BucketCount;
+		const auto slot = SeededStringHash(key, _seeds.at(bucket)) % k_SlotCount;
+		const auto index = _slots.at(slot);
+		if (index == k_EmptySlot || _keys.at(index) != key)
+		{
+			return std::nullopt;
+		}
+		return index;
+	}
+
+private:
+	std::array<std::string_view, N> _keys;
+	std::array<uint32_t, k_BucketCount> _seeds {};
+	std::array<uint16_t, k_SlotCount> _slots {};
+};
+
+} // namespace openblack
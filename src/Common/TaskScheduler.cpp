@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace openblack;
+
+namespace
+{
+/// Chunks handed out per thread, a few more than one so uneven chunks still balance
+constexpr size_t k_ChunksPerThread = 4;
+
+struct ParallelForState
+{
+	const std::function<void(size_t, size_t)>* func;
+	size_t begin;
+	size_t end;
+	size_t chunkSize;
+	size_t chunkCount;
+	std::atomic<size_t> nextChunk {0};
+	std::atomic<size_t> doneChunks {0};
+	std::mutex mutex;
+	std::condition_variable done;
+	std::exception_ptr error;
+};
+
+void RunChunks(ParallelForState& state)
+{
+	for (auto chunk = state.nextChunk++; chunk < state.chunkCount; chunk = state.nextChunk++)
+	{
+		const auto chunkBegin = state.begin + chunk * state.chunkSize;
+		const auto chunkEnd = std::min(chunkBegin + state.chunkSize, state.end);
+		try
+		{
+			(*state.func)(chunkBegin, chunkEnd);
+		}
+		catch (...)
+		{
+			const std::lock_guard lock(state.mutex);
+			if (!state.error)
+			{
+				state.error = std::current_exception();
+			}
+		}
+
+		if (++state.doneChunks == state.chunkCount)
+		{
+			const std::lock_guard lock(state.mutex);
+			state.done.notify_all();
+		}
+	}
+}
+} // namespace
+
+uint32_t TaskScheduler::DefaultWorkerCount()
+{
+	return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+}
+
+TaskScheduler::TaskScheduler(uint32_t workerCount)
+{
+	_workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		_workers.emplace_back(&TaskScheduler::WorkerLoop, this);
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	{
+		const std::lock_guard lock(_mutex);
+		_stopping = true;
+	}
+	_condition.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+void TaskScheduler::ParallelFor(size_t begin, size_t end, size_t grainSize,
+                                const std::function<void(size_t, size_t)>& func)
+{
+	if (begin >= end)
+	{
+		return;
+	}
+
+	const auto count = end - begin;
+	const auto threadCount = static_cast<size_t>(GetThreadCount());
+	const auto chunkSize = std::max({grainSize, size_t {1}, (count + threadCount * k_ChunksPerThread - 1) /
+	                                                             (threadCount * k_ChunksPerThread)});
+	const auto chunkCount = (count + chunkSize - 1) / chunkSize;
+	if (chunkCount == 1 || _workers.empty())
+	{
+		func(begin, end);
+		return;
+	}
+
+	auto state = std::make_shared<ParallelForState>();
+	state->func = &func;
+	state->begin = begin;
+	state->end = end;
+	state->chunkSize = chunkSize;
+	state->chunkCount = chunkCount;
+
+	// Helpers which start after all chunks were taken return straight away, so nested calls can't wait on each other
+	const auto helperCount = std::min(_workers.size(), chunkCount - 1);
+	for (size_t i = 0; i < helperCount; ++i)
+	{
+		Enqueue([state]() { RunChunks(*state); });
+	}
+	RunChunks(*state);
+
+	std::unique_lock lock(state->mutex);
+	state->done.wait(lock, [&state]() { return state->doneChunks == state->chunkCount; });
+	if (state->error)
+	{
+		std::rethrow_exception(state->error);
+	}
+}
+
+void TaskScheduler::Enqueue(std::function<void()> task)
+{
+	if (_workers.empty())
+	{
+		task();
+		return;
+	}
+
+	{
+		const std::lock_guard lock(_mutex);
+		_tasks.push_back(std::move(task));
+	}
+	_condition.notify_one();
+}
+
+void TaskScheduler::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock(_mutex);
+			_condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+			if (_tasks.empty())
+			{
+				return;
+			}
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openblack
+{
+
+/// Pool of worker threads shared by the engine for loading and simulation work.
+/// Tasks must not touch the renderer or other main thread only services, they should only produce data which the caller
+/// hands over once the task is done.
+class TaskScheduler
+{
+public:
+	/// Use one worker less than the hardware threads, the thread calling ParallelFor works as well
+	static uint32_t DefaultWorkerCount();
+
+	explicit TaskScheduler(uint32_t workerCount = DefaultWorkerCount());
+	~TaskScheduler();
+
+	TaskScheduler(const TaskScheduler&) = delete;
+	TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+	/// Number of threads which can run work at the same time, including the one calling ParallelFor
+	[[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(_workers.size()) + 1; }
+
+	/// Queue a task on a worker, the returned future holds its result or the exception it threw
+	template <typename Func>
+	auto Submit(Func&& func) -> std::future<std::invoke_result_t<Func>>
+	{
+		auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(func));
+		auto future = task->get_future();
+		Enqueue([task]() { (*task)(); });
+		return future;
+	}
+
+	/// Split [begin, end) in chunks of at least grainSize items and run func(chunkBegin, chunkEnd) on each of them.
+	/// The calling thread takes chunks too and only returns once all of them are done, rethrowing the first exception.
+	/// Calls may be nested from within tasks.
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& func);
+
+private:
+	void Enqueue(std::function<void()> task);
+	void WorkerLoop();
+
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _stopping {false};
+};
+
+} // namespace openblack
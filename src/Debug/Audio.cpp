@@ -12,6 +12,7 @@
 #include <imgui.h>
 
 #include "ECS/Registry.h"
+#include "EngineConfig.h"
 #include "Locator.h"
 #include "Resources/ResourcesInterface.h"
 
@@ -200,7 +201,7 @@ void Audio::AudioSettings() noexcept
 	ImGui::Separator();
 	Locator::entitiesRegistry::value().Each<ecs::components::AudioEmitter>(
 	    [this](entt::entity entity, const AudioEmitter& emitter) {
-		    if (ImGui::Selectable(("##" + std::to_string(emitter.sourceId)).c_str(), _selectedEmitter == entity,
+		    if (ImGui::Selectable(("##" + std::to_string(entt::to_integral(entity))).c_str(), _selectedEmitter == entity,
 		                          ImGuiSelectableFlags_SpanAllColumns))
 		    {
 			    _selectedEmitter = entity;
@@ -248,6 +249,26 @@ void Audio::AudioSettings() noexcept
 	{
 		soundManager.SetSfxVolume(sfxVolume);
 	}
+	constexpr float k_MegaByte = 1024.0f * 1024.0f;
+	const auto cache = soundManager.GetSoundCacheStats();
+	ImGui::Text("Sound cache: %.1f (+%.1f decoding) / %.1f MB, %zu resident, %zu decoding, %zu in use",
+	            static_cast<float>(cache.residentBytes) / k_MegaByte, static_cast<float>(cache.pendingBytes) / k_MegaByte,
+	            static_cast<float>(cache.budgetBytes) / k_MegaByte, cache.residentCount, cache.decodingCount,
+	            cache.retainedCount);
+	const auto voices = soundManager.GetVoiceStats();
+	ImGui::Text("Voices: %zu / %zu real, %zu pooled sources", voices.realVoices, voices.maxVoices, voices.pooledSources);
+	auto& config = Locator::config::value();
+	auto maxVoices = static_cast<int>(config.audioMaxVoices);
+	if (ImGui::SliderInt("Max Voices", &maxVoices, 1, 128))
+	{
+		config.audioMaxVoices = static_cast<uint32_t>(maxVoices);
+	}
+	auto budget = static_cast<int>(static_cast<float>(config.soundCacheBudget) / k_MegaByte);
+	if (ImGui::SliderInt("Sound Cache Budget (MB)", &budget, 1, 512))
+	{
+		config.soundCacheBudget = static_cast<size_t>(budget) * 1024 * 1024;
+	}
+	ImGui::Separator();
 	ImGui::Text("Active Sounds");
 	ImGui::SameLine();
 	if (ImGui::Button("Play") && _selectedEmitter != entt::null)
@@ -279,7 +300,7 @@ void Audio::AudioSettings() noexcept
 	ImGui::Separator();
 	Locator::entitiesRegistry::value().Each<ecs::components::AudioEmitter>(
 	    [this](entt::entity entity, const AudioEmitter& emitter) {
-		    if (ImGui::Selectable(("##" + std::to_string(emitter.sourceId)).c_str(), _selectedEmitter == entity,
+		    if (ImGui::Selectable(("##" + std::to_string(entt::to_integral(entity))).c_str(), _selectedEmitter == entity,
 		                          ImGuiSelectableFlags_SpanAllColumns))
 		    {
 			    _selectedEmitter = entity;
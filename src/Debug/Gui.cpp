@@ -30,6 +30,7 @@
 #endif
 #include <SDL.h>
 #include <bx/timer.h>
+#include <fmt/format.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/compatibility.hpp>
 #include <imgui.h>
@@ -49,6 +50,7 @@
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Villager.h"
 #include "ECS/Registry.h"
+#include "ECS/Systems/DynamicsSystemInterface.h"
 #include "ECS/Systems/HandSystemInterface.h"
 #include "ECS/Systems/LivingActionSystemInterface.h"
 #include "EngineConfig.h"
@@ -58,6 +60,7 @@
 #include "LHVMViewer.h"
 #include "LandIsland.h"
 #include "Locator.h"
+#include "Memory.h"
 #include "MeshViewer.h"
 #include "PathFinding.h"
 #include "Profiler.h"
@@ -110,6 +113,7 @@ std::unique_ptr<DebugGuiInterface> DebugGuiInterface::Create(graphics::RenderPas
 	debugWindows.emplace_back(new Profiler);
 	debugWindows.emplace_back(new MeshViewer);
 	debugWindows.emplace_back(new TextureViewer);
+	debugWindows.emplace_back(new Memory);
 	debugWindows.emplace_back(new Console);
 	debugWindows.emplace_back(new LandIsland);
 	debugWindows.emplace_back(new LHVMViewer);
@@ -587,6 +591,30 @@ bool Gui::ShowMenu() noexcept
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Physics"))
+			{
+				if (Locator::dynamicsSystem::has_value())
+				{
+					const auto& dynamicsSystem = Locator::dynamicsSystem::value();
+					ImGui::Text("Steps last frame: %u (interpolation %.3f)", dynamicsSystem.GetSubStepCount(),
+					            dynamicsSystem.GetInterpolationFactor());
+				}
+				ImGui::Checkbox("Fixed Timestep", &config.physicsFixedTimestep);
+				ImGui::Checkbox("Multithreaded (next level)", &config.physicsMultithreaded);
+				float rate = 1.0f / config.physicsTimestep;
+				if (ImGui::SliderFloat("Rate (Hz)", &rate, 10.0f, 240.0f, "%.0f"))
+				{
+					config.physicsTimestep = 1.0f / rate;
+				}
+				int maxSubSteps = static_cast<int>(config.physicsMaxSubSteps);
+				if (ImGui::SliderInt("Max Steps per Frame", &maxSubSteps, 1, 16))
+				{
+					config.physicsMaxSubSteps = static_cast<uint32_t>(maxSubSteps);
+				}
+
+				ImGui::EndMenu();
+			}
+
 			if (ImGui::BeginMenu("Game Speed"))
 			{
 				float multiplier = game.GetGameSpeed();
@@ -9,6 +9,12 @@
 
 #include "LHVMViewer.h"
 
+#include <cinttypes>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
 #include <imgui.h>
 #include <imgui_memory_editor.h>
 #include <imgui_user.h>
@@ -89,6 +95,13 @@ void LHVMViewer::Draw() noexcept
 			ImGui::EndTabItem();
 		}
 
+		if (ImGui::BeginTabItem("Profile"))
+		{
+			DrawProfileTab(lhvm);
+
+			ImGui::EndTabItem();
+		}
+
 		ImGui::EndTabBar();
 	}
 }
@@ -419,6 +432,97 @@ void LHVMViewer::DrawTasksTab(const lhvm::LHVM& lhvm) noexcept
 	}
 }
 
+void LHVMViewer::DrawProfileTab(lhvm::LHVM& lhvm) noexcept
+{
+	bool profiling = lhvm.IsProfiling();
+	if (ImGui::Checkbox("Record", &profiling))
+	{
+		lhvm.SetProfiling(profiling);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Reset"))
+	{
+		lhvm.ResetProfile();
+	}
+	ImGui::SameLine();
+	ImGui::InputText("##ProfilePath", _profilePath.data(), _profilePath.size());
+	ImGui::SameLine();
+	const auto profile = lhvm.GetProfile();
+	if (ImGui::Button("Save"))
+	{
+		profile.Write(_profilePath.data());
+	}
+	ImGui::Text("Ticks: %u", profile.ticks);
+
+	if (ImGui::BeginTabBar("##ProfileTabs", ImGuiTabBarFlags_None))
+	{
+		if (ImGui::BeginTabItem("Scripts"))
+		{
+			DrawProfileEntries("##ScriptProfile", profile.scripts, profile.ticks, true);
+			ImGui::EndTabItem();
+		}
+		if (ImGui::BeginTabItem("Native Functions"))
+		{
+			DrawProfileEntries("##NativeFunctionProfile", profile.nativeFunctions, profile.ticks, false);
+			ImGui::EndTabItem();
+		}
+		ImGui::EndTabBar();
+	}
+}
+
+void LHVMViewer::DrawProfileEntries(const char* label, const std::vector<lhvm::VMProfileEntry>& entries, uint32_t ticks,
+                                    bool isScript) noexcept
+{
+	// Most expensive first, by index so scripts can still be selected by id
+	std::vector<uint32_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::erase_if(order, [&entries](uint32_t i) { return entries[i].calls == 0; });
+	std::ranges::sort(order, [&entries](uint32_t a, uint32_t b) { return entries[a].time > entries[b].time; });
+
+	ImGui::BeginChild(label);
+	ImGui::Columns(5, label, true);
+	ImGui::Text("Name");
+	ImGui::NextColumn();
+	ImGui::Text("%s", isScript ? "Runs" : "Calls");
+	ImGui::NextColumn();
+	ImGui::Text("Instructions");
+	ImGui::NextColumn();
+	ImGui::Text("Total (ms)");
+	ImGui::NextColumn();
+	ImGui::Text("Per Tick (ms)");
+	ImGui::NextColumn();
+	ImGui::Separator();
+	for (const auto i : order)
+	{
+		const auto& entry = entries[i];
+		const auto totalMs = std::chrono::duration<double, std::milli>(entry.time).count();
+		if (isScript)
+		{
+			ImGui::PushID(static_cast<int>(i));
+			if (ImGui::TextButtonColored(Disassembly_ColorFuncName, entry.name.c_str()))
+			{
+				SelectScript(i + 1);
+			}
+			ImGui::PopID();
+		}
+		else
+		{
+			ImGui::Text("%s", entry.name.c_str());
+		}
+		ImGui::NextColumn();
+		ImGui::Text("%" PRIu64, entry.calls);
+		ImGui::NextColumn();
+		ImGui::Text("%" PRIu64, entry.instructions);
+		ImGui::NextColumn();
+		ImGui::Text("%.3f", totalMs);
+		ImGui::NextColumn();
+		ImGui::Text("%.4f", ticks > 0 ? totalMs / ticks : 0.0);
+		ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+	ImGui::EndChild();
+}
+
 void LHVMViewer::DrawStack(const openblack::lhvm::VMStack& stack) noexcept
 {
 	ImGui::BeginChild("##stack");
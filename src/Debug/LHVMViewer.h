@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include <LHVM.h>
 
 #include "Window.h"
@@ -39,6 +42,10 @@ class LHVMViewer final: public Window
 	void DrawExceptionHandlers(const std::vector<uint32_t>& exceptionHandlerIps) noexcept;
 	void SelectTask(uint32_t idx) noexcept;
 
+	void DrawProfileTab(lhvm::LHVM& lhvm) noexcept;
+	void DrawProfileEntries(const char* label, const std::vector<lhvm::VMProfileEntry>& entries, uint32_t ticks,
+	                        bool isScript) noexcept;
+
 	uint32_t _selectedScriptID {1};
 	bool _openScriptTab {false};
 	bool _scrollToSelected {false};
@@ -48,6 +55,8 @@ class LHVMViewer final: public Window
 	bool _resetStackScroll {false};
 	bool _resetExceptionHandlersScroll {false};
 
+	std::array<char, 256> _profilePath {"lhvm_profile.txt"};
+
 	static std::string DataToString(lhvm::VMValue data, lhvm::DataType type) noexcept;
 };
 
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "Memory.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "3D/L3DMesh.h"
+#include "EngineConfig.h"
+#include "Graphics/Texture2D.h"
+#include "Locator.h"
+#include "Resources/ResidencyManager.h"
+#include "Resources/ResourcesInterface.h"
+
+using namespace openblack;
+using namespace openblack::debug::gui;
+
+namespace
+{
+constexpr float k_MegaByte = 1024.0f * 1024.0f;
+constexpr size_t k_LargestCount = 20;
+
+float ToMegaBytes(size_t bytes)
+{
+	return static_cast<float>(bytes) / k_MegaByte;
+}
+
+void SizeRow(const char* label, const resources::ResourceSize& size, size_t count)
+{
+	ImGui::Text("%s", label);
+	ImGui::NextColumn();
+	ImGui::Text("%zu", count);
+	ImGui::NextColumn();
+	ImGui::Text("%.1f MB", ToMegaBytes(size.cpuBytes));
+	ImGui::NextColumn();
+	ImGui::Text("%.1f MB", ToMegaBytes(size.gpuBytes));
+	ImGui::NextColumn();
+}
+} // namespace
+
+Memory::Memory() noexcept
+    : Window("Memory", ImVec2(600.0f, 500.0f))
+{
+}
+
+void Memory::Draw() noexcept
+{
+	auto& resources = Locator::resources::value();
+	const auto stats = resources.GetResidency().GetStats();
+	auto total = stats.meshes;
+	total += stats.textures;
+
+	ImGui::Text("Resident: %.1f / %.1f MB", ToMegaBytes(total.Total()), ToMegaBytes(stats.budgetBytes));
+	ImGui::Text("Evictions: %zu, reloads: %zu", stats.evictions, stats.reloads);
+
+	size_t streamed = 0;
+	size_t streamedInFull = 0;
+	resources.GetTextures().Each([&streamed, &streamedInFull](entt::id_type, const graphics::Texture2D& texture) {
+		streamed += texture.IsStreamed() ? 1 : 0;
+		streamedInFull += texture.IsStreamed() && texture.GetStreamedLevel() == 0 ? 1 : 0;
+	});
+	ImGui::Text("Streamed textures: %zu, at full size: %zu", streamed, streamedInFull);
+
+	auto& config = Locator::config::value();
+	auto budget = static_cast<int>(ToMegaBytes(config.resourceMemoryBudget));
+	if (ImGui::SliderInt("Budget (MB)", &budget, 16, 4096))
+	{
+		config.resourceMemoryBudget = static_cast<size_t>(budget) * 1024 * 1024;
+	}
+
+	ImGui::Separator();
+	ImGui::Columns(4, "MemoryColumns", true);
+	ImGui::Text("Type");
+	ImGui::NextColumn();
+	ImGui::Text("Resident");
+	ImGui::NextColumn();
+	ImGui::Text("CPU");
+	ImGui::NextColumn();
+	ImGui::Text("GPU");
+	ImGui::NextColumn();
+	ImGui::Separator();
+	SizeRow("Meshes", stats.meshes, stats.residentMeshes);
+	SizeRow("Textures", stats.textures, stats.residentTextures);
+	SizeRow("Total", total, stats.residentMeshes + stats.residentTextures);
+	ImGui::Columns(1);
+
+	ImGui::Separator();
+	Largest();
+}
+
+void Memory::Largest() noexcept
+{
+	struct Row
+	{
+		std::string name;
+		const resources::Residency* residency;
+	};
+	std::vector<Row> rows;
+
+	// Each doesn't count as a use, looking at a resource here doesn't keep it resident
+	auto& resources = Locator::resources::value();
+	const auto& meshes = resources.GetMeshes();
+	meshes.Each([&rows, &meshes](entt::id_type id, const graphics::L3DMesh& mesh) {
+		rows.push_back({"mesh/" + mesh.GetDebugName(), meshes.GetResidency(id)});
+	});
+	const auto& textures = resources.GetTextures();
+	textures.Each([&rows, &textures](entt::id_type id, const graphics::Texture2D& texture) {
+		rows.push_back({"texture/" + texture.GetName(), textures.GetResidency(id)});
+	});
+
+	const auto count = std::min(rows.size(), k_LargestCount);
+	std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(count), rows.end(),
+	                  [](const Row& lhs, const Row& rhs) { return lhs.residency->size.Total() > rhs.residency->size.Total(); });
+
+	ImGui::Text("Largest resident resources");
+	ImGui::Columns(4, "LargestColumns", true);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& row = rows[i];
+		ImGui::Text("%s", row.name.c_str());
+		ImGui::NextColumn();
+		ImGui::Text("%.2f MB", ToMegaBytes(row.residency->size.Total()));
+		ImGui::NextColumn();
+		ImGui::Text("used frame %u", row.residency->lastUsedFrame);
+		ImGui::NextColumn();
+		ImGui::Text("%s", row.residency->pinned ? "pinned" : (row.residency->reload ? "evictable" : "permanent"));
+		ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+}
+
+void Memory::Update() noexcept {}
+
+void Memory::ProcessEventOpen(const SDL_Event&) noexcept {}
+
+void Memory::ProcessEventAlways(const SDL_Event&) noexcept {}
@@ -11,7 +11,13 @@
 
 #include <cinttypes>
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <bgfx/bgfx.h>
+#include <fmt/format.h>
 #include <imgui_widget_flamegraph.h>
 
 #include "ECS/Components/Transform.h"
@@ -79,6 +85,21 @@ void Profiler::Draw() noexcept
 	ImGui::Checkbox("Debug Cross", &config.drawDebugCross);
 	ImGui::Columns(1);
 
+	auto& profiler = Locator::profiler::value();
+	if (!profiler.IsTracing())
+	{
+		ImGui::InputText("##TracePath", _tracePath.data(), _tracePath.size());
+		ImGui::SameLine();
+		if (ImGui::Button("Start Trace"))
+		{
+			profiler.StartTrace(_tracePath.data());
+		}
+	}
+	else if (ImGui::Button("Stop Trace"))
+	{
+		profiler.StopTrace();
+	}
+
 	auto width = ImGui::GetColumnWidth() - ImGui::CalcTextSize("Frame").x;
 	ImGui::PlotHistogram("Frame", _times.values.data(), decltype(_times)::k_BufferSize, _times.offset, frameTextOverlay.data(),
 	                     0.0f, FLT_MAX, ImVec2(width, 45.0f));
@@ -102,36 +123,50 @@ void Profiler::Draw() noexcept
 
 	ImGui::Columns(1);
 
-	const auto& profiler = Locator::profiler::value();
 	const auto& entry = profiler.GetEntries().at(profiler.GetEntryIndex(-1));
 
-	ImGuiWidgetFlameGraph::PlotFlame(
-	    "CPU",
-	    [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data, int idx) -> void {
-		    const auto* entry = reinterpret_cast<const openblack::Profiler::Entry*>(data);
-		    const auto& stage = entry->stages.at(idx);
-		    if (startTimestamp != nullptr)
-		    {
-			    const std::chrono::duration<float, std::milli> fltStart = stage.start - entry->frameStart;
-			    *startTimestamp = fltStart.count();
-		    }
-		    if (endTimestamp != nullptr)
-		    {
-			    *endTimestamp = stage.end.time_since_epoch().count() / 1e6f;
-
-			    const std::chrono::duration<float, std::milli> fltEnd = stage.end - entry->frameStart;
-			    *endTimestamp = fltEnd.count();
-		    }
-		    if (level != nullptr)
-		    {
-			    *level = stage.level;
-		    }
-		    if (caption != nullptr)
-		    {
-			    *caption = openblack::Profiler::k_StageNames.at(idx).data();
-		    }
-	    },
-	    &entry, static_cast<uint8_t>(openblack::Profiler::Stage::_count), 0, "Main Thread", 0, FLT_MAX, ImVec2(width, 0));
+	// One flame graph per thread which recorded scopes this frame
+	struct ThreadScopes
+	{
+		const openblack::Profiler::Entry* entry;
+		std::vector<const openblack::Profiler::Scope*> scopes;
+	};
+	std::map<uint32_t, ThreadScopes> threads;
+	for (const auto& scope : entry.scopes)
+	{
+		auto& thread = threads.try_emplace(scope.thread, ThreadScopes {&entry, {}}).first->second;
+		thread.scopes.push_back(&scope);
+	}
+	for (const auto& [index, thread] : threads)
+	{
+		const auto name = index == 0 ? std::string("Main Thread") : fmt::format("Thread {}", index);
+		const auto label = index == 0 ? std::string("CPU") : "##" + name;
+		ImGuiWidgetFlameGraph::PlotFlame(
+		    label.c_str(),
+		    [](float* startTimestamp, float* endTimestamp, ImU8* level, const char** caption, const void* data, int idx) {
+			    const auto* thread = reinterpret_cast<const ThreadScopes*>(data);
+			    const auto& scope = *thread->scopes.at(idx);
+			    if (startTimestamp != nullptr)
+			    {
+				    const std::chrono::duration<float, std::milli> fltStart = scope.start - thread->entry->frameStart;
+				    *startTimestamp = fltStart.count();
+			    }
+			    if (endTimestamp != nullptr)
+			    {
+				    const std::chrono::duration<float, std::milli> fltEnd = scope.end - thread->entry->frameStart;
+				    *endTimestamp = fltEnd.count();
+			    }
+			    if (level != nullptr)
+			    {
+				    *level = scope.level;
+			    }
+			    if (caption != nullptr)
+			    {
+				    *caption = Locator::profiler::value().GetZoneName(scope.zone).data();
+			    }
+		    },
+		    &thread, static_cast<int>(thread.scopes.size()), 0, name.c_str(), 0, FLT_MAX, ImVec2(width, 0));
+	}
 
 	ImGuiWidgetFlameGraph::PlotFlame(
 	    "GPU",
@@ -168,17 +203,22 @@ void Profiler::Draw() noexcept
 		auto cursorX = ImGui::GetCursorPosX();
 		auto indentSize = ImGui::CalcTextSize("    ").x;
 
-		// TODO (#749) use std::views::enumerate
-		for (uint8_t i = 0; const auto& stage : entry.stages)
+		// Scopes are stored in the order they ended, list the main thread's in the order they started
+		std::vector<const openblack::Profiler::Scope*> mainScopes;
+		if (const auto mainThread = threads.find(0); mainThread != threads.end())
 		{
-			std::chrono::duration<float, std::milli> const duration = stage.end - stage.start;
-			ImGui::SetCursorPosX(cursorX + indentSize * stage.level);
-			ImGui::Text("    %s: %0.3f", openblack::Profiler::k_StageNames.at(i).data(), duration.count());
-			if (stage.level == 0)
+			mainScopes = mainThread->second.scopes;
+		}
+		std::ranges::sort(mainScopes, {}, &openblack::Profiler::Scope::start);
+		for (const auto* scope : mainScopes)
+		{
+			std::chrono::duration<float, std::milli> const duration = scope->end - scope->start;
+			ImGui::SetCursorPosX(cursorX + indentSize * scope->level);
+			ImGui::Text("    %s: %0.3f", profiler.GetZoneName(scope->zone).data(), duration.count());
+			if (scope->level == 0)
 			{
 				frameDuration -= duration;
 			}
-			++i;
 		}
 		ImGui::Text("    Unaccounted: %0.3f", frameDuration.count());
 	}
@@ -199,6 +239,15 @@ void Profiler::Draw() noexcept
 		ImGui::Text("    Unaccounted: %0.3f", 1000.0f * frameDuration / static_cast<double>(stats->gpuTimerFreq));
 	}
 	ImGui::Columns(1);
+
+	if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		for (size_t i = 0; i < entry.counters.size(); ++i)
+		{
+			ImGui::Text("%s: %" PRId64, openblack::Profiler::k_CounterNames.at(i).data(), entry.counters.at(i));
+		}
+		ImGui::Text("Threads: %u, Dropped Zones: %" PRIu64, profiler.GetThreadCount(), profiler.GetDroppedZoneCount());
+	}
 }
 
 void Profiler::Update() noexcept {}
@@ -54,6 +54,7 @@ class Profiler final: public Window
 	};
 	CircularBuffer<float, 100> _times;
 	CircularBuffer<float, 100> _fps;
+	std::array<char, 256> _tracePath {"openblack.trace.json"};
 };
 
 } // namespace openblack::debug::gui
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+
+#include <LinearMath/btThreads.h>
+
+#include "Common/TaskScheduler.h"
+
+namespace openblack::dynamics
+{
+
+/// Runs Bullet's parallel loops on the engine's task scheduler instead of a second pool of threads
+class BulletTaskScheduler final: public btITaskScheduler
+{
+public:
+	explicit BulletTaskScheduler(TaskScheduler& scheduler)
+	    : btITaskScheduler("openblack")
+	    , _scheduler(scheduler)
+	    , _numThreads(getMaxNumThreads())
+	{
+	}
+
+	[[nodiscard]] int getMaxNumThreads() const override
+	{
+		return std::min(static_cast<int>(_scheduler.GetThreadCount()), static_cast<int>(BT_MAX_THREAD_COUNT));
+	}
+	[[nodiscard]] int getNumThreads() const override { return _numThreads; }
+	void setNumThreads(int numThreads) override { _numThreads = std::clamp(numThreads, 1, getMaxNumThreads()); }
+
+	void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+	{
+		_scheduler.ParallelFor(static_cast<size_t>(iBegin), static_cast<size_t>(iEnd), static_cast<size_t>(grainSize),
+		                       [&body](size_t begin, size_t end) {
+			                       body.forLoop(static_cast<int>(begin), static_cast<int>(end));
+		                       });
+	}
+
+	btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+	{
+		std::mutex mutex;
+		btScalar sum = 0;
+		_scheduler.ParallelFor(static_cast<size_t>(iBegin), static_cast<size_t>(iEnd), static_cast<size_t>(grainSize),
+		                       [&body, &mutex, &sum](size_t begin, size_t end) {
+			                       const auto partial = body.sumLoop(static_cast<int>(begin), static_cast<int>(end));
+			                       const std::lock_guard lock(mutex);
+			                       sum += partial;
+		                       });
+		return sum;
+	}
+
+private:
+	TaskScheduler& _scheduler;
+	int _numThreads;
+};
+
+} // namespace openblack::dynamics
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <LinearMath/btMotionState.h>
+#include <LinearMath/btTransform.h>
+#include <entt/entity/entity.hpp>
+
+namespace openblack::dynamics
+{
+
+/// Motion state of an entity's rigid body.
+/// Bullet only writes the motion states of bodies it simulated during a step, static and sleeping bodies are skipped.
+/// Each write queues the entity once in a list so that syncing transforms only has to visit the bodies which moved.
+/// The transforms before and after the last step which moved the body are kept so rendering can interpolate between them.
+class EntityMotionState final: public btMotionState
+{
+public:
+	explicit EntityMotionState(const btTransform& startTransform)
+	    : _previous(startTransform)
+	    , _current(startTransform)
+	{
+	}
+
+	/// Start queueing the entity in moved whenever Bullet writes a new transform, stamped with the step index
+	void Track(entt::entity entity, std::vector<entt::entity>* moved, const uint64_t* stepIndex)
+	{
+		_entity = entity;
+		_moved = moved;
+		_stepIndex = stepIndex;
+		_queued = false;
+	}
+
+	/// Allow the entity to be queued again once its transform was synced
+	void ClearQueued() { _queued = false; }
+
+	/// Whether the body was moved by the step with the given index
+	[[nodiscard]] bool MovedDuring(uint64_t stepIndex) const { return _movedStep == stepIndex; }
+
+	/// Transform between the states before and after the last step which moved the body
+	[[nodiscard]] btTransform GetInterpolatedTransform(float alpha) const
+	{
+		return {_previous.getRotation().slerp(_current.getRotation(), alpha),
+		        _previous.getOrigin().lerp(_current.getOrigin(), alpha)};
+	}
+
+	void getWorldTransform(btTransform& worldTrans) const override { worldTrans = _current; }
+
+	void setWorldTransform(const btTransform& worldTrans) override
+	{
+		// A body which was left alone by the previous step still has that step's state in _current
+		_previous = _current;
+		_current = worldTrans;
+		if (_stepIndex != nullptr)
+		{
+			_movedStep = *_stepIndex;
+		}
+		if (_moved != nullptr && !_queued)
+		{
+			_moved->push_back(_entity);
+			_queued = true;
+		}
+	}
+
+private:
+	btTransform _previous;
+	btTransform _current;
+	entt::entity _entity {entt::null};
+	std::vector<entt::entity>* _moved {nullptr};
+	const uint64_t* _stepIndex {nullptr};
+	uint64_t _movedStep {0};
+	bool _queued {false};
+};
+
+} // namespace openblack::dynamics
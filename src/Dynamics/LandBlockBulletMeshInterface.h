@@ -50,6 +50,19 @@ class LandBlockBulletMeshInterface: public btStridingMeshInterface
 		}
 	}
 
+	/// Copy new positions from a vertex list with the same vertex count and layout as the one given on construction
+	void UpdateVertices(const uint8_t* vertexData, size_t stride)
+	{
+		for (size_t i = 0; auto& v : _vertices)
+		{
+			const auto* vertexBase = reinterpret_cast<const float*>(&vertexData[i * stride]);
+			v[0] = vertexBase[0];
+			v[1] = vertexBase[1];
+			v[2] = vertexBase[2];
+			++i;
+		}
+	}
+
 	/// get read and write access to a subpart of a triangle mesh
 	/// this subpart has a continuous array of vertices and indices
 	/// in this way the mesh can be handled as chunks of memory with striding
@@ -124,5 +124,7 @@ entt::entity AbodeArchetype::Create(uint32_t townId, const glm::vec3& position,
 		break;
 	}
 
+	Locator::townSystem::value().AddAbode(entity);
+
 	return entity;
 }
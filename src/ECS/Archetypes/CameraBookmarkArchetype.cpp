@@ -14,6 +14,7 @@
 #include "ECS/Registry.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Resources/ResourceId.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack;
@@ -23,11 +24,15 @@ using namespace openblack::ecs::components;
 std::array<entt::entity, 8> CameraBookmarkArchetype::CreateAll()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	auto texture = Locator::resources::value().GetTextures().Handle(entt::hashed_string("raw/misc0a"));
+	auto& textures = Locator::resources::value().GetTextures();
+	constexpr auto textureId = resources::MakeResourceId("raw/misc0a");
+	auto texture = textures.Handle(textureId);
 	if (!texture)
 	{
 		throw std::runtime_error("Failed to get Camera Bookmark sprite: misc0a");
 	}
+	// Sprites keep the texture's native handle
+	textures.Pin(textureId);
 
 	auto result = std::array<entt::entity, 8>();
 
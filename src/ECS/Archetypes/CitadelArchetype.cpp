@@ -16,6 +16,7 @@
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
 #include "Locator.h"
+#include "Resources/ResourceId.h"
 
 using namespace openblack;
 using namespace openblack::ecs::archetypes;
@@ -28,7 +29,7 @@ entt::entity CitadelArchetype::Create(const glm::vec3& position, PlayerNames pla
 	const auto entity = registry.Create();
 	registry.Assign<Transform>(entity, position, rotation, size);
 	registry.Assign<Temple>(entity, playerOwner);
-	const auto meshId = entt::hashed_string("temple/b_first_temple_l3d");
+	constexpr auto meshId = resources::MakeResourceId("temple/b_first_temple_l3d");
 	registry.Assign<Mesh>(entity, meshId, static_cast<int8_t>(0), static_cast<int8_t>(0));
 	return entity;
 }
@@ -43,9 +43,12 @@ entt::entity FeatureArchetype::Create(const glm::vec3& position, FeatureInfo typ
 	const auto resourceId = resources::MeshIdToResourceId(info.meshId);
 	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(1));
 
-	auto l3dMesh = Locator::resources::value().GetMeshes().Handle(resourceId);
+	auto& meshes = Locator::resources::value().GetMeshes();
+	auto l3dMesh = meshes.Handle(resourceId);
 	if (l3dMesh->HasPhysicsMesh())
 	{
+		// The rigid body points into the mesh's physics shape
+		meshes.Pin(resourceId);
 		auto& shape = l3dMesh->GetPhysicsMesh();
 		btVector3 bodyInertia(0, 0, 0);
 		shape.calculateLocalInertia(l3dMesh->GetMass(), bodyInertia);
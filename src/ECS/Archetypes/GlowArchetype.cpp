@@ -9,7 +9,6 @@
 
 #include "GlowArchetype.h"
 
-#include <entt/core/hashed_string.hpp>
 #include <glm/ext/matrix_float3x3.hpp>
 
 #include "3D/Light.h"
@@ -18,6 +17,7 @@
 #include "ECS/Registry.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Resources/ResourceId.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack;
@@ -26,7 +26,11 @@ using namespace openblack::ecs::components;
 
 std::array<entt::entity, 2> GlowArchetype::Create(const LightEmitter& emitter, components::TempleRoom room)
 {
-	auto texture = Locator::resources::value().GetTextures().Handle(entt::hashed_string("raw/ATMOS"));
+	auto& textures = Locator::resources::value().GetTextures();
+	constexpr auto textureId = resources::MakeResourceId("raw/ATMOS");
+	auto texture = textures.Handle(textureId);
+	// Sprites keep the texture's native handle
+	textures.Pin(textureId);
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto extent = glm::vec2 {1.0f / 8.0f, 1.0f / 8.0f};
 
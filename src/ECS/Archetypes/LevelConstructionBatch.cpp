@@ -0,0 +1,21 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LevelConstructionBatch.h"
+
+using namespace openblack::ecs::archetypes;
+
+void LevelConstructionBatch::Flush()
+{
+	TreeArchetype::CreateBatch(trees);
+	trees.clear();
+	// Villagers last as they look up the towns and abodes created by the script
+	VillagerArchetype::CreateBatch(villagers);
+	villagers.clear();
+}
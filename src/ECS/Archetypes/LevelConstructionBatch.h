@@ -0,0 +1,29 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "TreeArchetype.h"
+#include "VillagerArchetype.h"
+
+namespace openblack::ecs::archetypes
+{
+/// Entities queued while a level script is loading so that they can be created in bulk once it is done.
+/// Only the archetypes which are numerous in levels and which nothing else in the script depends on are deferred.
+struct LevelConstructionBatch
+{
+	std::vector<TreeArchetype::Parameters> trees;
+	std::vector<VillagerArchetype::Parameters> villagers;
+
+	/// Create all queued entities and clear the queues
+	void Flush();
+};
+} // namespace openblack::ecs::archetypes
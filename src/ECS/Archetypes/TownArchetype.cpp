@@ -12,6 +12,7 @@
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
+#include "ECS/Systems/TownSystemInterface.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -30,6 +31,7 @@ entt::entity TownArchetype::Create(int id, const glm::vec3& position, [[maybe_un
 	registry.Assign<Transform>(entity, position, glm::mat3(1.0f), glm::vec3(1.0f));
 	auto& registryContext = registry.Context();
 	registryContext.towns.insert({id, entity});
+	Locator::townSystem::value().AddTown(entity);
 
 	return entity;
 }
@@ -9,6 +9,8 @@
 
 #include "TreeArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 
 #include "ECS/Components/Fixed.h"
@@ -42,3 +44,38 @@ entt::entity TreeArchetype::Create([[maybe_unused]] uint32_t forestId, const glm
 
 	return entity;
 }
+
+void TreeArchetype::CreateBatch(std::span<const Parameters> trees)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& treeInfos = Locator::infoConstants::value().tree;
+
+	std::vector<entt::entity> entities(trees.size());
+	registry.Create(entities.begin(), entities.end());
+
+	std::vector<Transform> transforms;
+	std::vector<Fixed> fixed;
+	std::vector<Tree> treeComponents;
+	std::vector<Mesh> meshes;
+	transforms.reserve(trees.size());
+	fixed.reserve(trees.size());
+	treeComponents.reserve(trees.size());
+	meshes.reserve(trees.size());
+
+	for (const auto& tree : trees)
+	{
+		const auto& info = treeInfos.at(static_cast<size_t>(tree.type));
+
+		const auto& transform = transforms.emplace_back(
+		    Transform {tree.position, glm::mat3(glm::eulerAngleY(-tree.yAngleRadians)), glm::vec3(tree.scale)});
+		const auto [point, radius] = GetFixedObstacleBoundingCircle(info.normal, transform);
+		fixed.emplace_back(point, radius);
+		treeComponents.emplace_back(Tree {tree.type, tree.maxSize});
+		meshes.emplace_back(Mesh {resources::MeshIdToResourceId(info.normal), static_cast<int8_t>(0), static_cast<int8_t>(-1)});
+	}
+
+	registry.Insert<Transform>(entities.cbegin(), entities.cend(), transforms.cbegin());
+	registry.Insert<Fixed>(entities.cbegin(), entities.cend(), fixed.cbegin());
+	registry.Insert<Tree>(entities.cbegin(), entities.cend(), treeComponents.cbegin());
+	registry.Insert<Mesh>(entities.cbegin(), entities.cend(), meshes.cbegin());
+}
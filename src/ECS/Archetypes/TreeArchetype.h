@@ -9,8 +9,10 @@
 
 #pragma once
 
+#include <span>
+
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -19,8 +21,21 @@ namespace openblack::ecs::archetypes
 class TreeArchetype
 {
 public:
+	struct Parameters
+	{
+		uint32_t forestId;
+		glm::vec3 position;
+		TreeInfo type;
+		bool isNonScenic;
+		float yAngleRadians;
+		float maxSize;
+		float scale;
+	};
+
 	static entt::entity Create(uint32_t forestId, const glm::vec3& position, TreeInfo type, bool isNonScenic,
 	                           float yAngleRadians, float maxSize, float scale);
+	/// Create all trees at once, each component type is inserted as a single range
+	static void CreateBatch(std::span<const Parameters> trees);
 	TreeArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
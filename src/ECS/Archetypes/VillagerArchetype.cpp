@@ -9,6 +9,8 @@
 
 #include "VillagerArchetype.h"
 
+#include <vector>
+
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/vec3.hpp>
 
@@ -57,6 +59,10 @@ entt::entity VillagerArchetype::Create([[maybe_unused]] const glm::vec3& abodePo
 
 	registry.Assign<Villager>(entity, health, static_cast<uint32_t>(age), hunger, lifeStage, sex, info.tribeType,
 	                          info.villagerNumber, task, town, abode);
+	if (abode != entt::null)
+	{
+		Locator::townSystem::value().AddVillagerToAbode(abode, entity);
+	}
 	registry.Assign<WallHug>(entity, glm::vec2(), glm::vec2(), GetSpeedStateSpeed(info.speedGroup.speedDefault));
 	const auto resourceId = resources::MeshIdToResourceId(info.highDetail);
 	registry.Assign<Mesh>(entity, resourceId, static_cast<int8_t>(0), static_cast<int8_t>(0));
@@ -65,3 +71,67 @@ entt::entity VillagerArchetype::Create([[maybe_unused]] const glm::vec3& abodePo
 
 	return entity;
 }
+
+void VillagerArchetype::CreateBatch(std::span<const Parameters> villagers)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& infoConstants = Locator::infoConstants::value();
+	auto& rng = Locator::rng::value();
+	auto& townSystem = Locator::townSystem::value();
+
+	std::vector<entt::entity> entities(villagers.size());
+	registry.Create(entities.begin(), entities.end());
+
+	std::vector<Transform> transforms;
+	std::vector<Villager> villagerComponents;
+	std::vector<WallHug> wallHugs;
+	std::vector<Mesh> meshes;
+	std::vector<LivingAction> livingActions;
+	transforms.reserve(villagers.size());
+	villagerComponents.reserve(villagers.size());
+	wallHugs.reserve(villagers.size());
+	meshes.reserve(villagers.size());
+	livingActions.reserve(villagers.size());
+
+	const uint32_t health = 100;
+	const uint32_t hunger = 100;
+	const auto task = Villager::Task::IDLE;
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& villager : villagers)
+	{
+		const auto& info = infoConstants.villager.at(static_cast<size_t>(villager.type));
+
+		transforms.emplace_back(
+		    Transform {villager.position, glm::mat3(glm::eulerAngleY(glm::radians(180.0f))), glm::vec3(1.0)});
+
+		const auto lifeStage = villager.age < 18 ? Villager::LifeStage::Child : Villager::LifeStage::Adult;
+		const auto sex = info.villagerNumber == VillagerNumber::Housewife ? Villager::Sex::FEMALE : Villager::Sex::MALE;
+
+		const entt::entity town = townSystem.FindClosestTown(villager.abodePosition);
+		entt::entity abode = entt::null;
+		if (town != entt::null)
+		{
+			abode = townSystem.FindAbodeWithSpace(town);
+		}
+		if (abode != entt::null)
+		{
+			townSystem.AddVillagerToAbode(abode, entities.at(i));
+		}
+
+		villagerComponents.emplace_back(Villager {health, villager.age, hunger, lifeStage, sex, info.tribeType,
+		                                          info.villagerNumber, task, town, abode});
+		wallHugs.emplace_back(WallHug {glm::vec2(), glm::vec2(), GetSpeedStateSpeed(info.speedGroup.speedDefault)});
+		meshes.emplace_back(
+		    Mesh {resources::MeshIdToResourceId(info.highDetail), static_cast<int8_t>(0), static_cast<int8_t>(0)});
+		livingActions.emplace_back(VillagerStates::Created, rng.NextValue<uint16_t>(1, 500));
+		++i;
+	}
+
+	registry.Insert<Transform>(entities.cbegin(), entities.cend(), transforms.cbegin());
+	registry.Insert<Mobile>(entities.cbegin(), entities.cend());
+	registry.Insert<Villager>(entities.cbegin(), entities.cend(), villagerComponents.cbegin());
+	registry.Insert<WallHug>(entities.cbegin(), entities.cend(), wallHugs.cbegin());
+	registry.Insert<Mesh>(entities.cbegin(), entities.cend(), meshes.cbegin());
+	registry.Insert<LivingAction>(entities.cbegin(), entities.cend(), livingActions.cbegin());
+}
@@ -9,10 +9,11 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 
 #include <entt/fwd.hpp>
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 
 #include "Enums.h"
 
@@ -21,7 +22,18 @@ namespace openblack::ecs::archetypes
 class VillagerArchetype
 {
 public:
+	struct Parameters
+	{
+		glm::vec3 abodePosition;
+		glm::vec3 position;
+		VillagerInfo type;
+		uint32_t age;
+	};
+
 	static entt::entity Create(const glm::vec3& abodePosition, const glm::vec3& position, VillagerInfo type, uint32_t age);
+	/// Create all villagers at once, each component type is inserted as a single range.
+	/// Towns and abodes must already exist as villagers are housed in them.
+	static void CreateBatch(std::span<const Parameters> villagers);
 	VillagerArchetype() = delete;
 };
 } // namespace openblack::ecs::archetypes
@@ -11,6 +11,8 @@
 
 #include <set>
 
+#include <entt/fwd.hpp>
+
 #include "Enums.h"
 
 namespace openblack::ecs::components
@@ -27,7 +27,14 @@ struct AudioEmitter
 	glm::vec2 radius;
 	float volume = 0;
 	audio::PlayType loop = audio::PlayType::Once;
+	/// What the emitter should be doing, the source may be missing while it is virtual or its sound is decoding
 	audio::AudioStatus state = audio::AudioStatus::Playing;
 	bool relative;
+	/// Seconds into the sound, kept by AudioManager while the emitter has no source
+	float playbackTime = 0;
+	/// Parameters last sent to the source, an emitter which didn't change isn't sent again
+	glm::vec3 sourcePosition {};
+	float sourceVolume = 0;
+	bool sourceLoop = false;
 };
 } // namespace openblack::ecs::components
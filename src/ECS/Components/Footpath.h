@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include <glm/vec3.hpp>
@@ -26,7 +27,10 @@ struct Footpath
 		glm::vec3 position;
 	};
 
+	/// Nodes are connected to the next one in the list, there is no other adjacency to store
 	std::vector<Node> nodes;
+
+	[[nodiscard]] size_t EdgeCount() const { return nodes.empty() ? 0 : nodes.size() - 1; }
 };
 
 /// Links a [Planned]MultiMapFixed entity to a list of footpaths
@@ -9,8 +9,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <LinearMath/btDefaultMotionState.h>
+
+#include "Dynamics/EntityMotionState.h"
 
 namespace openblack::ecs::components
 {
@@ -19,11 +22,11 @@ struct RigidBody
 {
 	btRigidBody handle;
 	// TODO(bwrsandman): it would be more cache friendly to not use a pointer here
-	std::unique_ptr<btDefaultMotionState> motionState;
+	std::unique_ptr<dynamics::EntityMotionState> motionState;
 
 	RigidBody(const btRigidBody::btRigidBodyConstructionInfo& info, const btTransform& startTransform)
 	    : handle {info}
-	    , motionState(std::make_unique<btDefaultMotionState>(startTransform))
+	    , motionState(std::make_unique<dynamics::EntityMotionState>(startTransform))
 	{
 		handle.setMotionState(motionState.get());
 	}
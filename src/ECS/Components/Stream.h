@@ -9,11 +9,12 @@
 
 #pragma once
 
-#include <algorithm>
-#include <string>
+#include <cstdint>
+#include <limits>
+#include <span>
 #include <vector>
 
-#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
 #include <glm/vec3.hpp>
 
 #include "Enums.h"
@@ -21,44 +22,56 @@
 namespace openblack::ecs::components
 {
 
+/// A graph of stream nodes stored as flat arrays.
+/// Adjacency is in compressed sparse row form: the edges of node i are edges[edgeOffsets[i]] up to edges[edgeOffsets[i + 1]]
 struct Stream
 {
 	using Id = int;
+	using NodeIndex = uint32_t;
 
-	// NOLINTNEXTLINE(misc-no-recursion): lint error, this isn't a function
-	class Node
+	struct Node
 	{
-	public:
 		glm::vec3 position;
-		std::vector<Node> edges;
+	};
+
+	Stream::Id id;
+	std::vector<Node> nodes;
+	std::vector<uint32_t> edgeOffsets {0};
+	std::vector<NodeIndex> edges;
 
-		Node(const glm::vec3& position, const std::vector<Node>& nodes)
-		    : position(position)
+	/// Append a node, linking it to the closest existing node if that one is near enough
+	void AddNode(const glm::vec3& position)
+	{
+		auto closest = std::numeric_limits<float>::infinity();
+		auto closestIndex = static_cast<NodeIndex>(nodes.size());
+		for (NodeIndex i = 0; const auto& node : nodes)
 		{
-			if (nodes.empty())
+			const auto distance2 = glm::distance2(position, node.position);
+			if (distance2 < closest)
 			{
-				return;
+				closest = distance2;
+				closestIndex = i;
 			}
+			++i;
+		}
 
-			auto element =
-			    std::min_element(std::cbegin(nodes), std::cend(nodes), [&position](const auto& first, const auto& second) {
-				    auto firstDistance = glm::distance(position, first.position);
-				    auto secondDistance = glm::distance(position, second.position);
-				    return firstDistance < secondDistance;
-			    });
-
-			if (glm::distance(position, element->position) < k_MaxNodeDistance)
-			{
-				edges.push_back(*element);
-			}
+		nodes.push_back({position});
+		if (closest < k_MaxNodeDistance * k_MaxNodeDistance)
+		{
+			edges.push_back(closestIndex);
 		}
+		edgeOffsets.push_back(static_cast<uint32_t>(edges.size()));
+	}
 
-	private:
-		const static auto k_MaxNodeDistance = 100;
-	};
+	[[nodiscard]] std::span<const NodeIndex> Edges(NodeIndex node) const
+	{
+		return std::span(edges).subspan(edgeOffsets[node], edgeOffsets[node + 1] - edgeOffsets[node]);
+	}
 
-	Stream::Id id;
-	std::vector<Node> nodes;
+	[[nodiscard]] size_t EdgeCount() const { return edges.size(); }
+
+private:
+	static constexpr float k_MaxNodeDistance = 100.0f;
 };
 
 } // namespace openblack::ecs::components
@@ -0,0 +1,27 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec3.hpp>
+
+namespace openblack::ecs::components
+{
+
+/// Transform of a moving entity at the start of the current game turn.
+/// Game logic only moves entities once per turn, rendering blends from this snapshot to the entity's Transform by the
+/// fraction of the turn which has elapsed.
+struct TurnSnapshot
+{
+	glm::vec3 position;
+	glm::mat3 rotation;
+};
+
+} // namespace openblack::ecs::components
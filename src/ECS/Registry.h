@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <iterator>
+
 #include <entt/entity/entity.hpp>
 #include <entt/entity/helper.hpp>
 #include <entt/entity/registry.hpp>
@@ -57,6 +59,20 @@ class Registry
 		SetDirty();
 		return _registry.emplace<Component>(entity, std::forward<Args>(args)...);
 	}
+	/// Assign the same component value to a range of entities, the storage is only grown once
+	template <typename Component, typename It>
+	void Insert(It first, It last, const Component& value = {})
+	{
+		SetDirty();
+		_registry.insert<Component>(std::move(first), std::move(last), value);
+	}
+	/// Assign a range of components to a range of entities of the same length, the storage is only grown once
+	template <typename Component, typename EntityIt, std::input_iterator ComponentIt>
+	void Insert(EntityIt first, EntityIt last, ComponentIt from)
+	{
+		SetDirty();
+		_registry.insert<Component>(std::move(first), std::move(last), std::move(from));
+	}
 	template <typename Component, typename... Args>
 	decltype(auto) AssignOrReplace(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
@@ -76,6 +92,17 @@ class Registry
 		Remove<Before>(entity);
 		return Assign<After>(entity, std::forward<Args>(args)...);
 	}
+	/// Call Candidate on instance before a Component is removed, including when its entity is destroyed or on Reset
+	template <typename Component, auto Candidate, typename Type>
+	void ConnectOnDestroy(Type& instance)
+	{
+		_registry.on_destroy<Component>().template connect<Candidate>(instance);
+	}
+	template <typename Component, typename Type>
+	void DisconnectOnDestroy(Type& instance)
+	{
+		_registry.on_destroy<Component>().disconnect(&instance);
+	}
 	virtual void SetDirty();
 	virtual RegistryContext& Context();
 	[[nodiscard]] virtual const RegistryContext& Context() const;
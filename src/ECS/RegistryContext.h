@@ -9,10 +9,12 @@
 
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 
 #include <entt/entity/fwd.hpp>
 
+#include "Archetypes/LevelConstructionBatch.h"
 #include "Components/Footpath.h"
 #include "Components/Stream.h"
 #include "Components/Town.h"
@@ -24,5 +26,7 @@ struct RegistryContext
 	std::unordered_map<components::Footpath::Id, entt::entity> footpaths;
 	std::unordered_map<components::Stream::Id, entt::entity> streams;
 	std::unordered_map<uint32_t, entt::entity> towns;
+	/// Set while a script is loading, archetypes which support it are queued here instead of being created one by one
+	std::optional<archetypes::LevelConstructionBatch> constructionBatch;
 };
 } // namespace openblack::ecs
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <optional>
 #include <tuple>
 
@@ -51,6 +52,10 @@ class DynamicsSystemInterface
 	virtual void RegisterRigidBodies() = 0;
 	virtual void RegisterIslandRigidBodies(LandIslandInterface& island) = 0;
 	virtual void UpdatePhysicsTransforms() = 0;
+	/// Number of simulation steps taken by the last Update
+	[[nodiscard]] virtual uint32_t GetSubStepCount() const = 0;
+	/// How far between the last two simulation steps rendered transforms are, in [0, 1]
+	[[nodiscard]] virtual float GetInterpolationFactor() const = 0;
 	[[nodiscard]] virtual std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const = 0;
 };
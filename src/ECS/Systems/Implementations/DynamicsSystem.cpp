@@ -11,22 +11,29 @@
 
 #include "DynamicsSystem.h"
 
+#include <cmath>
 #include <vector>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/rotate_vector.hpp>
+#include <spdlog/spdlog.h>
 
 #include "3D/LandBlock.h"
 #include "3D/LandIslandInterface.h"
+#include "Dynamics/BulletTaskScheduler.h"
 #include "ECS/Components/RigidBody.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
+#include "EngineConfig.h"
 #include "Locator.h"
 
 using namespace openblack;
@@ -35,12 +42,32 @@ using namespace openblack::ecs::systems;
 
 DynamicsSystem::DynamicsSystem()
     : _configuration(std::make_unique<btDefaultCollisionConfiguration>())
-    , _dispatcher(std::make_unique<btCollisionDispatcher>(_configuration.get()))
     , _broadphase(std::make_unique<btDbvtBroadphase>())
-    , _solver(std::make_unique<btSequentialImpulseConstraintSolver>())
-    , _world(
-          std::make_unique<btDiscreteDynamicsWorld>(_dispatcher.get(), _broadphase.get(), _solver.get(), _configuration.get()))
 {
+	if (Locator::config::value().physicsMultithreaded)
+	{
+#if BT_THREADSAFE
+		// Bullet keeps a single global scheduler, it is set here on the main thread before any worker calls into Bullet
+		_taskScheduler = std::make_unique<dynamics::BulletTaskScheduler>(Locator::taskScheduler::value());
+		btSetTaskScheduler(_taskScheduler.get());
+		_dispatcher = std::make_unique<btCollisionDispatcherMt>(_configuration.get());
+		_solverPool = std::make_unique<btConstraintSolverPoolMt>(_taskScheduler->getNumThreads());
+		_solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+		_world = std::make_unique<btDiscreteDynamicsWorldMt>(_dispatcher.get(), _broadphase.get(), _solverPool.get(),
+		                                                     _solver.get(), _configuration.get());
+		SPDLOG_LOGGER_INFO(spdlog::get("game"), "Multithreaded physics using {} threads", _taskScheduler->getNumThreads());
+#else
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Bullet was built without BT_THREADSAFE, physics will be single threaded");
+#endif
+	}
+
+	if (_world == nullptr)
+	{
+		_dispatcher = std::make_unique<btCollisionDispatcher>(_configuration.get());
+		_solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+		_world = std::make_unique<btDiscreteDynamicsWorld>(_dispatcher.get(), _broadphase.get(), _solver.get(),
+		                                                   _configuration.get());
+	}
 	_world->setGravity(btVector3(0, -10, 0));
 }
 
@@ -60,14 +87,55 @@ void DynamicsSystem::Reset()
 	{
 		_world->removeRigidBody(obj);
 	}
+	_movedEntities.clear();
+	_accumulator = 0.0f;
+	_subStepCount = 0;
+	_interpolation = 1.0f;
 }
 
-DynamicsSystem::~DynamicsSystem() = default;
+DynamicsSystem::~DynamicsSystem()
+{
+	_world.reset();
+	// The next level's system is constructed before this one is destroyed and may have set its own scheduler already
+	if (_taskScheduler != nullptr && btGetTaskScheduler() == _taskScheduler.get())
+	{
+		btSetTaskScheduler(btGetSequentialTaskScheduler());
+	}
+}
 
 void DynamicsSystem::Update(std::chrono::microseconds& dt)
 {
-	std::chrono::duration<float> seconds = dt;
-	_world->stepSimulation(seconds.count());
+	const auto& config = Locator::config::value();
+	const std::chrono::duration<float> seconds = dt;
+	_subStepCount = 0;
+
+	if (!config.physicsFixedTimestep)
+	{
+		++_stepIndex;
+		// No substeps, Bullet steps by the frame's delta and writes the resulting state
+		_world->stepSimulation(seconds.count(), 0);
+		_subStepCount = 1;
+		_accumulator = 0.0f;
+		_interpolation = 1.0f;
+		return;
+	}
+
+	const auto step = config.physicsTimestep;
+	_accumulator += seconds.count();
+	while (_accumulator >= step && _subStepCount < config.physicsMaxSubSteps)
+	{
+		++_stepIndex;
+		_world->stepSimulation(step, 0);
+		_accumulator -= step;
+		++_subStepCount;
+	}
+
+	// Time the capped steps could not cover is dropped rather than carried into the next frames
+	if (_accumulator >= step)
+	{
+		_accumulator = std::fmod(_accumulator, step);
+	}
+	_interpolation = _accumulator / step;
 }
 
 void DynamicsSystem::AddRigidBody(btRigidBody* object)
@@ -78,10 +146,11 @@ void DynamicsSystem::AddRigidBody(btRigidBody* object)
 void DynamicsSystem::RegisterRigidBodies()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<RigidBody>([this](RigidBody& body) {
+	registry.Each<RigidBody>([this](entt::entity entity, RigidBody& body) {
 		body.handle.setUserIndex(static_cast<int>(RigidBodyType::Entity));
 		body.handle.setUserIndex2(0);
 		body.handle.setUserPointer(this);
+		body.motionState->Track(entity, &_movedEntities, &_stepIndex);
 		AddRigidBody(&body.handle);
 	});
 }
@@ -101,10 +170,29 @@ void DynamicsSystem::RegisterIslandRigidBodies(LandIslandInterface& island)
 
 void DynamicsSystem::UpdatePhysicsTransforms()
 {
+	// Resting and static bodies are never queued, nothing needs to be redrawn if nothing moved
+	if (_movedEntities.empty())
+	{
+		return;
+	}
+
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, const RigidBody>([&registry](Transform& transform, const RigidBody& body) {
-		btTransform trans;
-		body.motionState->getWorldTransform(trans);
+	std::erase_if(_movedEntities, [this, &registry](entt::entity entity) {
+		if (!registry.Valid(entity) || !registry.AllOf<Transform, RigidBody>(entity))
+		{
+			return true;
+		}
+		auto& transform = registry.Get<Transform>(entity);
+		auto& body = registry.Get<RigidBody>(entity);
+
+		// Bodies moved by the last step are drawn between their last two states until a step leaves them alone,
+		// after which they are drawn at rest and stop being visited
+		const bool interpolating = body.motionState->MovedDuring(_stepIndex) && _interpolation < 1.0f;
+		const auto trans = body.motionState->GetInterpolatedTransform(interpolating ? _interpolation : 1.0f);
+		if (!interpolating)
+		{
+			body.motionState->ClearQueued();
+		}
 
 		transform.position.x = trans.getOrigin().getX();
 		transform.position.y = trans.getOrigin().getY();
@@ -115,8 +203,10 @@ void DynamicsSystem::UpdatePhysicsTransforms()
 
 		transform.rotation = glm::mat3_cast(quaternion);
 
-		registry.SetDirty();
+		return !interpolating;
 	});
+
+	registry.SetDirty();
 }
 
 std::optional<std::pair<Transform, RigidBodyDetails>>
@@ -10,6 +10,9 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
+#include <entt/entity/fwd.hpp>
 
 #include "ECS/Systems/DynamicsSystemInterface.h"
 
@@ -18,6 +21,7 @@
 #endif
 
 class btCollisionDispatcher;
+class btConstraintSolverPoolMt;
 class btDefaultCollisionConfiguration;
 class btDiscreteDynamicsWorld;
 struct btDbvtBroadphase;
@@ -26,6 +30,10 @@ class btSequentialImpulseConstraintSolver;
 namespace openblack
 {
 class LandIslandInterface;
+namespace dynamics
+{
+class BulletTaskScheduler;
+}
 namespace ecs::components
 {
 struct Transform;
@@ -47,6 +55,8 @@ class DynamicsSystem final: public DynamicsSystemInterface
 	void RegisterRigidBodies() override;
 	void RegisterIslandRigidBodies(LandIslandInterface& island) override;
 	void UpdatePhysicsTransforms() override;
+	[[nodiscard]] uint32_t GetSubStepCount() const override { return _subStepCount; }
+	[[nodiscard]] float GetInterpolationFactor() const override { return _interpolation; }
 	[[nodiscard]] std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const override;
 
@@ -61,5 +71,16 @@ class DynamicsSystem final: public DynamicsSystemInterface
 	/// different solver (see Extras/BulletMultiThreaded)
 	std::unique_ptr<btSequentialImpulseConstraintSolver> _solver;
 	std::unique_ptr<btDiscreteDynamicsWorld> _world;
+	/// Only set for the multithreaded world, runs Bullet's parallel loops and holds one solver per thread
+	std::unique_ptr<dynamics::BulletTaskScheduler> _taskScheduler;
+	std::unique_ptr<btConstraintSolverPoolMt> _solverPool;
+	/// Entities whose rendered transform still has to follow their body, filled by their motion state
+	std::vector<entt::entity> _movedEntities;
+	/// Simulation time not yet stepped in fixed timestep mode
+	float _accumulator {0.0f};
+	/// Total number of simulation steps, motion states remember the last one which moved them
+	uint64_t _stepIndex {0};
+	uint32_t _subStepCount {0};
+	float _interpolation {1.0f};
 };
 } // namespace openblack::ecs::systems
@@ -18,6 +18,7 @@
 #include "ECS/Registry.h"
 #include "Enums.h"
 #include "Locator.h"
+#include "Profiler.h"
 
 using namespace openblack;
 using namespace openblack::ecs::components;
@@ -389,26 +390,38 @@ const static std::array<VillagerStateTableEntry, static_cast<size_t>(VillagerSta
 void LivingActionSystem::Update()
 {
 	auto& registry = Locator::entitiesRegistry::value();
+	int64_t entityCount = 0;
 
-	registry.Each<LivingAction>([](LivingAction& action) { ++action.turnsSinceStateChange; });
+	registry.Each<LivingAction>([&entityCount](LivingAction& action) {
+		++action.turnsSinceStateChange;
+		++entityCount;
+	});
 
 	// TODO(#475): process food speedup
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Top);
-	});
+	registry.Each<const Villager, LivingAction>(
+	    [this, &entityCount]([[maybe_unused]] const Villager& villager, LivingAction& action) {
+		    VillagerCallValidate(action, LivingAction::Index::Top);
+		    ++entityCount;
+	    });
 	// TODO(#476): same call but for other types of living
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Final);
-	});
+	registry.Each<const Villager, LivingAction>(
+	    [this, &entityCount]([[maybe_unused]] const Villager& villager, LivingAction& action) {
+		    VillagerCallValidate(action, LivingAction::Index::Final);
+		    ++entityCount;
+	    });
 	// TODO(#476): same call but for other types of living
 
 	// TODO(bwrsandman): Store result of this call in vector or with tag component
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallState(action, LivingAction::Index::Top);
-	});
+	registry.Each<const Villager, LivingAction>(
+	    [this, &entityCount]([[maybe_unused]] const Villager& villager, LivingAction& action) {
+		    VillagerCallState(action, LivingAction::Index::Top);
+		    ++entityCount;
+	    });
 	// TODO(#476): same call but for other types of living
+
+	Locator::profiler::value().Count(Profiler::Counter::EntitiesIterated, entityCount);
 }
 
 VillagerStates LivingActionSystem::VillagerGetState(const LivingAction& action, LivingAction::Index index) const
@@ -11,6 +11,8 @@
 
 #include "RenderingSystem.h"
 
+#include <algorithm>
+
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
@@ -19,10 +21,12 @@
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Components/TurnSnapshot.h"
 #include "ECS/Registry.h"
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
 #include "Locator.h"
+#include "Profiler.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack::ecs::systems;
@@ -91,17 +95,24 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	std::map<entt::id_type, uint32_t> uniformOffsets;
 
 	// Set transforms for instanced draw at offsets
+	int64_t entityCount = 0;
+	_turnSnapshotSlots.clear();
 	registry.Each<const Mesh, const Transform>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform) {
+	    [this, &registry, &uniformOffsets, &entityCount, drawBoundingBox](entt::entity entity, const Mesh& mesh,
+	                                                                      const Transform& transform) {
+		    ++entityCount;
 		    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
 		    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
 
-		    auto modelMatrix = glm::mat4(transform.rotation);
-		    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
-		    modelMatrix = glm::scale(modelMatrix, transform.scale);
+		    const auto* snapshot = registry.TryGet<const TurnSnapshot>(entity);
+		    const auto modelMatrix = GetModelMatrix(transform, snapshot);
 
 		    const uint32_t idx = desc->second.offset + offset.first->second;
 		    _renderContext.instanceUniforms[idx] = modelMatrix;
+		    if (snapshot != nullptr)
+		    {
+			    _turnSnapshotSlots.push_back({entity, idx});
+		    }
 		    if (drawBoundingBox)
 		    {
 			    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
@@ -112,10 +123,14 @@ void RenderingSystem::PrepareDrawUploadUniforms(bool drawBoundingBox)
 		    offset.first->second++;
 	    },
 	    entt::exclude<TempleInteriorPart>);
+	std::ranges::sort(_turnSnapshotSlots, {}, &TurnSnapshotSlot::index);
 
+	auto& profiler = Locator::profiler::value();
+	profiler.Count(Profiler::Counter::EntitiesIterated, entityCount);
 	if (!_renderContext.instanceUniforms.empty())
 	{
 		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
 		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(_renderContext.instanceUniforms.data(), size));
+		profiler.Count(Profiler::Counter::BytesUploaded, size);
 	}
 }
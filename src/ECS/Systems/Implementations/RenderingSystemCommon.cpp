@@ -11,18 +11,25 @@
 
 #include "RenderingSystemCommon.h"
 
+#include <algorithm>
+
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
+#include "Camera/Camera.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/MorphWithTerrain.h"
 #include "ECS/Components/Stream.h"
 #include "ECS/Components/Temple.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Components/TurnSnapshot.h"
+#include "ECS/Components/WallHug.h"
 #include "ECS/Registry.h"
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
 #include "Locator.h"
+#include "Profiler.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack::ecs::systems;
@@ -49,6 +56,42 @@ void RenderingSystemCommon::SetDirty()
 	_renderContext.dirty = true;
 }
 
+void RenderingSystemCommon::SnapshotTurnTransforms()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+
+	// Entities which stopped wall hugging are no longer moved by turns and are drawn where they are
+	std::vector<entt::entity> stopped;
+	registry.Each<const TurnSnapshot>(
+	    [&stopped](entt::entity entity, const TurnSnapshot& /*unused*/) { stopped.push_back(entity); },
+	    entt::exclude<WallHug>);
+	for (const auto entity : stopped)
+	{
+		registry.Remove<TurnSnapshot>(entity);
+	}
+
+	// Snapshots are updated in place so a turn where nothing moved doesn't rebuild every draw desc
+	bool changed = false;
+	registry.Each<const WallHug, const Transform>(
+	    [&registry, &changed](entt::entity entity, const WallHug& /*unused*/, const Transform& transform) {
+		    auto* snapshot = registry.TryGet<TurnSnapshot>(entity);
+		    if (snapshot == nullptr)
+		    {
+			    registry.Assign<TurnSnapshot>(entity, transform.position, transform.rotation);
+		    }
+		    else if (snapshot->position != transform.position || snapshot->rotation != transform.rotation)
+		    {
+			    snapshot->position = transform.position;
+			    snapshot->rotation = transform.rotation;
+			    changed = true;
+		    }
+	    });
+	if (changed)
+	{
+		SetDirty();
+	}
+}
+
 void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams)
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -68,16 +111,15 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 		_renderContext.footpaths.reset();
 		if (drawFootpaths)
 		{
-			uint32_t nodeCount = 0;
-			registry.Each<const Footpath>(
-			    [&nodeCount](const Footpath& ent) { nodeCount += 2 * std::max(static_cast<int>(ent.nodes.size()) - 1, 0); });
+			size_t edgeCount = 0;
+			registry.Each<const Footpath>([&edgeCount](const Footpath& ent) { edgeCount += ent.EdgeCount(); });
 
 			std::vector<graphics::DebugLines::Vertex> edges;
-			edges.reserve(nodeCount);
+			edges.reserve(edgeCount * 2);
 			registry.Each<const Footpath>([&edges](const Footpath& ent) {
 				const auto color = glm::vec4(0, 1, 0, 1);
 				const auto offset = glm::vec3(0, 1, 0);
-				for (int i = 0; i < static_cast<int>(ent.nodes.size()) - 1; ++i)
+				for (size_t i = 0; i < ent.EdgeCount(); ++i)
 				{
 					edges.push_back({glm::vec4(ent.nodes[i].position + offset, 1.0f), color});
 					edges.push_back({glm::vec4(ent.nodes[i + 1].position + offset, 1.0f), color});
@@ -93,23 +135,18 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 		_renderContext.streams.reset();
 		if (drawStreams)
 		{
-			uint32_t edgeCount = 0;
-			registry.Each<const Stream>([&edgeCount](const Stream& ent) {
-				for (const auto& from : ent.nodes)
-				{
-					edgeCount += static_cast<uint32_t>(from.edges.size());
-				}
-			});
+			size_t edgeCount = 0;
+			registry.Each<const Stream>([&edgeCount](const Stream& ent) { edgeCount += ent.EdgeCount(); });
 			std::vector<graphics::DebugLines::Vertex> edges;
 			edges.reserve(edgeCount * 2);
 			registry.Each<const Stream>([&edges](const Stream& ent) {
 				const auto color = glm::vec4(1, 0, 0, 1);
-				for (const auto& from : ent.nodes)
+				for (Stream::NodeIndex from = 0; from < static_cast<Stream::NodeIndex>(ent.nodes.size()); ++from)
 				{
-					for (const auto& to : from.edges)
+					for (const auto to : ent.Edges(from))
 					{
-						edges.push_back({glm::vec4(from.position, 1.0f), color});
-						edges.push_back({glm::vec4(to.position, 1.0f), color});
+						edges.push_back({glm::vec4(ent.nodes[from].position, 1.0f), color});
+						edges.push_back({glm::vec4(ent.nodes[to].position, 1.0f), color});
 					}
 				}
 			});
@@ -124,4 +161,108 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 		_renderContext.dirty = false;
 		_renderContext.hasBoundingBoxes = drawBoundingBox;
 	}
+	else
+	{
+		// Instances are unchanged but entities moved by the current turn are blended a little further each frame
+		PrepareDrawUploadTurnSnapshotUniforms(drawBoundingBox);
+	}
+
+	if (++_framesSinceMeshDistances >= k_MeshDistanceInterval)
+	{
+		UpdateMeshDistances();
+		_framesSinceMeshDistances = 0;
+	}
+}
+
+glm::mat4 RenderingSystemCommon::GetModelMatrix(const Transform& transform, const TurnSnapshot* snapshot) const
+{
+	auto position = transform.position;
+	auto rotation = transform.rotation;
+	if (snapshot != nullptr && _turnFraction < 1.0f)
+	{
+		position = glm::mix(snapshot->position, transform.position, _turnFraction);
+		rotation = glm::mat3_cast(
+		    glm::slerp(glm::quat_cast(snapshot->rotation), glm::quat_cast(transform.rotation), _turnFraction));
+	}
+
+	auto modelMatrix = glm::mat4(rotation);
+	modelMatrix = glm::translate(modelMatrix, position * rotation);
+	modelMatrix = glm::scale(modelMatrix, transform.scale);
+	return modelMatrix;
+}
+
+void RenderingSystemCommon::PrepareDrawUploadTurnSnapshotUniforms(bool drawBoundingBox)
+{
+	if (_turnSnapshotSlots.empty())
+	{
+		return;
+	}
+
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto boxOffset = static_cast<uint32_t>(_renderContext.instanceUniforms.size() / 2);
+	for (const auto& slot : _turnSnapshotSlots)
+	{
+		if (!registry.Valid(slot.entity) || !registry.AllOf<Mesh, Transform, TurnSnapshot>(slot.entity))
+		{
+			continue;
+		}
+		const auto& transform = registry.Get<const Transform>(slot.entity);
+		const auto modelMatrix = GetModelMatrix(transform, &registry.Get<const TurnSnapshot>(slot.entity));
+		_renderContext.instanceUniforms[slot.index] = modelMatrix;
+		if (drawBoundingBox)
+		{
+			const auto& mesh = registry.Get<const Mesh>(slot.entity);
+			auto box = Locator::resources::value().GetMeshes().Handle(mesh.id)->GetBoundingBox();
+			_renderContext.instanceUniforms[slot.index + boxOffset] =
+			    modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
+		}
+	}
+
+	// Each run of consecutive slots is uploaded at once, bounding boxes are in the same order in the second half
+	uint32_t uploaded = 0;
+	const auto upload = [this, &uploaded](uint32_t first, uint32_t count) {
+		const auto size = static_cast<uint32_t>(count * sizeof(glm::mat4));
+		bgfx::update(_renderContext.instanceUniformBuffer, first,
+		             bgfx::makeRef(&_renderContext.instanceUniforms[first], size));
+		uploaded += size;
+	};
+	for (size_t begin = 0; begin < _turnSnapshotSlots.size();)
+	{
+		auto end = begin + 1;
+		while (end < _turnSnapshotSlots.size() &&
+		       _turnSnapshotSlots[end].index == _turnSnapshotSlots[end - 1].index + 1)
+		{
+			++end;
+		}
+		const auto first = _turnSnapshotSlots[begin].index;
+		const auto count = static_cast<uint32_t>(end - begin);
+		upload(first, count);
+		if (drawBoundingBox)
+		{
+			upload(first + boxOffset, count);
+		}
+		begin = end;
+	}
+
+	if (Locator::profiler::has_value())
+	{
+		auto& profiler = Locator::profiler::value();
+		profiler.Count(Profiler::Counter::EntitiesIterated, static_cast<int64_t>(_turnSnapshotSlots.size()));
+		profiler.Count(Profiler::Counter::BytesUploaded, uploaded);
+	}
+}
+
+void RenderingSystemCommon::UpdateMeshDistances()
+{
+	const auto origin = Locator::camera::value().GetOrigin();
+	_renderContext.meshDistances.clear();
+	Locator::entitiesRegistry::value().Each<const Mesh, const Transform>(
+	    [this, &origin](const Mesh& mesh, const Transform& transform) {
+		    const auto distance = glm::distance(origin, transform.position);
+		    const auto [closest, inserted] = _renderContext.meshDistances.try_emplace(mesh.id, distance);
+		    if (!inserted)
+		    {
+			    closest->second = std::min(closest->second, distance);
+		    }
+	    });
 }
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <bgfx/bgfx.h>
+#include <entt/entity/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
 #include "3D/AllMeshes.h"
@@ -22,22 +23,50 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+namespace openblack::ecs::components
+{
+struct Transform;
+struct TurnSnapshot;
+} // namespace openblack::ecs::components
+
 namespace openblack::ecs::systems
 {
 
 class RenderingSystemCommon: public RenderingSystemInterface
 {
 public:
+	/// Frames between refreshes of RenderContext::meshDistances, texture streaming doesn't need to follow every frame
+	static constexpr uint32_t k_MeshDistanceInterval = 10;
+
 	~RenderingSystemCommon();
 	void SetDirty() override;
+	void SnapshotTurnTransforms() override;
+	void SetTurnFraction(float fraction) override { _turnFraction = fraction; }
 	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) override;
 	const RenderContext& GetContext() override { return _renderContext; }
 
 private:
 	virtual void PrepareDrawDescs(bool drawBoundingBox) = 0;
 	virtual void PrepareDrawUploadUniforms(bool drawBoundingBox) = 0;
+	/// Rewrite and upload only the instances in \ref _turnSnapshotSlots, between turns nothing else moves
+	void PrepareDrawUploadTurnSnapshotUniforms(bool drawBoundingBox);
+	void UpdateMeshDistances();
 
 protected:
+	struct TurnSnapshotSlot
+	{
+		entt::entity entity;
+		uint32_t index;
+	};
+
+	/// Model matrix of an instance, entities moved by game turns are blended from where they were at the start of the turn
+	[[nodiscard]] glm::mat4 GetModelMatrix(const components::Transform& transform,
+	                                       const components::TurnSnapshot* snapshot) const;
+
 	RenderContext _renderContext;
+	/// Instance uniforms of entities with a turn snapshot in index order, filled when all uniforms are uploaded
+	std::vector<TurnSnapshotSlot> _turnSnapshotSlots;
+	float _turnFraction {1.0f};
+	uint32_t _framesSinceMeshDistances {k_MeshDistanceInterval};
 };
 } // namespace openblack::ecs::systems
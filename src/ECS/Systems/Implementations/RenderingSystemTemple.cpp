@@ -23,6 +23,7 @@
 #include "Graphics/DebugLines.h"
 #include "Graphics/ShaderManager.h"
 #include "Locator.h"
+#include "Profiler.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack::ecs::systems;
@@ -109,9 +110,11 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	std::map<entt::id_type, uint32_t> uniformOffsets;
 
 	// Set transforms for instanced draw at offsets
+	int64_t entityCount = 0;
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
-	                                             const TempleInteriorPart& templePart) {
+	    [this, &uniformOffsets, &entityCount, drawBoundingBox](const Mesh& mesh, const Transform& transform,
+	                                                           const TempleInteriorPart& templePart) {
+		    ++entityCount;
 		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
 
 		    if (_loadedRooms.contains(templePart.room))
@@ -135,9 +138,12 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 		    }
 	    });
 
+	auto& profiler = Locator::profiler::value();
+	profiler.Count(Profiler::Counter::EntitiesIterated, entityCount);
 	if (!_renderContext.instanceUniforms.empty())
 	{
 		const auto size = static_cast<uint32_t>(_renderContext.instanceUniforms.size() * sizeof(glm::mat4));
 		bgfx::update(_renderContext.instanceUniformBuffer, 0, bgfx::makeRef(_renderContext.instanceUniforms.data(), size));
+		profiler.Count(Profiler::Counter::BytesUploaded, size);
 	}
 }
@@ -11,6 +11,12 @@
 
 #include "TownSystem.h"
 
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtx/component_wise.hpp>
+#include <glm/gtx/norm.hpp>
+
 #include "ECS/Components/Abode.h"
 #include "ECS/Components/Town.h"
 #include "ECS/Components/Transform.h"
@@ -22,44 +28,171 @@
 using namespace openblack::ecs::components;
 using namespace openblack::ecs::systems;
 
-entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
+namespace
+{
+constexpr float k_TownGridCellSize = 256.0f;
+
+glm::ivec2 TownGridCell(const glm::vec3& point)
+{
+	return glm::ivec2(glm::floor(glm::vec2(point.x, point.z) / k_TownGridCellSize));
+}
+
+uint64_t TownGridKey(const glm::ivec2& cell)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32) | static_cast<uint32_t>(cell.y);
+}
+} // namespace
+
+TownSystem::TownSystem()
 {
-	const auto& infoConstants = Locator::infoConstants::value();
 	auto& registry = Locator::entitiesRegistry::value();
-	const auto& town = registry.Get<Town>(townEntity);
+	registry.ConnectOnDestroy<Town, &TownSystem::OnTownDestroyed>(*this);
+	registry.ConnectOnDestroy<Abode, &TownSystem::OnAbodeDestroyed>(*this);
+}
 
-	entt::entity result = entt::null;
-	registry.Each<const Abode>([&town, &infoConstants, &result](entt::entity entity, auto component) {
-		if (result != entt::null || component.townId != town.id)
+TownSystem::~TownSystem()
+{
+	if (Locator::entitiesRegistry::has_value())
+	{
+		auto& registry = Locator::entitiesRegistry::value();
+		registry.DisconnectOnDestroy<Town>(*this);
+		registry.DisconnectOnDestroy<Abode>(*this);
+	}
+}
+
+void TownSystem::OnTownDestroyed(entt::registry& /*unused*/, entt::entity townEntity)
+{
+	// The town's transform may already be gone, there are few enough towns to look through every cell
+	for (auto cell = _townGrid.begin(); cell != _townGrid.end(); ++cell)
+	{
+		auto& towns = cell->second;
+		if (auto found = std::ranges::find(towns, townEntity, &GridTown::entity); found != towns.end())
 		{
+			*found = towns.back();
+			towns.pop_back();
+			if (towns.empty())
+			{
+				_townGrid.erase(cell);
+			}
 			return;
 		}
-		const auto& info = infoConstants.abode.at(static_cast<size_t>(component.type));
-		if (static_cast<uint32_t>(component.inhabitants.size()) < info.maxVillagersInAbode)
-		{
-			result = entity;
-		}
-	});
+	}
+}
 
-	return result;
+void TownSystem::OnAbodeDestroyed(entt::registry& registry, entt::entity abodeEntity)
+{
+	auto iter = _abodesWithSpace.find(registry.get<const Abode>(abodeEntity).townId);
+	if (iter == _abodesWithSpace.end())
+	{
+		return;
+	}
+	auto& abodes = iter->second;
+	if (auto found = std::ranges::find(abodes, abodeEntity); found != abodes.end())
+	{
+		*found = abodes.back();
+		abodes.pop_back();
+	}
+}
+
+void TownSystem::AddTown(entt::entity townEntity)
+{
+	const auto& position = Locator::entitiesRegistry::value().Get<Transform>(townEntity).position;
+	const auto cell = TownGridCell(position);
+	_townGrid[TownGridKey(cell)].emplace_back(GridTown {position, townEntity});
+	_townGridMin = glm::min(_townGridMin, cell);
+	_townGridMax = glm::max(_townGridMax, cell);
+}
+
+void TownSystem::AddAbode(entt::entity abodeEntity)
+{
+	const auto& abode = Locator::entitiesRegistry::value().Get<Abode>(abodeEntity);
+	const auto& info = Locator::infoConstants::value().abode.at(static_cast<size_t>(abode.type));
+	if (static_cast<uint32_t>(abode.inhabitants.size()) < info.maxVillagersInAbode)
+	{
+		_abodesWithSpace[abode.townId].push_back(abodeEntity);
+	}
+}
+
+void TownSystem::AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity)
+{
+	auto& abode = Locator::entitiesRegistry::value().Get<Abode>(abodeEntity);
+	abode.inhabitants.insert(villagerEntity);
+
+	const auto& info = Locator::infoConstants::value().abode.at(static_cast<size_t>(abode.type));
+	if (static_cast<uint32_t>(abode.inhabitants.size()) < info.maxVillagersInAbode)
+	{
+		return;
+	}
+	auto iter = _abodesWithSpace.find(abode.townId);
+	if (iter == _abodesWithSpace.end())
+	{
+		return;
+	}
+	auto& abodes = iter->second;
+	if (auto found = std::ranges::find(abodes, abodeEntity); found != abodes.end())
+	{
+		*found = abodes.back();
+		abodes.pop_back();
+	}
+}
+
+entt::entity TownSystem::FindAbodeWithSpace(entt::entity townEntity) const
+{
+	const auto& town = Locator::entitiesRegistry::value().Get<Town>(townEntity);
+
+	auto iter = _abodesWithSpace.find(town.id);
+	if (iter == _abodesWithSpace.end() || iter->second.empty())
+	{
+		return entt::null;
+	}
+	return iter->second.back();
 }
 
 entt::entity TownSystem::FindClosestTown(const glm::vec3& point) const
 {
-	const auto& registry = Locator::entitiesRegistry::value();
+	if (_townGrid.empty())
+	{
+		return entt::null;
+	}
 
 	entt::entity result = entt::null;
 	auto closest = std::numeric_limits<float>::infinity();
 
-	registry.Each<const Town, const Transform>(
-	    [&point, &result, &closest](entt::entity entity, [[maybe_unused]] auto& town, [[maybe_unused]] auto& transform) {
-		    float distance2 = glm::dot(point, transform.position);
-		    if (distance2 < closest)
-		    {
-			    closest = distance2;
-			    result = entity;
-		    }
-	    });
+	// Visit the grid in square rings of cells around the point, rings past the occupied bounds can't contain a town
+	const auto origin = TownGridCell(point);
+	const auto maxRing = glm::compMax(glm::max(glm::abs(origin - _townGridMin), glm::abs(_townGridMax - origin)));
+	for (int ring = 0; ring <= maxRing; ++ring)
+	{
+		// Towns in this ring or further out are at least this far away
+		const auto ringDistance = static_cast<float>(ring - 1) * k_TownGridCellSize;
+		if (ring > 1 && ringDistance * ringDistance > closest)
+		{
+			break;
+		}
+
+		for (int y = -ring; y <= ring; ++y)
+		{
+			// Only the top and bottom rows of the ring are visited in full, other rows only have their two ends
+			const int step = (y == -ring || y == ring) ? 1 : 2 * ring;
+			for (int x = -ring; x <= ring; x += step)
+			{
+				auto cell = _townGrid.find(TownGridKey(origin + glm::ivec2(x, y)));
+				if (cell == _townGrid.end())
+				{
+					continue;
+				}
+				for (const auto& town : cell->second)
+				{
+					const auto distance2 = glm::distance2(point, town.position);
+					if (distance2 < closest)
+					{
+						closest = distance2;
+						result = town.entity;
+					}
+				}
+			}
+		}
+	}
 
 	return result;
 }
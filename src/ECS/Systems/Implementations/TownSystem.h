@@ -9,6 +9,14 @@
 
 #pragma once
 
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
 #include "ECS/Systems/TownSystemInterface.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -21,8 +29,33 @@ namespace openblack::ecs::systems
 class TownSystem final: public TownSystemInterface
 {
 public:
+	TownSystem();
+	~TownSystem();
+
+	void AddTown(entt::entity townEntity) override;
+	void AddAbode(entt::entity abodeEntity) override;
+	void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) override;
 	[[nodiscard]] entt::entity FindAbodeWithSpace(entt::entity townEntity) const override;
 	[[nodiscard]] entt::entity FindClosestTown(const glm::vec3& point) const override;
 	void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) override;
+
+private:
+	/// Towns and abodes which are destroyed, or lose their component, are no longer offered
+	void OnTownDestroyed(entt::registry& registry, entt::entity townEntity);
+	void OnAbodeDestroyed(entt::registry& registry, entt::entity abodeEntity);
+
+	struct GridTown
+	{
+		glm::vec3 position;
+		entt::entity entity;
+	};
+
+	/// Towns bucketed in a uniform grid over the xz plane, keyed by packed cell coordinates
+	std::unordered_map<uint64_t, std::vector<GridTown>> _townGrid;
+	/// Bounds of the occupied grid cells, nearest town searches don't go past them
+	glm::ivec2 _townGridMin {INT_MAX};
+	glm::ivec2 _townGridMax {INT_MIN};
+	/// Abodes which have not reached their maximum number of villagers, keyed by Town::id
+	std::unordered_map<uint32_t, std::vector<entt::entity>> _abodesWithSpace;
 };
 } // namespace openblack::ecs::systems
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 
 #include <bgfx/bgfx.h>
 #include <entt/fwd.hpp>
@@ -49,6 +50,9 @@ struct RenderContext
 	std::vector<glm::mat4> instanceUniforms;
 	/// Stores information for rendering which is prepared at \ref PrepareDraw.
 	std::map<entt::id_type, const InstancedDrawDesc> instancedDrawDescs;
+	/// Distance from the camera to the closest instance of each mesh, refreshed every few calls to \ref PrepareDraw.
+	/// The textures of a mesh are streamed in at the resolution this distance calls for.
+	std::unordered_map<entt::id_type, float> meshDistances;
 	/// Not an actual vertex buffer, but a dynamic general purpose buffer which
 	/// stores uniform data as a GPU-side copy of \ref _instanceUniforms and
 	/// which is populated in \ref PrepareDraw and consumed in \ref DrawModels.
@@ -66,6 +70,10 @@ class RenderingSystemInterface
 {
 public:
 	virtual void SetDirty() = 0;
+	/// Remember the transforms of moving entities before a game turn moves them
+	virtual void SnapshotTurnTransforms() = 0;
+	/// Set how far the current game turn has progressed, in [0, 1], to blend moving entities from their snapshot
+	virtual void SetTurnFraction(float fraction) = 0;
 	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) = 0;
 	virtual const RenderContext& GetContext() = 0;
 	inline ~RenderingSystemInterface() = default;
@@ -17,6 +17,12 @@ namespace openblack::ecs::systems
 class TownSystemInterface
 {
 public:
+	/// Index a newly created town so it can be found by FindClosestTown
+	virtual void AddTown(entt::entity townEntity) = 0;
+	/// Index a newly created abode so it can be found by FindAbodeWithSpace while it has room left
+	virtual void AddAbode(entt::entity abodeEntity) = 0;
+	/// House a villager in an abode, the abode stops being offered by FindAbodeWithSpace once full
+	virtual void AddVillagerToAbode(entt::entity abodeEntity, entt::entity villagerEntity) = 0;
 	[[nodiscard]] virtual entt::entity FindAbodeWithSpace(entt::entity townEntity) const = 0;
 	[[nodiscard]] virtual entt::entity FindClosestTown(const glm::vec3& point) const = 0;
 	virtual void AddHomelessVillagerToTown(entt::entity townEntity, entt::entity villagerEntity) = 0;
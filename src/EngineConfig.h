@@ -49,10 +49,28 @@ struct EngineConfig
 
 	float guiScale {1.0f};
 
+	/// Step physics at physicsTimestep and interpolate rendered transforms instead of stepping by the frame's delta
+	bool physicsFixedTimestep {true};
+	float physicsTimestep {1.0f / 60.0f};
+	/// Simulation time beyond this many steps in a frame is dropped so slow frames can't spiral
+	uint32_t physicsMaxSubSteps {4};
+	/// Use Bullet's multithreaded world on the engine's task scheduler, read when a level is loaded
+	bool physicsMultithreaded {false};
+
+	/// Bytes of decoded sound effects kept in memory, the least recently played ones which aren't playing are evicted
+	size_t soundCacheBudget {64 * 1024 * 1024};
+	/// Sources playing sound effects at once, the least important emitters beyond that are virtual
+	uint32_t audioMaxVoices {32};
+
+	/// Bytes of meshes and textures kept loaded, the least recently drawn ones which can be loaded again are evicted
+	size_t resourceMemoryBudget {512 * 1024 * 1024};
+
 	bgfx::RendererType::Enum rendererType {bgfx::RendererType::Noop};
 	glm::u16vec2 resolution {256, 256};
 	windowing::DisplayMode displayMode {windowing::DisplayMode::Windowed};
 
 	uint32_t numFramesToSimulate {0};
+	/// Run a game turn on every frame, ignoring the turn duration and the pause, for headless benchmarks
+	bool turnEveryFrame {false};
 };
 } // namespace openblack
@@ -0,0 +1,316 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#define LOCATOR_IMPLEMENTATIONS
+
+#include "ArchiveFileSystem.h"
+
+#include <cctype>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+#include <AssetArchive.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "Common/StringUtils.h"
+#include "MemoryStream.h"
+
+using namespace openblack::filesystem;
+
+namespace
+{
+bool StartsWithIgnoringCase(std::string_view text, std::string_view prefix)
+{
+	return text.size() >= prefix.size() &&
+	       std::equal(prefix.begin(), prefix.end(), text.begin(), [](char l, char r) {
+		       return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+	       });
+}
+
+/// Reads a stored entry straight from the archive file, so only the parts of large files like packs which are asked for
+/// are read into memory
+class ArchiveEntryStream: public Stream
+{
+public:
+	ArchiveEntryStream(openblack::pack::AssetArchive& archive, const openblack::pack::ArchiveEntry& entry, std::string name)
+	    : _archive(archive)
+	    , _entry(entry)
+	    , _name(std::move(name))
+	{
+	}
+
+	[[nodiscard]] std::size_t Position() const override { return _position; }
+	[[nodiscard]] std::size_t Size() const override { return _entry.size; }
+
+	void Seek(std::size_t position, SeekMode seek) override
+	{
+		switch (seek)
+		{
+		case SeekMode::Begin:
+			_position = position;
+			break;
+		case SeekMode::Current:
+			_position += position;
+			break;
+		case SeekMode::End:
+			_position = _entry.size + position;
+			break;
+		}
+	}
+
+	Stream& Read(uint8_t* buffer, std::size_t length) override
+	{
+		const auto result = _archive.Read(_entry, _position, {buffer, length});
+		if (result != openblack::pack::ArchiveResult::Success)
+		{
+			throw std::runtime_error(fmt::format("Failed to read {} bytes at {} of '{}' from {}: {}", length, _position,
+			                                     _name, ArchiveFileSystem::k_ArchiveName, openblack::pack::ResultToStr(result)));
+		}
+		_position += length;
+		return *this;
+	}
+
+	Stream& Write(const uint8_t* /*buffer*/, std::size_t /*length*/) override
+	{
+		throw std::runtime_error(fmt::format("Can't write '{}' in {}", _name, ArchiveFileSystem::k_ArchiveName));
+	}
+
+	std::string GetLine() override
+	{
+		std::string line;
+		std::array<uint8_t, 256> chunk;
+		while (_position < _entry.size)
+		{
+			const auto length = std::min<std::size_t>(chunk.size(), _entry.size - _position);
+			Read(chunk.data(), length);
+			const auto* begin = chunk.data();
+			const auto* end = begin + length;
+			const auto* newline = std::find(begin, end, '\n');
+			line.append(begin, newline);
+			if (newline != end)
+			{
+				// Move the cursor back to just past the '\n'
+				_position -= static_cast<std::size_t>(end - newline - 1);
+				break;
+			}
+		}
+		return line;
+	}
+
+	[[nodiscard]] bool IsEndOfFile() const override { return _position >= _entry.size; }
+
+private:
+	openblack::pack::AssetArchive& _archive;
+	const openblack::pack::ArchiveEntry& _entry;
+	std::string _name;
+	std::size_t _position {0};
+};
+} // namespace
+
+ArchiveFileSystem::ArchiveFileSystem() = default;
+ArchiveFileSystem::~ArchiveFileSystem() = default;
+
+std::string ArchiveFileSystem::GetArchiveName(const std::filesystem::path& path) const
+{
+	auto relative = FixPath(path);
+	if (relative.is_absolute())
+	{
+		relative = relative.lexically_relative(GetGamePath());
+		if (relative.empty() || *relative.begin() == "..")
+		{
+			return {};
+		}
+	}
+	auto name = relative.lexically_normal().generic_string();
+	while (!name.empty() && name.back() == '/')
+	{
+		name.pop_back();
+	}
+	return name == "." ? std::string {} : name;
+}
+
+const openblack::pack::ArchiveEntry* ArchiveFileSystem::FindEntry(const std::filesystem::path& path) const
+{
+	if (_archive == nullptr)
+	{
+		return nullptr;
+	}
+	const auto name = GetArchiveName(path);
+	if (name.empty())
+	{
+		return nullptr;
+	}
+	const auto* entry = _archive->Find(name);
+	// Loose files, such as edited playground scripts or mod overrides, win over the archived file of the same name
+	std::error_code ec;
+	if (entry != nullptr && std::filesystem::is_regular_file(GetGamePath() / name, ec))
+	{
+		return nullptr;
+	}
+	return entry;
+}
+
+std::vector<const openblack::pack::ArchiveEntry*> ArchiveFileSystem::GetDirectoryEntries(const std::string& directory,
+                                                                                       bool recursive) const
+{
+	std::vector<const pack::ArchiveEntry*> result;
+	if (_archive == nullptr || !_directories.contains(string_utils::LowerCase(directory)))
+	{
+		return result;
+	}
+
+	const auto prefix = directory + '/';
+	for (const auto& entry : _archive->GetEntries())
+	{
+		const auto name = _archive->GetName(entry);
+		if (name.size() > prefix.size() && StartsWithIgnoringCase(name, prefix) &&
+		    (recursive || name.find('/', prefix.size()) == std::string_view::npos))
+		{
+			result.push_back(&entry);
+		}
+	}
+	std::ranges::sort(result, {}, [](const pack::ArchiveEntry* entry) { return entry->offset; });
+	return result;
+}
+
+std::filesystem::path ArchiveFileSystem::FindPath(const std::filesystem::path& path) const
+{
+	if (FindEntry(path) != nullptr)
+	{
+		return path;
+	}
+	return DefaultFileSystem::FindPath(path);
+}
+
+std::unique_ptr<Stream> ArchiveFileSystem::Open(const std::filesystem::path& path, Stream::Mode mode)
+{
+	const auto* entry = mode == Stream::Mode::Read ? FindEntry(path) : nullptr;
+	if (entry != nullptr)
+	{
+		// Compressed entries have to be decompressed in full anyway, packtool stores large packs uncompressed
+		if (entry->compression == pack::ArchiveCompression::None)
+		{
+			return std::make_unique<ArchiveEntryStream>(*_archive, *entry, path.generic_string());
+		}
+		return std::unique_ptr<Stream>(new MemoryStream(ReadAll(path)));
+	}
+	return DefaultFileSystem::Open(path, mode);
+}
+
+std::unique_ptr<std::istream> ArchiveFileSystem::GetData(const std::filesystem::path& path)
+{
+	if (FindEntry(path) != nullptr)
+	{
+		const auto data = ReadAll(path);
+		return std::make_unique<std::istringstream>(std::string(data.begin(), data.end()), std::ios::binary);
+	}
+	return DefaultFileSystem::GetData(path);
+}
+
+bool ArchiveFileSystem::Exists(const std::filesystem::path& path) const
+{
+	if (_archive != nullptr)
+	{
+		const auto name = GetArchiveName(path);
+		if (!name.empty() && (_archive->Find(name) != nullptr || _directories.contains(string_utils::LowerCase(name))))
+		{
+			return true;
+		}
+	}
+	return DefaultFileSystem::Exists(path);
+}
+
+void ArchiveFileSystem::SetGamePath(const std::filesystem::path& path)
+{
+	DefaultFileSystem::SetGamePath(path);
+
+	_archive.reset();
+	_directories.clear();
+	const auto archivePath = GetGamePath() / k_ArchiveName;
+	std::error_code ec;
+	if (GetGamePath().empty() || !std::filesystem::is_regular_file(archivePath, ec))
+	{
+		return;
+	}
+	auto archive = std::make_unique<pack::AssetArchive>();
+	const auto result = archive->Open(archivePath);
+	if (result != pack::ArchiveResult::Success)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Unable to open {}, reading loose files instead: {}", archivePath.string(),
+		                   pack::ResultToStr(result));
+		return;
+	}
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Reading game files from {} ({} files)", archivePath.string(),
+	                   archive->GetEntries().size());
+	// Every directory with an archived file under it, so looking one up doesn't go through every entry
+	for (const auto& entry : archive->GetEntries())
+	{
+		const auto name = string_utils::LowerCase(std::string(archive->GetName(entry)));
+		for (auto slash = name.find('/'); slash != std::string::npos; slash = name.find('/', slash + 1))
+		{
+			_directories.insert(name.substr(0, slash));
+		}
+	}
+	_archive = std::move(archive);
+}
+
+std::vector<uint8_t> ArchiveFileSystem::ReadAll(const std::filesystem::path& path)
+{
+	const auto* entry = FindEntry(path);
+	if (entry == nullptr)
+	{
+		return DefaultFileSystem::ReadAll(path);
+	}
+
+	std::vector<uint8_t> data;
+	const auto result = _archive->Read(*entry, data);
+	if (result != pack::ArchiveResult::Success)
+	{
+		throw std::runtime_error(
+		    fmt::format("Failed to read '{}' from {}: {}", path.generic_string(), k_ArchiveName, pack::ResultToStr(result)));
+	}
+	return data;
+}
+
+void ArchiveFileSystem::Iterate(const std::filesystem::path& path, bool recursive,
+                                const std::function<void(const std::filesystem::path&)>& function) const
+{
+	const auto entries = GetDirectoryEntries(GetArchiveName(path), recursive);
+	if (entries.empty())
+	{
+		DefaultFileSystem::Iterate(path, recursive, function);
+		return;
+	}
+
+	// Loose files, such as scripts added next to archived ones, are listed first and hide archived files of the same name
+	std::unordered_set<std::string> looseNames;
+	if (DefaultFileSystem::Exists(path))
+	{
+		DefaultFileSystem::Iterate(path, recursive, [this, &function, &looseNames](const std::filesystem::path& f) {
+			looseNames.insert(string_utils::LowerCase(GetArchiveName(f)));
+			function(f);
+		});
+	}
+	// Archived files are given as full paths under the game directory, the same as loose ones
+	for (const auto* entry : entries)
+	{
+		const auto name = _archive->GetName(*entry);
+		if (!looseNames.contains(string_utils::LowerCase(std::string(name))))
+		{
+			function(GetGamePath() / std::filesystem::path(name));
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "DefaultFileSystem.h"
+
+#if !defined(LOCATOR_IMPLEMENTATIONS)
+#error "Locator interface implementations should only be included in Locator.cpp"
+#endif
+
+namespace openblack::pack
+{
+class AssetArchive;
+struct ArchiveEntry;
+} // namespace openblack::pack
+
+namespace openblack::filesystem
+{
+
+/// Reads game files out of the asset archive in the game directory when there is one, made with packtool --write-archive.
+/// Opening a file is then a read from an already open file instead of a file system lookup. Files which aren't in the
+/// archive, and every file when there is no archive, are read as loose files. A loose file next to the archive replaces
+/// the archived file of the same name, when listing directories as well as when reading.
+class ArchiveFileSystem: public DefaultFileSystem
+{
+public:
+	static constexpr std::string_view k_ArchiveName = "openblack.oba";
+
+	ArchiveFileSystem();
+	~ArchiveFileSystem() override;
+
+	[[nodiscard]] std::filesystem::path FindPath(const std::filesystem::path& path) const override;
+	std::unique_ptr<Stream> Open(const std::filesystem::path& path, Stream::Mode mode) override;
+	std::unique_ptr<std::istream> GetData(const std::filesystem::path& path) override;
+	[[nodiscard]] bool Exists(const std::filesystem::path& path) const override;
+	void SetGamePath(const std::filesystem::path& path) override;
+	std::vector<uint8_t> ReadAll(const std::filesystem::path& path) override;
+	void Iterate(const std::filesystem::path& path, bool recursive,
+	             const std::function<void(const std::filesystem::path&)>& function) const override;
+
+	[[nodiscard]] bool IsArchiveMounted() const { return _archive != nullptr; }
+
+private:
+	/// Name of a path in the archive: relative to the game directory with forward slashes, empty if it's outside of it
+	[[nodiscard]] std::string GetArchiveName(const std::filesystem::path& path) const;
+	/// Archived file of a path, unless a loose file replaces it
+	[[nodiscard]] const pack::ArchiveEntry* FindEntry(const std::filesystem::path& path) const;
+	/// Entries under a directory in the order they are stored in, so reading them one after the other reads forward
+	[[nodiscard]] std::vector<const pack::ArchiveEntry*> GetDirectoryEntries(const std::string& directory,
+	                                                                        bool recursive) const;
+
+	std::unique_ptr<pack::AssetArchive> _archive;
+	/// Lower case names of the directories archived files are in, including their parents
+	std::unordered_set<std::string> _directories;
+};
+
+} // namespace openblack::filesystem
@@ -9,6 +9,7 @@
 
 #include "Game.h"
 
+#include <algorithm>
 #include <string>
 
 #include <LHVM.h>
@@ -16,7 +17,6 @@
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/euler_angles.hpp>
-#include <glm/gtx/intersect.hpp>
 #include <glm/gtx/transform.hpp>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -51,11 +51,14 @@
 #include "Graphics/RendererInterface.h"
 #include "Input/GameActionMapInterface.h"
 #include "LHScriptX/Script.h"
+#include "LevelCatalog.h"
 #include "Locator.h"
 #include "Parsers/InfoFile.h"
 #include "Profiler.h"
 #include "Resources/Loaders.h"
 #include "Resources/MeshId.h"
+#include "Resources/ResidencyManager.h"
+#include "Resources/ResourceId.h"
 #include "Resources/ResourcesInterface.h"
 #include "Serializer/FotFile.h"
 
@@ -74,8 +77,11 @@ Game* Game::sInstance = nullptr;
 Game::Game(Arguments&& args) noexcept
     : _gamePath(args.gamePath)
     , _startMap(args.startLevel)
+    , _levelCache(args.levelCache)
+    , _mipChainCache(args.mipChainCache)
     , _handPose(glm::identity<glm::mat4>())
     , _requestScreenshot(args.requestScreenshot)
+    , _profilerTrace(args.profilerTrace)
 {
 	Locator::camera::emplace(glm::zero<glm::vec3>());
 	std::function<std::shared_ptr<spdlog::logger>(const std::string&)> createLogger;
@@ -234,7 +240,8 @@ bool Game::GameLogicLoop() noexcept
 	using namespace ecs::components;
 	using namespace ecs::systems;
 
-	if (_paused)
+	const auto turnEveryFrame = Locator::config::value().turnEveryFrame;
+	if (_paused && !turnEveryFrame)
 	{
 		return false;
 	}
@@ -243,16 +250,20 @@ bool Game::GameLogicLoop() noexcept
 	const auto delta = currentTime - _lastGameLoopTime;
 	const auto turnDuration = k_TurnDuration * _gameSpeedMultiplier;
 	// NOLINTNEXTLINE(modernize-use-nullptr): clang-tidy bug
-	if (delta < turnDuration)
+	if (delta < turnDuration && !turnEveryFrame)
 	{
 		return false;
 	}
 
+	auto& profiler = Locator::profiler::value();
+	auto turnZone = profiler.BeginScoped("Turn");
+
+	// Moving entities are drawn blended from where they were before this turn moves them
+	Locator::rendereringSystem::value().SnapshotTurnTransforms();
+
 	// Build Map Grid Acceleration Structure
 	Locator::entitiesMap::value().Rebuild();
 
-	auto& profiler = Locator::profiler::value();
-
 	{
 		auto pathfinding = profiler.BeginScoped(Profiler::Stage::PathfindingUpdate);
 		Locator::pathfindingSystem::value().Update();
@@ -356,29 +367,11 @@ bool Game::Update() noexcept
 			const auto scale = glm::vec3(50.0f, 50.0f, 50.0f);
 			if (screenSize.x > 0 && screenSize.y > 0)
 			{
-				glm::vec3 rayOrigin;
-				glm::vec3 rayDirection;
-				camera.DeprojectScreenToWorld(static_cast<glm::vec2>(_mousePosition) / static_cast<glm::vec2>(screenSize),
-				                              rayOrigin, rayDirection);
-				auto& dynamicsSystem = Locator::dynamicsSystem::value();
-
-				if (!glm::any(glm::isnan(rayOrigin) || glm::isnan(rayDirection)))
+				// Only the land and the water, this doesn't need the physics world's broadphase every frame
+				const auto screenCoord = static_cast<glm::vec2>(_mousePosition) / static_cast<glm::vec2>(screenSize);
+				if (auto hit = camera.RaycastScreenCoordToLand(screenCoord, true))
 				{
-					if (auto hit = dynamicsSystem.RayCastClosestHit(rayOrigin, rayDirection, 1e10f))
-					{
-						intersectionTransform = hit->first;
-					}
-					else // For the water
-					{
-						float intersectDistance = 0.0f;
-						const auto planeOrigin = glm::vec3(0.0f, 0.0f, 0.0f);
-						const auto planeNormal = glm::vec3(0.0f, 1.0f, 0.0f);
-						if (glm::intersectRayPlane(rayOrigin, rayDirection, planeOrigin, planeNormal, intersectDistance))
-						{
-							intersectionTransform.position = rayOrigin + rayDirection * intersectDistance;
-							intersectionTransform.rotation = glm::mat3(1.0f);
-						}
-					}
+					intersectionTransform = *hit;
 				}
 				intersectionTransform.scale = scale;
 				_handPose = glm::mat4(1.0f);
@@ -412,6 +405,10 @@ bool Game::Update() noexcept
 			auto updateEntities = profiler.BeginScoped(Profiler::Stage::UpdateEntities);
 			if (config.drawEntities)
 			{
+				const auto turnDuration = k_TurnDuration * _gameSpeedMultiplier;
+				const auto turnFraction = (std::chrono::steady_clock::now() - _lastGameLoopTime) / turnDuration;
+				Locator::rendereringSystem::value().SetTurnFraction(
+				    config.turnEveryFrame ? 1.0f : std::clamp(turnFraction, 0.0f, 1.0f));
 				Locator::rendereringSystem::value().PrepareDraw(config.drawBoundingBoxes, config.drawFootpaths,
 				                                                config.drawStreams);
 			}
@@ -424,6 +421,9 @@ bool Game::Update() noexcept
 		Locator::audio::value().Update();
 	} // Update Audio
 
+	// Evict the meshes and textures which haven't been drawn in a while if they take too much memory
+	Locator::resources::value().GetResidency().Update(_frameCount);
+
 	return config.numFramesToSimulate == 0 || _frameCount < config.numFramesToSimulate;
 }
 
@@ -447,6 +447,12 @@ bool Game::Initialize() noexcept
 		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Failed to initialize engine services.");
 		return false;
 	}
+	auto& profiler = Locator::profiler::value();
+	if (_profilerTrace.has_value())
+	{
+		profiler.StartTrace(*_profilerTrace);
+	}
+	auto initializeZone = profiler.BeginScoped("Initialize");
 	auto& fileSystem = Locator::filesystem::value();
 	auto& events = Locator::events::value();
 
@@ -516,7 +522,8 @@ bool Game::Initialize() noexcept
 			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading temple mesh: {}", f.stem().string());
 			    try
 			    {
-				    meshManager.Load(fmt::format("temple/{}", f.stem().string()), resources::L3DLoader::FromDiskTag {}, f);
+				    meshManager.Load(resources::MakeResourceId("temple/", f.stem().string()),
+				                     resources::L3DLoader::FromDiskTag {}, f);
 			    }
 			    catch (std::runtime_error& err)
 			    {
@@ -540,8 +547,8 @@ bool Game::Initialize() noexcept
 			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple mesh: {}", f.stem().string());
 			    try
 			    {
-				    meshManager.Load(fmt::format("temple/interior/{}", f.stem().string()), resources::L3DLoader::FromDiskTag {},
-				                     f);
+				    meshManager.Load(resources::MakeResourceId("temple/interior/", f.stem().string()),
+				                     resources::L3DLoader::FromDiskTag {}, f);
 			    }
 			    catch (std::runtime_error& err)
 			    {
@@ -553,7 +560,7 @@ bool Game::Initialize() noexcept
 			    SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading interior temple glows: {}", f.stem().string());
 			    try
 			    {
-				    glowManager.Load(fmt::format("temple/interior/glow/{}", f.stem().string()),
+				    glowManager.Load(resources::MakeResourceId("temple/interior/glow/", f.stem().string()),
 				                     resources::LightLoader::FromDiskTag {}, f);
 			    }
 			    catch (std::runtime_error& err)
@@ -565,7 +572,8 @@ bool Game::Initialize() noexcept
 
 	pack::PackFile pack;
 
-	auto packResult = pack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d"));
+	const auto allMeshesPath = fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d";
+	auto packResult = pack.Open(fileSystem.ReadAll(allMeshesPath));
 	if (packResult != pack::PackResult::Success)
 	{
 		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Unable to load AllMeshes.g3d: {}", pack::ResultToStr(packResult));
@@ -578,17 +586,30 @@ bool Game::Initialize() noexcept
 	{
 		const auto meshId = static_cast<MeshId>(i);
 		meshManager.Load(meshId, resources::L3DLoader::FromBufferTag {}, k_MeshNames.at(i), mesh);
+		// The pack is closed once loaded, evicted meshes read their own bytes from it again
+		meshManager.SetReload(meshId, resources::L3DLoader::FromPackTag {}, k_MeshNames.at(i), allMeshesPath,
+		                      pack.GetMeshRange(static_cast<uint32_t>(i)));
 		++i;
 	}
 
+	// Only the textures which changed since the last run have their mip chains generated
+	auto& mipChains = resources.GetResidency().GetMipChains();
+	if (!_mipChainCache.empty())
+	{
+		mipChains.Open(_mipChainCache);
+	}
 	const auto& textures = pack.GetTextures();
 	for (auto const& [name, g3dTexture] : textures)
 	{
-		textureManager.Load(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, name, g3dTexture);
+		const auto range = pack.GetTextureRange(name);
+		textureManager.Load(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, name, g3dTexture, allMeshesPath,
+		                    range);
+		textureManager.SetReload(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, name, allMeshesPath, range);
 	}
+	mipChains.Save();
 
 	pack::PackFile animationPack;
-	packResult = animationPack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllAnims.anm"));
+	packResult = animationPack.Open(fileSystem.ReadAll(fileSystem.GetPath<Path::Data>() / "AllAnims.anm"));
 	if (packResult != pack::PackResult::Success)
 	{
 		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Unable to load AllAnims.anm: {}", pack::ResultToStr(packResult));
@@ -638,55 +659,40 @@ bool Game::Initialize() noexcept
 
 	// TODO(raffclar): #400: Parse level files within the resource loader
 	// TODO(raffclar): #405: Determine campaign levels from the challenge script file
-	// Load the campaign levels
-	fileSystem.Iterate(fileSystem.GetPath<Path::Scripts>(), false, [&levelManager](const std::filesystem::path& f) {
-		const auto& name = f.stem().string();
-		if (f.extension() != ".txt" || name.rfind("InfoScript", 0) != std::string::npos)
-		{
-			return;
-		}
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading campaign level: {}", f.stem().string());
-		try
-		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("campaign/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Campaign);
-			}
-		}
-		catch (std::runtime_error& err)
-		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
-		}
+	// Index the levels, only the scripts which changed since the last run are read. A level's script is otherwise only
+	// read once it is selected and loaded with LoadMap.
+	LevelCatalog levelCatalog;
+	if (!_levelCache.empty())
+	{
+		levelCatalog.LoadCache(_levelCache);
+	}
+	levelCatalog.Scan(fileSystem.GetPath<Path::Scripts>(), Level::LandType::Campaign, [](const std::filesystem::path& f) {
+		return f.stem().string().rfind("InfoScript", 0) == std::string::npos;
 	});
-	// Load Playgrounds
 	// Attempt to load additional levels as playgrounds
-	fileSystem.Iterate(fileSystem.GetPath<Path::Playgrounds>(), false, [&levelManager](const std::filesystem::path& f) {
-		if (f.extension() != ".txt")
-		{
-			return;
-		}
-		const auto& name = f.stem().string();
-		if (levelManager.Contains(fmt::format("playgrounds/{}", name)))
-		{
-			// Already added
-			return;
-		}
+	levelCatalog.Scan(fileSystem.GetPath<Path::Playgrounds>(), Level::LandType::Skirmish);
+	if (!_levelCache.empty())
+	{
+		levelCatalog.SaveCache(_levelCache);
+	}
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Indexed {} level scripts, {} of them had to be read",
+	                    levelCatalog.GetEntries().size(), levelCatalog.GetParsedCount());
 
-		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading custom level: {}", f.stem().string());
-		try
+	for (const auto& entry : levelCatalog.GetEntries())
+	{
+		if (!entry.isLevel)
 		{
-			if (Level::IsLevelFile(f))
-			{
-				levelManager.Load(fmt::format("playgrounds/{}", name), resources::LevelLoader::FromDiskTag {}, f,
-				                  Level::LandType::Skirmish);
-			}
+			continue;
 		}
-		catch (std::runtime_error& err)
+		const auto* prefix = entry.landType == Level::LandType::Campaign ? "campaign" : "playgrounds";
+		const auto id = resources::MakeResourceId(prefix, "/", entry.scriptPath.stem().string());
+		if (levelManager.Contains(id))
 		{
-			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
+			// Already added
+			continue;
 		}
-	});
+		levelManager.Load(id, resources::LevelLoader::FromCatalogTag {}, entry);
+	}
 
 	// Load all sound packs in the Audio directory
 	auto& audioManager = Locator::audio::value();
@@ -699,7 +705,7 @@ bool Game::Initialize() noexcept
 
 		    pack::PackFile soundPack;
 		    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Opening sound pack {}", f.filename().string());
-		    const auto result = soundPack.ReadFile(*fileSystem.GetData(f));
+		    const auto result = soundPack.Open(fileSystem.ReadAll(f));
 		    if (result != pack::PackResult::Success)
 		    {
 			    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Unable to load sound pack {}: {}", f.filename().string(),
@@ -738,10 +744,10 @@ bool Game::Initialize() noexcept
 					    return;
 				    }
 
-				    const auto stringId = fmt::format("{}/{}", groupName, audioHeaders[i].id);
-				    const entt::id_type id = entt::hashed_string(stringId.c_str());
+				    const auto id = resources::MakeResourceId(groupName, "/", audioHeaders[i].id);
 				    const std::vector<std::vector<uint8_t>> buffer = {audioData[i]};
-				    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Loading sound {}: {}", stringId, audioHeaders[i].name.data());
+				    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Loading sound {}/{}: {}", groupName, audioHeaders[i].id,
+				                        audioHeaders[i].name.data());
 				    soundManager.Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[i], buffer);
 				    audioManager.AddToSoundGroup(groupName, id);
 			    }
@@ -765,7 +771,8 @@ bool Game::Initialize() noexcept
 			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading raw texture: {}", f.stem().string());
 			try
 			{
-				textureManager.Load(fmt::format("raw/{}", f.stem().string()), resources::Texture2DLoader::FromDiskTag {}, f);
+				textureManager.Load(resources::MakeResourceId("raw/", f.stem().string()),
+				                    resources::Texture2DLoader::FromDiskTag {}, f);
 			}
 			catch (std::runtime_error& err)
 			{
@@ -910,6 +917,7 @@ bool Game::Run() noexcept
 
 bool Game::LoadMap(const std::filesystem::path& path) noexcept
 {
+	auto loadZone = Locator::profiler::value().BeginScoped("Load Map");
 	auto& fileSystem = Locator::filesystem::value();
 
 	if (!fileSystem.Exists(path))
@@ -921,6 +929,8 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 	const auto data = fileSystem.ReadAll(path);
 	const auto source = std::string(reinterpret_cast<const char*>(data.data()), data.size());
 
+	// Emitters hand their voices and sound buffers back before the registry forgets about them
+	Locator::audio::value().Stop();
 	// Reset everything. Deletes all entities and their components
 	Locator::entitiesRegistry::value().Reset();
 	// TODO(#661): split entities that are permanent from map entities and move hand and camera to init
@@ -933,6 +943,9 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 	Locator::camera::value().SetProjectionMatrixPerspective(config.cameraXFov, aspect, config.cameraNearClip,
 	                                                        config.cameraFarClip);
 
+	// Gameplay effects, the ones named by audio::SoundId, decode in the background while the script loads the level
+	Locator::audio::value().PrefetchSoundGroup("InGame.sad");
+
 	Script script;
 	script.Load(source);
 
@@ -962,6 +975,7 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 
 void Game::LoadLandscape(const std::filesystem::path& path)
 {
+	auto loadZone = Locator::profiler::value().BeginScoped("Load Landscape");
 	auto& fileSystem = Locator::filesystem::value();
 
 	auto fixedName = fileSystem.FindPath(filesystem::FileSystemInterface::FixPath(path));
@@ -63,7 +63,12 @@ struct Arguments
 	std::string logFile;
 	std::array<spdlog::level::level_enum, k_LoggingSubsystemStrs.size()> logLevels;
 	std::string startLevel;
+	/// File the level catalog is kept in between runs, empty to index every level script at start-up
+	std::filesystem::path levelCache;
+	/// File the mip chains of the pack textures are kept in between runs, empty to generate them at every start-up
+	std::filesystem::path mipChainCache;
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> requestScreenshot;
+	std::optional<std::filesystem::path> profilerTrace;
 };
 
 class Game
@@ -106,6 +111,8 @@ class Game
 	const std::filesystem::path _gamePath;
 
 	std::filesystem::path _startMap;
+	std::filesystem::path _levelCache;
+	std::filesystem::path _mipChainCache;
 
 	std::chrono::steady_clock::time_point _lastGameLoopTime;
 	std::chrono::steady_clock::duration _turnDeltaTime;
@@ -120,5 +127,6 @@ class Game
 	bool _handGripping;
 
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> _requestScreenshot;
+	std::optional<std::filesystem::path> _profilerTrace;
 };
 } // namespace openblack
@@ -14,6 +14,9 @@
 #include <string>
 #include <utility>
 
+#include "Locator.h"
+#include "Profiler.h"
+
 using namespace openblack::graphics;
 
 IndexBuffer::IndexBuffer(std::string name, const void* indices, uint32_t indexCount, Type type)
@@ -28,6 +31,10 @@ IndexBuffer::IndexBuffer(std::string name, const void* indices, uint32_t indexCo
 	const auto* mem = bgfx::makeRef(indices, indexCount * GetTypeSize(_type));
 	_handle = bgfx::createIndexBuffer(mem, type == Type::Uint32 ? BGFX_BUFFER_INDEX32 : 0);
 	bgfx::setName(_handle, _name.c_str());
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, mem->size);
+	}
 }
 
 IndexBuffer::IndexBuffer(std::string name, const bgfx::Memory* mem, Type type)
@@ -39,6 +46,10 @@ IndexBuffer::IndexBuffer(std::string name, const bgfx::Memory* mem, Type type)
 
 	_handle = bgfx::createIndexBuffer(mem, type == Type::Uint32 ? BGFX_BUFFER_INDEX32 : 0);
 	bgfx::setName(_handle, _name.c_str());
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, mem->size);
+	}
 }
 
 IndexBuffer::~IndexBuffer()
@@ -39,6 +39,11 @@ bool Mesh::IsIndexed() const
 	return _indexBuffer != nullptr && _indexBuffer->GetCount() > 0;
 }
 
+uint32_t Mesh::GetSizeInBytes() const
+{
+	return _vertexBuffer->GetSizeInBytes() + (IsIndexed() ? _indexBuffer->GetSize() : 0);
+}
+
 Mesh::Topology Mesh::GetTopology() const noexcept
 {
 	return _topology;
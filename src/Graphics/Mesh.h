@@ -46,6 +46,8 @@ class Mesh
 	[[nodiscard]] const VertexBuffer& GetVertexBuffer() const;
 	[[nodiscard]] const IndexBuffer& GetIndexBuffer() const;
 	[[nodiscard]] bool IsIndexed() const;
+	/// Size of the vertex and index buffers
+	[[nodiscard]] uint32_t GetSizeInBytes() const;
 
 	[[nodiscard]] Topology GetTopology() const noexcept;
 
@@ -0,0 +1,499 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MipChain.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+using namespace openblack::graphics;
+
+namespace
+{
+/// Width of each channel from the lowest bits. 8 bit channels take a byte each, narrower ones are packed in 16 bits.
+/// Channel order doesn't matter when averaging so formats which only differ by it share a layout.
+struct Layout
+{
+	uint8_t channelCount;
+	std::array<uint8_t, 4> bits;
+
+	[[nodiscard]] bool IsPacked() const { return bits[0] != 8; }
+	[[nodiscard]] size_t GetTexelSize() const { return IsPacked() ? sizeof(uint16_t) : channelCount; }
+};
+
+constexpr Layout k_Rgba8Layout {4, {8, 8, 8, 8}};
+
+std::optional<Layout> GetLayout(Format format)
+{
+	switch (format)
+	{
+	case Format::A8:
+	case Format::R8:
+		return Layout {1, {8, 0, 0, 0}};
+	case Format::RG8:
+		return Layout {2, {8, 8, 0, 0}};
+	case Format::RGB8:
+		return Layout {3, {8, 8, 8, 0}};
+	case Format::RGBA8:
+	case Format::BGRA8:
+		return k_Rgba8Layout;
+	case Format::B5G6R5:
+	case Format::R5G6B5:
+		return Layout {3, {5, 6, 5, 0}};
+	case Format::BGR5A1:
+	case Format::RGB5A1:
+		return Layout {4, {5, 5, 5, 1}};
+	case Format::BGRA4:
+	case Format::RGBA4:
+		return Layout {4, {4, 4, 4, 4}};
+	default:
+		return std::nullopt;
+	}
+}
+
+/// Bytes in a 4x4 block, 0 for formats which aren't block compressed
+size_t GetBlockSize(Format format)
+{
+	switch (format)
+	{
+	case Format::BlockCompression1:
+		return 8;
+	case Format::BlockCompression2:
+	case Format::BlockCompression3:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+using Texel = std::array<uint32_t, 4>;
+
+Texel ReadTexel(const Layout& layout, const uint8_t* src)
+{
+	Texel texel {};
+	if (!layout.IsPacked())
+	{
+		std::copy_n(src, layout.channelCount, texel.begin());
+		return texel;
+	}
+	uint32_t value = src[0] | (src[1] << 8);
+	for (uint8_t i = 0; i < layout.channelCount; ++i)
+	{
+		texel.at(i) = value & ((1u << layout.bits.at(i)) - 1);
+		value >>= layout.bits.at(i);
+	}
+	return texel;
+}
+
+void WriteTexel(const Layout& layout, const Texel& texel, uint8_t* dst)
+{
+	if (!layout.IsPacked())
+	{
+		std::transform(texel.begin(), texel.begin() + layout.channelCount, dst,
+		               [](uint32_t channel) { return static_cast<uint8_t>(channel); });
+		return;
+	}
+	uint32_t value = 0;
+	uint32_t shift = 0;
+	for (uint8_t i = 0; i < layout.channelCount; ++i)
+	{
+		value |= texel.at(i) << shift;
+		shift += layout.bits.at(i);
+	}
+	dst[0] = static_cast<uint8_t>(value & 0xFF);
+	dst[1] = static_cast<uint8_t>(value >> 8);
+}
+
+/// Average each 2x2 square of texels into one, the last row or column of odd sizes is dropped. A size of 1 is kept by
+/// averaging its only row or column with itself.
+std::vector<uint8_t> Downsample(const Layout& layout, std::span<const uint8_t> src, uint16_t width, uint16_t height)
+{
+	const auto texelSize = layout.GetTexelSize();
+	const auto dstWidth = std::max<uint16_t>(1, width / 2);
+	const auto dstHeight = std::max<uint16_t>(1, height / 2);
+	std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * texelSize);
+	for (uint16_t y = 0; y < dstHeight; ++y)
+	{
+		for (uint16_t x = 0; x < dstWidth; ++x)
+		{
+			Texel sum {};
+			for (uint16_t dy = 0; dy < 2; ++dy)
+			{
+				for (uint16_t dx = 0; dx < 2; ++dx)
+				{
+					const auto sx = std::min<size_t>(2 * x + dx, width - 1);
+					const auto sy = std::min<size_t>(2 * y + dy, height - 1);
+					const auto texel = ReadTexel(layout, &src[(sy * width + sx) * texelSize]);
+					std::transform(sum.begin(), sum.end(), texel.begin(), sum.begin(), std::plus<>());
+				}
+			}
+			std::transform(sum.begin(), sum.end(), sum.begin(), [](uint32_t channel) { return (channel + 2) / 4; });
+			WriteTexel(layout, sum, &dst[(static_cast<size_t>(y) * dstWidth + x) * texelSize]);
+		}
+	}
+	return dst;
+}
+
+using Rgba = std::array<uint8_t, 4>;
+
+uint16_t ReadU16(const uint8_t* src)
+{
+	return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
+void WriteU16(uint16_t value, uint8_t* dst)
+{
+	dst[0] = static_cast<uint8_t>(value & 0xFF);
+	dst[1] = static_cast<uint8_t>(value >> 8);
+}
+
+Rgba Expand565(uint16_t colour)
+{
+	const auto r = (colour >> 11) & 0x1F;
+	const auto g = (colour >> 5) & 0x3F;
+	const auto b = colour & 0x1F;
+	return {static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+	        static_cast<uint8_t>((b << 3) | (b >> 2)), 0xFF};
+}
+
+uint16_t Pack565(const Rgba& colour)
+{
+	const auto r = (colour[0] * 31 + 127) / 255;
+	const auto g = (colour[1] * 63 + 127) / 255;
+	const auto b = (colour[2] * 31 + 127) / 255;
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+/// Colours a DXT colour block's indices select. DXT1 blocks whose first colour isn't greater than the second have a
+/// single interpolated colour and transparent black instead.
+std::array<Rgba, 4> GetColourPalette(uint16_t colour0, uint16_t colour1, bool allowTransparent)
+{
+	std::array<Rgba, 4> palette {Expand565(colour0), Expand565(colour1)};
+	const bool fourColours = colour0 > colour1 || !allowTransparent;
+	for (size_t c = 0; c < 3; ++c)
+	{
+		const auto a = palette[0].at(c);
+		const auto b = palette[1].at(c);
+		palette[2].at(c) = static_cast<uint8_t>(fourColours ? (2 * a + b + 1) / 3 : (a + b + 1) / 2);
+		palette[3].at(c) = static_cast<uint8_t>(fourColours ? (a + 2 * b + 1) / 3 : 0);
+	}
+	palette[2][3] = 0xFF;
+	palette[3][3] = fourColours ? 0xFF : 0;
+	return palette;
+}
+
+/// Alpha values a DXT5 alpha block's indices select
+std::array<uint8_t, 8> GetAlphaPalette(uint8_t alpha0, uint8_t alpha1)
+{
+	std::array<uint8_t, 8> palette {alpha0, alpha1};
+	if (alpha0 > alpha1)
+	{
+		for (int i = 2; i < 8; ++i)
+		{
+			palette.at(i) = static_cast<uint8_t>(((8 - i) * alpha0 + (i - 1) * alpha1 + 3) / 7);
+		}
+	}
+	else
+	{
+		for (int i = 2; i < 6; ++i)
+		{
+			palette.at(i) = static_cast<uint8_t>(((6 - i) * alpha0 + (i - 1) * alpha1 + 2) / 5);
+		}
+		palette[6] = 0;
+		palette[7] = 0xFF;
+	}
+	return palette;
+}
+
+void DecodeBlock(Format format, const uint8_t* block, std::array<Rgba, 16>& texels)
+{
+	const auto* colourBlock = format == Format::BlockCompression1 ? block : block + 8;
+	const auto palette = GetColourPalette(ReadU16(colourBlock), ReadU16(colourBlock + 2), format == Format::BlockCompression1);
+	uint32_t indices;
+	std::memcpy(&indices, colourBlock + 4, sizeof(indices));
+	for (size_t i = 0; i < texels.size(); ++i)
+	{
+		texels.at(i) = palette.at((indices >> (2 * i)) & 0x3);
+	}
+
+	if (format == Format::BlockCompression2)
+	{
+		uint64_t alphas;
+		std::memcpy(&alphas, block, sizeof(alphas));
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			texels.at(i)[3] = static_cast<uint8_t>(((alphas >> (4 * i)) & 0xF) * 17);
+		}
+	}
+	else if (format == Format::BlockCompression3)
+	{
+		const auto alphaPalette = GetAlphaPalette(block[0], block[1]);
+		uint64_t alphaIndices = 0;
+		std::memcpy(&alphaIndices, block + 2, 6);
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			texels.at(i)[3] = alphaPalette.at((alphaIndices >> (3 * i)) & 0x7);
+		}
+	}
+}
+
+/// Compress with the bounding box of the block's colours as end points. This is far from what offline compressors
+/// achieve but only the smaller levels are compressed here, where the difference is hard to see.
+void EncodeBlock(Format format, const std::array<Rgba, 16>& texels, uint8_t* block)
+{
+	const bool isDxt1 = format == Format::BlockCompression1;
+	const auto isTransparent = [isDxt1](const Rgba& texel) { return isDxt1 && texel[3] < 0x80; };
+
+	Rgba minimum {0xFF, 0xFF, 0xFF, 0xFF};
+	Rgba maximum {0, 0, 0, 0};
+	bool hasTransparent = false;
+	bool hasOpaque = false;
+	for (const auto& texel : texels)
+	{
+		if (isTransparent(texel))
+		{
+			hasTransparent = true;
+			continue;
+		}
+		hasOpaque = true;
+		for (size_t c = 0; c < 4; ++c)
+		{
+			minimum.at(c) = std::min(minimum.at(c), texel.at(c));
+			maximum.at(c) = std::max(maximum.at(c), texel.at(c));
+		}
+	}
+
+	auto colour0 = hasOpaque ? Pack565(maximum) : uint16_t {0};
+	auto colour1 = hasOpaque ? Pack565(minimum) : uint16_t {0};
+	// DXT1 picks the palette with a transparent entry by the order of the end points
+	if ((colour0 < colour1) != hasTransparent && colour0 != colour1)
+	{
+		std::swap(colour0, colour1);
+	}
+	const auto palette = GetColourPalette(colour0, colour1, isDxt1);
+	// Equal end points select the palette with a transparent entry as well
+	const size_t colourCount = hasTransparent || (isDxt1 && colour0 == colour1) ? 3 : 4;
+
+	uint32_t indices = 0;
+	for (size_t i = 0; i < texels.size(); ++i)
+	{
+		const auto& texel = texels.at(i);
+		uint32_t best = 3;
+		if (!isTransparent(texel))
+		{
+			int bestDistance = std::numeric_limits<int>::max();
+			for (size_t p = 0; p < colourCount; ++p)
+			{
+				int distance = 0;
+				for (size_t c = 0; c < 3; ++c)
+				{
+					const int delta = texel.at(c) - palette.at(p).at(c);
+					distance += delta * delta;
+				}
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = static_cast<uint32_t>(p);
+				}
+			}
+		}
+		indices |= best << (2 * i);
+	}
+
+	auto* colourBlock = isDxt1 ? block : block + 8;
+	WriteU16(colour0, colourBlock);
+	WriteU16(colour1, colourBlock + 2);
+	std::memcpy(colourBlock + 4, &indices, sizeof(indices));
+
+	if (format == Format::BlockCompression2)
+	{
+		uint64_t alphas = 0;
+		for (size_t i = 0; i < texels.size(); ++i)
+		{
+			alphas |= static_cast<uint64_t>((texels.at(i)[3] * 15 + 127) / 255) << (4 * i);
+		}
+		std::memcpy(block, &alphas, sizeof(alphas));
+	}
+	else if (format == Format::BlockCompression3)
+	{
+		const auto alphaPalette = GetAlphaPalette(maximum[3], minimum[3]);
+		uint64_t alphaIndices = 0;
+		for (size_t i = 0; i < texels.size() && maximum[3] != minimum[3]; ++i)
+		{
+			const auto alpha = texels.at(i)[3];
+			const auto best = std::min_element(alphaPalette.begin(), alphaPalette.end(), [alpha](uint8_t lhs, uint8_t rhs) {
+				return std::abs(lhs - alpha) < std::abs(rhs - alpha);
+			});
+			alphaIndices |= static_cast<uint64_t>(std::distance(alphaPalette.begin(), best)) << (3 * i);
+		}
+		block[0] = maximum[3];
+		block[1] = minimum[3];
+		std::memcpy(block + 2, &alphaIndices, 6);
+	}
+}
+
+std::vector<uint8_t> DecodeImage(Format format, std::span<const uint8_t> src, uint16_t width, uint16_t height)
+{
+	const auto blockSize = GetBlockSize(format);
+	const auto blocksWide = std::max(1, (width + 3) / 4);
+	std::vector<uint8_t> dst(static_cast<size_t>(width) * height * sizeof(Rgba));
+	std::array<Rgba, 16> texels;
+	for (size_t by = 0; by * 4 < height; ++by)
+	{
+		for (size_t bx = 0; bx * 4 < width; ++bx)
+		{
+			DecodeBlock(format, &src[(by * blocksWide + bx) * blockSize], texels);
+			for (size_t y = by * 4; y < std::min<size_t>(by * 4 + 4, height); ++y)
+			{
+				for (size_t x = bx * 4; x < std::min<size_t>(bx * 4 + 4, width); ++x)
+				{
+					const auto& texel = texels.at((y - by * 4) * 4 + (x - bx * 4));
+					std::memcpy(&dst[(y * width + x) * sizeof(Rgba)], texel.data(), sizeof(Rgba));
+				}
+			}
+		}
+	}
+	return dst;
+}
+
+std::vector<uint8_t> EncodeImage(Format format, std::span<const uint8_t> src, uint16_t width, uint16_t height)
+{
+	const auto blockSize = GetBlockSize(format);
+	const auto blocksWide = std::max(1, (width + 3) / 4);
+	std::vector<uint8_t> dst(MipChain::GetLevelSize(format, width, height));
+	std::array<Rgba, 16> texels;
+	for (size_t by = 0; by * 4 < height; ++by)
+	{
+		for (size_t bx = 0; bx * 4 < width; ++bx)
+		{
+			// Blocks which go past the edge of small levels repeat the last row and column
+			for (size_t i = 0; i < texels.size(); ++i)
+			{
+				const auto x = std::min<size_t>(bx * 4 + i % 4, width - 1);
+				const auto y = std::min<size_t>(by * 4 + i / 4, height - 1);
+				std::memcpy(texels.at(i).data(), &src[(y * width + x) * sizeof(Rgba)], sizeof(Rgba));
+			}
+			EncodeBlock(format, texels, &dst[(by * blocksWide + bx) * blockSize]);
+		}
+	}
+	return dst;
+}
+} // namespace
+
+MipChain::MipChain(Format format, uint16_t width, uint16_t height)
+    : _format(format)
+    , _width(width)
+    , _height(height)
+{
+}
+
+bool MipChain::IsSupported(Format format)
+{
+	return GetBlockSize(format) != 0 || GetLayout(format).has_value();
+}
+
+size_t MipChain::GetLevelSize(Format format, uint16_t width, uint16_t height)
+{
+	if (const auto blockSize = GetBlockSize(format); blockSize != 0)
+	{
+		return static_cast<size_t>(std::max(1, (width + 3) / 4)) * std::max(1, (height + 3) / 4) * blockSize;
+	}
+	if (const auto layout = GetLayout(format))
+	{
+		return static_cast<size_t>(width) * height * layout->GetTexelSize();
+	}
+	return 0;
+}
+
+std::optional<MipChain> MipChain::Generate(Format format, uint16_t width, uint16_t height, std::span<const uint8_t> data)
+{
+	const auto size = GetLevelSize(format, width, height);
+	if (width == 0 || height == 0 || size == 0 || data.size() < size)
+	{
+		return std::nullopt;
+	}
+
+	MipChain chain(format, width, height);
+	chain._levels.emplace_back(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size));
+
+	if (const auto layout = GetLayout(format))
+	{
+		for (uint8_t level = 0; chain.GetWidth(level) > 1 || chain.GetHeight(level) > 1; ++level)
+		{
+			chain._levels.emplace_back(Downsample(*layout, chain._levels.back(), chain.GetWidth(level), chain.GetHeight(level)));
+		}
+		return chain;
+	}
+
+	auto rgba = DecodeImage(format, data, width, height);
+	for (uint8_t level = 0; chain.GetWidth(level) > 1 || chain.GetHeight(level) > 1; ++level)
+	{
+		rgba = Downsample(k_Rgba8Layout, rgba, chain.GetWidth(level), chain.GetHeight(level));
+		chain._levels.emplace_back(EncodeImage(format, rgba, chain.GetWidth(level + 1), chain.GetHeight(level + 1)));
+	}
+	return chain;
+}
+
+std::optional<MipChain> MipChain::FromLevels(Format format, uint16_t width, uint16_t height, std::span<const uint8_t> data)
+{
+	if (width == 0 || height == 0 || !IsSupported(format))
+	{
+		return std::nullopt;
+	}
+
+	MipChain chain(format, width, height);
+	for (uint8_t level = 0;; ++level)
+	{
+		const auto size = GetLevelSize(format, chain.GetWidth(level), chain.GetHeight(level));
+		if (data.size() < size)
+		{
+			return std::nullopt;
+		}
+		chain._levels.emplace_back(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size));
+		data = data.subspan(size);
+		if (chain.GetWidth(level) == 1 && chain.GetHeight(level) == 1)
+		{
+			break;
+		}
+	}
+	if (!data.empty())
+	{
+		return std::nullopt;
+	}
+	return chain;
+}
+
+uint16_t MipChain::GetWidth(uint8_t level) const
+{
+	return std::max<uint16_t>(1, static_cast<uint16_t>(_width >> level));
+}
+
+uint16_t MipChain::GetHeight(uint8_t level) const
+{
+	return std::max<uint16_t>(1, static_cast<uint16_t>(_height >> level));
+}
+
+size_t MipChain::GetSizeInBytes(uint8_t firstLevel) const
+{
+	return std::accumulate(_levels.begin() + firstLevel, _levels.end(), size_t {0},
+	                       [](size_t total, const std::vector<uint8_t>& level) { return total + level.size(); });
+}
+
+void MipChain::CopyLevels(uint8_t firstLevel, uint8_t* out) const
+{
+	for (auto level = _levels.begin() + firstLevel; level != _levels.end(); ++level)
+	{
+		out = std::copy(level->begin(), level->end(), out);
+	}
+}
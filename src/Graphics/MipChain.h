@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Texture2D.h"
+
+namespace openblack::graphics
+{
+
+/// Every level of an image from its full size down to 1x1, laid out the way bgfx expects mipmapped texture memory.
+/// The game's textures ship without mipmaps so the chains are generated when the textures are loaded.
+class MipChain
+{
+public:
+	/// Whether Generate can filter images of this format
+	[[nodiscard]] static bool IsSupported(Format format);
+
+	/// Box filter each level from the one above it. Block compressed images are decoded, filtered and compressed again.
+	/// Returns nothing if the format isn't supported or `data` is smaller than the image.
+	[[nodiscard]] static std::optional<MipChain> Generate(Format format, uint16_t width, uint16_t height,
+	                                                      std::span<const uint8_t> data);
+
+	/// Chain generated earlier, such as by a previous run, from every level down to 1x1 laid out one after the other the
+	/// way CopyLevels writes them. Returns nothing if the format isn't supported or `data` doesn't hold exactly those levels.
+	[[nodiscard]] static std::optional<MipChain> FromLevels(Format format, uint16_t width, uint16_t height,
+	                                                        std::span<const uint8_t> data);
+
+	/// Bytes in a level of an image of the given size, block compressed levels are rounded up to whole blocks
+	[[nodiscard]] static size_t GetLevelSize(Format format, uint16_t width, uint16_t height);
+
+	[[nodiscard]] Format GetFormat() const { return _format; }
+	[[nodiscard]] uint8_t GetLevelCount() const { return static_cast<uint8_t>(_levels.size()); }
+	[[nodiscard]] uint16_t GetWidth(uint8_t level = 0) const;
+	[[nodiscard]] uint16_t GetHeight(uint8_t level = 0) const;
+	[[nodiscard]] std::span<const uint8_t> GetLevel(uint8_t level) const { return _levels[level]; }
+	/// Bytes in the levels from `firstLevel` down to 1x1
+	[[nodiscard]] size_t GetSizeInBytes(uint8_t firstLevel = 0) const;
+	/// Copy the levels from `firstLevel` down to 1x1 one after the other, `out` must hold GetSizeInBytes(firstLevel)
+	void CopyLevels(uint8_t firstLevel, uint8_t* out) const;
+
+private:
+	MipChain(Format format, uint16_t width, uint16_t height);
+
+	Format _format;
+	uint16_t _width;
+	uint16_t _height;
+	std::vector<std::vector<uint8_t>> _levels;
+};
+
+} // namespace openblack::graphics
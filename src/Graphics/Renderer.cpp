@@ -13,6 +13,10 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <optional>
+#include <utility>
+
 #include <SDL_video.h>
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
@@ -192,6 +196,17 @@ struct BgfxCallback: public bgfx::CallbackI
 	}
 };
 
+/// Sections are only recorded while a profiler is registered
+using OptionalProfilerSection = std::optional<decltype(std::declval<Profiler&>().BeginScoped(Profiler::Stage::MainPass))>;
+
+void BeginProfilerSection(OptionalProfilerSection& section, Profiler::Stage stage)
+{
+	if (Locator::profiler::has_value())
+	{
+		section.emplace(&Locator::profiler::value(), stage);
+	}
+}
+
 } // namespace openblack
 
 std::unique_ptr<RendererInterface> RendererInterface::Create(bgfx::RendererType::Enum rendererType, bool vsync) noexcept
@@ -314,6 +329,14 @@ const Texture2D* GetTexture(uint32_t skinID, const std::unordered_map<SkinId, st
 	return texture;
 }
 
+/// Pixels across the screen an object of `size` covers at `distance` from the camera
+float GetScreenSize(const Camera& camera, float size, float distance)
+{
+	// The projection's y scale is the cotangent of half the vertical field of view
+	const auto pixelsPerUnit = camera.GetProjectionMatrix()[1][1] * 0.5f * Locator::config::value().resolution.y;
+	return size * pixelsPerUnit / std::max(distance - size * 0.5f, 1.0f);
+}
+
 void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc,
                            bool preserveState) const
 {
@@ -321,6 +344,10 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 	// We don't draw physics meshes, we haven't implemented statuses (building and graves) and modern GPUs can handle high lod
 	if (!desc.drawAll && (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & 1) != 1))
 	{
+		if (Locator::profiler::has_value())
+		{
+			Locator::profiler::value().Count(Profiler::Counter::InstancesCulled, std::max(desc.instanceCount, 1u));
+		}
 		return;
 	}
 
@@ -344,6 +371,11 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 
 		const bool primitivePreserveState = texture != nullptr && texture == nextTexture && (preserveState || hasNext);
 
+		if (texture != nullptr)
+		{
+			texture->RequestSize(desc.texelDemand > 0.0f ? desc.texelDemand : std::numeric_limits<float>::max());
+		}
+
 		uint32_t skip = Mesh::SkipState::SkipNone;
 		if (!lastPreserveState)
 		{
@@ -434,7 +466,8 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 {
 	const auto viewId = graphics::RenderPass::Footprint;
-	auto section = Locator::profiler::value().BeginScoped(Profiler::Stage::FootprintPass);
+	OptionalProfilerSection section;
+	BeginProfilerSection(section, Profiler::Stage::FootprintPass);
 	if (drawDesc.drawIsland)
 	{
 		const auto& island = Locator::terrainSystem::value();
@@ -482,7 +515,8 @@ void Renderer::DrawScene(const DrawSceneDesc& drawDesc) const noexcept
 	DrawFootprintPass(drawDesc);
 	// Reflection Pass
 	{
-		auto section = Locator::profiler::value().BeginScoped(Profiler::Stage::ReflectionPass);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, Profiler::Stage::ReflectionPass);
 		if (drawDesc.drawWater)
 		{
 			DrawSceneDesc drawPassDesc = drawDesc;
@@ -504,7 +538,8 @@ void Renderer::DrawScene(const DrawSceneDesc& drawDesc) const noexcept
 
 	// Main Draw Pass
 	{
-		auto section = Locator::profiler::value().BeginScoped(Profiler::Stage::MainPass);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, Profiler::Stage::MainPass);
 		DrawPass(drawDesc);
 	}
 }
@@ -512,7 +547,6 @@ void Renderer::DrawScene(const DrawSceneDesc& drawDesc) const noexcept
 void Renderer::DrawPass(const DrawSceneDesc& desc) const
 {
 	const auto& meshManager = Locator::resources::value().GetMeshes();
-	auto& profiler = Locator::profiler::value();
 
 	if (desc.frameBuffer != nullptr)
 	{
@@ -536,8 +570,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
 
 	{
-		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSky
-		                                                                          : Profiler::Stage::MainPassDrawSky);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSky
+		                                                                    : Profiler::Stage::MainPassDrawSky);
 		if (desc.drawSky)
 		{
 			const auto modelMatrix = glm::mat4(1.0f);
@@ -564,8 +599,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	}
 
 	{
-		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawWater
-		                                                                          : Profiler::Stage::MainPassDrawWater);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawWater
+		                                                                    : Profiler::Stage::MainPassDrawWater);
 		if (desc.drawWater)
 		{
 			const auto& ocean = Locator::oceanSystem::value();
@@ -585,8 +621,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	}
 
 	{
-		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawIsland
-		                                                                          : Profiler::Stage::MainPassDrawIsland);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawIsland
+		                                                                    : Profiler::Stage::MainPassDrawIsland);
 		if (desc.drawIsland)
 		{
 			auto& island = Locator::terrainSystem::value();
@@ -636,8 +673,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	}
 
 	{
-		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawModels
-		                                                                          : Profiler::Stage::MainPassDrawModels);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawModels
+		                                                                    : Profiler::Stage::MainPassDrawModels);
 		if (desc.drawEntities)
 		{
 			L3DMeshSubmitDesc submitDesc = {};
@@ -673,6 +711,11 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				submitDesc.isSky = false;
 				submitDesc.morphWithTerrain = placers.morphWithTerrain;
 				submitDesc.program = submitDesc.morphWithTerrain ? objectShaderHeightMapInstanced : objectShaderInstanced;
+				const auto distance = renderCtx.meshDistances.find(meshId);
+				submitDesc.texelDemand =
+				    distance != renderCtx.meshDistances.end()
+				        ? GetScreenSize(*desc.camera, glm::length(mesh->GetBoundingBox().Size()), distance->second)
+				        : 0.0f;
 
 				// TODO(bwrsandman): choose the correct LOD
 				DrawMesh(*mesh, submitDesc, std::numeric_limits<uint8_t>::max());
@@ -714,9 +757,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 		}
 
 		{
-			auto subSection =
-			    profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSprites
-			                                                               : Profiler::Stage::MainPassDrawSprites);
+			OptionalProfilerSection subSection;
+			BeginProfilerSection(subSection, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawSprites
+			                                                                       : Profiler::Stage::MainPassDrawSprites);
 
 			if (desc.drawSprites)
 			{
@@ -761,8 +804,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				| BGFX_STATE_MSAA
 			;
 			// clang-format on
-			const auto& mesh = meshManager.Handle(entt::hashed_string("coffre"));
-			const auto& testAnimation = Locator::resources::value().GetAnimations().Handle(entt::hashed_string("coffre"));
+			constexpr auto testModelId = resources::MakeResourceId("coffre");
+			const auto& mesh = meshManager.Handle(testModelId);
+			const auto& testAnimation = Locator::resources::value().GetAnimations().Handle(testModelId);
 			const std::vector<uint32_t>& boneParents = mesh->GetBoneParents();
 			auto bones = testAnimation->GetBoneMatrices(desc.time);
 			for (uint32_t i = 0; i < bones.size(); ++i)
@@ -780,8 +824,9 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	}
 
 	{
-		auto section = profiler.BeginScoped(desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawDebugCross
-		                                                                          : Profiler::Stage::MainPassDrawDebugCross);
+		OptionalProfilerSection section;
+		BeginProfilerSection(section, desc.viewId == RenderPass::Reflection ? Profiler::Stage::ReflectionDrawDebugCross
+		                                                                    : Profiler::Stage::MainPassDrawDebugCross);
 		if (desc.drawDebugCross)
 		{
 			bgfx::setTransform(glm::value_ptr(_debugCrossPose));
@@ -812,6 +857,12 @@ void Renderer::Frame() noexcept
 {
 	// Advance to next frame. Process submitted rendering primitives.
 	bgfx::frame();
+
+	// Stats are those of the frame which was just submitted
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::DrawCalls, bgfx::getStats()->numDraw);
+	}
 }
 
 void Renderer::RequestScreenshot(const std::filesystem::path& filepath) noexcept
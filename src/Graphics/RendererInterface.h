@@ -74,6 +74,9 @@ class RendererInterface
 		bool isSky;
 		bool drawAll; ///< For use in the mesh viewer
 		bool morphWithTerrain;
+		/// Pixels the closest instance covers on screen, the mesh's streamed textures are uploaded up to that size.
+		/// 0 when it isn't known and the textures are used in full.
+		float texelDemand;
 	};
 
 	static std::unique_ptr<RendererInterface> Create(bgfx::RendererType::Enum rendererType, bool vsync) noexcept;
@@ -13,12 +13,56 @@
 
 #include <algorithm>
 #include <array>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 #include <stb_image_write.h>
 
+#include "Locator.h"
+#include "MipChain.h"
+#include "Profiler.h"
+
 namespace openblack::graphics
 {
+namespace
+{
+uint64_t GetSamplerFlags(Wrapping wrapping, Filter filter)
+{
+	uint64_t flags = BGFX_TEXTURE_NONE;
+	switch (wrapping)
+	{
+	case Wrapping::ClampEdge:
+		flags |= BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
+		break;
+	case Wrapping::ClampBorder:
+		flags |= BGFX_SAMPLER_U_BORDER | BGFX_SAMPLER_V_BORDER;
+		break;
+	case Wrapping::Repeat:
+		break;
+	case Wrapping::MirroredRepeat:
+		flags |= BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR;
+		break;
+	}
+	switch (filter)
+	{
+	case Filter::Nearest:
+	case Filter::NearestMipmapNearest:
+		flags |= BGFX_SAMPLER_POINT;
+		break;
+	case Filter::NearestMipmapLinear:
+		flags |= BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT;
+		break;
+	case Filter::LinearMipmapNearest:
+		flags |= BGFX_SAMPLER_MIP_POINT;
+		break;
+	case Filter::Linear:
+	case Filter::LinearMipmapLinear:
+		break;
+	}
+	return flags;
+}
+} // namespace
+
 constexpr std::array<bgfx::TextureFormat::Enum,
                      static_cast<size_t>(Format::RGBA4) + 1>
     k_TextureFormatsBgfx {
@@ -98,44 +142,137 @@ Texture2D::~Texture2D()
 void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
                        const bgfx::Memory* memory) noexcept
 {
-	uint64_t flags = BGFX_TEXTURE_NONE;
-	switch (wrapping)
+	_flags = GetSamplerFlags(wrapping, filter);
+	Upload(width, height, layers, false, format, memory);
+	bgfx::frame();
+	bgfx::frame();
+}
+
+void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
+                       const void* data, uint32_t size) noexcept
+{
+
+	Texture2D::Create(width, height, layers, format, wrapping, filter, bgfx::makeRef(data, size));
+}
+
+void Texture2D::Create(std::span<const MipChain> layers, Wrapping wrapping, Filter filter) noexcept
+{
+	assert(!layers.empty());
+	const auto& first = layers.front();
+	const auto layerSize = first.GetSizeInBytes();
+	const auto* memory = bgfx::alloc(static_cast<uint32_t>(layerSize * layers.size()));
+	// bgfx expects every level of the first layer, then every level of the second and so on
+	for (size_t i = 0; i < layers.size(); ++i)
 	{
-	case Wrapping::ClampEdge:
-		flags |= BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
-		break;
-	case Wrapping::ClampBorder:
-		flags |= BGFX_SAMPLER_U_BORDER | BGFX_SAMPLER_V_BORDER;
-		break;
-	case Wrapping::Repeat:
-		break;
-	case Wrapping::MirroredRepeat:
-		flags |= BGFX_SAMPLER_U_MIRROR | BGFX_SAMPLER_V_MIRROR;
-		break;
+		assert(layers[i].GetFormat() == first.GetFormat() && layers[i].GetSizeInBytes() == layerSize);
+		layers[i].CopyLevels(0, memory->data + i * layerSize);
 	}
-	switch (filter)
+	_flags = GetSamplerFlags(wrapping, filter);
+	Upload(first.GetWidth(), first.GetHeight(), static_cast<uint16_t>(layers.size()), true, first.GetFormat(), memory);
+}
+
+void Texture2D::CreateStreamed(MipChain chain, Wrapping wrapping, Filter filter) noexcept
+{
+	_flags = GetSamplerFlags(wrapping, filter);
+	_streamed = std::make_unique<const MipChain>(std::move(chain));
+	UploadStreamed(GetStreamingBaseLevel());
+}
+
+void Texture2D::Upload(uint16_t width, uint16_t height, uint16_t layers, bool hasMips, Format format,
+                       const bgfx::Memory* memory) noexcept
+{
+	if (bgfx::isValid(_handle))
 	{
-	case Filter::Nearest:
-		flags |= BGFX_SAMPLER_POINT;
-		break;
-	case Filter::Linear:
-		break;
-	default:
-		assert(false);
+		bgfx::destroy(_handle);
+	}
+	_handle = bgfx::createTexture2D(width, height, hasMips, layers, getBgfxTextureFormat(format), _flags, memory);
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, memory != nullptr ? memory->size : 0);
 	}
-	_handle = bgfx::createTexture2D(width, height, false, layers, getBgfxTextureFormat(format), flags, memory);
 	bgfx::setName(_handle, _name.c_str());
-	bgfx::frame();
 
-	bgfx::calcTextureSize(_info, width, height, 1, false, false, layers, getBgfxTextureFormat(format));
-	bgfx::frame();
+	bgfx::calcTextureSize(_info, width, height, 1, false, hasMips, layers, getBgfxTextureFormat(format));
 }
 
-void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Format format, Wrapping wrapping, Filter filter,
-                       const void* data, uint32_t size) noexcept
+void Texture2D::UploadStreamed(uint8_t level) noexcept
 {
+	const auto* memory = bgfx::alloc(static_cast<uint32_t>(_streamed->GetSizeInBytes(level)));
+	_streamed->CopyLevels(level, memory->data);
+	Upload(_streamed->GetWidth(level), _streamed->GetHeight(level), 1, true, _streamed->GetFormat(), memory);
+	_streamedLevel = level;
+}
 
-	Texture2D::Create(width, height, layers, format, wrapping, filter, bgfx::makeRef(data, size));
+void Texture2D::RequestSize(float pixels) const
+{
+	const auto size = static_cast<uint16_t>(std::clamp(pixels, 0.0f, static_cast<float>(UINT16_MAX)));
+	_requestedSize = std::max(_requestedSize, size);
+}
+
+bool Texture2D::UpdateStreaming(size_t& budget) noexcept
+{
+	if (!_streamed)
+	{
+		return false;
+	}
+
+	// The smallest level with at least as many texels across as the draws covered pixels, without going under the
+	// levels the texture started with
+	const auto requested = std::exchange(_requestedSize, uint16_t {0});
+	const auto levelSize = [this](uint8_t level) {
+		return std::max(_streamed->GetWidth(level), _streamed->GetHeight(level));
+	};
+	auto wanted = GetStreamingBaseLevel();
+	while (wanted > 0 && levelSize(wanted) < requested)
+	{
+		--wanted;
+	}
+
+	if (wanted >= _streamedLevel)
+	{
+		// Keep the larger levels for a while in case the texture is drawn up close again
+		_coarserUpdates = wanted > _streamedLevel ? _coarserUpdates + 1 : 0;
+		if (_coarserUpdates < k_StreamingDropUpdates)
+		{
+			return false;
+		}
+	}
+
+	const auto size = _streamed->GetSizeInBytes(wanted);
+	if (size > budget)
+	{
+		return false;
+	}
+	budget -= size;
+	_coarserUpdates = 0;
+	UploadStreamed(wanted);
+	return true;
+}
+
+uint8_t Texture2D::GetStreamingBaseLevel() const
+{
+	uint8_t level = 0;
+	while (level + 1 < _streamed->GetLevelCount() &&
+	       std::max(_streamed->GetWidth(level), _streamed->GetHeight(level)) > k_StreamingBaseSize)
+	{
+		++level;
+	}
+	return level;
+}
+
+size_t Texture2D::GetCpuSizeInBytes() const
+{
+	return _streamed != nullptr ? _streamed->GetSizeInBytes() : 0;
+}
+
+void Texture2D::Update(uint16_t layer, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const void* data,
+                       uint32_t size) noexcept
+{
+	bgfx::updateTexture2D(_handle, layer, 0, x, y, width, height, bgfx::copy(data, size));
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, size);
+	}
 }
 
 void Texture2D::DumpTexture() const
@@ -12,6 +12,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <memory>
+#include <span>
 #include <string>
 
 #include <bgfx/bgfx.h>
@@ -96,10 +98,16 @@ enum class Wrapping : uint8_t
 bgfx::TextureFormat::Enum getBgfxTextureFormat(Format format);
 
 class FrameBuffer;
+class MipChain;
 
 class Texture2D
 {
 public:
+	/// Streamed textures start with the levels of their chain of this size and below
+	static constexpr uint16_t k_StreamingBaseSize = 64;
+	/// Streamed textures go back to smaller levels once draws asked for less for this many updates in a row
+	static constexpr uint32_t k_StreamingDropUpdates = 120;
+
 	explicit Texture2D(std::string name);
 	~Texture2D();
 
@@ -112,6 +120,14 @@ class Texture2D
 	void Create(uint16_t width, uint16_t height, uint16_t layers, Format format = Format::RGBA8,
 	            Wrapping wrapping = Wrapping::ClampEdge, Filter filter = Filter::Linear, const void* data = nullptr,
 	            uint32_t size = 0) noexcept;
+	/// Create a mipmapped texture with one chain per layer, the chains must all have the same size and format
+	void Create(std::span<const MipChain> layers, Wrapping wrapping, Filter filter) noexcept;
+	/// Upload the levels of the chain from k_StreamingBaseSize down and keep the chain so that UpdateStreaming can upload
+	/// the larger levels once draws ask for them
+	void CreateStreamed(MipChain chain, Wrapping wrapping, Filter filter) noexcept;
+	/// Replace a region of a layer, only valid for textures created without initial memory
+	void Update(uint16_t layer, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const void* data,
+	            uint32_t size) noexcept;
 
 	[[nodiscard]] const std::string& GetName() const { return _name; }
 	[[nodiscard]] const bgfx::TextureHandle& GetNativeHandle() const { return _handle; }
@@ -119,13 +135,39 @@ class Texture2D
 	[[nodiscard]] uint16_t GetHeight() const { return _info.height; }
 	[[nodiscard]] uint16_t GetLayerCount() const { return _info.numLayers; }
 	[[nodiscard]] bgfx::TextureFormat::Enum GetFormat() const { return _info.format; }
+	[[nodiscard]] uint32_t GetSizeInBytes() const { return _info.storageSize; }
+
+	/// Note that a draw covers about this many pixels of the screen with the texture, the largest request is kept until
+	/// the next UpdateStreaming
+	void RequestSize(float pixels) const;
+	/// Upload the levels draws asked for since the last update if they fit in `budget`, which is reduced by what was
+	/// uploaded. Returns whether the texture was recreated.
+	bool UpdateStreaming(size_t& budget) noexcept;
+	[[nodiscard]] bool IsStreamed() const { return _streamed != nullptr; }
+	/// Level of the streamed chain which is the largest on the GPU
+	[[nodiscard]] uint8_t GetStreamedLevel() const { return _streamedLevel; }
+	/// Bytes of the streamed chain kept in memory to upload from
+	[[nodiscard]] size_t GetCpuSizeInBytes() const;
 
 	void DumpTexture() const;
 
 protected:
+	/// Create the texture, replacing the one created before if any
+	void Upload(uint16_t width, uint16_t height, uint16_t layers, bool hasMips, Format format,
+	            const bgfx::Memory* memory) noexcept;
+	void UploadStreamed(uint8_t level) noexcept;
+	/// Level the streamed chain starts from, the largest which is no bigger than k_StreamingBaseSize
+	[[nodiscard]] uint8_t GetStreamingBaseLevel() const;
+
 	std::string _name;
 	bgfx::TextureHandle _handle;
 	bgfx::TextureInfo _info;
+	uint64_t _flags {BGFX_TEXTURE_NONE};
+
+	std::unique_ptr<const MipChain> _streamed;
+	uint8_t _streamedLevel {0};
+	mutable uint16_t _requestedSize {0};
+	uint32_t _coarserUpdates {0};
 
 	friend FrameBuffer;
 };
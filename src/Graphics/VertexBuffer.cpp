@@ -13,6 +13,9 @@
 
 #include <array>
 
+#include "Locator.h"
+#include "Profiler.h"
+
 using namespace openblack::graphics;
 
 namespace
@@ -69,6 +72,10 @@ VertexBuffer::VertexBuffer(std::string name, const void* vertices, uint32_t vert
 	_handle = bgfx::createVertexBuffer(mem, layout);
 	_layoutHandle = bgfx::createVertexLayout(layout);
 	bgfx::setName(_handle, _name.c_str());
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, mem->size);
+	}
 }
 
 VertexBuffer::VertexBuffer(std::string name, const bgfx::Memory* mem, VertexDecl decl) noexcept
@@ -107,6 +114,10 @@ VertexBuffer::VertexBuffer(std::string name, const bgfx::Memory* mem, VertexDecl
 	_handle = bgfx::createVertexBuffer(mem, layout);
 	_layoutHandle = bgfx::createVertexLayout(layout);
 	bgfx::setName(_handle, _name.c_str());
+	if (Locator::profiler::has_value())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::BytesUploaded, mem->size);
+	}
 }
 
 VertexBuffer::~VertexBuffer() noexcept
@@ -10,7 +10,6 @@
 #pragma once
 
 #include <array>
-#include <functional>
 #include <string>
 #include <vector>
 
@@ -92,7 +91,7 @@ class ScriptCommandParameter
 
 using ScriptCommandParameters = std::vector<ScriptCommandParameter>;
 
-using ScriptCommand = std::function<void(const ScriptCommandParameters&)>;
+using ScriptCommand = void (*)(const ScriptCommandParameters&);
 
 struct ScriptCommandSignature
 {
@@ -9,6 +9,7 @@
 
 #include "FeatureScriptCommands.h"
 
+#include <algorithm>
 #include <tuple>
 
 #include <glm/gtx/euler_angles.hpp>
@@ -18,6 +19,7 @@
 
 #include "3D/LandIslandInterface.h"
 #include "Camera/Camera.h"
+#include "Common/PerfectHash.h"
 #include "ECS/Archetypes/AbodeArchetype.h"
 #include "ECS/Archetypes/AnimatedStaticArchetype.h"
 #include "ECS/Archetypes/BigForestArchetype.h"
@@ -103,7 +105,7 @@ PlayerNames GetPlayerName(const std::string& name)
 
 } // namespace
 
-const std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Signatures = {{
+constexpr std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Signatures = {{
     CREATE_COMMAND_BINDING("SET_A_TOWNS_INFLUENCE_MULTIPLIER", SetATownInfluenceMultiplier),
     CREATE_COMMAND_BINDING("CREATE_MIST", CreateMist),
     CREATE_COMMAND_BINDING("CREATE_PATH", CreatePath),
@@ -212,6 +214,26 @@ const std::array<const ScriptCommandSignature, 106> FeatureScriptCommands::k_Sig
     CREATE_COMMAND_BINDING("SET_LOST_TOWN_SCALE", SetLostTownScale),
 }};
 
+namespace
+{
+template <size_t N>
+constexpr std::array<std::string_view, N> GetSignatureNames(const std::array<const ScriptCommandSignature, N>& signatures)
+{
+	std::array<std::string_view, N> names;
+	std::transform(signatures.cbegin(), signatures.cend(), names.begin(),
+	               [](const auto& signature) { return std::string_view(signature.name.data()); });
+	return names;
+}
+
+constexpr PerfectHash k_SignatureLookup(GetSignatureNames(FeatureScriptCommands::k_Signatures));
+} // namespace
+
+const ScriptCommandSignature* FeatureScriptCommands::FindSignature(std::string_view name) noexcept
+{
+	const auto index = k_SignatureLookup.Find(name);
+	return index.has_value() ? &k_Signatures.at(*index) : nullptr;
+}
+
 inline glm::mat4 GetRotation(int rotation)
 {
 	return glm::eulerAngleY(static_cast<float>(rotation) * -0.001f);
@@ -363,7 +385,15 @@ void FeatureScriptCommands::CreateVillagerPos(glm::vec3 abodePosition, glm::vec3
                                               int32_t age)
 {
 	auto [tribe, number] = GetVillagerTribeAndNumber(tribeAndNumber);
-	VillagerArchetype::Create(abodePosition, position, GVillagerInfo::Find(tribe, number), age);
+	const auto type = GVillagerInfo::Find(tribe, number);
+	auto& batch = Locator::entitiesRegistry::value().Context().constructionBatch;
+	if (batch.has_value())
+	{
+		batch->villagers.emplace_back(
+		    VillagerArchetype::Parameters {abodePosition, position, type, static_cast<uint32_t>(age)});
+		return;
+	}
+	VillagerArchetype::Create(abodePosition, position, type, age);
 }
 
 void FeatureScriptCommands::CreateCitadel(glm::vec3 position, int32_t, const std::string& playerOwner, int32_t rotation,
@@ -431,6 +461,13 @@ void FeatureScriptCommands::CreateDeadTree(glm::vec3 position, [[maybe_unused]]
 void FeatureScriptCommands::CreateNewTree(int32_t forestId, glm::vec3 position, TreeInfo treeType, int32_t isNonScenic,
                                           float rotation, float currentSize, float maxSize)
 {
+	auto& batch = Locator::entitiesRegistry::value().Context().constructionBatch;
+	if (batch.has_value())
+	{
+		batch->trees.emplace_back(TreeArchetype::Parameters {static_cast<uint32_t>(forestId), position, treeType,
+		                                                     static_cast<bool>(isNonScenic), rotation, maxSize, currentSize});
+		return;
+	}
 	TreeArchetype::Create(forestId, position, treeType, static_cast<bool>(isNonScenic), rotation, maxSize, currentSize);
 }
 
@@ -518,16 +555,20 @@ void FeatureScriptCommands::CreateScaffold(int32_t, [[maybe_unused]] glm::vec3 p
 	// __func__);
 }
 
-void FeatureScriptCommands::CountryChange([[maybe_unused]] glm::vec3 position, int32_t)
+void FeatureScriptCommands::CountryChange(glm::vec3 position, int32_t country)
 {
-	// SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "LHScriptX: {}:{}: Function {} not implemented.", __FILE__, __LINE__,
-	// __func__);
+	auto& island = Locator::terrainSystem::value();
+	const auto cell = glm::u16vec2(glm::vec2(position.x, position.z) / LandIslandInterface::k_CellSize);
+	island.SetCountry(cell, static_cast<uint8_t>(std::clamp(country, 0, 0xFF)));
+	island.ApplyEdits();
 }
 
-void FeatureScriptCommands::HeightChange([[maybe_unused]] glm::vec3 position, int32_t)
+void FeatureScriptCommands::HeightChange(glm::vec3 position, int32_t altitude)
 {
-	// SPDLOG_LOGGER_ERROR(spdlog::get("scripting"), "LHScriptX: {}:{}: Function {} not implemented.", __FILE__, __LINE__,
-	// __func__);
+	auto& island = Locator::terrainSystem::value();
+	const auto cell = glm::u16vec2(glm::vec2(position.x, position.z) / LandIslandInterface::k_CellSize);
+	island.SetAltitude(cell, static_cast<uint8_t>(std::clamp(altitude, 0, 0xFF)));
+	island.ApplyEdits();
 }
 
 void FeatureScriptCommands::CreateCreature(glm::vec3 position, int32_t param2, int32_t param3)
@@ -672,7 +713,7 @@ void FeatureScriptCommands::CreateStreamPoint(int32_t streamId, glm::vec3 positi
 	auto& registryContext = registry.Context();
 
 	Stream& stream = registry.Get<Stream>(registryContext.streams.at(streamId));
-	stream.nodes.emplace_back(position, stream.nodes);
+	stream.AddNode(position);
 }
 
 void FeatureScriptCommands::CreateWaterfall([[maybe_unused]] glm::vec3 position)
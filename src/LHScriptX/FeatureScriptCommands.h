@@ -10,6 +10,7 @@
 #pragma once
 
 #include <array>
+#include <string_view>
 
 #include <glm/vec3.hpp>
 
@@ -24,6 +25,9 @@ class FeatureScriptCommands
 public:
 	static const std::array<const ScriptCommandSignature, 106> k_Signatures;
 
+	/// Find the signature of a command by name in constant time, nullptr if there is no such command
+	[[nodiscard]] static const ScriptCommandSignature* FindSignature(std::string_view name) noexcept;
+
 	static void SetATownInfluenceMultiplier(int32_t townId, float mult);
 	static void CreateMist(glm::vec3 position, float param2, int32_t param3, float param4, float param5);
 	static void CreatePath(int32_t param1, int32_t param2, int32_t param3, int32_t param4);
@@ -77,8 +81,8 @@ class FeatureScriptCommands
 	static void CreateMobileUStatic(glm::vec3 position, MobileStaticInfo type, float verticalOffset, float xRotation,
 	                                float yRotation, float zRotation, float scale);
 	static void CreateScaffold(int32_t, glm::vec3, int32_t, int32_t, int32_t);
-	static void CountryChange(glm::vec3 position, int32_t);
-	static void HeightChange(glm::vec3 position, int32_t);
+	static void CountryChange(glm::vec3 position, int32_t country);
+	static void HeightChange(glm::vec3 position, int32_t altitude);
 	static void CreateCreature(glm::vec3 position, int32_t, int32_t);
 	static void CreateCreatureFromFile(const std::string& playerName, CreatureType creatureType,
 	                                   const std::string& creatureMind, glm::vec3 position);
@@ -10,13 +10,16 @@
 #include "Lexer.h"
 
 #include <cctype>
+#include <charconv>
+#include <cstdlib>
 
-#include <utility>
+#include <algorithm>
+#include <array>
 
 using namespace openblack::lhscriptx;
 
-Lexer::Lexer(std::string source)
-    : _source(std::move(source))
+Lexer::Lexer(std::string_view source)
+    : _source(source)
 {
 	_current = _source.begin();
 	_end = _source.end();
@@ -36,10 +39,10 @@ Token Lexer::GetToken()
 		{
 		case '/':
 			// Comment syntax. Ignore the rest of the line
-			if (*(_current + 1) == '/')
+			if (Remaining() > 1 && _current[1] == '/')
 			{
 				// Skip line
-				while (*_current != '\n' && _current != _end)
+				while (HasMore() && *_current != '\n')
 				{
 					_current++;
 				}
@@ -51,7 +54,7 @@ Token Lexer::GetToken()
 			_current++;
 
 			// skip over whitespace quickly
-			while (*_current == ' ' || *_current == '\t' || *_current == '\r')
+			while (HasMore() && (*_current == ' ' || *_current == '\t' || *_current == '\r'))
 			{
 				_current++;
 			}
@@ -64,7 +67,7 @@ Token Lexer::GetToken()
 		// not sure if it's **** or just *, this can be drastically improved on
 		// though
 		case '*':
-			while (*_current != '\n')
+			while (HasMore() && *_current != '\n')
 			{
 				_current++;
 			}
@@ -73,10 +76,9 @@ Token Lexer::GetToken()
 		// handle potential rem/REM
 		case 'R':
 		case 'r':
-			// todo: potential out of bounds here:
-			if ((_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
+			if (Remaining() > 2 && (_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
 			{
-				while (*_current != '\n')
+				while (HasMore() && *_current != '\n')
 				{
 					_current++;
 				}
@@ -200,7 +202,7 @@ Token Lexer::GatherIdentifer()
 		_current++;
 	}
 
-	return Token::MakeIdentifierToken(std::string(idStart, _current));
+	return Token::MakeIdentifierToken(std::string_view(idStart, _current));
 }
 
 Token Lexer::GatherNumber()
@@ -234,9 +236,17 @@ Token Lexer::GatherNumber()
 		}
 	}
 
+	const std::string_view number(numberStart, _current);
 	if (isFloat)
 	{
-		float value = std::stof(std::string(numberStart, _current));
+		// Copy to a terminated buffer on the stack rather than allocating a string for std::stof
+		std::array<char, 64> buffer {};
+		if (number.empty() || number.size() >= buffer.size())
+		{
+			throw LexerException("invalid float " + std::string(number));
+		}
+		std::copy(number.cbegin(), number.cend(), buffer.begin());
+		float value = std::strtof(buffer.data(), nullptr);
 		if (isNeg)
 		{
 			value = -value;
@@ -244,7 +254,12 @@ Token Lexer::GatherNumber()
 		return Token::MakeFloatToken(value);
 	}
 
-	int value = std::stoi(std::string(numberStart, _current));
+	int value = 0;
+	const auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), value);
+	if (error != std::errc())
+	{
+		throw LexerException("invalid integer " + std::string(number));
+	}
 	if (isNeg)
 	{
 		value = -value;
@@ -256,13 +271,17 @@ Token Lexer::GatherString()
 {
 	auto stringStart = ++_current;
 
-	// todo: we should check for unterminated strings
 	while (HasMore() && *_current != '"')
 	{
 		_current++;
 	}
 
-	return Token::MakeStringToken(std::string(stringStart, _current++));
+	if (!HasMore())
+	{
+		throw LexerException("unterminated string on line " + std::to_string(_currentLine));
+	}
+
+	return Token::MakeStringToken(std::string_view(stringStart, _current++));
 }
 
 void Token::Print(FILE* file) const
@@ -279,10 +298,10 @@ void Token::Print(FILE* file) const
 		fprintf(file, "\n");
 		break;
 	case Type::Identifier:
-		fprintf(file, "identifier \"%s\"", this->_s.c_str());
+		fprintf(file, "identifier \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::String:
-		fprintf(file, "quoted string \"%s\"", this->_s.c_str());
+		fprintf(file, "quoted string \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::Integer:
 		fprintf(file, "integer %d", this->_u.integerValue);
@@ -15,6 +15,7 @@
 #include <glm/vec2.hpp>
 
 #include "3D/LandIslandInterface.h"
+#include "ECS/Registry.h"
 #include "FeatureScriptCommands.h"
 #include "Lexer.h"
 #include "Locator.h"
@@ -25,8 +26,39 @@ using namespace openblack::lhscriptx;
 Script::Script() = default;
 
 void Script::Load(const std::string& source)
+{
+	// Scripts loaded from within a script add to the batch of the outermost one
+	if (Locator::entitiesRegistry::value().Context().constructionBatch.has_value())
+	{
+		RunCommands(source);
+		return;
+	}
+
+	Locator::entitiesRegistry::value().Context().constructionBatch.emplace();
+	try
+	{
+		RunCommands(source);
+	}
+	catch (...)
+	{
+		Locator::entitiesRegistry::value().Context().constructionBatch.reset();
+		throw;
+	}
+
+	// Commands may have reset the registry so the context is looked up again
+	auto& batch = Locator::entitiesRegistry::value().Context().constructionBatch;
+	if (batch.has_value())
+	{
+		auto pending = std::move(*batch);
+		batch.reset();
+		pending.Flush();
+	}
+}
+
+void Script::RunCommands(const std::string& source)
 {
 	Lexer lexer(source);
+	_token = Token::MakeInvalidToken();
 
 	const Token* token = this->PeekToken(lexer);
 	while (!token->IsEOF())
@@ -35,17 +67,18 @@ void Script::Load(const std::string& source)
 
 		if (token->IsIdentifier())
 		{
-			const std::string identifier = token->Identifier();
+			const std::string_view identifier = token->Identifier();
 
-			if (!IsCommand(identifier))
+			const auto* signature = FindCommand(identifier);
+			if (signature == nullptr)
 			{
-				throw std::runtime_error("unknown command: " + identifier);
+				throw std::runtime_error("unknown command: " + std::string(identifier));
 			}
 
 			token = this->AdvanceToken(lexer);
 			if (!token->IsOP(Operator::LeftParentheses))
 			{
-				throw std::runtime_error("expected ( after identifier " + identifier);
+				throw std::runtime_error("expected ( after identifier " + std::string(identifier));
 			}
 
 			std::vector<Token> args;
@@ -78,18 +111,16 @@ void Script::Load(const std::string& source)
 			// move token to whatever is after ')'
 			this->AdvanceToken(lexer);
 
-			RunCommand(identifier, args);
+			RunCommand(*signature, args);
 		}
 
 		this->AdvanceToken(lexer);
 	}
 }
 
-bool Script::IsCommand(const std::string& identifier) const
+const ScriptCommandSignature* Script::FindCommand(std::string_view identifier)
 {
-	// TODO(handsomematt): this could be done a lot better
-	return std::any_of(FeatureScriptCommands::k_Signatures.cbegin(), FeatureScriptCommands::k_Signatures.cend(),
-	                   [&identifier](const auto& s) { return s.name.data() == identifier; });
+	return FeatureScriptCommands::FindSignature(identifier);
 }
 
 ScriptCommandParameter GetParameter(Token& argument)
@@ -105,10 +136,10 @@ ScriptCommandParameter GetParameter(Token& argument)
 	case Token::Type::EndOfLine:
 		throw std::runtime_error("Unexpected EOL in script");
 	case Token::Type::Identifier:
-		return ScriptCommandParameter(argument.Identifier());
+		return ScriptCommandParameter(std::string(argument.Identifier()));
 	case Token::Type::String:
 	{
-		const auto& str = argument.StringValue();
+		const auto str = std::string(argument.StringValue());
 		// Check if it's a vector
 		if (std::count_if(str.cbegin(), str.cend(), [](char c) { return c == ','; }) == 1)
 		{
@@ -139,28 +170,11 @@ ScriptCommandParameter GetParameter(Token& argument)
 	}
 }
 
-void Script::RunCommand(const std::string& identifier, const std::vector<Token>& args)
+void Script::RunCommand(const ScriptCommandSignature& commandSignature, const std::vector<Token>& args)
 {
-	const ScriptCommandSignature* commandSignature = nullptr;
-
-	for (const auto& signature : FeatureScriptCommands::k_Signatures)
-	{
-		if (signature.name.data() != identifier)
-		{
-			continue;
-		}
-
-		commandSignature = &signature;
-		break;
-	}
-
-	if (commandSignature == nullptr)
-	{
-		throw std::runtime_error("Missing script command signature");
-	}
-
 	// Turn tokens into parameters
 	auto parameters = ScriptCommandParameters();
+	parameters.reserve(args.size());
 
 	for (auto arg : args)
 	{
@@ -168,10 +182,10 @@ void Script::RunCommand(const std::string& identifier, const std::vector<Token>&
 		parameters.push_back(param);
 	}
 
-	const auto expectedParameters = commandSignature->parameters;
+	const auto expectedParameters = commandSignature.parameters;
 	uint32_t expectedSize;
 	// TODO (#749) use std::views::enumerate
-	for (expectedSize = 0; const auto& p : commandSignature->parameters)
+	for (expectedSize = 0; const auto& p : commandSignature.parameters)
 	{
 		// Looping until None because parameters is a fixed sized array.
 		// Last Argument is the one before the first None or the 9th
@@ -197,7 +211,7 @@ void Script::RunCommand(const std::string& identifier, const std::vector<Token>&
 		}
 	}
 
-	commandSignature->command(parameters);
+	commandSignature.command(parameters);
 }
 
 const Token* Script::PeekToken(Lexer& lexer)
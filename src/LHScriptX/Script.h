@@ -9,8 +9,10 @@
 
 #pragma once
 
+#include <string_view>
 #include <vector>
 
+#include "CommandSignature.h"
 #include "Lexer.h"
 
 namespace openblack::lhscriptx
@@ -21,11 +23,13 @@ class Script
 public:
 	Script();
 
+	/// Run every command of the script. Trees and villagers are queued while loading and created in bulk at the end.
 	void Load(const std::string&);
 
 private:
-	[[nodiscard]] bool IsCommand(const std::string& identifier) const;
-	void RunCommand(const std::string& identifier, const std::vector<Token>& args);
+	void RunCommands(const std::string& source);
+	[[nodiscard]] static const ScriptCommandSignature* FindCommand(std::string_view identifier);
+	void RunCommand(const ScriptCommandSignature& signature, const std::vector<Token>& args);
 
 	const Token* PeekToken(Lexer&);
 	const Token* AdvanceToken(Lexer&);
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
@@ -33,7 +35,7 @@ template <>
 constexpr inline ParameterType k_ParameterTypeStaticLookUpRegular<int32_t> = ParameterType::Number;
 
 template <typename T>
-inline ParameterType GetParamType()
+constexpr ParameterType GetParamType()
 {
 	if constexpr (std::is_enum_v<T>)
 	{
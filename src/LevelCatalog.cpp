@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "LevelCatalog.h"
+
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <BinaryReader.h>
+#include <spdlog/spdlog.h>
+
+#include "Common/StringUtils.h"
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+
+using namespace openblack;
+
+namespace
+{
+constexpr std::array<char, 4> k_CacheMagic = {'O', 'B', 'L', 'C'};
+
+/// Size and modification time of a script, left at 0 for files std::filesystem can't see such as Android assets
+void Stamp(LevelCatalog::Entry& entry)
+{
+	std::error_code ec;
+	const auto size = std::filesystem::file_size(entry.scriptPath, ec);
+	if (ec)
+	{
+		return;
+	}
+	const auto time = std::filesystem::last_write_time(entry.scriptPath, ec);
+	if (ec)
+	{
+		return;
+	}
+	entry.fileSize = size;
+	entry.writeTime = static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+void WriteString(std::ofstream& stream, const std::string& value)
+{
+	stream.write(value.c_str(), static_cast<std::streamsize>(value.size() + 1));
+}
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+} // namespace
+
+bool LevelCatalog::LoadCache(const std::filesystem::path& path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream)
+	{
+		return false;
+	}
+	const auto bytes = ReadAllBytes(stream);
+	BinaryReader reader(bytes);
+
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t count;
+	if (!reader.Read(magic) || magic != k_CacheMagic || !reader.Read(version) || version != k_CacheVersion ||
+	    !reader.Read(count))
+	{
+		SPDLOG_LOGGER_INFO(spdlog::get("game"), "Level cache {} is from another version, rebuilding it", path.string());
+		return false;
+	}
+
+	std::unordered_map<std::string, Entry> cached;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Entry entry;
+		std::string scriptPath;
+		uint8_t landType;
+		uint8_t isLevel;
+		uint32_t landscapeCount;
+		if (!reader.ReadString(scriptPath) || !reader.Read(landType) || !reader.Read(entry.fileSize) ||
+		    !reader.Read(entry.writeTime) || !reader.Read(isLevel) || !reader.ReadString(entry.name) ||
+		    !reader.ReadString(entry.description) || !reader.Read(landscapeCount))
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Level cache {} is truncated, rebuilding it", path.string());
+			return false;
+		}
+		for (uint32_t j = 0; j < landscapeCount; ++j)
+		{
+			std::string landscapePath;
+			if (!reader.ReadString(landscapePath))
+			{
+				SPDLOG_LOGGER_WARN(spdlog::get("game"), "Level cache {} is truncated, rebuilding it", path.string());
+				return false;
+			}
+			entry.landscapePaths.emplace_back(landscapePath);
+		}
+		entry.scriptPath = scriptPath;
+		entry.landType = static_cast<Level::LandType>(landType != 0);
+		entry.isLevel = isLevel != 0;
+		cached.emplace(std::move(scriptPath), std::move(entry));
+	}
+	_cached = std::move(cached);
+	return true;
+}
+
+bool LevelCatalog::SaveCache(const std::filesystem::path& path) const
+{
+	// Every entry came out of the cache and none of its entries went away
+	if (_parsedCount == 0 && _entries.size() == _cached.size())
+	{
+		return true;
+	}
+
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Unable to write level cache {}", path.string());
+		return false;
+	}
+	stream.write(k_CacheMagic.data(), k_CacheMagic.size());
+	WriteValue(stream, k_CacheVersion);
+	WriteValue(stream, static_cast<uint32_t>(_entries.size()));
+	for (const auto& entry : _entries)
+	{
+		WriteString(stream, entry.scriptPath.generic_string());
+		WriteValue(stream, static_cast<uint8_t>(entry.landType));
+		WriteValue(stream, entry.fileSize);
+		WriteValue(stream, entry.writeTime);
+		WriteValue(stream, static_cast<uint8_t>(entry.isLevel));
+		WriteString(stream, entry.name);
+		WriteString(stream, entry.description);
+		WriteValue(stream, static_cast<uint32_t>(entry.landscapePaths.size()));
+		for (const auto& landscapePath : entry.landscapePaths)
+		{
+			WriteString(stream, landscapePath.generic_string());
+		}
+	}
+	return static_cast<bool>(stream);
+}
+
+void LevelCatalog::Scan(const std::filesystem::path& directory, Level::LandType landType, const Filter& filter)
+{
+	Locator::filesystem::value().Iterate(directory, false, [this, landType, &filter](const std::filesystem::path& f) {
+		if (f.extension() != ".txt" || (filter && !filter(f)))
+		{
+			return;
+		}
+
+		Entry entry;
+		entry.scriptPath = f;
+		entry.landType = landType;
+		Stamp(entry);
+
+		const auto cached = _cached.find(f.generic_string());
+		if (entry.writeTime != 0 && cached != _cached.end() && cached->second.landType == landType &&
+		    cached->second.fileSize == entry.fileSize && cached->second.writeTime == entry.writeTime)
+		{
+			_entries.emplace_back(cached->second);
+			return;
+		}
+
+		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Indexing level script: {}", f.stem().string());
+		++_parsedCount;
+		try
+		{
+			Parse(entry);
+		}
+		catch (std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}", err.what());
+		}
+		_entries.emplace_back(std::move(entry));
+	});
+}
+
+void LevelCatalog::Parse(Entry& entry)
+{
+	const std::string loadLandscapeLine("LOAD_LANDSCAPE");
+	const std::string startMessageLine("START_GAME_MESSAGE");
+	const std::string gameMessageLine("ADD_GAME_MESSAGE_LINE");
+
+	entry.name = entry.scriptPath.stem().filename().string();
+	auto levelFile = Locator::filesystem::value().Open(entry.scriptPath, filesystem::Stream::Mode::Read);
+	while (!levelFile->IsEndOfFile())
+	{
+		std::string line = levelFile->GetLine();
+		if (line.find(loadLandscapeLine) != std::string::npos)
+		{
+			// Which landscape is used is only known when the level is loaded, as it depends on which files exist then
+			entry.isLevel = true;
+			entry.landscapePaths.emplace_back(string_utils::ExtractQuote(line));
+		}
+		if (line.find(startMessageLine) != std::string::npos)
+		{
+			entry.name = string_utils::ExtractQuote(line);
+		}
+		if (line.find(gameMessageLine) != std::string::npos)
+		{
+			entry.description = string_utils::ExtractQuote(line);
+		}
+	}
+}
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Level.h"
+
+namespace openblack
+{
+
+/// Index of the level scripts installed with the game, with the metadata the level menus show. The index is kept in a
+/// cache file between runs so that only the scripts which were added or changed since are read at start-up, a level's
+/// script is otherwise only read when the level is loaded.
+class LevelCatalog
+{
+public:
+	/// Bumped whenever the cache layout or what is extracted from the scripts changes
+	static constexpr uint32_t k_CacheVersion = 2;
+
+	struct Entry
+	{
+		std::filesystem::path scriptPath;
+		Level::LandType landType;
+		/// Size and modification time of the script when it was parsed, 0 when they can't be known and the script has
+		/// to be read every time
+		uint64_t fileSize {0};
+		int64_t writeTime {0};
+		/// The script loads a landscape, other scripts in the same directories are helpers
+		bool isLevel {false};
+		std::string name;
+		std::string description;
+		/// Every landscape the script loads in order, the level uses the first one which exists like Level::ParseLevel
+		std::vector<std::filesystem::path> landscapePaths;
+	};
+
+	using Filter = std::function<bool(const std::filesystem::path&)>;
+
+	/// Read the entries of a previous run, returns false if there is no cache or it was written by another version
+	bool LoadCache(const std::filesystem::path& path);
+	/// Write the entries out, nothing is written when the cache loaded is still up to date
+	bool SaveCache(const std::filesystem::path& path) const;
+
+	/// Index the .txt scripts of a directory which `filter` accepts, reusing the cached entries of unchanged scripts
+	void Scan(const std::filesystem::path& directory, Level::LandType landType, const Filter& filter = {});
+
+	/// Read the script once and extract its metadata
+	static void Parse(Entry& entry);
+
+	[[nodiscard]] const std::vector<Entry>& GetEntries() const { return _entries; }
+	/// Number of scripts which had to be read by the scans so far
+	[[nodiscard]] size_t GetParsedCount() const { return _parsedCount; }
+
+private:
+	std::unordered_map<std::string, Entry> _cached;
+	std::vector<Entry> _entries;
+	size_t _parsedCount {0};
+};
+
+} // namespace openblack
@@ -23,6 +23,7 @@
 #include "CHLApi.h"
 #include "Common/EventManager.h"
 #include "Common/RandomNumberManagerProduction.h"
+#include "Common/TaskScheduler.h"
 #include "Debug/DebugGuiInterface.h"
 #include "ECS/Archetypes/PlayerArchetype.h"
 #include "ECS/MapProduction.h"
@@ -44,7 +45,7 @@
 #if __ANDROID__
 #include "FileSystem/AndroidFileSystem.h"
 #else
-#include "FileSystem/DefaultFileSystem.h"
+#include "FileSystem/ArchiveFileSystem.h"
 #endif
 
 using namespace openblack::audio;
@@ -83,6 +84,7 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), GLM_VERSION_MESSAGE);
 
 	Locator::profiler::emplace();
+	Locator::taskScheduler::emplace();
 
 	Locator::rendererInterface::reset(
 	    RendererInterface::Create(static_cast<bgfx::RendererType::Enum>(rendererType), vsync).release());
@@ -97,7 +99,7 @@ bool openblack::InitializeEngine(uint8_t rendererType, bool vsync) noexcept
 #if __ANDROID__
 	Locator::filesystem::emplace<AndroidFileSystem>();
 #else
-	Locator::filesystem::emplace<DefaultFileSystem>();
+	Locator::filesystem::emplace<ArchiveFileSystem>();
 #endif
 	Locator::rng::emplace<RandomNumberManagerProduction>();
 	try
@@ -190,4 +192,5 @@ void openblack::ShutDownServices()
 	Locator::profiler::reset();
 
 	Locator::vm::reset();
+	Locator::taskScheduler::reset();
 }
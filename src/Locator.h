@@ -26,6 +26,7 @@ class OceanInterface;
 class Profiler;
 class RandomNumberManagerInterface;
 class SkyInterface;
+class TaskScheduler;
 class TempleInteriorInterface;
 
 namespace v120
@@ -109,6 +110,7 @@ struct Locator
 	using config = entt::locator<EngineConfig>;
 	using infoConstants = entt::locator<const InfoConstants>;
 	using profiler = entt::locator<Profiler>;
+	using taskScheduler = entt::locator<TaskScheduler>;
 	using events = entt::locator<EventManager>;
 	using windowing = entt::locator<windowing::WindowingInterface>;
 	using debugGui = entt::locator<debug::gui::DebugGuiInterface>;
@@ -25,7 +25,7 @@ std::unique_ptr<const InfoConstants> InfoFile::LoadFromFile(const std::filesyste
 	auto infos = std::make_unique<InfoConstants>();
 	std::vector<uint8_t> data;
 	pack::PackFile pack;
-	const auto result = pack.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = pack.Open(Locator::filesystem::value().ReadAll(path));
 	if (result != pack::PackResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open {}: {}", path.generic_string(), pack::ResultToStr(result));
@@ -11,30 +11,343 @@
 
 #include <cassert>
 
-void openblack::Profiler::Begin(Stage stage)
+#include <atomic>
+#include <limits>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+using openblack::Profiler;
+
+namespace
+{
+/// Events each thread can hold between two frames, must be a power of two
+constexpr size_t k_ThreadBufferSize = 1 << 14;
+constexpr Profiler::ZoneId k_EndZone = std::numeric_limits<Profiler::ZoneId>::max();
+
+std::atomic<uint64_t> g_NextProfilerId {1};
+
+std::string EscapeJson(std::string_view str)
+{
+	std::string result;
+	result.reserve(str.size());
+	for (const auto c : str)
+	{
+		switch (c)
+		{
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				result += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+			}
+			else
+			{
+				result += c;
+			}
+			break;
+		}
+	}
+	return result;
+}
+
+double ToMicroseconds(Profiler::Clock::duration duration)
 {
-	assert(_currentLevel < 255);
-	auto& entry = _entries.at(_currentEntry).stages.at(static_cast<uint8_t>(stage));
-	entry.level = _currentLevel;
-	_currentLevel++;
-	entry.start = std::chrono::system_clock::now();
-	entry.finalized = false;
+	return std::chrono::duration<double, std::micro>(duration).count();
 }
+} // namespace
 
-void openblack::Profiler::End(Stage stage)
+/// Single producer (the owning thread), single consumer (Frame on the main thread) ring of zone events
+struct Profiler::ThreadBuffer
 {
-	assert(_currentLevel > 0);
-	auto& entry = _entries.at(_currentEntry).stages.at(static_cast<uint8_t>(stage));
-	assert(!entry.finalized);
-	_currentLevel--;
-	assert(entry.level == _currentLevel);
-	entry.end = std::chrono::system_clock::now();
-	entry.finalized = true;
+	struct Event
+	{
+		ZoneId zone;
+		Clock::time_point time;
+	};
+
+	struct OpenZone
+	{
+		ZoneId zone;
+		Clock::time_point start;
+	};
+
+	explicit ThreadBuffer(uint32_t index)
+	    : index(index)
+	{
+	}
+
+	bool Push(const Event& event, size_t reserved)
+	{
+		const auto writeIndex = head.load(std::memory_order_relaxed);
+		if (k_ThreadBufferSize - (writeIndex - tail.load(std::memory_order_acquire)) < reserved)
+		{
+			return false;
+		}
+		events.at(writeIndex & (k_ThreadBufferSize - 1)) = event;
+		head.store(writeIndex + 1, std::memory_order_release);
+		return true;
+	}
+
+	const uint32_t index;
+	std::array<Event, k_ThreadBufferSize> events;
+	std::atomic<size_t> head {0};
+	std::atomic<size_t> tail {0};
+	std::array<std::atomic<int64_t>, static_cast<uint8_t>(Counter::_count)> counters {};
+	std::atomic<uint64_t> dropped {0};
+
+	// Owning thread only, whether each open zone made it in the ring so its end is dropped along with it
+	std::vector<bool> openDropped;
+
+	// Main thread only
+	std::vector<OpenZone> open;
+	bool namedInTrace = false;
+};
+
+Profiler::Profiler()
+    : _instanceId(g_NextProfilerId++)
+{
+	for (const auto& name : k_StageNames)
+	{
+		// Some stages share a name between passes, they still get their own id
+		_zoneNames.emplace_back(std::make_unique<const std::string>(name));
+		_zoneIds.try_emplace(*_zoneNames.back(), static_cast<ZoneId>(_zoneNames.size() - 1));
+	}
+	// Claim thread 0 for the thread creating the profiler
+	static_cast<void>(GetThreadBuffer());
 }
 
-void openblack::Profiler::Frame()
+Profiler::~Profiler()
 {
-	auto& prevEntry = _entries.at(_currentEntry);
+	StopTrace();
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+	thread_local uint64_t cachedProfilerId = 0;
+	thread_local ThreadBuffer* cachedBuffer = nullptr;
+	if (cachedProfilerId != _instanceId)
+	{
+		const std::lock_guard lock(_threadsMutex);
+		_threads.emplace_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(_threads.size())));
+		cachedProfilerId = _instanceId;
+		cachedBuffer = _threads.back().get();
+	}
+	return *cachedBuffer;
+}
+
+Profiler::ZoneId Profiler::Intern(std::string_view name)
+{
+	{
+		const std::shared_lock lock(_zonesMutex);
+		if (const auto iter = _zoneIds.find(name); iter != _zoneIds.end())
+		{
+			return iter->second;
+		}
+	}
+
+	const std::unique_lock lock(_zonesMutex);
+	if (const auto iter = _zoneIds.find(name); iter != _zoneIds.end())
+	{
+		return iter->second;
+	}
+	_zoneNames.emplace_back(std::make_unique<const std::string>(name));
+	const auto zone = static_cast<ZoneId>(_zoneNames.size() - 1);
+	_zoneIds.emplace(*_zoneNames.back(), zone);
+	return zone;
+}
+
+std::string_view Profiler::GetZoneName(ZoneId zone) const
+{
+	const std::shared_lock lock(_zonesMutex);
+	return *_zoneNames.at(zone);
+}
+
+void Profiler::Begin(Stage stage)
+{
+	BeginZone(static_cast<ZoneId>(stage));
+}
+
+void Profiler::End([[maybe_unused]] Stage stage)
+{
+	EndZone();
+}
+
+void Profiler::BeginZone(ZoneId zone)
+{
+	auto& buffer = GetThreadBuffer();
+	assert(buffer.openDropped.size() < 255);
+	// Keep room for the end of every open zone, so an end is never dropped when its beginning was recorded
+	const auto pushed = buffer.Push({zone, Clock::now()}, buffer.openDropped.size() + 2);
+	buffer.openDropped.push_back(!pushed);
+	if (!pushed)
+	{
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Profiler::EndZone()
+{
+	auto& buffer = GetThreadBuffer();
+	assert(!buffer.openDropped.empty());
+	const bool dropped = buffer.openDropped.back();
+	buffer.openDropped.pop_back();
+	if (!dropped)
+	{
+		[[maybe_unused]] const auto pushed = buffer.Push({k_EndZone, Clock::now()}, 1);
+		assert(pushed);
+	}
+}
+
+void Profiler::Count(Counter counter, int64_t value)
+{
+	GetThreadBuffer().counters.at(static_cast<uint8_t>(counter)).fetch_add(value, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::GetThreadCount() const
+{
+	const std::lock_guard lock(_threadsMutex);
+	return static_cast<uint32_t>(_threads.size());
+}
+
+uint64_t Profiler::GetDroppedZoneCount() const
+{
+	const std::lock_guard lock(_threadsMutex);
+	uint64_t dropped = 0;
+	for (const auto& buffer : _threads)
+	{
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+void Profiler::Frame()
+{
+	const auto now = Clock::now();
+	auto& entry = _entries.at(_currentEntry);
+	entry.frameEnd = now;
+	{
+		const std::lock_guard lock(_threadsMutex);
+		for (auto& buffer : _threads)
+		{
+			Collect(*buffer, entry);
+		}
+	}
+
+	if (IsTracing())
+	{
+		if (entry.frameStart.time_since_epoch().count() != 0)
+		{
+			WriteTraceEvent(fmt::format(R"({{"name":"Frame","ph":"X","pid":0,"tid":0,"ts":{:.3f},"dur":{:.3f}}})",
+			                            ToMicroseconds(entry.frameStart - _traceStart),
+			                            ToMicroseconds(entry.frameEnd - entry.frameStart)));
+		}
+		for (size_t i = 0; i < entry.counters.size(); ++i)
+		{
+			WriteTraceEvent(fmt::format(R"({{"name":"{}","ph":"C","pid":0,"ts":{:.3f},"args":{{"value":{}}}}})",
+			                            k_CounterNames.at(i), ToMicroseconds(now - _traceStart), entry.counters.at(i)));
+		}
+		_traceFile.flush();
+	}
+	if (_frameCallback)
+	{
+		_frameCallback(entry);
+	}
+
 	_currentEntry = (_currentEntry + 1) % k_BufferSize;
-	prevEntry.frameEnd = _entries.at(_currentEntry).frameStart = std::chrono::system_clock::now();
+	auto& next = _entries.at(_currentEntry);
+	next.frameStart = now;
+	next.scopes.clear();
+	next.counters.fill(0);
+}
+
+void Profiler::Collect(ThreadBuffer& buffer, Entry& entry)
+{
+	const auto tracing = IsTracing();
+	if (tracing && !buffer.namedInTrace)
+	{
+		const auto name = buffer.index == 0 ? std::string("Main Thread") : fmt::format("Thread {}", buffer.index);
+		WriteTraceEvent(fmt::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})",
+		                            buffer.index, name));
+		buffer.namedInTrace = true;
+	}
+
+	const auto head = buffer.head.load(std::memory_order_acquire);
+	for (auto i = buffer.tail.load(std::memory_order_relaxed); i != head; ++i)
+	{
+		const auto& event = buffer.events.at(i & (k_ThreadBufferSize - 1));
+		if (event.zone != k_EndZone)
+		{
+			buffer.open.push_back({event.zone, event.time});
+			if (tracing)
+			{
+				WriteTraceEvent(fmt::format(R"({{"name":"{}","ph":"B","pid":0,"tid":{},"ts":{:.3f}}})",
+				                            EscapeJson(GetZoneName(event.zone)), buffer.index,
+				                            ToMicroseconds(event.time - _traceStart)));
+			}
+			continue;
+		}
+
+		assert(!buffer.open.empty());
+		const auto open = buffer.open.back();
+		buffer.open.pop_back();
+		entry.scopes.push_back({open.zone, buffer.index, static_cast<uint8_t>(buffer.open.size()), open.start, event.time});
+		if (tracing)
+		{
+			WriteTraceEvent(fmt::format(R"({{"ph":"E","pid":0,"tid":{},"ts":{:.3f}}})", buffer.index,
+			                            ToMicroseconds(event.time - _traceStart)));
+		}
+	}
+	buffer.tail.store(head, std::memory_order_release);
+
+	for (size_t i = 0; i < entry.counters.size(); ++i)
+	{
+		entry.counters.at(i) += buffer.counters.at(i).exchange(0, std::memory_order_relaxed);
+	}
+}
+
+bool Profiler::StartTrace(const std::filesystem::path& path)
+{
+	StopTrace();
+
+	_traceFile.open(path, std::ios::out | std::ios::trunc);
+	if (!_traceFile.is_open())
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Could not open trace file {}", path.generic_string());
+		return false;
+	}
+	_traceFile << R"({"displayTimeUnit":"ms","traceEvents":[)" << '\n';
+	_firstTraceEvent = true;
+	WriteTraceEvent(R"({"name":"process_name","ph":"M","pid":0,"tid":0,"args":{"name":"openblack"}})");
+	{
+		const std::lock_guard lock(_threadsMutex);
+		for (auto& buffer : _threads)
+		{
+			buffer->namedInTrace = false;
+		}
+	}
+	_traceStart = Clock::now();
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Capturing profiler trace to {}", path.generic_string());
+	return true;
+}
+
+void Profiler::StopTrace()
+{
+	if (!IsTracing())
+	{
+		return;
+	}
+	_traceFile << "\n]}\n";
+	_traceFile.close();
+}
+
+void Profiler::WriteTraceEvent(std::string_view event)
+{
+	_traceFile << (_firstTraceEvent ? "" : ",\n") << event;
+	_firstTraceEvent = false;
 }
@@ -13,8 +13,16 @@
 
 #include <array>
 #include <chrono>
-#include <map>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace openblack
 {
@@ -22,6 +30,8 @@ namespace openblack
 class Profiler
 {
 public:
+	using Clock = std::chrono::steady_clock;
+
 	enum class Stage : uint8_t
 	{
 		PhysicsUpdate,
@@ -85,6 +95,26 @@ class Profiler
 	    "Renderer Frame",       //
 	};
 
+	enum class Counter : uint8_t
+	{
+		EntitiesIterated,
+		DrawCalls,
+		InstancesCulled,
+		BytesUploaded,
+
+		_count,
+	};
+
+	constexpr static std::array<std::string_view, static_cast<uint8_t>(Counter::_count)> k_CounterNames = {
+	    "Entities Iterated", //
+	    "Draw Calls",        //
+	    "Instances Culled",  //
+	    "Bytes Uploaded",    //
+	};
+
+	/// Interned zone name, the stages are the first ids
+	using ZoneId = uint32_t;
+
 private:
 	struct ScopedSection
 	{
@@ -100,27 +130,72 @@ class Profiler
 		const Stage stage;
 	};
 
+	struct ScopedZone
+	{
+		inline explicit ScopedZone(Profiler* profiler, ZoneId zone)
+		    : profiler(profiler)
+		{
+			profiler->BeginZone(zone);
+		}
+		inline ~ScopedZone() { profiler->EndZone(); }
+
+		Profiler* const profiler;
+	};
+
+	struct ThreadBuffer;
+
 public:
 	struct Scope
 	{
+		ZoneId zone;
+		uint32_t thread;
 		uint8_t level;
-		std::chrono::system_clock::time_point start;
-		std::chrono::system_clock::time_point end;
-		bool finalized = false;
+		Clock::time_point start;
+		Clock::time_point end;
 	};
 
 	struct Entry
 	{
-		std::chrono::system_clock::time_point frameStart;
-		std::chrono::system_clock::time_point frameEnd;
-		std::array<Scope, static_cast<uint8_t>(Stage::_count)> stages;
+		Clock::time_point frameStart;
+		Clock::time_point frameEnd;
+		/// Scopes which ended during the frame, from all threads
+		std::vector<Scope> scopes;
+		std::array<int64_t, static_cast<uint8_t>(Counter::_count)> counters {};
 	};
 
+	Profiler();
+	~Profiler();
+
+	/// Collect the scopes and counters recorded by all threads since the last frame, must be called from the main thread
 	void Frame();
 	void Begin(Stage stage);
 	void End(Stage stage);
 	inline ScopedSection BeginScoped(Stage stage) { return ScopedSection(this, stage); }
 
+	/// Zones and counters may be recorded from any thread, zones must nest on each thread
+	[[nodiscard]] ZoneId Intern(std::string_view name);
+	[[nodiscard]] std::string_view GetZoneName(ZoneId zone) const;
+	void BeginZone(ZoneId zone);
+	void BeginZone(std::string_view name) { BeginZone(Intern(name)); }
+	void EndZone();
+	inline ScopedZone BeginScoped(ZoneId zone) { return ScopedZone(this, zone); }
+	inline ScopedZone BeginScoped(std::string_view name) { return ScopedZone(this, Intern(name)); }
+	void Count(Counter counter, int64_t value = 1);
+
+	/// Thread 0 is the one which created the profiler
+	[[nodiscard]] uint32_t GetThreadCount() const;
+	/// Zones which didn't fit in their thread's buffer before the main thread collected it
+	[[nodiscard]] uint64_t GetDroppedZoneCount() const;
+
+	/// Stream every scope, frame and counter to a Chrome trace event JSON file (chrome://tracing, ui.perfetto.dev) until
+	/// StopTrace is called or the profiler is destroyed
+	bool StartTrace(const std::filesystem::path& path);
+	void StopTrace();
+	[[nodiscard]] bool IsTracing() const { return _traceFile.is_open(); }
+
+	/// Called by Frame with each completed entry, for tools which need more history than the last k_BufferSize frames
+	void SetFrameCallback(std::function<void(const Entry&)> callback) { _frameCallback = std::move(callback); }
+
 	[[nodiscard]] uint8_t GetEntryIndex(int8_t offset) const { return (_currentEntry + k_BufferSize + offset) % k_BufferSize; }
 
 	constexpr static uint8_t k_BufferSize = 100;
@@ -128,9 +203,27 @@ class Profiler
 	[[nodiscard]] const std::array<Entry, k_BufferSize>& GetEntries() const { return _entries; }
 
 private:
+	[[nodiscard]] ThreadBuffer& GetThreadBuffer();
+	void Collect(ThreadBuffer& buffer, Entry& entry);
+	void WriteTraceEvent(std::string_view event);
+
 	std::array<Entry, k_BufferSize> _entries;
 	uint8_t _currentEntry = k_BufferSize - 1;
-	uint8_t _currentLevel = 0;
+
+	/// Tells apart profilers created at the same address, each thread caches its buffer for the last profiler it used
+	const uint64_t _instanceId;
+	mutable std::mutex _threadsMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+
+	mutable std::shared_mutex _zonesMutex;
+	/// Names are never moved once interned so views of them stay valid
+	std::vector<std::unique_ptr<const std::string>> _zoneNames;
+	std::unordered_map<std::string_view, ZoneId> _zoneIds;
+
+	std::ofstream _traceFile;
+	Clock::time_point _traceStart;
+	bool _firstTraceEvent = true;
+	std::function<void(const Entry&)> _frameCallback;
 };
 
 } // namespace openblack
@@ -9,6 +9,7 @@
 
 #include "Resources/Loaders.h"
 
+#include <algorithm>
 #include <iostream>
 #include <ranges>
 #include <utility>
@@ -23,15 +24,18 @@
 #include "Common/StringUtils.h"
 #include "Common/Zip.h"
 #include "FileSystem/FileSystemInterface.h"
+#include "Graphics/MipChain.h"
 #include "Graphics/Texture2D.h"
 #include "Locator.h"
+#include "Resources/ResidencyManager.h"
+#include "Resources/ResourcesInterface.h"
 
 using namespace openblack;
 using namespace openblack::filesystem;
 using namespace openblack::resources;
 
 L3DLoader::result_type L3DLoader::operator()(FromBufferTag, const std::string& debugName,
-                                             const std::vector<uint8_t>& data) const
+                                             std::span<const uint8_t> data) const
 {
 	auto mesh = std::make_shared<graphics::L3DMesh>(debugName);
 	if (!mesh->LoadFromBuffer(data))
@@ -71,11 +75,25 @@ L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem:
 	return mesh;
 }
 
+L3DLoader::result_type L3DLoader::operator()(FromPackTag, const std::string& debugName, const std::filesystem::path& packPath,
+                                             pack::PackRange range) const
+{
+	// Only the mesh's own bytes are read from the pack, which the residency manager keeps open
+	const auto data = Locator::resources::value().GetResidency().ReadPackRange(packPath, range);
+	return (*this)(FromBufferTag {}, debugName, data);
+}
+
+ResourceSize L3DLoader::Measure(const graphics::L3DMesh& mesh)
+{
+	return {mesh.GetCpuSizeInBytes(), mesh.GetGpuSizeInBytes()};
+}
+
 Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std::string& name,
-                                                         const pack::G3DTexture& g3dTexture) const
+                                                         const pack::G3DTexture& g3dTexture,
+                                                         const std::filesystem::path& packPath, pack::PackRange range) const
 {
 	// some assumptions:
-	// - no mipmaps
+	// - no mipmaps, they are generated here
 	// - no cubemap or volume textures
 	// - always dxt1 or dxt3
 	// - all are compressed
@@ -98,12 +116,44 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std:
 		throw std::runtime_error("Unsupported compressed texture format");
 	}
 
-	texture2D->Create(static_cast<uint16_t>(g3dTexture.ddsHeader.width), static_cast<uint16_t>(g3dTexture.ddsHeader.height), 1,
-	                  internalFormat, graphics::Wrapping::Repeat, graphics::Filter::Linear, g3dTexture.ddsData.data(),
-	                  static_cast<uint32_t>(g3dTexture.ddsData.size()));
+	const auto width = static_cast<uint16_t>(g3dTexture.ddsHeader.width);
+	const auto height = static_cast<uint16_t>(g3dTexture.ddsHeader.height);
+	// Generating the chain decodes and compresses every level again, it is only done the first time the texture is loaded
+	auto& mipChains = Locator::resources::value().GetResidency().GetMipChains();
+	const auto key = MipChainCache::MakeKey(packPath, range, internalFormat, width, height, g3dTexture.ddsData);
+	auto chain = mipChains.Find(key);
+	if (!chain)
+	{
+		chain = graphics::MipChain::Generate(internalFormat, width, height, g3dTexture.ddsData);
+		if (!chain)
+		{
+			throw std::runtime_error("Texture " + name + " has less data than its size");
+		}
+		mipChains.Add(key, *chain);
+	}
+	// Only the small levels are uploaded until the texture is drawn large enough to need the others
+	texture2D->CreateStreamed(std::move(*chain), graphics::Wrapping::Repeat, graphics::Filter::LinearMipmapLinear);
 	return texture2D;
 }
 
+Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std::string& name,
+                                                         const std::filesystem::path& packPath, pack::PackRange range) const
+{
+	// Only the texture's block is read from the pack, which the residency manager keeps open
+	const auto block = Locator::resources::value().GetResidency().ReadPackRange(packPath, range);
+	pack::G3DTexture texture;
+	if (pack::PackFile::ReadTexture(std::as_bytes(std::span(block)), texture) != pack::PackResult::Success)
+	{
+		throw std::runtime_error("Unable to load texture " + name + " from pack");
+	}
+	return (*this)(FromPackTag {}, name, texture, packPath, range);
+}
+
+ResourceSize Texture2DLoader::Measure(const graphics::Texture2D& texture)
+{
+	return {texture.GetCpuSizeInBytes(), texture.GetSizeInBytes()};
+}
+
 Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const
 {
 	bool found = false;
@@ -142,8 +192,9 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromDiskTag, const std:
 	}
 
 	auto texture = std::make_shared<graphics::Texture2D>(("raw" / rawTexturePath.stem()).string());
-	texture->Create(width, height, 1, format, graphics::Wrapping::Repeat, graphics::Filter::Linear, data.data(),
-	                static_cast<uint32_t>(data.size()));
+	// Sprites keep the handle of raw textures so they are not streamed, they get all their levels straight away
+	const auto chain = graphics::MipChain::Generate(format, width, height, data).value();
+	texture->Create({&chain, 1}, graphics::Wrapping::Repeat, graphics::Filter::LinearMipmapLinear);
 
 	return texture;
 }
@@ -172,6 +223,16 @@ LevelLoader::result_type LevelLoader::operator()(FromDiskTag, const std::filesys
 	return std::make_shared<Level>(Level::ParseLevel(path, landType));
 }
 
+LevelLoader::result_type LevelLoader::operator()(FromCatalogTag, const LevelCatalog::Entry& entry) const
+{
+	// The landscapes may have been added or removed since the script was indexed
+	const auto& fileSystem = Locator::filesystem::value();
+	const bool isValid = std::ranges::any_of(entry.landscapePaths, [&fileSystem](const std::filesystem::path& path) {
+		return fileSystem.Exists(filesystem::FileSystemInterface::FixPath(path));
+	});
+	return std::make_shared<Level>(entry.name, entry.scriptPath, entry.description, entry.landType, isValid);
+}
+
 CreatureMindLoader::result_type CreatureMindLoader::operator()(FromDiskTag, const std::filesystem::path& /*unused*/) const
 {
 	return std::make_shared<creature::CreatureMind>();
@@ -201,7 +262,7 @@ LightLoader::result_type LightLoader::operator()(BaseLoader<Lights>::FromDiskTag
 	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Loading lights from file: {}", path.string());
 	glw::GLWFile glw;
 
-	const auto result = glw.ReadFile(*Locator::filesystem::value().GetData(path));
+	const auto result = glw.Open(Locator::filesystem::value().ReadAll(path));
 	if (result != glw::GLWResult::Success)
 	{
 		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open glw file from filesystem {}: {}", path.string(),
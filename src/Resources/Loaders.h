@@ -10,6 +10,7 @@
 #pragma once
 
 #include <queue>
+#include <span>
 
 #include <PackFile.h>
 
@@ -18,6 +19,8 @@
 #include "Audio/Sound.h"
 #include "Creature/CreatureMind.h"
 #include "Level.h"
+#include "LevelCatalog.h"
+#include "ResourceSize.h"
 
 namespace openblack::graphics
 {
@@ -49,8 +52,17 @@ struct BaseLoader
 
 struct L3DLoader final: BaseLoader<graphics::L3DMesh>
 {
-	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, const std::vector<uint8_t>& data) const;
+	struct FromPackTag
+	{
+	};
+
+	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, std::span<const uint8_t> data) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
+	/// Load a single mesh of a pack, used to load meshes again after they were evicted
+	[[nodiscard]] result_type operator()(FromPackTag, const std::string& debugName, const std::filesystem::path& packPath,
+	                                     pack::PackRange range) const;
+
+	[[nodiscard]] static ResourceSize Measure(const graphics::L3DMesh& mesh);
 };
 
 struct Texture2DLoader final: BaseLoader<graphics::Texture2D>
@@ -59,8 +71,15 @@ struct Texture2DLoader final: BaseLoader<graphics::Texture2D>
 	{
 	};
 
-	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const pack::G3DTexture& g3dTexture) const;
+	/// The mip chain is read from the residency manager's MipChainCache when it was generated for this pack entry before
+	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const pack::G3DTexture& g3dTexture,
+	                                     const std::filesystem::path& packPath, pack::PackRange range) const;
+	/// Load a single texture of a pack, used to load textures again after they were evicted
+	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const std::filesystem::path& packPath,
+	                                     pack::PackRange range) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const;
+
+	[[nodiscard]] static ResourceSize Measure(const graphics::Texture2D& texture);
 };
 
 struct L3DAnimLoader final: BaseLoader<L3DAnim>
@@ -71,6 +90,11 @@ struct L3DAnimLoader final: BaseLoader<L3DAnim>
 
 struct LevelLoader final: BaseLoader<Level>
 {
+	struct FromCatalogTag
+	{
+	};
+
+	[[nodiscard]] result_type operator()(FromCatalogTag, const LevelCatalog::Entry& entry) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path, Level::LandType landType) const;
 };
 
@@ -9,10 +9,10 @@
 
 #pragma once
 
-#include <entt/core/hashed_string.hpp>
 #include <fmt/format.h>
 
 #include "3D/AllMeshes.h"
+#include "ResourceId.h"
 
 template <>
 struct fmt::formatter<openblack::MeshId>: fmt::formatter<uint32_t>
@@ -26,9 +26,9 @@ struct fmt::formatter<openblack::MeshId>: fmt::formatter<uint32_t>
 namespace openblack::resources
 {
 
-inline entt::id_type MeshIdToResourceId(openblack::MeshId id)
+constexpr entt::id_type MeshIdToResourceId(openblack::MeshId id)
 {
-	return entt::hashed_string(fmt::format("{}", id).c_str());
+	return MakeResourceId(id);
 }
 
 } // namespace openblack::resources
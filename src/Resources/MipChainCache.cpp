@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MipChainCache.h"
+
+#include <array>
+#include <system_error>
+
+#include <entt/core/hashed_string.hpp>
+#include <spdlog/spdlog.h>
+
+using namespace openblack::resources;
+
+namespace
+{
+constexpr std::array<char, 4> k_CacheMagic = {'O', 'B', 'M', 'C'};
+
+template <typename T>
+bool ReadValue(std::ifstream& stream, T& value)
+{
+	stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+	return static_cast<bool>(stream);
+}
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+} // namespace
+
+static_assert(sizeof(MipChainCache::Key) == 32, "Keys are written to the cache file as they are, without padding");
+
+MipChainCache::Key MipChainCache::MakeKey(const std::filesystem::path& packPath, pack::PackRange entry,
+                                          graphics::Format format, uint16_t width, uint16_t height,
+                                          std::span<const uint8_t> data)
+{
+	const auto dataHash = entt::hashed_string::value(reinterpret_cast<const char*>(data.data()), data.size());
+	const auto packName = packPath.generic_string();
+	const auto packHash = entt::hashed_string::value(packName.data(), packName.size());
+	return {entry.offset, entry.size, dataHash, static_cast<uint32_t>(format), width, height, packHash};
+}
+
+size_t MipChainCache::KeyHash::operator()(const Key& key) const
+{
+	return entt::hashed_string::value(reinterpret_cast<const char*>(&key), sizeof(key));
+}
+
+bool MipChainCache::Open(const std::filesystem::path& path)
+{
+	_path = path;
+	_records.clear();
+	_added.clear();
+	_hitCount = 0;
+	_stream = std::ifstream(path, std::ios::binary);
+	if (!_stream)
+	{
+		return false;
+	}
+
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint32_t count;
+	std::error_code ec;
+	const auto fileSize = std::filesystem::file_size(path, ec);
+	if (!ReadValue(_stream, magic) || magic != k_CacheMagic || !ReadValue(_stream, version) || version != k_CacheVersion ||
+	    !ReadValue(_stream, count) || ec || static_cast<uint64_t>(count) * sizeof(Record) > fileSize)
+	{
+		SPDLOG_LOGGER_INFO(spdlog::get("game"), "Mip chain cache {} is from another version, rebuilding it", path.string());
+		_stream.close();
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		Record record;
+		if (!ReadValue(_stream, record) || record.fileOffset > fileSize || record.fileSize > fileSize - record.fileOffset)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Mip chain cache {} is truncated, rebuilding it", path.string());
+			_records.clear();
+			_stream.close();
+			return false;
+		}
+		_records.insert_or_assign(record.key, record);
+	}
+	return true;
+}
+
+bool MipChainCache::Save()
+{
+	if (_added.empty() || _path.empty())
+	{
+		return true;
+	}
+
+	// Chains of the cache file which were not generated again are copied over
+	std::vector<const Record*> kept;
+	for (const auto& [key, record] : _records)
+	{
+		if (!_added.contains(key))
+		{
+			kept.push_back(&record);
+		}
+	}
+
+	auto tempPath = _path;
+	tempPath += ".tmp";
+	{
+		std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Unable to write mip chain cache {}", _path.string());
+			return false;
+		}
+		const auto count = static_cast<uint32_t>(kept.size() + _added.size());
+		stream.write(k_CacheMagic.data(), k_CacheMagic.size());
+		WriteValue(stream, k_CacheVersion);
+		WriteValue(stream, count);
+
+		uint64_t fileOffset = k_CacheMagic.size() + sizeof(k_CacheVersion) + sizeof(count) + count * sizeof(Record);
+		for (const auto* record : kept)
+		{
+			WriteValue(stream, Record {record->key, fileOffset, record->fileSize});
+			fileOffset += record->fileSize;
+		}
+		for (const auto& [key, levels] : _added)
+		{
+			WriteValue(stream, Record {key, fileOffset, levels.size()});
+			fileOffset += levels.size();
+		}
+
+		std::vector<char> levels;
+		for (const auto* record : kept)
+		{
+			levels.resize(record->fileSize);
+			_stream.clear();
+			_stream.seekg(static_cast<std::streamoff>(record->fileOffset));
+			_stream.read(levels.data(), static_cast<std::streamsize>(levels.size()));
+			stream.write(levels.data(), static_cast<std::streamsize>(levels.size()));
+		}
+		for (const auto& [key, added] : _added)
+		{
+			stream.write(reinterpret_cast<const char*>(added.data()), static_cast<std::streamsize>(added.size()));
+		}
+		if (!stream || (!kept.empty() && !_stream))
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Unable to write mip chain cache {}", _path.string());
+			stream.close();
+			std::error_code ec;
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+	}
+
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Cached {} newly generated mip chains, {} were read from the cache",
+	                   _added.size(), _hitCount);
+	_stream.close();
+	std::error_code ec;
+	std::filesystem::rename(tempPath, _path, ec);
+	if (ec)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Unable to replace mip chain cache {}: {}", _path.string(), ec.message());
+		return false;
+	}
+	// Reloads of evicted textures read their chains from the new file
+	return Open(_path);
+}
+
+std::optional<openblack::graphics::MipChain> MipChainCache::Find(const Key& key)
+{
+	const auto format = static_cast<graphics::Format>(key.format);
+	if (const auto added = _added.find(key); added != _added.end())
+	{
+		return graphics::MipChain::FromLevels(format, key.width, key.height, added->second);
+	}
+
+	const auto record = _records.find(key);
+	if (record == _records.end())
+	{
+		return std::nullopt;
+	}
+	std::vector<uint8_t> levels(record->second.fileSize);
+	_stream.clear();
+	_stream.seekg(static_cast<std::streamoff>(record->second.fileOffset));
+	_stream.read(reinterpret_cast<char*>(levels.data()), static_cast<std::streamsize>(levels.size()));
+	if (!_stream)
+	{
+		return std::nullopt;
+	}
+	auto chain = graphics::MipChain::FromLevels(format, key.width, key.height, levels);
+	if (chain)
+	{
+		++_hitCount;
+	}
+	return chain;
+}
+
+void MipChainCache::Add(const Key& key, const graphics::MipChain& chain)
+{
+	// Without a file to save to, the chains would only be kept in memory
+	if (_path.empty())
+	{
+		return;
+	}
+	std::vector<uint8_t> levels(chain.GetSizeInBytes());
+	chain.CopyLevels(0, levels.data());
+	_added.insert_or_assign(key, std::move(levels));
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <PackFile.h>
+
+#include "Graphics/MipChain.h"
+
+namespace openblack::resources
+{
+
+/// Mip chains generated for the textures of packs, kept in a file between runs so a texture's chain is only generated the
+/// first time it is loaded. Entries are keyed by the pack and where the texture is in it and hold a hash of the texture's
+/// data, so the chains of a modified pack are generated again.
+class MipChainCache
+{
+public:
+	/// Bumped whenever the cache layout or how chains are generated changes
+	static constexpr uint32_t k_CacheVersion = 2;
+
+	/// Identifies the texture a chain was generated from
+	struct Key
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t dataHash;
+		uint32_t format;
+		uint16_t width;
+		uint16_t height;
+		/// Hash of the pack's path, textures of different packs may be at the same offset
+		uint32_t packHash;
+
+		bool operator==(const Key&) const = default;
+	};
+
+	static Key MakeKey(const std::filesystem::path& packPath, pack::PackRange entry, graphics::Format format, uint16_t width,
+	                   uint16_t height, std::span<const uint8_t> data);
+
+	/// Read the index of a previous run's cache, returns false if there is none or it was written by another version. The
+	/// file is kept open and chains are only read from it when they are found.
+	bool Open(const std::filesystem::path& path);
+	/// Write the chains found in the cache and the ones added since it was opened, nothing is written when none were added
+	bool Save();
+
+	[[nodiscard]] std::optional<graphics::MipChain> Find(const Key& key);
+	/// Keep a chain which had to be generated until the cache is saved
+	void Add(const Key& key, const graphics::MipChain& chain);
+
+	/// Number of chains found and added since the cache was opened
+	[[nodiscard]] size_t GetHitCount() const { return _hitCount; }
+	[[nodiscard]] size_t GetMissCount() const { return _added.size(); }
+
+private:
+	struct Record
+	{
+		Key key;
+		uint64_t fileOffset;
+		uint64_t fileSize;
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	std::filesystem::path _path;
+	std::ifstream _stream;
+	std::unordered_map<Key, Record, KeyHash> _records;
+	/// Levels of the chains which were generated since the cache was opened
+	std::unordered_map<Key, std::vector<uint8_t>, KeyHash> _added;
+	size_t _hitCount {0};
+};
+
+} // namespace openblack::resources
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "ResidencyManager.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "EngineConfig.h"
+#include "FileSystem/FileSystemInterface.h"
+#include "Graphics/Texture2D.h"
+#include "Locator.h"
+
+using namespace openblack::resources;
+
+ResidencyManager::ResidencyManager(MeshManager& meshes, TextureManager& textures)
+    : _meshes(meshes)
+    , _textures(textures)
+{
+}
+
+ResidencyManager::~ResidencyManager() = default;
+
+void ResidencyManager::Update(uint32_t frame)
+{
+	_meshes.BeginFrame(frame);
+	_textures.BeginFrame(frame);
+	UpdateStreaming();
+
+	const auto budget = Locator::config::value().resourceMemoryBudget;
+	auto total = _meshes.GetResidentSize().Total() + _textures.GetResidentSize().Total();
+	if (total <= budget)
+	{
+		return;
+	}
+
+	_candidates.clear();
+	const auto gather = [this, frame](bool isMesh) {
+		return [this, frame, isMesh](entt::id_type id, const Residency& residency, bool resident) {
+			if (resident && !residency.pinned && residency.reload && residency.lastUsedFrame + k_MinIdleFrames < frame)
+			{
+				_candidates.push_back({residency.lastUsedFrame, isMesh, id, residency.size.Total()});
+			}
+		};
+	};
+	_meshes.EachResidency(gather(true));
+	_textures.EachResidency(gather(false));
+	std::sort(_candidates.begin(), _candidates.end(),
+	          [](const Candidate& lhs, const Candidate& rhs) { return lhs.lastUsedFrame < rhs.lastUsedFrame; });
+
+	for (const auto& candidate : _candidates)
+	{
+		if (total <= budget)
+		{
+			break;
+		}
+		if (candidate.isMesh ? _meshes.Evict(candidate.id) : _textures.Evict(candidate.id))
+		{
+			total -= candidate.bytes;
+		}
+	}
+}
+
+void ResidencyManager::UpdateStreaming()
+{
+	size_t uploaded = 0;
+	_textures.Each([this, &uploaded](entt::id_type id, graphics::Texture2D& texture) {
+		// The first upload of a frame goes ahead whatever its size, levels larger than the budget would never fit otherwise
+		auto budget = uploaded == 0 ? std::numeric_limits<size_t>::max()
+		                            : k_StreamingUploadBudget - std::min(uploaded, k_StreamingUploadBudget);
+		const auto available = budget;
+		if (texture.UpdateStreaming(budget))
+		{
+			uploaded += available - budget;
+			_textures.Remeasure(id);
+		}
+	});
+}
+
+ResidencyStats ResidencyManager::GetStats() const
+{
+	return {
+	    _meshes.GetResidentSize(),
+	    _textures.GetResidentSize(),
+	    _meshes.Size(),
+	    _textures.Size(),
+	    _meshes.GetEvictionCount() + _textures.GetEvictionCount(),
+	    _meshes.GetReloadCount() + _textures.GetReloadCount(),
+	    Locator::config::value().resourceMemoryBudget,
+	};
+}
+
+std::vector<uint8_t> ResidencyManager::ReadPackRange(const std::filesystem::path& packPath, pack::PackRange range)
+{
+	auto& stream = _packs[packPath];
+	if (stream == nullptr)
+	{
+		stream = Locator::filesystem::value().Open(packPath, filesystem::Stream::Mode::Read);
+	}
+	if (range.offset + range.size > stream->Size())
+	{
+		throw std::runtime_error("Entry is outside of pack " + packPath.string());
+	}
+
+	std::vector<uint8_t> data(range.size);
+	stream->Seek(range.offset, filesystem::Stream::SeekMode::Begin);
+	stream->Read(data.data(), data.size());
+	return data;
+}
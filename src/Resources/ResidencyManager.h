@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <PackFile.h>
+#include <entt/fwd.hpp>
+
+#include "MipChainCache.h"
+#include "ResourcesInterface.h"
+
+namespace openblack::filesystem
+{
+class Stream;
+}
+
+namespace openblack::resources
+{
+
+struct ResidencyStats
+{
+	ResourceSize meshes;
+	ResourceSize textures;
+	size_t residentMeshes;
+	size_t residentTextures;
+	size_t evictions;
+	size_t reloads;
+	size_t budgetBytes;
+};
+
+/// Keeps the meshes and textures within EngineConfig::resourceMemoryBudget by evicting the ones which were drawn the
+/// longest ago, skipping those which are pinned, in use or can't be loaded again. Evicted resources are loaded again by
+/// ResourceManager::Handle the next time they are needed. Streamed textures are also given the levels draws asked for.
+class ResidencyManager
+{
+public:
+	/// Resources used this recently are assumed to be needed again soon and are never evicted
+	static constexpr uint32_t k_MinIdleFrames = 60;
+	/// Bytes of streamed texture levels uploaded per frame, the textures which don't fit wait for the next frames. The first
+	/// upload of a frame is always made so that levels larger than this still get uploaded.
+	static constexpr size_t k_StreamingUploadBudget = 4 * 1024 * 1024;
+
+	ResidencyManager(MeshManager& meshes, TextureManager& textures);
+	~ResidencyManager();
+
+	/// Call once per frame before anything is drawn
+	void Update(uint32_t frame);
+
+	[[nodiscard]] ResidencyStats GetStats() const;
+
+	/// Read the bytes of one entry of a pack, to load an evicted resource again. The pack is opened on its first reload and
+	/// kept open, so later reloads only seek to their entry instead of reading and parsing the whole pack. Packs in the asset
+	/// archive are stored uncompressed so that keeping them open doesn't keep them in memory. Main thread only.
+	[[nodiscard]] std::vector<uint8_t> ReadPackRange(const std::filesystem::path& packPath, pack::PackRange range);
+
+	/// Mip chains of pack textures generated by previous runs, used by loads and reloads alike. Main thread only.
+	[[nodiscard]] MipChainCache& GetMipChains() { return _mipChains; }
+
+private:
+	/// Upload the texture levels the draws of the last frame asked for, within k_StreamingUploadBudget after the first
+	void UpdateStreaming();
+
+	struct Candidate
+	{
+		uint32_t lastUsedFrame;
+		bool isMesh;
+		entt::id_type id;
+		size_t bytes;
+	};
+
+	MeshManager& _meshes;
+	TextureManager& _textures;
+	/// Kept between frames to not allocate
+	std::vector<Candidate> _candidates;
+	/// Packs evicted resources were reloaded from
+	std::map<std::filesystem::path, std::unique_ptr<filesystem::Stream>> _packs;
+	MipChainCache _mipChains;
+};
+
+} // namespace openblack::resources
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <concepts>
+#include <string_view>
+#include <type_traits>
+
+#include <entt/fwd.hpp>
+
+namespace openblack::resources
+{
+
+/// Something which can be part of a resource name: text, an integer written in decimal or an enum written as its value
+template <typename T>
+concept ResourceNamePart = std::is_convertible_v<const T&, std::string_view> || std::is_enum_v<T> ||
+                           (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>);
+
+/// Hashes a resource name piece by piece so names made at runtime don't have to be formatted into a string first.
+/// The result is the FNV-1a hash entt::hashed_string gives the whole name, so ids from either can be mixed.
+class ResourceIdBuilder
+{
+public:
+	constexpr ResourceIdBuilder& Append(std::string_view text)
+	{
+		for (const char c : text)
+		{
+			_hash = (_hash ^ static_cast<uint8_t>(c)) * k_Prime;
+		}
+		return *this;
+	}
+
+	template <ResourceNamePart T>
+	constexpr ResourceIdBuilder& Append(const T& part)
+	{
+		if constexpr (std::is_convertible_v<const T&, std::string_view>)
+		{
+			return Append(std::string_view(part));
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			return Append(static_cast<std::underlying_type_t<T>>(part));
+		}
+		else
+		{
+			// Written the way fmt::format("{}", part) would
+			std::array<char, 24> digits {};
+			auto first = digits.end();
+			auto magnitude = static_cast<std::make_unsigned_t<T>>(part);
+			if constexpr (std::is_signed_v<T>)
+			{
+				if (part < 0)
+				{
+					magnitude = static_cast<std::make_unsigned_t<T>>(0 - magnitude);
+				}
+			}
+			do
+			{
+				*--first = static_cast<char>('0' + magnitude % 10);
+				magnitude /= 10;
+			} while (magnitude != 0);
+			if constexpr (std::is_signed_v<T>)
+			{
+				if (part < 0)
+				{
+					*--first = '-';
+				}
+			}
+			return Append(std::string_view(first, digits.end()));
+		}
+	}
+
+	[[nodiscard]] constexpr entt::id_type Get() const { return _hash; }
+
+private:
+	static constexpr bool k_Is64Bit = sizeof(entt::id_type) == sizeof(uint64_t);
+	static constexpr entt::id_type k_Offset =
+	    k_Is64Bit ? static_cast<entt::id_type>(14695981039346656037ULL) : static_cast<entt::id_type>(2166136261U);
+	static constexpr entt::id_type k_Prime =
+	    k_Is64Bit ? static_cast<entt::id_type>(1099511628211ULL) : static_cast<entt::id_type>(16777619U);
+
+	entt::id_type _hash {k_Offset};
+};
+
+/// Id of the resource named by the parts put one after the other, such as MakeResourceId("raw/", name).
+/// Literal names are hashed at compile time when the result is constexpr.
+template <ResourceNamePart... Parts>
+[[nodiscard]] constexpr entt::id_type MakeResourceId(const Parts&... parts)
+{
+	ResourceIdBuilder builder;
+	(builder.Append(parts), ...);
+	return builder.Get();
+}
+
+} // namespace openblack::resources
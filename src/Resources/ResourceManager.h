@@ -9,63 +9,156 @@
 
 #pragma once
 
-#include <entt/core/hashed_string.hpp>
+#include <cstdint>
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
 #include <entt/fwd.hpp>
 #include <entt/resource/cache.hpp>
-#include <fmt/format.h>
+
+#include "ResourceId.h"
+#include "ResourceSize.h"
 
 namespace openblack::resources
 {
 
+/// Residency of a resource, kept when the resource is evicted so it can be loaded again
+struct Residency
+{
+	ResourceSize size;
+	/// Frame of the last Handle(), see ResourceManager::BeginFrame
+	uint32_t lastUsedFrame {0};
+	/// Referenced by something which can't hold a handle, such as a rigid body or a sprite
+	bool pinned {false};
+	/// Loads the resource again, empty when it was loaded from data which is gone and can't be evicted
+	std::function<void()> reload;
+};
+
 template <typename ResourceLoader>
 class ResourceManager
 {
 public:
 	using ResourceType = typename ResourceLoader::ResourceType;
 
+	ResourceManager() = default;
+	// The reload functions refer to the manager
+	ResourceManager(const ResourceManager&) = delete;
+	ResourceManager& operator=(const ResourceManager&) = delete;
+
+	/// Resources loaded from disk can be evicted and are loaded again with the same arguments on their next Handle()
 	template <typename... Args>
 	[[maybe_unused]] decltype(auto) Load(entt::id_type identifier, Args&&... args)
 	{
-		return _resourceCache.load(identifier, std::forward<Args>(args)...);
+		if constexpr (IsFromDisk<Args...>())
+		{
+			auto reload = [this, identifier, ... args = std::decay_t<Args>(args)]() {
+				_resourceCache.load(identifier, args...);
+			};
+			auto result = _resourceCache.load(identifier, std::forward<Args>(args)...);
+			if (result.second)
+			{
+				Track(identifier, std::move(reload));
+			}
+			return result;
+		}
+		else
+		{
+			auto result = _resourceCache.load(identifier, std::forward<Args>(args)...);
+			if (result.second)
+			{
+				Track(identifier, {});
+			}
+			return result;
+		}
+	}
+
+	/// Make a resource which was loaded from memory evictable by telling how to load it again
+	template <typename... Args>
+	void SetReload(entt::id_type identifier, Args&&... args)
+	{
+		auto residency = _residency.find(identifier);
+		if (residency != _residency.end())
+		{
+			residency->second.reload = [this, identifier, ... args = std::forward<Args>(args)]() {
+				_resourceCache.load(identifier, args...);
+			};
+		}
+	}
+
+	template <ResourceNamePart T, typename... Args>
+	void SetReload(const T& name, Args&&... args)
+	{
+		SetReload(MakeResourceId(name), std::forward<Args>(args)...);
 	}
 
 	template <typename... Args>
 	[[maybe_unused]] decltype(auto) Erase(entt::id_type identifier, Args&&... args)
 	{
+		if (_resourceCache.contains(identifier))
+		{
+			_residentSize -= _residency[identifier].size;
+		}
+		_residency.erase(identifier);
 		return _resourceCache.erase(identifier, std::forward<Args>(args)...);
 	}
 
-	template <typename T, typename... Args>
-	[[maybe_unused]] decltype(auto) Load(T identifier, Args&&... args)
+	/// Names are hashed in place, see MakeResourceId
+	template <ResourceNamePart T, typename... Args>
+	[[maybe_unused]] decltype(auto) Load(const T& name, Args&&... args)
 	{
-		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
-		return Load(id, std::forward<Args>(args)...);
+		return Load(MakeResourceId(name), std::forward<Args>(args)...);
 	}
 
-	template <typename T, typename... Args>
-	[[maybe_unused]] decltype(auto) Erase(T identifier, Args&&... args)
+	template <ResourceNamePart T, typename... Args>
+	[[maybe_unused]] decltype(auto) Erase(const T& name, Args&&... args)
 	{
-		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
-		return Erase(id, std::forward<Args>(args)...);
+		return Erase(MakeResourceId(name), std::forward<Args>(args)...);
 	}
 
-	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier) { return _resourceCache[identifier]; }
+	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier)
+	{
+		Use(identifier);
+		return _resourceCache[identifier];
+	}
 
-	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier) const { return _resourceCache[identifier]; }
+	[[nodiscard]] decltype(auto) Handle(entt::id_type identifier) const
+	{
+		Use(identifier);
+		return std::as_const(_resourceCache)[identifier];
+	}
+
+	/// Whether the resource was loaded, evicted resources included
+	[[nodiscard]] bool Contains(entt::id_type identifier) const
+	{
+		return _resourceCache.contains(identifier) || _residency.contains(identifier);
+	}
 
-	[[nodiscard]] bool Contains(entt::id_type identifier) const { return _resourceCache.contains(identifier); }
+	[[nodiscard]] bool IsResident(entt::id_type identifier) const { return _resourceCache.contains(identifier); }
 
-	template <typename T>
-	[[nodiscard]] bool Contains(T identifier) const
+	template <ResourceNamePart T>
+	[[nodiscard]] bool Contains(const T& name) const
 	{
-		entt::id_type id = entt::hashed_string(fmt::format("{}", identifier).c_str());
-		return Contains(id);
+		return Contains(MakeResourceId(name));
 	}
 
+	/// Iterate over the resident resources
 	template <typename Func>
 	void Each(Func func) const
 	{
-		for (const auto [i, r] : _resourceCache)
+		for (const auto [i, r] : std::as_const(_resourceCache))
+		{
+			func(i, r);
+		}
+	}
+
+	template <typename Func>
+	void Each(Func func)
+	{
+		for (auto [i, r] : _resourceCache)
 		{
 			func(i, r);
 		}
@@ -78,9 +171,146 @@ class ResourceManager
 
 	[[nodiscard]] decltype(auto) Size() const { return _resourceCache.size(); }
 
-	void Clear() { _resourceCache.clear(); }
+	void Clear()
+	{
+		_resourceCache.clear();
+		_residency.clear();
+		_residentSize = {};
+	}
+
+	/// Stamp the resources handed out from now on as used in `frame`
+	void BeginFrame(uint32_t frame) { _frame = frame; }
+
+	/// Never evict the resource
+	void Pin(entt::id_type identifier)
+	{
+		auto residency = _residency.find(identifier);
+		if (residency != _residency.end())
+		{
+			residency->second.pinned = true;
+		}
+	}
+
+	/// Whether the resource could be evicted now: it is resident, can be loaded again and nothing holds a handle to it
+	[[nodiscard]] bool CanEvict(entt::id_type identifier) const
+	{
+		const auto residency = _residency.find(identifier);
+		if (residency == _residency.end() || residency->second.pinned || !residency->second.reload ||
+		    !_resourceCache.contains(identifier))
+		{
+			return false;
+		}
+		// One reference for the cache and one for the handle just taken
+		const auto resource = std::as_const(_resourceCache)[identifier];
+		return resource.handle().use_count() <= 2;
+	}
+
+	/// Release the resource, it is loaded again the next time it is handed out. Returns false if it can't be evicted.
+	bool Evict(entt::id_type identifier)
+	{
+		if (!CanEvict(identifier))
+		{
+			return false;
+		}
+		_residentSize -= _residency[identifier].size;
+		_resourceCache.erase(identifier);
+		++_evictionCount;
+		return true;
+	}
+
+	/// Measure a resident resource again after its size changed, such as a texture streaming in more levels
+	void Remeasure(entt::id_type identifier)
+	{
+		const auto residency = _residency.find(identifier);
+		if (residency == _residency.end() || !_resourceCache.contains(identifier))
+		{
+			return;
+		}
+		_residentSize -= residency->second.size;
+		residency->second.size = Measure(*std::as_const(_resourceCache)[identifier]);
+		_residentSize += residency->second.size;
+	}
+
+	/// Iterate over the residency of every loaded resource, evicted or not
+	template <typename Func>
+	void EachResidency(Func func) const
+	{
+		for (const auto& [id, residency] : _residency)
+		{
+			func(id, residency, _resourceCache.contains(id));
+		}
+	}
+
+	[[nodiscard]] const Residency* GetResidency(entt::id_type identifier) const
+	{
+		const auto residency = _residency.find(identifier);
+		return residency != _residency.end() ? &residency->second : nullptr;
+	}
+
+	[[nodiscard]] const ResourceSize& GetResidentSize() const { return _residentSize; }
+	[[nodiscard]] size_t GetEvictionCount() const { return _evictionCount; }
+	[[nodiscard]] size_t GetReloadCount() const { return _reloadCount; }
 
 private:
-	entt::resource_cache<ResourceType, ResourceLoader> _resourceCache;
+	template <typename... Args>
+	static constexpr bool IsFromDisk()
+	{
+		if constexpr (sizeof...(Args) == 0)
+		{
+			return false;
+		}
+		else
+		{
+			using Tag = std::decay_t<std::tuple_element_t<0, std::tuple<Args...>>>;
+			return std::is_same_v<Tag, typename ResourceLoader::FromDiskTag>;
+		}
+	}
+
+	static ResourceSize Measure(const ResourceType& resource)
+	{
+		if constexpr (requires { ResourceLoader::Measure(resource); })
+		{
+			return ResourceLoader::Measure(resource);
+		}
+		else
+		{
+			return {};
+		}
+	}
+
+	void Track(entt::id_type identifier, std::function<void()> reload)
+	{
+		auto& residency = _residency[identifier];
+		residency.size = Measure(*_resourceCache[identifier]);
+		residency.lastUsedFrame = _frame;
+		residency.reload = std::move(reload);
+		_residentSize += residency.size;
+	}
+
+	/// Stamp the resource and load it again if it was evicted
+	void Use(entt::id_type identifier) const
+	{
+		const auto residency = _residency.find(identifier);
+		if (residency == _residency.end())
+		{
+			return;
+		}
+		residency->second.lastUsedFrame = _frame;
+		if (!_resourceCache.contains(identifier) && residency->second.reload)
+		{
+			residency->second.reload();
+			residency->second.size = Measure(*std::as_const(_resourceCache)[identifier]);
+			_residentSize += residency->second.size;
+			++_reloadCount;
+		}
+	}
+
+	// Evicted resources are loaded again by const accessors too, which is invisible to the caller
+	mutable entt::resource_cache<ResourceType, ResourceLoader> _resourceCache;
+	mutable std::unordered_map<entt::id_type, Residency> _residency;
+	mutable ResourceSize _residentSize;
+	uint32_t _frame {0};
+	size_t _evictionCount {0};
+	mutable size_t _reloadCount {0};
 };
 } // namespace openblack::resources
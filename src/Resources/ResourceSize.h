@@ -0,0 +1,40 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace openblack::resources
+{
+
+/// Memory held by a resource, in main memory and in memory allocated through the renderer
+struct ResourceSize
+{
+	size_t cpuBytes {0};
+	size_t gpuBytes {0};
+
+	[[nodiscard]] size_t Total() const { return cpuBytes + gpuBytes; }
+
+	ResourceSize& operator+=(const ResourceSize& rhs)
+	{
+		cpuBytes += rhs.cpuBytes;
+		gpuBytes += rhs.gpuBytes;
+		return *this;
+	}
+
+	ResourceSize& operator-=(const ResourceSize& rhs)
+	{
+		cpuBytes -= rhs.cpuBytes;
+		gpuBytes -= rhs.gpuBytes;
+		return *this;
+	}
+};
+
+} // namespace openblack::resources
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "ResidencyManager.h"
 #include "ResourcesInterface.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -27,6 +28,7 @@ class Resources final: public ResourcesInterface
 	CreatureMindManager& GetCreatureMinds() override { return _creatureMinds; }
 	SoundManager& GetSounds() override { return _sounds; }
 	GlowManager& GetGlows() override { return _glows; }
+	ResidencyManager& GetResidency() override { return _residency; }
 
 private:
 	MeshManager _meshes;
@@ -36,5 +38,6 @@ class Resources final: public ResourcesInterface
 	CreatureMindManager _creatureMinds;
 	SoundManager _sounds;
 	GlowManager _glows;
+	ResidencyManager _residency {_meshes, _textures};
 };
 } // namespace openblack::resources
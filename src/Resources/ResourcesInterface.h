@@ -14,6 +14,8 @@
 
 namespace openblack::resources
 {
+class ResidencyManager;
+
 using MeshManager = ResourceManager<L3DLoader>;
 using TextureManager = ResourceManager<Texture2DLoader>;
 using AnimationManager = ResourceManager<L3DAnimLoader>;
@@ -32,6 +34,7 @@ class ResourcesInterface
 	virtual CreatureMindManager& GetCreatureMinds() = 0;
 	virtual SoundManager& GetSounds() = 0;
 	virtual GlowManager& GetGlows() = 0;
+	virtual ResidencyManager& GetResidency() = 0;
 };
 
 } // namespace openblack::resources
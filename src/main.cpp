@@ -7,11 +7,14 @@
  * openblack is licensed under the GNU General Public License version 3.
  *******************************************************************************/
 
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <memory>
 
+#include <SDL_filesystem.h>
 #include <SDL_messagebox.h>
+#include <SDL_stdinc.h>
 #include <cxxopts.hpp>
 
 #ifdef _WIN32
@@ -24,6 +27,19 @@
 
 #include "Game.h"
 
+/// Directory SDL gives the application for per user files, or the working directory if there is none
+std::filesystem::path getUserPath()
+{
+	char* prefPath = SDL_GetPrefPath("openblack", "openblack");
+	if (prefPath == nullptr)
+	{
+		return {};
+	}
+	std::filesystem::path result(prefPath);
+	SDL_free(prefPath);
+	return result;
+}
+
 bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& returnCode)
 {
 	cxxopts::Options options("openblack", "Open source reimplementation of the game Black & White (2001).");
@@ -49,6 +65,8 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		("H,height", "Window resolution in the y axis.", cxxopts::value<uint16_t>()->default_value("1024"))
 		("u,ui-scale", "Scaling of the GUI", cxxopts::value<float>()->default_value("1.0"))
 		("s,start-level", "Level that is loaded at start-up", cxxopts::value<std::string>()->default_value("Land1.txt"))
+		("level-cache", "File the index of level scripts is cached in between runs, empty to disable.", cxxopts::value<std::filesystem::path>()->default_value((getUserPath() / "levels.cache").string()))
+		("mip-chain-cache", "File the mip chains generated for the game's textures are cached in between runs, empty to disable.", cxxopts::value<std::filesystem::path>()->default_value((getUserPath() / "mipchains.cache").string()))
 		("V,vsync", "Enable Vertical Sync.")
 		("m,window-mode", "Which mode to run window.", cxxopts::value<std::string>()->default_value("windowed"))
 		("b,backend-type", "Which backend to use for rendering.", cxxopts::value<std::string>())
@@ -58,6 +76,7 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		    cxxopts::value<std::vector<std::string>>()->default_value("all=debug"))
 		("screenshot-frame", "Request a screenshot of the backbuffer at a certain frame number.", cxxopts::value<uint32_t>())
 		("screenshot-path", "Path of the request a screenshot of the backbuffer.", cxxopts::value<std::filesystem::path>()->default_value("screenshot.png"))
+		("profiler-trace", "Capture the profiler's scopes from start-up to exit into a Chrome trace JSON file.", cxxopts::value<std::filesystem::path>())
 	;
 	// clang-format on
 
@@ -183,6 +202,11 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 			                                        result["screenshot-path"].as<std::filesystem::path>());
 		}
 
+		if (result.count("profiler-trace") != 0)
+		{
+			args.profilerTrace = result["profiler-trace"].as<std::filesystem::path>();
+		}
+
 		args.windowWidth = result["width"].as<uint16_t>();
 		args.windowHeight = result["height"].as<uint16_t>();
 		args.guiScale = result["ui-scale"].as<float>();
@@ -193,6 +217,8 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		args.logFile = result["log-file"].as<std::string>();
 		args.logLevels = logLevels;
 		args.startLevel = result["start-level"].as<std::string>();
+		args.levelCache = result["level-cache"].as<std::filesystem::path>();
+		args.mipChainCache = result["mip-chain-cache"].as<std::filesystem::path>();
 	}
 	catch (cxxopts::exceptions::parsing& err)
 	{
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cmath>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+#include <json.hpp>
+
+#include "EngineConfig.h"
+#include "Game.h"
+#include "Locator.h"
+#include "Profiler.h"
+
+namespace
+{
+struct SyntheticMap
+{
+	uint32_t villagers;
+	uint32_t trees;
+	uint32_t abodes;
+};
+
+/// Lay items out on a square grid centered on the town, on the flat part of Land1 the tests use
+std::string GridPosition(uint32_t index, uint32_t count, float spacing, float offset)
+{
+	const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+	const auto x = 2185.72f + offset + static_cast<float>(index % side) * spacing - static_cast<float>(side) * spacing / 2.0f;
+	const auto z = 2315.78f + offset + static_cast<float>(index / side) * spacing - static_cast<float>(side) * spacing / 2.0f;
+	return fmt::format("{:.2f},{:.2f}", x, z);
+}
+
+std::string MakeSyntheticScript(const SyntheticMap& map)
+{
+	std::string script = "VERSION(2.300000)\n"
+	                     "LOAD_LANDSCAPE(\".\\Data\\Landscape\\Land1.lnd\")\n"
+	                     "CREATE_TOWN(0, \"2185.72,2315.78\", \"PLAYER_ONE\", 0, \"CELTIC\")\n";
+	for (uint32_t i = 0; i < map.abodes; ++i)
+	{
+		script += fmt::format("CREATE_ABODE(0, \"{}\", \"CELTIC_ABODE_F\", 11100, 1095, 0, 0)\n",
+		                      GridPosition(i, map.abodes, 25.0f, 0.0f));
+	}
+	for (uint32_t i = 0; i < map.trees; ++i)
+	{
+		script += fmt::format("CREATE_NEW_TREE(0, \"{}\", 3, 1, {:.2f}, 1.0, 1.0)\n", GridPosition(i, map.trees, 9.0f, 4.5f),
+		                      static_cast<float>(i % 7));
+	}
+	for (uint32_t i = 0; i < map.villagers; ++i)
+	{
+		script += fmt::format("CREATE_VILLAGER_POS(\"{0}\", \"{0}\", \"CELTIC_HOUSEWIFE\", {1})\n",
+		                      GridPosition(i, map.villagers, 3.0f, 1.5f), 18 + i % 40);
+	}
+	return script;
+}
+
+nlohmann::json Statistics(std::vector<double>& samples)
+{
+	if (samples.empty())
+	{
+		return {{"samples", 0}};
+	}
+	std::sort(samples.begin(), samples.end());
+	const auto percentile = [&samples](double p) {
+		const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(samples.size())));
+		return samples.at(std::clamp<size_t>(rank, 1, samples.size()) - 1);
+	};
+	return {
+	    {"samples", samples.size()},
+	    {"mean", std::accumulate(samples.cbegin(), samples.cend(), 0.0) / static_cast<double>(samples.size())},
+	    {"p50", percentile(0.50)},
+	    {"p99", percentile(0.99)},
+	};
+}
+
+/// The draw stages of the reflection and main passes share their names, they are reported under their pass
+std::string StageName(const openblack::Profiler& profiler, openblack::Profiler::ZoneId zone)
+{
+	using Stage = openblack::Profiler::Stage;
+	const auto name = profiler.GetZoneName(zone);
+	const auto isBetween = [zone](Stage first, Stage last) {
+		return zone >= static_cast<uint32_t>(first) && zone <= static_cast<uint32_t>(last);
+	};
+	const auto passName = [](Stage pass) { return openblack::Profiler::k_StageNames.at(static_cast<size_t>(pass)); };
+	if (isBetween(Stage::ReflectionDrawSky, Stage::ReflectionDrawDebugCross))
+	{
+		return fmt::format("{}/{}", passName(Stage::ReflectionPass), name);
+	}
+	if (isBetween(Stage::MainPassDrawSky, Stage::MainPassDrawDebugCross))
+	{
+		return fmt::format("{}/{}", passName(Stage::MainPass), name);
+	}
+	return std::string(name);
+}
+} // namespace
+
+// Runs the game headless with the Noop renderer on a level script, or on a generated map of villagers, trees and abodes,
+// and reports the profiler's stages and counters as JSON. Every frame also runs a game turn, as fast as they go.
+// ctest runs it once on the mock data to keep it working, point it at a real game install for numbers.
+int main(int argc, char* argv[])
+{
+	cxxopts::Options options("bench_game", "Benchmark the game's simulation and draw encoding without a GPU.");
+	// clang-format off
+	options.add_options()
+		("h,help", "Display this help message.")
+		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game.", cxxopts::value<std::string>())
+		("s,script", "Level script to run. Defaults to a synthetic map built from the counts below.", cxxopts::value<std::string>())
+		("villagers", "Villagers in the synthetic map.", cxxopts::value<uint32_t>()->default_value("200"))
+		("trees", "Trees in the synthetic map.", cxxopts::value<uint32_t>()->default_value("200"))
+		("abodes", "Abodes in the synthetic map.", cxxopts::value<uint32_t>()->default_value("20"))
+		("i,iterations", "Number of times to load and run the level.", cxxopts::value<uint32_t>()->default_value("3"))
+		("f,frames", "Number of frames, each running a game turn, in every iteration.", cxxopts::value<uint32_t>()->default_value("300"))
+		("o,output", "Write the JSON report to this file instead of the standard output.", cxxopts::value<std::string>())
+	;
+	// clang-format on
+
+	const auto result = options.parse(argc, argv);
+	if (result.count("help") != 0 || result.count("game-path") == 0)
+	{
+		std::cout << options.help() << std::endl;
+		return result.count("help") != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	std::filesystem::path scriptPath;
+	if (result.count("script") != 0)
+	{
+		scriptPath = result["script"].as<std::string>();
+	}
+	else
+	{
+		const auto map = SyntheticMap {
+		    .villagers = result["villagers"].as<uint32_t>(),
+		    .trees = result["trees"].as<uint32_t>(),
+		    .abodes = result["abodes"].as<uint32_t>(),
+		};
+		scriptPath = std::filesystem::temp_directory_path() / "openblack_bench_game" / "Synthetic.txt";
+		std::filesystem::create_directories(scriptPath.parent_path());
+		std::ofstream(scriptPath) << MakeSyntheticScript(map);
+	}
+
+	const auto frames = std::max(result["frames"].as<uint32_t>(), 1u);
+	auto args = openblack::Arguments {
+	    .rendererType = bgfx::RendererType::Enum::Noop,
+	    .gamePath = result["game-path"].as<std::string>(),
+	    .numFramesToSimulate = frames,
+	    .logFile = "stdout",
+	    .startLevel = scriptPath.string(),
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+	auto game = std::make_unique<openblack::Game>(std::move(args));
+	if (!game->Initialize())
+	{
+		return EXIT_FAILURE;
+	}
+
+	auto& config = openblack::Locator::config::value();
+	config.running = true;
+	config.turnEveryFrame = true;
+
+	// The profiler only keeps the last few frames, gather the samples as they complete
+	auto& profiler = openblack::Locator::profiler::value();
+	std::vector<double> frameSamples;
+	std::map<openblack::Profiler::ZoneId, std::vector<double>> zoneSamples;
+	std::array<std::vector<double>, static_cast<size_t>(openblack::Profiler::Counter::_count)> counterSamples;
+	bool loading = true;
+	profiler.SetFrameCallback([&](const openblack::Profiler::Entry& entry) {
+		// The entry closed by a run's first frame spans the level load, keep its zones but not its length
+		if (!loading)
+		{
+			frameSamples.push_back(std::chrono::duration<double, std::milli>(entry.frameEnd - entry.frameStart).count());
+			for (size_t i = 0; i < entry.counters.size(); ++i)
+			{
+				counterSamples.at(i).push_back(static_cast<double>(entry.counters.at(i)));
+			}
+		}
+		// Zones which ran several times in the frame, or on several threads, are added up
+		std::map<openblack::Profiler::ZoneId, double> frameZones;
+		for (const auto& scope : entry.scopes)
+		{
+			frameZones[scope.zone] += std::chrono::duration<double, std::milli>(scope.end - scope.start).count();
+		}
+		for (const auto& [zone, duration] : frameZones)
+		{
+			zoneSamples[zone].push_back(duration);
+		}
+		loading = false;
+	});
+
+	const auto iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	uint32_t turns = 0;
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		loading = true;
+		if (!game->Run())
+		{
+			return EXIT_FAILURE;
+		}
+		turns += game->GetTurn();
+	}
+	profiler.SetFrameCallback(nullptr);
+
+	nlohmann::json report = {
+	    {"level", scriptPath.generic_string()},
+	    {"iterations", iterations},
+	    {"frames", frameSamples.size()},
+	    {"turns", turns},
+	    {"threads", profiler.GetThreadCount()},
+	    {"droppedZones", profiler.GetDroppedZoneCount()},
+	    {"frameMs", Statistics(frameSamples)},
+	};
+	for (auto& [zone, samples] : zoneSamples)
+	{
+		report["stagesMs"][StageName(profiler, zone)] = Statistics(samples);
+	}
+	for (size_t i = 0; i < counterSamples.size(); ++i)
+	{
+		report["counters"][std::string(openblack::Profiler::k_CounterNames.at(i))] = Statistics(counterSamples.at(i));
+	}
+
+	if (result.count("output") != 0)
+	{
+		std::ofstream(result["output"].as<std::string>()) << report.dump(4) << std::endl;
+	}
+	else
+	{
+		std::cout << report.dump(4) << std::endl;
+	}
+
+	game.reset();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "Game.h"
+#include "Level.h"
+#include "Locator.h"
+#include "Resources/ResourcesInterface.h"
+
+// Loads the largest campaign level script (or the one given) repeatedly and reports the time spent in Game::LoadMap.
+// ctest runs it once on the mock data to keep it compiling and working, point it at a real game install for numbers.
+int main(int argc, char* argv[])
+{
+	cxxopts::Options options("bench_load_script", "Benchmark the loading of LHScriptX level scripts.");
+	// clang-format off
+	options.add_options()
+		("h,help", "Display this help message.")
+		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game.", cxxopts::value<std::string>())
+		("s,script", "Level script to load. Defaults to the largest campaign script.", cxxopts::value<std::string>())
+		("i,iterations", "Number of times to load the script.", cxxopts::value<uint32_t>()->default_value("10"))
+	;
+	// clang-format on
+
+	const auto result = options.parse(argc, argv);
+	if (result.count("help") != 0 || result.count("game-path") == 0)
+	{
+		std::cout << options.help() << std::endl;
+		return result.count("help") != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	auto args = openblack::Arguments {
+	    .rendererType = bgfx::RendererType::Enum::Noop,
+	    .gamePath = result["game-path"].as<std::string>(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+	auto game = std::make_unique<openblack::Game>(std::move(args));
+	if (!game->Initialize())
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::filesystem::path scriptPath;
+	if (result.count("script") != 0)
+	{
+		scriptPath = result["script"].as<std::string>();
+	}
+	else
+	{
+		uintmax_t largestSize = 0;
+		openblack::Locator::resources::value().GetLevels().Each([&scriptPath, &largestSize](auto, const auto& level) {
+			if (level->GetType() != openblack::Level::LandType::Campaign)
+			{
+				return;
+			}
+			const auto path = openblack::Locator::filesystem::value().FindPath(level->GetScriptPath());
+			const auto size = std::filesystem::file_size(path);
+			if (size > largestSize)
+			{
+				largestSize = size;
+				scriptPath = level->GetScriptPath();
+			}
+		});
+	}
+	if (scriptPath.empty())
+	{
+		std::cerr << "No level script found to load" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const auto iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	std::vector<double> timings;
+	timings.reserve(iterations);
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		if (!game->LoadMap(scriptPath))
+		{
+			return EXIT_FAILURE;
+		}
+		timings.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	std::sort(timings.begin(), timings.end());
+	const auto mean = std::accumulate(timings.cbegin(), timings.cend(), 0.0) / static_cast<double>(timings.size());
+	std::cout << scriptPath.generic_string() << ": " << iterations << " loads, min " << timings.front() << " ms, mean "
+	          << mean << " ms, max " << timings.back() << " ms" << std::endl;
+
+	game.reset();
+	return EXIT_SUCCESS;
+}
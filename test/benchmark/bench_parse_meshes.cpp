@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <BinaryReader.h>
+#include <L3DFile.h>
+#include <PackFile.h>
+#include <cxxopts.hpp>
+
+namespace
+{
+void Report(const char* name, std::vector<double>& timings, double bytes, size_t meshes)
+{
+	std::sort(timings.begin(), timings.end());
+	const auto mean = std::accumulate(timings.cbegin(), timings.cend(), 0.0) / static_cast<double>(timings.size());
+	std::cout << name << ": " << timings.size() << " runs, min " << timings.front() << " ms, mean " << mean << " ms, max "
+	          << timings.back() << " ms, " << bytes / 1000.0 / timings.front() << " MB/s, "
+	          << static_cast<double>(meshes) * 1000.0 / timings.front() << " meshes/s" << std::endl;
+}
+} // namespace
+
+// Parses every mesh of AllMeshes.g3d from memory, without touching the disk or the GPU, and reports the time spent in the
+// pack and l3d parsers. The file is read once up front so only parsing is measured.
+int main(int argc, char* argv[])
+{
+	cxxopts::Options options("bench_parse_meshes", "Benchmark the g3d and l3d parsers.");
+	// clang-format off
+	options.add_options()
+		("h,help", "Display this help message.")
+		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game.", cxxopts::value<std::string>())
+		("i,iterations", "Number of times to parse every mesh.", cxxopts::value<uint32_t>()->default_value("20"))
+	;
+	// clang-format on
+
+	const auto result = options.parse(argc, argv);
+	if (result.count("help") != 0 || result.count("game-path") == 0)
+	{
+		std::cout << options.help() << std::endl;
+		return result.count("help") != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	const auto path = std::filesystem::path(result["game-path"].as<std::string>()) / "Data" / "AllMeshes.g3d";
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open())
+	{
+		std::cerr << "Could not open " << path.generic_string() << std::endl;
+		return EXIT_FAILURE;
+	}
+	const auto bytes = openblack::ReadAllBytes(stream);
+
+	const auto iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	std::vector<double> packTimings;
+	std::vector<double> meshTimings;
+	packTimings.reserve(iterations);
+	meshTimings.reserve(iterations);
+	size_t meshCount = 0;
+	size_t meshBytes = 0;
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		openblack::pack::PackFile pack;
+		const auto packResult = pack.Open(std::span(bytes));
+		if (packResult != openblack::pack::PackResult::Success)
+		{
+			std::cerr << "Failed to open " << path.generic_string() << ": " << openblack::pack::ResultToStr(packResult)
+			          << std::endl;
+			return EXIT_FAILURE;
+		}
+		packTimings.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+		meshCount = pack.GetMeshes().size();
+		meshBytes = 0;
+		start = std::chrono::steady_clock::now();
+		for (const auto& mesh : pack.GetMeshes())
+		{
+			openblack::l3d::L3DFile l3d;
+			const auto l3dResult = l3d.Open(std::as_bytes(mesh));
+			if (l3dResult != openblack::l3d::L3DResult::Success)
+			{
+				std::cerr << "Failed to parse mesh: " << openblack::l3d::ResultToStr(l3dResult) << std::endl;
+				return EXIT_FAILURE;
+			}
+			meshBytes += mesh.size();
+		}
+		meshTimings.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	Report("pack", packTimings, static_cast<double>(bytes.size()), meshCount);
+	Report("meshes", meshTimings, static_cast<double>(meshBytes), meshCount);
+
+	return EXIT_SUCCESS;
+}
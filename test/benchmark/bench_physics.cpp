@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "Common/TaskScheduler.h"
+#include "ECS/Systems/DynamicsSystemInterface.h"
+#include "EngineConfig.h"
+#include "Game.h"
+#include "Level.h"
+#include "Locator.h"
+#include "Resources/ResourcesInterface.h"
+
+namespace
+{
+void Report(const char* name, std::vector<double>& timings)
+{
+	std::sort(timings.begin(), timings.end());
+	const auto mean = std::accumulate(timings.cbegin(), timings.cend(), 0.0) / static_cast<double>(timings.size());
+	std::cout << name << ": " << timings.size() << " runs, min " << timings.front() << " ms, mean " << mean << " ms, max "
+	          << timings.back() << " ms" << std::endl;
+}
+} // namespace
+
+// Loads a campaign level (the first one or the one given) and reports the time spent loading it, which is dominated by
+// the island's meshes and BVHs, and the time spent stepping its physics world.
+// Compare runs with --workers 0 and with --multithreaded-physics to see the effect of the task scheduler.
+int main(int argc, char* argv[])
+{
+	cxxopts::Options options("bench_physics", "Benchmark the island build and physics step.");
+	// clang-format off
+	options.add_options()
+		("h,help", "Display this help message.")
+		("g,game-path", "Path to the Data/ and Scripts/ directories of the original Black & White game.", cxxopts::value<std::string>())
+		("s,script", "Level script to load. Defaults to the first campaign script.", cxxopts::value<std::string>())
+		("i,iterations", "Number of times to load the level.", cxxopts::value<uint32_t>()->default_value("10"))
+		("steps", "Number of physics steps timed after each load.", cxxopts::value<uint32_t>()->default_value("600"))
+		("w,workers", "Number of task scheduler worker threads. Defaults to one less than the hardware threads.", cxxopts::value<uint32_t>())
+		("m,multithreaded-physics", "Use Bullet's multithreaded world.")
+	;
+	// clang-format on
+
+	const auto result = options.parse(argc, argv);
+	if (result.count("help") != 0 || result.count("game-path") == 0)
+	{
+		std::cout << options.help() << std::endl;
+		return result.count("help") != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	auto args = openblack::Arguments {
+	    .rendererType = bgfx::RendererType::Enum::Noop,
+	    .gamePath = result["game-path"].as<std::string>(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+	auto game = std::make_unique<openblack::Game>(std::move(args));
+	if (!game->Initialize())
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (result.count("workers") != 0)
+	{
+		openblack::Locator::taskScheduler::emplace(result["workers"].as<uint32_t>());
+	}
+	auto& config = openblack::Locator::config::value();
+	config.physicsMultithreaded = result.count("multithreaded-physics") != 0;
+	config.physicsFixedTimestep = true;
+
+	std::filesystem::path scriptPath;
+	if (result.count("script") != 0)
+	{
+		scriptPath = result["script"].as<std::string>();
+	}
+	else
+	{
+		openblack::Locator::resources::value().GetLevels().Each([&scriptPath](auto, const auto& level) {
+			if (scriptPath.empty() && level->GetType() == openblack::Level::LandType::Campaign)
+			{
+				scriptPath = level->GetScriptPath();
+			}
+		});
+	}
+	if (scriptPath.empty())
+	{
+		std::cerr << "No level script found to load" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << scriptPath.generic_string() << " with " << openblack::Locator::taskScheduler::value().GetThreadCount()
+	          << " threads, " << (config.physicsMultithreaded ? "multithreaded" : "single threaded") << " physics"
+	          << std::endl;
+
+	const auto iterations = std::max(result["iterations"].as<uint32_t>(), 1u);
+	const auto steps = std::max(result["steps"].as<uint32_t>(), 1u);
+	const auto stepDuration = std::chrono::ceil<std::chrono::microseconds>(std::chrono::duration<float>(config.physicsTimestep));
+	std::vector<double> loadTimings;
+	std::vector<double> stepTimings;
+	loadTimings.reserve(iterations);
+	stepTimings.reserve(iterations);
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		if (!game->LoadMap(scriptPath))
+		{
+			return EXIT_FAILURE;
+		}
+		loadTimings.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+		auto& dynamicsSystem = openblack::Locator::dynamicsSystem::value();
+		start = std::chrono::steady_clock::now();
+		for (uint32_t step = 0; step < steps; ++step)
+		{
+			auto dt = stepDuration;
+			dynamicsSystem.Update(dt);
+			dynamicsSystem.UpdatePhysicsTransforms();
+		}
+		stepTimings.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+		                      steps);
+	}
+
+	Report("level load", loadTimings);
+	Report("physics step", stepTimings);
+
+	game.reset();
+	return EXIT_SUCCESS;
+}
@@ -70,6 +70,28 @@ class MockTerrain final: public openblack::LandIslandInterface
 	[[nodiscard]] float GetHeightAt(glm::vec2) const final { return 0.0f; }
 	[[nodiscard]] glm::vec3 GetNormalAt(glm::vec2) const final { return {0.0f, 1.0f, 0.0f}; }
 	[[nodiscard]] const openblack::lnd::LNDCell& GetCell(const glm::u16vec2&) const final { assert(false); }
+	// The scenarios describe their hits through the mock dynamics system, which knows about the camera
+	[[nodiscard]] std::optional<openblack::LandRayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+	                                                           float tMax) const final
+	{
+		const auto hit = openblack::Locator::dynamicsSystem::value().RayCastClosestHit(origin, direction, tMax);
+		if (!hit.has_value())
+		{
+			return std::nullopt;
+		}
+		const auto& position = hit->first.position;
+		return openblack::LandRayHit {position, {0.0f, 1.0f, 0.0f}, glm::length(position - origin) / glm::length(direction)};
+	}
+	void RayCast(std::span<const openblack::LandRay> rays, std::span<std::optional<openblack::LandRayHit>> hits) const final
+	{
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			hits[i] = RayCast(rays[i].origin, rays[i].direction, rays[i].tMax);
+		}
+	}
+	void SetAltitude(const glm::u16vec2&, uint8_t) final { assert(false); }
+	void SetCountry(const glm::u16vec2&, uint8_t) final { assert(false); }
+	void ApplyEdits() final { assert(false); }
 	void DumpTextures() const final { assert(false); }
 	void DumpMaps() const final { assert(false); }
 	[[nodiscard]] std::vector<openblack::LandBlock>& GetBlocks() final { assert(false); }
@@ -119,6 +141,8 @@ class MockDynamicsSystem: public openblack::ecs::systems::DynamicsSystemInterfac
 	void RegisterRigidBodies() override {}
 	void RegisterIslandRigidBodies(openblack::LandIslandInterface& island) override {}
 	void UpdatePhysicsTransforms() override {}
+	[[nodiscard]] uint32_t GetSubStepCount() const override { return 0; }
+	[[nodiscard]] float GetInterpolationFactor() const override { return 1.0f; }
 	[[nodiscard]] virtual std::optional<glm::vec2> RayCastClosestHitScreenCoord(glm::u16vec2 screenCoord) const = 0;
 	[[nodiscard]] std::optional<std::pair<openblack::ecs::components::Transform, openblack::RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, [[maybe_unused]] const glm::vec3& direction,
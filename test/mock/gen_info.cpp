@@ -82,6 +82,7 @@ int main(int argc, char* argv[]) noexcept
 		abode.abodeNumber = static_cast<openblack::AbodeNumber>(i);
 		std::memcpy(abode.debugString.data(), abodeDebugName.c_str(), abodeDebugName.length());
 		abode.meshId = static_cast<openblack::MeshId>(static_cast<uint32_t>(openblack::MeshId::BuildingCeltic1) + i);
+		abode.maxVillagersInAbode = 4;
 	}
 	std::string townCentreDebugName = "ABODE_TOWN_CENTRE";
 	constants.abode[12].abodeNumber = openblack::AbodeNumber::TownCentre;
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <AssetArchive.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/ArchiveFileSystem.h>
+
+using namespace openblack::pack;
+
+namespace
+{
+const auto k_ArchivePath = std::filesystem::path(TEST_BINARY_DIR) / "test_asset_archive.oba";
+
+std::vector<uint8_t> Repeated(size_t size, uint8_t value)
+{
+	return std::vector<uint8_t>(size, value);
+}
+
+std::vector<uint8_t> Text(std::string_view text)
+{
+	return {text.begin(), text.end()};
+}
+
+void WriteLooseFile(const std::filesystem::path& path, std::string_view text)
+{
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	stream << text;
+}
+
+std::vector<uint8_t> Counting(size_t size)
+{
+	std::vector<uint8_t> data(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		data[i] = static_cast<uint8_t>((i * 7919) >> 3);
+	}
+	return data;
+}
+} // namespace
+
+TEST(TestAssetArchive, EntriesReadBackAsWritten)
+{
+	AssetArchiveWriter writer;
+	ASSERT_EQ(writer.Add("Scripts/Land1.txt", Repeated(10000, 'a'), ArchiveCompression::Zlib), ArchiveResult::Success);
+	ASSERT_EQ(writer.Add("Data\\Landscape\\Land1.lnd", Counting(256), ArchiveCompression::Zlib), ArchiveResult::Success);
+	ASSERT_EQ(writer.Add("Data/Empty.txt", {}, ArchiveCompression::Zlib), ArchiveResult::Success);
+	ASSERT_EQ(writer.Write(k_ArchivePath), ArchiveResult::Success);
+
+	AssetArchive archive;
+	ASSERT_EQ(archive.Open(k_ArchivePath), ArchiveResult::Success);
+	ASSERT_EQ(archive.GetEntries().size(), 3);
+
+	const auto* script = archive.Find("scripts/LAND1.TXT");
+	ASSERT_NE(script, nullptr);
+	ASSERT_EQ(archive.GetName(*script), "Scripts/Land1.txt");
+	ASSERT_EQ(script->compression, ArchiveCompression::Zlib);
+	ASSERT_LT(script->storedSize, script->size);
+	std::vector<uint8_t> data;
+	ASSERT_EQ(archive.Read(*script, data), ArchiveResult::Success);
+	ASSERT_EQ(data, Repeated(10000, 'a'));
+
+	const auto* landscape = archive.Find("Data\\Landscape\\land1.lnd");
+	ASSERT_NE(landscape, nullptr);
+	ASSERT_EQ(archive.GetName(*landscape), "Data/Landscape/Land1.lnd");
+	ASSERT_EQ(archive.Read(*landscape, data), ArchiveResult::Success);
+	ASSERT_EQ(data, Counting(256));
+	// Data is in the order the files were added
+	ASSERT_LT(script->offset, landscape->offset);
+
+	const auto* empty = archive.Find("Data/Empty.txt");
+	ASSERT_NE(empty, nullptr);
+	ASSERT_EQ(archive.Read(*empty, data), ArchiveResult::Success);
+	ASSERT_TRUE(data.empty());
+
+	ASSERT_EQ(archive.Find("Data/Landscape"), nullptr);
+	ASSERT_EQ(archive.Find("Scripts/Land2.txt"), nullptr);
+}
+
+TEST(TestAssetArchive, NamesAreUniqueIgnoringCase)
+{
+	AssetArchiveWriter writer;
+	ASSERT_EQ(writer.Add("Data/AllMeshes.g3d", Counting(16), ArchiveCompression::None), ArchiveResult::Success);
+	ASSERT_EQ(writer.Add("data/allmeshes.G3D", Counting(16), ArchiveCompression::None), ArchiveResult::Success);
+	ASSERT_EQ(writer.Write(k_ArchivePath), ArchiveResult::ErrDuplicateEntry);
+}
+
+TEST(TestAssetArchive, RejectsOtherFiles)
+{
+	{
+		std::ofstream stream(k_ArchivePath, std::ios::binary | std::ios::trunc);
+		stream << "LiOnHeAd and not an archive at all";
+	}
+	AssetArchive archive;
+	ASSERT_EQ(archive.Open(k_ArchivePath), ArchiveResult::ErrUnrecognizedHeader);
+	AssetArchive missing;
+	ASSERT_EQ(missing.Open(k_ArchivePath.parent_path() / "missing.oba"), ArchiveResult::ErrCantOpen);
+}
+
+TEST(TestAssetArchive, FileSystemListsLooseAndArchivedFiles)
+{
+	if (spdlog::get("game") == nullptr)
+	{
+		spdlog::stdout_color_mt("game");
+	}
+	const auto gamePath = std::filesystem::path(TEST_BINARY_DIR) / "test_asset_archive_game";
+	const auto playgrounds = gamePath / "Scripts" / "Playgrounds";
+	std::filesystem::remove_all(gamePath);
+	std::filesystem::create_directories(playgrounds);
+	WriteLooseFile(playgrounds / "Loose.txt", "loose");
+	WriteLooseFile(playgrounds / "Both.txt", "loose");
+
+	AssetArchiveWriter writer;
+	ASSERT_EQ(writer.Add("Scripts/Playgrounds/Archived.txt", Text("archived"), ArchiveCompression::None),
+	          ArchiveResult::Success);
+	ASSERT_EQ(writer.Add("Scripts/Playgrounds/BOTH.txt", Text("archived"), ArchiveCompression::None), ArchiveResult::Success);
+	ASSERT_EQ(writer.Write(gamePath / openblack::filesystem::ArchiveFileSystem::k_ArchiveName), ArchiveResult::Success);
+
+	openblack::filesystem::ArchiveFileSystem fileSystem;
+	fileSystem.SetGamePath(gamePath);
+	ASSERT_TRUE(fileSystem.IsArchiveMounted());
+
+	std::vector<std::filesystem::path> files;
+	fileSystem.Iterate("Scripts/Playgrounds", false, [&files](const std::filesystem::path& f) { files.push_back(f); });
+	// Loose files are listed as well as archived ones, and the same file is only listed once
+	ASSERT_EQ(files.size(), 3);
+	std::ranges::sort(files);
+	ASSERT_EQ(files[0], playgrounds / "Archived.txt");
+	ASSERT_EQ(files[1], playgrounds / "Both.txt");
+	ASSERT_EQ(files[2], playgrounds / "Loose.txt");
+	ASSERT_EQ(fileSystem.ReadAll(files[0]), Text("archived"));
+	ASSERT_EQ(fileSystem.ReadAll(files[2]), Text("loose"));
+	// The loose file that hides an archived one when listing is also the one which is read
+	ASSERT_EQ(fileSystem.ReadAll(files[1]), Text("loose"));
+	ASSERT_EQ(fileSystem.Open(files[1], openblack::filesystem::Stream::Mode::Read)->Size(), Text("loose").size());
+
+	ASSERT_TRUE(fileSystem.Exists("Scripts"));
+	ASSERT_TRUE(fileSystem.Exists("scripts/playgrounds"));
+	ASSERT_TRUE(fileSystem.Exists("Scripts/Playgrounds/Archived.txt"));
+	ASSERT_FALSE(fileSystem.Exists("Scripts/Missing"));
+}
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <ANMFile.h>
+#include <BinaryReader.h>
+#include <GLWFile.h>
+#include <L3DFile.h>
+#include <LNDFile.h>
+#include <PackFile.h>
+#include <gtest/gtest.h>
+
+using namespace openblack;
+
+namespace
+{
+std::filesystem::path TestPath(const std::string& name)
+{
+	return std::filesystem::path(TEST_BINARY_DIR) / name;
+}
+
+std::vector<uint8_t> ReadBytes(const std::filesystem::path& path)
+{
+	std::ifstream stream(path, std::ios::binary);
+	return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+/// The first `size` bytes of a written file, as a parser would get them from a file which was cut short
+std::span<const std::byte> Truncated(const std::vector<uint8_t>& bytes, std::size_t size)
+{
+	return std::as_bytes(std::span(bytes)).first(size);
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& bytes, const T& value)
+{
+	const auto* begin = reinterpret_cast<const uint8_t*>(&value);
+	bytes.insert(bytes.end(), begin, begin + sizeof(value));
+}
+} // namespace
+
+TEST(TestFileFormats, BinaryReaderShortReadsKeepThePosition)
+{
+	const std::array<uint8_t, 6> bytes = {1, 0, 0, 0, 2, 0};
+	BinaryReader reader(std::as_bytes(std::span(bytes)));
+
+	uint32_t value = 0;
+	ASSERT_TRUE(reader.Read(value));
+	ASSERT_EQ(value, 1);
+	ASSERT_FALSE(reader.Read(value));
+	ASSERT_EQ(reader.Tell(), 4);
+	ASSERT_EQ(reader.Remaining(), 2);
+
+	std::vector<uint16_t> values;
+	ASSERT_FALSE(reader.ReadVector(values, 2));
+	ASSERT_TRUE(reader.ReadVector(values, 1));
+	ASSERT_EQ(values, std::vector<uint16_t> {2});
+	ASSERT_TRUE(reader.AtEnd());
+
+	ASSERT_FALSE(reader.Contains(4, 3));
+	ASSERT_FALSE(reader.Contains(SIZE_MAX, 1));
+	ASSERT_FALSE(reader.Seek(7));
+}
+
+TEST(TestFileFormats, GlowsRoundTrip)
+{
+	const auto path = TestPath("test_file_formats.glw");
+	{
+		glw::GLWFile glw;
+		for (int i = 0; i < 2; ++i)
+		{
+			glw::Glow glow {};
+			glow.size = sizeof(glow);
+			glow.red = 0.5f;
+			glow.posX = 100.0f * static_cast<float>(i);
+			std::snprintf(glow.name.data(), glow.name.size(), "Glow %d", i);
+			glow.emitterSize = 3.0f;
+			glw.AddGlow(glow);
+		}
+		ASSERT_EQ(glw.Write(path), glw::GLWResult::Success);
+	}
+	const auto bytes = ReadBytes(path);
+	ASSERT_EQ(bytes.size(), 2 * sizeof(glw::Glow) + sizeof(uint32_t));
+
+	glw::GLWFile glw;
+	ASSERT_EQ(glw.Open(std::as_bytes(std::span(bytes))), glw::GLWResult::Success);
+	ASSERT_EQ(glw.GetGlows().size(), 2);
+	ASSERT_EQ(glw.GetGlow(1).posX, 100.0f);
+	ASSERT_EQ(glw.GetGlow(1).emitterSize, 3.0f);
+	ASSERT_STREQ(glw.GetGlow(1).name.data(), "Glow 1");
+
+	// The count at the end of the file is cut short
+	ASSERT_EQ(glw::GLWFile().Open(Truncated(bytes, bytes.size() - 1)), glw::GLWResult::ErrItemCountMismatch);
+	// A whole glow is missing
+	ASSERT_EQ(glw::GLWFile().Open(Truncated(bytes, bytes.size() - sizeof(glw::Glow))), glw::GLWResult::ErrItemCountMismatch);
+}
+
+TEST(TestFileFormats, AnimationsRoundTrip)
+{
+	// The writer only writes the header, the keyframes are appended after it
+	const auto path = TestPath("test_file_formats.anm");
+	{
+		anm::ANMFile anm;
+		auto& header = anm.GetHeader();
+		header = {};
+		std::snprintf(header.name.data(), header.name.size(), "Walk");
+		header.frameCount = 1;
+		header.animationDuration = 1200;
+		header.framesBase = sizeof(anm::ANMHeader);
+		ASSERT_EQ(anm.Write(path), anm::ANMResult::Success);
+	}
+	auto bytes = ReadBytes(path);
+	ASSERT_EQ(bytes.size(), sizeof(anm::ANMHeader));
+	// Keyframe offsets, then the keyframe pointer, then the bone block offset, then the bone block
+	const auto keyframeOffset = static_cast<uint32_t>(bytes.size() + sizeof(uint32_t));
+	Append(bytes, keyframeOffset);
+	Append(bytes, keyframeOffset + static_cast<uint32_t>(sizeof(uint32_t)));
+	Append(bytes, keyframeOffset + static_cast<uint32_t>(2 * sizeof(uint32_t)));
+	Append(bytes, uint32_t {2});  // bone count
+	Append(bytes, uint32_t {40}); // time
+	for (int i = 0; i < 2; ++i)
+	{
+		anm::ANMBone bone {};
+		bone.matrix[0] = bone.matrix[4] = bone.matrix[8] = 1.0f;
+		bone.matrix[9] = static_cast<float>(i);
+		Append(bytes, bone);
+	}
+
+	anm::ANMFile anm;
+	ASSERT_EQ(anm.Open(std::as_bytes(std::span(bytes))), anm::ANMResult::Success);
+	ASSERT_STREQ(anm.GetHeader().name.data(), "Walk");
+	ASSERT_EQ(anm.GetHeader().animationDuration, 1200);
+	ASSERT_EQ(anm.GetKeyframes().size(), 1);
+	ASSERT_EQ(anm.GetKeyframes()[0].time, 40);
+	ASSERT_EQ(anm.GetKeyframes()[0].bones.size(), 2);
+	ASSERT_EQ(anm.GetKeyframes()[0].bones[1].matrix[9], 1.0f);
+
+	ASSERT_EQ(anm::ANMFile().Open(Truncated(bytes, sizeof(anm::ANMHeader) - 1)), anm::ANMResult::ErrFileTooSmall);
+	// The keyframe offsets are past the end
+	ASSERT_EQ(anm::ANMFile().Open(Truncated(bytes, sizeof(anm::ANMHeader))), anm::ANMResult::ErrBadKeyframeOffset);
+	// The last bone is cut short
+	ASSERT_EQ(anm::ANMFile().Open(Truncated(bytes, bytes.size() - 1)), anm::ANMResult::ErrBadKeyframeOffset);
+}
+
+TEST(TestFileFormats, LandscapesRoundTrip)
+{
+	const auto path = TestPath("test_file_formats.lnd");
+	{
+		lnd::LNDFile lnd;
+		lnd::LNDLowResolutionTexture texture {};
+		texture.texels = {1, 2, 3, 4};
+		lnd.AddLowResolutionTexture(texture);
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			auto block = std::make_unique<lnd::LNDBlock>();
+			block->blockX = i;
+			block->cells[5].altitude = static_cast<uint8_t>(10 + i);
+			lnd.AddBlock(*block);
+		}
+		auto country = std::make_unique<lnd::LNDCountry>();
+		country->type = 3;
+		lnd.AddCountry(*country);
+		auto material = std::make_unique<lnd::LNDMaterial>();
+		material->type = 7;
+		lnd.AddMaterial(*material);
+		auto bump = std::make_unique<lnd::LNDBumpMap>();
+		bump->texels[1] = 9;
+		lnd.AddBumpMap(*bump);
+		ASSERT_EQ(lnd.Write(path), lnd::LNDResult::Success);
+	}
+	const auto bytes = ReadBytes(path);
+
+	lnd::LNDFile lnd;
+	ASSERT_EQ(lnd.Open(std::as_bytes(std::span(bytes))), lnd::LNDResult::Success);
+	ASSERT_EQ(lnd.GetHeader().blockCount, 3);
+	ASSERT_EQ(lnd.GetLowResolutionTextures().size(), 1);
+	ASSERT_EQ(lnd.GetLowResolutionTextures()[0].texels, (std::vector<uint8_t> {1, 2, 3, 4}));
+	ASSERT_EQ(lnd.GetBlocks().size(), 2);
+	ASSERT_EQ(lnd.GetBlocks()[1].blockX, 1);
+	ASSERT_EQ(lnd.GetBlocks()[1].cells[5].altitude, 11);
+	ASSERT_EQ(lnd.GetCountries().size(), 1);
+	ASSERT_EQ(lnd.GetCountries()[0].type, 3);
+	ASSERT_EQ(lnd.GetMaterials().size(), 1);
+	ASSERT_EQ(lnd.GetMaterials()[0].type, 7);
+	ASSERT_EQ(lnd.GetExtra().bump.texels[1], 9);
+	ASSERT_TRUE(lnd.GetUnaccounted().empty());
+
+	// Every part of the file cut short is reported by the part it was cut in
+	const auto blocksBase = sizeof(lnd::LNDHeader) + sizeof(lnd::LNDLowResolutionTextureHeader) + 4;
+	const auto countriesBase = blocksBase + 2 * sizeof(lnd::LNDBlock);
+	const auto materialsBase = countriesBase + sizeof(lnd::LNDCountry);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, sizeof(lnd::LNDHeader) - 1)), lnd::LNDResult::ErrFileTooSmall);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, blocksBase - 1)), lnd::LNDResult::ErrBadLowResolutionTextureSize);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, countriesBase - 1)), lnd::LNDResult::ErrBadBlockSize);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, materialsBase - 1)), lnd::LNDResult::ErrBadCountrySize);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, materialsBase + 1)), lnd::LNDResult::ErrBadMaterialSize);
+	ASSERT_EQ(lnd::LNDFile().Open(Truncated(bytes, bytes.size() - 1)), lnd::LNDResult::ErrExtraTextureData);
+}
+
+TEST(TestFileFormats, MeshesRoundTrip)
+{
+	const auto path = TestPath("test_file_formats.l3d");
+	{
+		l3d::L3DFile l3d;
+		l3d.AddVertices({
+		    {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+		    {{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+		    {{0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}},
+		});
+		l3d.AddIndices({0, 2, 1});
+		l3d::L3DPrimitiveHeader primitive {};
+		primitive.numVertices = 3;
+		primitive.numTriangles = 1;
+		l3d.AddPrimitives({primitive});
+		l3d::L3DSubmeshHeader submesh {};
+		submesh.numPrimitives = 1;
+		l3d.AddSubmesh(submesh);
+		ASSERT_EQ(l3d.Write(path), l3d::L3DResult::Success);
+	}
+	const auto bytes = ReadBytes(path);
+
+	l3d::L3DFile l3d;
+	ASSERT_EQ(l3d.Open(std::as_bytes(std::span(bytes))), l3d::L3DResult::Success);
+	ASSERT_EQ(l3d.GetSubmeshHeaders().size(), 1);
+	ASSERT_EQ(l3d.GetPrimitiveHeaders().size(), 1);
+	ASSERT_EQ(l3d.GetPrimitiveHeaders()[0].numVertices, 3);
+	ASSERT_EQ(l3d.GetVertices().size(), 3);
+	ASSERT_EQ(l3d.GetVertices()[1].position.x, 1.0f);
+	ASSERT_EQ(l3d.GetVertices()[2].texCoord.y, 1.0f);
+	ASSERT_EQ(l3d.GetIndices(), (std::vector<uint16_t> {0, 2, 1}));
+	ASSERT_EQ(l3d.GetPrimitiveSpan(0).size(), 1);
+	ASSERT_EQ(l3d.GetVertexSpan(0).size(), 3);
+
+	ASSERT_EQ(l3d::L3DFile().Open(Truncated(bytes, sizeof(l3d::L3DHeader) - 1)), l3d::L3DResult::ErrFileTooSmall);
+	ASSERT_EQ(l3d::L3DFile().Open(Truncated(bytes, sizeof(l3d::L3DHeader))), l3d::L3DResult::ErrBadSubmeshOffset);
+	// The indices are the last thing written
+	ASSERT_EQ(l3d::L3DFile().Open(Truncated(bytes, bytes.size() - 1)), l3d::L3DResult::ErrBadTriangleOffset);
+
+	// Offsets past the end of the file are rejected rather than read
+	auto corrupt = bytes;
+	const auto corruptOffset = static_cast<uint32_t>(bytes.size());
+	std::memcpy(corrupt.data() + sizeof(l3d::L3DHeader), &corruptOffset, sizeof(corruptOffset));
+	ASSERT_EQ(l3d::L3DFile().Open(std::as_bytes(std::span(corrupt))), l3d::L3DResult::ErrBadSubmeshHeaderOffset);
+}
+
+TEST(TestFileFormats, MeshPacksRoundTrip)
+{
+	const auto path = TestPath("test_file_formats.g3d");
+	const std::vector<uint8_t> mesh0 = {1, 2, 3, 4, 5};
+	const std::vector<uint8_t> mesh1 = {6, 7, 8};
+	{
+		pack::PackFile pack;
+		ASSERT_EQ(pack.InsertMesh(mesh0), pack::PackResult::Success);
+		ASSERT_EQ(pack.InsertMesh(mesh1), pack::PackResult::Success);
+		ASSERT_EQ(pack.CreateMeshBlock(), pack::PackResult::Success);
+		ASSERT_EQ(pack.CreateInfoBlock(), pack::PackResult::Success);
+		ASSERT_EQ(pack.Write(path), pack::PackResult::Success);
+	}
+	const auto bytes = ReadBytes(path);
+
+	pack::PackFile pack;
+	ASSERT_EQ(pack.Open(std::as_bytes(std::span(bytes))), pack::PackResult::Success);
+	ASSERT_EQ(pack.GetMeshes().size(), 2);
+	ASSERT_TRUE(std::ranges::equal(pack.GetMesh(0), mesh0));
+	ASSERT_TRUE(std::ranges::equal(pack.GetMesh(1), mesh1));
+	// Ranges point at the mesh in the file, so evicted meshes can be read again without the rest of the pack
+	const auto range = pack.GetMeshRange(1);
+	ASSERT_TRUE(std::ranges::equal(std::span(bytes).subspan(range.offset, range.size), mesh1));
+
+	ASSERT_EQ(pack::PackFile().Open(Truncated(bytes, 4)), pack::PackResult::ErrFileTooSmall);
+	// The MESHES block is written last
+	ASSERT_EQ(pack::PackFile().Open(Truncated(bytes, bytes.size() - 1)), pack::PackResult::ErrFileNotEvenlySplit);
+
+	// Mesh offsets past the end of the block are rejected rather than read
+	auto corrupt = bytes;
+	const auto meshOffsetsOffset = range.offset - 2 * sizeof(uint32_t) - mesh0.size();
+	const uint32_t corruptOffset = 0xFFFF;
+	std::memcpy(corrupt.data() + meshOffsetsOffset, &corruptOffset, sizeof(corruptOffset));
+	ASSERT_EQ(pack::PackFile().Open(std::as_bytes(std::span(corrupt))), pack::PackResult::ErrMeshBlockHeaderMalformed);
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include <Level.h>
+#include <LevelCatalog.h>
+#include <Locator.h>
+#include <Resources/Loaders.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/DefaultFileSystem.h>
+
+using namespace openblack;
+
+namespace
+{
+constexpr std::string_view k_TwoLandscapes = R""""(VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Missing.lnd")
+LOAD_LANDSCAPE(".\Data\Landscape\Land2.lnd")
+START_GAME_MESSAGE("Two Landscapes")
+ADD_GAME_MESSAGE_LINE("Only the second landscape exists")
+)"""";
+
+constexpr std::string_view k_Helper = R""""(VERSION(2.300000)
+CREATE_TOWN(0, "2185.72,2315.78", "PLAYER_ONE", 0, "CELTIC")
+)"""";
+
+void WriteFile(const std::filesystem::path& path, std::string_view text)
+{
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	stream << text;
+}
+
+class TestLevelCatalog: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (spdlog::get("game") == nullptr)
+		{
+			spdlog::stdout_color_mt("game");
+		}
+		std::filesystem::remove_all(_gamePath);
+		std::filesystem::create_directories(_gamePath / "Scripts");
+		std::filesystem::create_directories(_gamePath / "Data" / "Landscape");
+		WriteFile(_gamePath / "Data" / "Landscape" / "Land2.lnd", "");
+		WriteFile(_gamePath / "Scripts" / "TwoLandscapes.txt", k_TwoLandscapes);
+		WriteFile(_gamePath / "Scripts" / "Helper.txt", k_Helper);
+
+		Locator::filesystem::emplace<filesystem::DefaultFileSystem>();
+		Locator::filesystem::value().SetGamePath(_gamePath);
+	}
+	void TearDown() override { Locator::filesystem::reset(); }
+
+	const std::filesystem::path _gamePath = std::filesystem::path(TEST_BINARY_DIR) / "test_level_catalog";
+	const std::filesystem::path _cachePath = std::filesystem::path(TEST_BINARY_DIR) / "test_level_catalog.cache";
+};
+} // namespace
+
+TEST_F(TestLevelCatalog, ParseMatchesLevel)
+{
+	const auto scriptPath = _gamePath / "Scripts" / "TwoLandscapes.txt";
+	LevelCatalog::Entry entry;
+	entry.scriptPath = scriptPath;
+	entry.landType = Level::LandType::Campaign;
+	LevelCatalog::Parse(entry);
+	ASSERT_TRUE(entry.isLevel);
+	ASSERT_EQ(entry.name, "Two Landscapes");
+	ASSERT_EQ(entry.description, "Only the second landscape exists");
+	ASSERT_EQ(entry.landscapePaths.size(), 2);
+
+	// A landscape which exists after one which doesn't makes the level valid, as it does when the script is parsed
+	const auto parsed = Level::ParseLevel(scriptPath, Level::LandType::Campaign);
+	const auto cataloged = resources::LevelLoader {}(resources::LevelLoader::FromCatalogTag {}, entry);
+	ASSERT_TRUE(parsed.IsValid());
+	ASSERT_EQ(cataloged->IsValid(), parsed.IsValid());
+	ASSERT_EQ(cataloged->GetName(), parsed.GetName());
+
+	LevelCatalog::Entry helper;
+	helper.scriptPath = _gamePath / "Scripts" / "Helper.txt";
+	LevelCatalog::Parse(helper);
+	ASSERT_FALSE(helper.isLevel);
+	ASSERT_TRUE(helper.landscapePaths.empty());
+}
+
+TEST_F(TestLevelCatalog, CacheIsInvalidatedByChangedScripts)
+{
+	{
+		LevelCatalog catalog;
+		ASSERT_FALSE(catalog.LoadCache(_gamePath / "missing.cache"));
+		catalog.Scan(_gamePath / "Scripts", Level::LandType::Campaign);
+		ASSERT_EQ(catalog.GetEntries().size(), 2);
+		ASSERT_EQ(catalog.GetParsedCount(), 2);
+		ASSERT_TRUE(catalog.SaveCache(_cachePath));
+	}
+	{
+		// Nothing changed, every entry comes from the cache
+		LevelCatalog catalog;
+		ASSERT_TRUE(catalog.LoadCache(_cachePath));
+		catalog.Scan(_gamePath / "Scripts", Level::LandType::Campaign);
+		ASSERT_EQ(catalog.GetEntries().size(), 2);
+		ASSERT_EQ(catalog.GetParsedCount(), 0);
+		const auto entry = std::ranges::find(catalog.GetEntries(), "Two Landscapes", &LevelCatalog::Entry::name);
+		ASSERT_NE(entry, catalog.GetEntries().end());
+		ASSERT_EQ(entry->landscapePaths.size(), 2);
+	}
+
+	WriteFile(_gamePath / "Scripts" / "TwoLandscapes.txt",
+	          "LOAD_LANDSCAPE(\".\\Data\\Landscape\\Land2.lnd\")\nSTART_GAME_MESSAGE(\"Renamed\")\n");
+	{
+		// Only the script which changed is read again
+		LevelCatalog catalog;
+		ASSERT_TRUE(catalog.LoadCache(_cachePath));
+		catalog.Scan(_gamePath / "Scripts", Level::LandType::Campaign);
+		ASSERT_EQ(catalog.GetParsedCount(), 1);
+		const auto entry = std::ranges::find(catalog.GetEntries(), "Renamed", &LevelCatalog::Entry::name);
+		ASSERT_NE(entry, catalog.GetEntries().end());
+		ASSERT_EQ(entry->landscapePaths.size(), 1);
+		ASSERT_TRUE(catalog.SaveCache(_cachePath));
+	}
+
+	// A cache from another version is ignored
+	{
+		std::fstream stream(_cachePath, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(4);
+		const uint32_t version = LevelCatalog::k_CacheVersion + 1;
+		stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	}
+	LevelCatalog catalog;
+	ASSERT_FALSE(catalog.LoadCache(_cachePath));
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdlib>
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#include <LHVMProfile.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::lhvm;
+
+namespace
+{
+const auto k_ProfilePath = std::filesystem::path(TEST_BINARY_DIR) / "test_lhvm_profile.txt";
+
+int ReadText(std::string_view text)
+{
+	{
+		std::ofstream stream(k_ProfilePath, std::ios::binary | std::ios::trunc);
+		stream << text;
+	}
+	LHVMProfile profile;
+	return profile.Read(k_ProfilePath);
+}
+} // namespace
+
+TEST(TestLHVMProfile, WriteThenRead)
+{
+	LHVMProfile written;
+	written.ticks = 10;
+	written.scripts.resize(3);
+	written.scripts[2] = {"Intro", 4, 120, std::chrono::nanoseconds(5000)};
+	written.nativeFunctions.resize(1);
+	written.nativeFunctions[0] = {"SLEEP", 7, 0, std::chrono::nanoseconds(300)};
+
+	ASSERT_EQ(written.Write(k_ProfilePath), EXIT_SUCCESS);
+	LHVMProfile read;
+	ASSERT_EQ(read.Read(k_ProfilePath), EXIT_SUCCESS);
+	ASSERT_EQ(read.ticks, 10);
+	ASSERT_EQ(read.scripts.size(), 3);
+	ASSERT_EQ(read.scripts[2].name, "Intro");
+	ASSERT_EQ(read.scripts[2].instructions, 120);
+	ASSERT_EQ(read.nativeFunctions[0].time, std::chrono::nanoseconds(300));
+}
+
+TEST(TestLHVMProfile, MalformedFilesAreRejected)
+{
+	ASSERT_EQ(ReadText("LHVMProfile 1\nticks\t2\nscript\t0\t1\t2\t3\tIntro\n"), EXIT_SUCCESS);
+
+	ASSERT_EQ(ReadText("LHVMProfile 2\n"), EXIT_FAILURE);
+	ASSERT_EQ(ReadText("LHVMProfile 1\nticks\tmany\n"), EXIT_FAILURE);
+	ASSERT_EQ(ReadText("LHVMProfile 1\nglobal\t0\t1\t2\t3\tIntro\n"), EXIT_FAILURE);
+	ASSERT_EQ(ReadText("LHVMProfile 1\nscript\t0\t1\n"), EXIT_FAILURE);
+	// Indices which would need huge or wrapped around allocations
+	ASSERT_EQ(ReadText("LHVMProfile 1\nscript\t4294967295\t1\t2\t3\tIntro\n"), EXIT_FAILURE);
+	ASSERT_EQ(ReadText("LHVMProfile 1\nnative\t-1\t1\t2\t3\tSLEEP\n"), EXIT_FAILURE);
+}
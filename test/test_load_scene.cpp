@@ -7,8 +7,25 @@
  * openblack is licensed under the GNU General Public License version 3.
  *******************************************************************************/
 
+#include <array>
+
+#include <3D/LandIslandInterface.h>
+#include <ECS/Components/Abode.h>
+#include <ECS/Components/Mesh.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/Tree.h>
+#include <ECS/Components/TurnSnapshot.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/DynamicsSystemInterface.h>
+#include <ECS/Systems/RenderingSystemInterface.h>
+#include <ECS/Systems/TownSystemInterface.h>
+#include <EngineConfig.h>
 #include <Game.h>
 #include <LHScriptX/Script.h>
+#include <Locator.h>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
 #include <gtest/gtest.h>
 
 class LoadScene: public ::testing::Test
@@ -70,3 +87,280 @@ LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
 CREATE_ABODE(0, "2224.63,2372.52", "CELTIC_ABODE_F", 11100, 1095, 0, 0)
 )"""");
 }
+
+TEST_F(LoadScene, batched_trees_and_villagers)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+CREATE_TOWN(0, "2185.72,2315.78", "PLAYER_ONE", 0, "CELTIC")
+CREATE_ABODE(0, "2224.63,2372.52", "CELTIC_ABODE_F", 11100, 1095, 0, 0)
+CREATE_NEW_TREE(0, "2190.00,2330.00", 3, 1, 0.5, 1.0, 1.0)
+CREATE_NEW_TREE(0, "2195.00,2335.00", 3, 1, 1.5, 0.5, 1.0)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2186.72,2316.78", "CELTIC_HOUSEWIFE", 12)
+)"""");
+
+	using namespace openblack::ecs::components;
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	ASSERT_FALSE(registry.Context().constructionBatch.has_value());
+	ASSERT_EQ(registry.Size<Tree>(), 2);
+	ASSERT_EQ(registry.Size<Villager>(), 2);
+	registry.Each<const Villager>([&registry](entt::entity entity, const Villager& villager) {
+		ASSERT_NE(villager.town, entt::null);
+		ASSERT_NE(villager.abode, entt::null);
+		ASSERT_TRUE(registry.Get<Abode>(villager.abode).inhabitants.contains(entity));
+	});
+}
+
+TEST_F(LoadScene, closest_town_and_abode_capacity)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+CREATE_TOWN(0, "2185.72,2315.78", "PLAYER_ONE", 0, "CELTIC")
+CREATE_TOWN(1, "1200.00,1300.00", "PLAYER_ONE", 0, "CELTIC")
+CREATE_ABODE(0, "2224.63,2372.52", "CELTIC_ABODE_F", 11100, 1095, 0, 0)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+)"""");
+
+	using namespace openblack::ecs::components;
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	const auto& townSystem = openblack::Locator::townSystem::value();
+	const auto town0 = registry.Context().towns.at(0);
+	const auto town1 = registry.Context().towns.at(1);
+	ASSERT_EQ(townSystem.FindClosestTown(registry.Get<Transform>(town0).position + glm::vec3(10.0f)), town0);
+	ASSERT_EQ(townSystem.FindClosestTown(registry.Get<Transform>(town1).position - glm::vec3(10.0f)), town1);
+	ASSERT_EQ(townSystem.FindClosestTown(glm::vec3(1300.0f, 0.0f, 1400.0f)), town1);
+
+	// The mock abodes house 4 villagers, the last one is left without a home
+	ASSERT_EQ(townSystem.FindAbodeWithSpace(town0), entt::null);
+	size_t housed = 0;
+	registry.Each<const Villager>([&housed](entt::entity, const Villager& villager) {
+		ASSERT_NE(villager.town, entt::null);
+		housed += villager.abode != entt::null ? 1 : 0;
+	});
+	ASSERT_EQ(housed, 4);
+}
+
+TEST_F(LoadScene, destroyed_towns_and_abodes_are_not_found)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+CREATE_TOWN(0, "2185.72,2315.78", "PLAYER_ONE", 0, "CELTIC")
+CREATE_TOWN(1, "1200.00,1300.00", "PLAYER_ONE", 0, "CELTIC")
+CREATE_ABODE(0, "2224.63,2372.52", "CELTIC_ABODE_F", 11100, 1095, 0, 0)
+)"""");
+
+	using namespace openblack::ecs::components;
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	const auto& townSystem = openblack::Locator::townSystem::value();
+	const auto town0 = registry.Context().towns.at(0);
+	const auto town1 = registry.Context().towns.at(1);
+	const auto abode = registry.Front<const Abode>();
+	ASSERT_EQ(townSystem.FindAbodeWithSpace(town0), abode);
+
+	registry.Destroy(abode);
+	ASSERT_EQ(townSystem.FindAbodeWithSpace(town0), entt::null);
+
+	const auto nearTown0 = registry.Get<Transform>(town0).position + glm::vec3(10.0f);
+	ASSERT_EQ(townSystem.FindClosestTown(nearTown0), town0);
+	registry.Destroy(town0);
+	ASSERT_EQ(townSystem.FindClosestTown(nearTown0), town1);
+}
+
+TEST_F(LoadScene, height_and_country_change)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+HEIGHT_CHANGE("1790.00,2710.00", 200)
+COUNTRY_CHANGE("1790.00,2710.00", 0)
+)"""");
+
+	const auto& island = openblack::Locator::terrainSystem::value();
+	ASSERT_FLOAT_EQ(island.GetHeightAt(glm::vec2(1790.0f, 2710.0f)), 200 * openblack::LandIslandInterface::k_HeightUnit);
+}
+
+TEST_F(LoadScene, fixed_physics_timestep)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+
+	auto& config = openblack::Locator::config::value();
+	config.physicsFixedTimestep = true;
+	config.physicsTimestep = 0.02f;
+	config.physicsMaxSubSteps = 4;
+
+	auto& dynamicsSystem = openblack::Locator::dynamicsSystem::value();
+	auto step = [&dynamicsSystem](std::chrono::milliseconds frame) {
+		std::chrono::microseconds dt = frame;
+		dynamicsSystem.Update(dt);
+		dynamicsSystem.UpdatePhysicsTransforms();
+	};
+
+	// A frame shorter than the timestep only advances the interpolation
+	step(std::chrono::milliseconds(10));
+	ASSERT_EQ(dynamicsSystem.GetSubStepCount(), 0u);
+	ASSERT_NEAR(dynamicsSystem.GetInterpolationFactor(), 0.5f, 1e-4f);
+
+	step(std::chrono::milliseconds(15));
+	ASSERT_EQ(dynamicsSystem.GetSubStepCount(), 1u);
+	ASSERT_NEAR(dynamicsSystem.GetInterpolationFactor(), 0.25f, 1e-4f);
+
+	// A long frame is capped and the time the cap could not cover is dropped
+	step(std::chrono::milliseconds(200));
+	ASSERT_EQ(dynamicsSystem.GetSubStepCount(), 4u);
+	ASSERT_NEAR(dynamicsSystem.GetInterpolationFactor(), 0.25f, 1e-4f);
+
+	config.physicsFixedTimestep = false;
+	step(std::chrono::milliseconds(33));
+	ASSERT_EQ(dynamicsSystem.GetSubStepCount(), 1u);
+	ASSERT_FLOAT_EQ(dynamicsSystem.GetInterpolationFactor(), 1.0f);
+}
+
+TEST_F(LoadScene, turn_transform_interpolation)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+CREATE_TOWN(0, "2185.72,2315.78", "PLAYER_ONE", 0, "CELTIC")
+CREATE_ABODE(0, "2224.63,2372.52", "CELTIC_ABODE_F", 11100, 1095, 0, 0)
+CREATE_VILLAGER_POS("2219.71,2371.99", "2185.72,2315.78", "CELTIC_HOUSEWIFE", 37)
+)"""");
+
+	using namespace openblack::ecs::components;
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	auto& renderingSystem = openblack::Locator::rendereringSystem::value();
+	const auto villager = registry.Front<const Villager>();
+	auto& transform = registry.Get<Transform>(villager);
+	const auto start = transform.position;
+
+	// Snapshot before the turn moves the villager, then draw halfway through the turn
+	renderingSystem.SnapshotTurnTransforms();
+	ASSERT_TRUE(registry.AllOf<TurnSnapshot>(villager));
+	transform.position += glm::vec3(10.0f, 0.0f, 0.0f);
+	renderingSystem.SetTurnFraction(0.5f);
+	renderingSystem.PrepareDraw(false, false, false);
+
+	const auto& context = renderingSystem.GetContext();
+	const auto& desc = context.instancedDrawDescs.at(registry.Get<const Mesh>(villager).id);
+	ASSERT_EQ(desc.count, 1u);
+	const auto drawn = glm::vec3(context.instanceUniforms.at(desc.offset)[3]);
+	ASSERT_NEAR(drawn.x, start.x + 5.0f, 1e-3f);
+	ASSERT_NEAR(drawn.y, start.y, 1e-3f);
+	ASSERT_NEAR(drawn.z, start.z, 1e-3f);
+
+	// Without any change to the registry, the next frames keep blending towards the turn's result
+	renderingSystem.SetTurnFraction(1.0f);
+	renderingSystem.PrepareDraw(false, false, false);
+	ASSERT_NEAR(context.instanceUniforms.at(desc.offset)[3].x, start.x + 10.0f, 1e-3f);
+
+	// A turn which moved the villager rebuilds the draw descs, one which moved nothing doesn't
+	renderingSystem.SnapshotTurnTransforms();
+	ASSERT_TRUE(context.dirty);
+	renderingSystem.PrepareDraw(false, false, false);
+	renderingSystem.SnapshotTurnTransforms();
+	ASSERT_FALSE(context.dirty);
+}
+
+TEST_F(LoadScene, land_ray_cast)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+HEIGHT_CHANGE("1790.00,2710.00", 200)
+)"""");
+
+	const auto& island = openblack::Locator::terrainSystem::value();
+	const auto expectedHeight = 200 * openblack::LandIslandInterface::k_HeightUnit;
+
+	// The edit must reach the ray caster, straight down on the edited corner lands exactly on it
+	const auto hit = island.RayCast(glm::vec3(1790.0f, 1000.0f, 2710.0f), glm::vec3(0.0f, -1.0f, 0.0f), 1e10f);
+	ASSERT_TRUE(hit.has_value());
+	ASSERT_NEAR(hit->position.y, expectedHeight, 1e-3f);
+	ASSERT_NEAR(hit->distance, 1000.0f - expectedHeight, 1e-3f);
+	ASSERT_GT(hit->normal.y, 0.0f);
+
+	ASSERT_FALSE(island.RayCast(glm::vec3(1790.0f, 1000.0f, 2710.0f), glm::vec3(0.0f, 1.0f, 0.0f), 1e10f).has_value());
+	ASSERT_FALSE(island.RayCast(glm::vec3(1790.0f, 1000.0f, 2710.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f).has_value());
+
+	// Batched rays give the same hits as single ones
+	std::vector<openblack::LandRay> rays;
+	for (int i = 0; i < 64; ++i)
+	{
+		const auto angle = glm::radians(static_cast<float>(i) * 360.0f / 64.0f);
+		rays.push_back({glm::vec3(1790.0f, 1000.0f, 2710.0f), glm::vec3(glm::cos(angle), -1.0f, glm::sin(angle)), 1e10f});
+	}
+	std::vector<std::optional<openblack::LandRayHit>> hits(rays.size());
+	island.RayCast(rays, hits);
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		const auto single = island.RayCast(rays[i].origin, rays[i].direction, rays[i].tMax);
+		ASSERT_EQ(hits[i].has_value(), single.has_value());
+		if (single.has_value())
+		{
+			ASSERT_FLOAT_EQ(hits[i]->distance, single->distance);
+		}
+	}
+}
+
+TEST_F(LoadScene, land_ray_cast_matches_physics)
+{
+	LoadTestScene(R""""(
+VERSION(2.300000)
+LOAD_LANDSCAPE(".\Data\Landscape\Land1.lnd")
+)"""");
+
+	const auto& island = openblack::Locator::terrainSystem::value();
+	const auto& dynamics = openblack::Locator::dynamicsSystem::value();
+
+	// Rays fanned out from above and to the side of the mock land's hill, the same rays go to Bullet's rayTest on the block
+	// meshes given to the physics world
+	const std::array<glm::vec3, 3> origins = {
+	    glm::vec3(1788.4f, 500.0f, 2710.0f),
+	    glm::vec3(1500.0f, 120.0f, 2500.0f),
+	    glm::vec3(2100.0f, 60.0f, 2900.0f),
+	};
+	constexpr float k_MaxDistance = 5000.0f;
+	constexpr float k_Tolerance = 0.05f;
+	size_t hitCount = 0;
+	for (const auto& origin : origins)
+	{
+		for (int pitch = 1; pitch <= 8; ++pitch)
+		{
+			for (int yaw = 0; yaw < 16; ++yaw)
+			{
+				const auto pitchAngle = glm::radians(static_cast<float>(pitch) * 10.0f);
+				const auto yawAngle = glm::radians(static_cast<float>(yaw) * 360.0f / 16.0f + 5.0f);
+				const auto direction = glm::normalize(glm::vec3(glm::cos(yawAngle) * glm::cos(pitchAngle),
+				                                                -glm::sin(pitchAngle),
+				                                                glm::sin(yawAngle) * glm::cos(pitchAngle)));
+
+				const auto hit = island.RayCast(origin, direction, k_MaxDistance);
+				const auto physicsHit = dynamics.RayCastClosestHit(origin, direction, k_MaxDistance);
+				ASSERT_EQ(hit.has_value(), physicsHit.has_value()) << "pitch " << pitch << " yaw " << yaw;
+				if (!hit.has_value())
+				{
+					continue;
+				}
+				++hitCount;
+				ASSERT_EQ(physicsHit->second.type, openblack::RigidBodyType::Terrain);
+				const auto& physicsPosition = physicsHit->first.position;
+				ASSERT_NEAR(hit->position.x, physicsPosition.x, k_Tolerance) << "pitch " << pitch << " yaw " << yaw;
+				ASSERT_NEAR(hit->position.y, physicsPosition.y, k_Tolerance) << "pitch " << pitch << " yaw " << yaw;
+				ASSERT_NEAR(hit->position.z, physicsPosition.z, k_Tolerance) << "pitch " << pitch << " yaw " << yaw;
+				ASSERT_NEAR(hit->distance, glm::distance(origin, physicsPosition), k_Tolerance);
+			}
+		}
+	}
+	// The comparison isn't only of misses
+	ASSERT_GT(hitCount, 0);
+}
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include <Graphics/MipChain.h>
+#include <Resources/MipChainCache.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+using namespace openblack::graphics;
+using openblack::resources::MipChainCache;
+
+TEST(TestMipChain, BoxFilterDownToOneTexel)
+{
+	// clang-format off
+	const std::array<uint8_t, 16> texels = {
+	    0,   4,   8,   12,
+	    16,  20,  24,  28,
+	    100, 100, 200, 200,
+	    100, 100, 200, 200,
+	};
+	// clang-format on
+	const auto chain = MipChain::Generate(Format::R8, 4, 4, texels);
+	ASSERT_TRUE(chain.has_value());
+	ASSERT_EQ(chain->GetLevelCount(), 3);
+	ASSERT_EQ(chain->GetWidth(2), 1);
+	ASSERT_EQ(chain->GetHeight(2), 1);
+
+	const std::vector<uint8_t> level1(chain->GetLevel(1).begin(), chain->GetLevel(1).end());
+	ASSERT_EQ(level1, std::vector<uint8_t>({10, 18, 100, 200}));
+	ASSERT_EQ(chain->GetLevel(2)[0], 82);
+
+	ASSERT_EQ(chain->GetSizeInBytes(), 16 + 4 + 1);
+	std::vector<uint8_t> levels(chain->GetSizeInBytes(1));
+	chain->CopyLevels(1, levels.data());
+	ASSERT_EQ(levels, std::vector<uint8_t>({10, 18, 100, 200, 82}));
+}
+
+TEST(TestMipChain, OddSizesRepeatTheLastTexel)
+{
+	const std::array<uint8_t, 9> texels = {30, 60, 90, 30, 60, 90, 90, 90, 90};
+	const auto chain = MipChain::Generate(Format::RGB8, 3, 1, texels);
+	ASSERT_TRUE(chain.has_value());
+	ASSERT_EQ(chain->GetLevelCount(), 2);
+	const std::vector<uint8_t> level1(chain->GetLevel(1).begin(), chain->GetLevel(1).end());
+	ASSERT_EQ(level1, std::vector<uint8_t>({30, 60, 90}));
+}
+
+TEST(TestMipChain, PackedChannelsAreAveragedSeparately)
+{
+	// Opaque white, opaque black and two transparent reds in 5551
+	const std::array<uint16_t, 4> texels = {0xFFFF, 0x8000, 0x001F, 0x001F};
+	const auto chain = MipChain::Generate(Format::BGR5A1, 2, 2,
+	                                      {reinterpret_cast<const uint8_t*>(texels.data()), sizeof(texels)});
+	ASSERT_TRUE(chain.has_value());
+	ASSERT_EQ(chain->GetLevelCount(), 2);
+	const auto level = chain->GetLevel(1);
+	const auto texel = static_cast<uint16_t>(level[0] | (level[1] << 8));
+	// (31 + 0 + 31 + 31) / 4 rounds to 23, (31 + 0 + 0 + 0) / 4 rounds to 8 and half of the alpha rounds up
+	ASSERT_EQ(texel, 0x8000 | (8 << 10) | (8 << 5) | 23);
+}
+
+TEST(TestMipChain, BlockCompressedLevelsKeepWholeBlocks)
+{
+	// Solid red DXT1 blocks
+	std::vector<uint8_t> blocks;
+	for (int i = 0; i < 4; ++i)
+	{
+		blocks.insert(blocks.end(), {0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00});
+	}
+	const auto chain = MipChain::Generate(Format::BlockCompression1, 8, 8, blocks);
+	ASSERT_TRUE(chain.has_value());
+	ASSERT_EQ(chain->GetLevelCount(), 4);
+	for (uint8_t level = 1; level < chain->GetLevelCount(); ++level)
+	{
+		const std::vector<uint8_t> block(chain->GetLevel(level).begin(), chain->GetLevel(level).end());
+		ASSERT_EQ(block, std::vector<uint8_t>({0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00}));
+	}
+}
+
+TEST(TestMipChain, TransparentTexelsStayTransparent)
+{
+	// DXT1 block in its three colour mode with every texel on the transparent entry
+	const std::array<uint8_t, 8> block = {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	const auto chain = MipChain::Generate(Format::BlockCompression1, 4, 4, block);
+	ASSERT_TRUE(chain.has_value());
+	const std::vector<uint8_t> level1(chain->GetLevel(1).begin(), chain->GetLevel(1).end());
+	ASSERT_EQ(level1, std::vector<uint8_t>({0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF}));
+}
+
+TEST(TestMipChain, OddSizesDropTheirLastColumn)
+{
+	const std::array<uint8_t, 3> texels = {10, 20, 200};
+	const auto chain = MipChain::Generate(Format::R8, 3, 1, texels);
+	ASSERT_TRUE(chain.has_value());
+	ASSERT_EQ(chain->GetLevelCount(), 2);
+	// The single row is averaged with itself and the third texel is left out
+	ASSERT_EQ(chain->GetLevel(1)[0], 15);
+}
+
+TEST(TestMipChain, RejectsUnsupportedFormatsAndShortData)
+{
+	const std::array<uint8_t, 8> data = {};
+	ASSERT_FALSE(MipChain::IsSupported(Format::R16F));
+	ASSERT_FALSE(MipChain::Generate(Format::R16F, 2, 2, data).has_value());
+	ASSERT_FALSE(MipChain::Generate(Format::RGBA8, 2, 2, data).has_value());
+	ASSERT_EQ(MipChain::GetLevelSize(Format::BlockCompression3, 2, 2), 16);
+}
+
+TEST(TestMipChain, FromLevelsTakesWhatCopyLevelsWrote)
+{
+	const std::array<uint8_t, 16> texels = {0, 4, 8, 12, 16, 20, 24, 28, 100, 100, 200, 200, 100, 100, 200, 200};
+	const auto chain = MipChain::Generate(Format::R8, 4, 4, texels);
+	std::vector<uint8_t> levels(chain->GetSizeInBytes());
+	chain->CopyLevels(0, levels.data());
+
+	const auto copy = MipChain::FromLevels(Format::R8, 4, 4, levels);
+	ASSERT_TRUE(copy.has_value());
+	ASSERT_EQ(copy->GetLevelCount(), chain->GetLevelCount());
+	ASSERT_EQ(copy->GetLevel(2)[0], chain->GetLevel(2)[0]);
+
+	levels.pop_back();
+	ASSERT_FALSE(MipChain::FromLevels(Format::R8, 4, 4, levels).has_value());
+	levels.push_back(0);
+	levels.push_back(0);
+	ASSERT_FALSE(MipChain::FromLevels(Format::R8, 4, 4, levels).has_value());
+}
+
+TEST(TestMipChain, CachedChainsAreReadOnLaterRuns)
+{
+	if (spdlog::get("game") == nullptr)
+	{
+		spdlog::stdout_color_mt("game");
+	}
+	const auto path = std::filesystem::path(TEST_BINARY_DIR) / "test_mip_chain.cache";
+	std::filesystem::remove(path);
+
+	const std::array<uint8_t, 16> texels = {0, 4, 8, 12, 16, 20, 24, 28, 100, 100, 200, 200, 100, 100, 200, 200};
+	const auto pack = std::filesystem::path("Data") / "AllMeshes.g3d";
+	const auto key = MipChainCache::MakeKey(pack, {64, texels.size()}, Format::R8, 4, 4, texels);
+	{
+		MipChainCache cache;
+		ASSERT_FALSE(cache.Open(path));
+		ASSERT_FALSE(cache.Find(key).has_value());
+		cache.Add(key, *MipChain::Generate(Format::R8, 4, 4, texels));
+		ASSERT_EQ(cache.GetMissCount(), 1);
+		ASSERT_TRUE(cache.Save());
+	}
+	{
+		// The next run reads the chain instead of generating it
+		MipChainCache cache;
+		ASSERT_TRUE(cache.Open(path));
+		const auto chain = cache.Find(key);
+		ASSERT_TRUE(chain.has_value());
+		ASSERT_EQ(chain->GetLevelCount(), 3);
+		ASSERT_EQ(chain->GetLevel(2)[0], 82);
+		ASSERT_EQ(cache.GetHitCount(), 1);
+
+		// A texture whose data changed in the pack is generated again
+		auto changed = texels;
+		changed[0] = 255;
+		ASSERT_FALSE(cache.Find(MipChainCache::MakeKey(pack, {64, texels.size()}, Format::R8, 4, 4, changed)).has_value());
+		ASSERT_FALSE(cache.Find(MipChainCache::MakeKey(pack, {128, texels.size()}, Format::R8, 4, 4, texels)).has_value());
+		// Nor is a texture at the same place in another pack
+		const auto otherPack = std::filesystem::path("Data") / "Citadel" / "Outside" / "CitadelEngine.g3d";
+		ASSERT_FALSE(cache.Find(MipChainCache::MakeKey(otherPack, {64, texels.size()}, Format::R8, 4, 4, texels)).has_value());
+	}
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <Profiler.h>
+#include <gtest/gtest.h>
+
+using openblack::Profiler;
+
+namespace
+{
+const Profiler::Entry& LastEntry(const Profiler& profiler)
+{
+	return profiler.GetEntries().at(profiler.GetEntryIndex(-1));
+}
+} // namespace
+
+TEST(TestProfiler, StagesAreTheFirstZones)
+{
+	Profiler profiler;
+	ASSERT_EQ(profiler.GetZoneName(static_cast<Profiler::ZoneId>(Profiler::Stage::SdlInput)),
+	          Profiler::k_StageNames.at(static_cast<size_t>(Profiler::Stage::SdlInput)));
+	const auto zone = profiler.Intern("Custom Zone");
+	ASSERT_GE(zone, Profiler::k_StageNames.size());
+	ASSERT_EQ(profiler.Intern("Custom Zone"), zone);
+	ASSERT_EQ(profiler.GetZoneName(zone), "Custom Zone");
+}
+
+TEST(TestProfiler, NestedZonesAreCollectedOnFrame)
+{
+	Profiler profiler;
+	{
+		auto outer = profiler.BeginScoped("Outer");
+		auto inner = profiler.BeginScoped("Inner");
+	}
+	profiler.Frame();
+
+	const auto& scopes = LastEntry(profiler).scopes;
+	ASSERT_EQ(scopes.size(), 2);
+	// Scopes are recorded as they end
+	ASSERT_EQ(profiler.GetZoneName(scopes[0].zone), "Inner");
+	ASSERT_EQ(scopes[0].level, 1);
+	ASSERT_EQ(profiler.GetZoneName(scopes[1].zone), "Outer");
+	ASSERT_EQ(scopes[1].level, 0);
+	ASSERT_LE(scopes[1].start, scopes[0].start);
+	ASSERT_GE(scopes[1].end, scopes[0].end);
+}
+
+TEST(TestProfiler, ZonesAndCountersFromWorkerThreads)
+{
+	constexpr uint32_t k_Threads = 4;
+	constexpr uint32_t k_ZonesPerThread = 100;
+
+	Profiler profiler;
+	std::vector<std::thread> threads;
+	for (uint32_t i = 0; i < k_Threads; ++i)
+	{
+		threads.emplace_back([&profiler]() {
+			for (uint32_t j = 0; j < k_ZonesPerThread; ++j)
+			{
+				auto zone = profiler.BeginScoped("Work");
+				profiler.Count(Profiler::Counter::EntitiesIterated, 2);
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	profiler.Frame();
+
+	const auto& entry = LastEntry(profiler);
+	ASSERT_EQ(profiler.GetThreadCount(), k_Threads + 1);
+	ASSERT_EQ(entry.scopes.size(), k_Threads * k_ZonesPerThread);
+	ASSERT_TRUE(std::ranges::all_of(entry.scopes, [](const auto& scope) { return scope.thread != 0; }));
+	ASSERT_EQ(entry.counters.at(static_cast<size_t>(Profiler::Counter::EntitiesIterated)), 2 * k_Threads * k_ZonesPerThread);
+
+	// Counters start again from zero every frame
+	profiler.Frame();
+	ASSERT_EQ(LastEntry(profiler).counters.at(static_cast<size_t>(Profiler::Counter::EntitiesIterated)), 0);
+}
+
+TEST(TestProfiler, FullBufferDropsWholeZones)
+{
+	Profiler profiler;
+	{
+		auto outer = profiler.BeginScoped("Outer");
+		for (uint32_t i = 0; i < 100000; ++i)
+		{
+			auto zone = profiler.BeginScoped("Inner");
+		}
+	}
+	profiler.Frame();
+
+	const auto& scopes = LastEntry(profiler).scopes;
+	ASSERT_GT(profiler.GetDroppedZoneCount(), 0u);
+	ASSERT_EQ(scopes.size() + profiler.GetDroppedZoneCount(), 100001u);
+	ASSERT_EQ(profiler.GetZoneName(scopes.back().zone), "Outer");
+	ASSERT_TRUE(std::ranges::all_of(scopes.begin(), scopes.end() - 1, [](const auto& scope) { return scope.level == 1; }));
+}
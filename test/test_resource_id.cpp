@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <memory>
+#include <string>
+
+#include <Resources/ResourceId.h>
+#include <Resources/ResourceManager.h>
+#include <entt/core/hashed_string.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack::resources;
+
+namespace
+{
+enum class Kind : uint32_t
+{
+	First = 7,
+	Second = 1234,
+};
+
+struct NameLoader
+{
+	using result_type = std::shared_ptr<int>;
+	using ResourceType = int;
+	struct FromBufferTag
+	{
+	};
+	struct FromDiskTag
+	{
+	};
+
+	result_type operator()(FromBufferTag, int value) const { return std::make_shared<int>(value); }
+};
+
+// Literal names are hashed by the compiler
+static_assert(MakeResourceId("raw/", "misc0a") == MakeResourceId("raw/misc0a"));
+} // namespace
+
+TEST(TestResourceId, MatchesHashedString)
+{
+	ASSERT_EQ(MakeResourceId(""), entt::hashed_string("").value());
+	ASSERT_EQ(MakeResourceId("raw/ATMOS"), entt::hashed_string("raw/ATMOS").value());
+	const std::string name = "b_first_temple_l3d";
+	ASSERT_EQ(MakeResourceId("temple/", name), entt::hashed_string("temple/b_first_temple_l3d").value());
+}
+
+TEST(TestResourceId, NumbersAreWrittenInDecimal)
+{
+	ASSERT_EQ(MakeResourceId("creature/", static_cast<uint8_t>(3), "/", 2U), entt::hashed_string("creature/3/2").value());
+	ASSERT_EQ(MakeResourceId(0), entt::hashed_string("0").value());
+	ASSERT_EQ(MakeResourceId(-42), entt::hashed_string("-42").value());
+	ASSERT_EQ(MakeResourceId(INT64_MIN), entt::hashed_string("-9223372036854775808").value());
+	ASSERT_EQ(MakeResourceId(UINT64_MAX), entt::hashed_string("18446744073709551615").value());
+	ASSERT_EQ(MakeResourceId(Kind::First), entt::hashed_string("7").value());
+	ASSERT_EQ(MakeResourceId("InGame.sad/", Kind::Second), entt::hashed_string("InGame.sad/1234").value());
+}
+
+TEST(TestResourceId, NamesAndIdsFindTheSameResource)
+{
+	ResourceManager<NameLoader> manager;
+	manager.Load("coffre", NameLoader::FromBufferTag {}, 1);
+	manager.Load(std::string("raw/sky"), NameLoader::FromBufferTag {}, 2);
+	manager.Load(Kind::First, NameLoader::FromBufferTag {}, 3);
+
+	ASSERT_TRUE(manager.Contains(MakeResourceId("coffre")));
+	ASSERT_TRUE(manager.Contains("raw/sky"));
+	ASSERT_EQ(*manager.Handle(MakeResourceId("raw/", "sky")), 2);
+	ASSERT_EQ(*manager.Handle(MakeResourceId(7)), 3);
+	// Ids are used as they are, only other integers are names
+	ASSERT_FALSE(manager.Contains(entt::id_type {7}));
+}
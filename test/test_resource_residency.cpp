@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <AssetArchive.h>
+#include <Locator.h>
+#include <Resources/ResidencyManager.h>
+#include <Resources/ResourceManager.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#define LOCATOR_IMPLEMENTATIONS
+#include <FileSystem/ArchiveFileSystem.h>
+#include <FileSystem/MemoryStream.h>
+
+using namespace openblack;
+using namespace openblack::resources;
+
+namespace
+{
+struct Counter
+{
+	int value;
+};
+
+/// Counts how many times resources are loaded from "disk"
+struct CounterLoader
+{
+	using result_type = std::shared_ptr<Counter>;
+	using ResourceType = Counter;
+	struct FromBufferTag
+	{
+	};
+	struct FromDiskTag
+	{
+	};
+
+	result_type operator()(FromDiskTag, int value) const
+	{
+		++diskLoads;
+		return std::make_shared<Counter>(value);
+	}
+	result_type operator()(FromBufferTag, int value) const { return std::make_shared<Counter>(value); }
+
+	static ResourceSize Measure(const Counter&) { return {1, 2}; }
+
+	static inline int diskLoads = 0;
+};
+
+constexpr entt::id_type k_Id1 = 1;
+constexpr entt::id_type k_Id2 = 2;
+constexpr entt::id_type k_Id3 = 3;
+constexpr entt::id_type k_Id4 = 4;
+
+class TestResourceResidency: public ::testing::Test
+{
+protected:
+	void SetUp() override { CounterLoader::diskLoads = 0; }
+};
+} // namespace
+
+TEST_F(TestResourceResidency, EvictedResourcesAreLoadedAgain)
+{
+	ResourceManager<CounterLoader> manager;
+	manager.Load(k_Id1, CounterLoader::FromDiskTag {}, 5);
+	ASSERT_EQ(manager.GetResidentSize().cpuBytes, 1);
+	ASSERT_EQ(manager.GetResidentSize().gpuBytes, 2);
+
+	ASSERT_TRUE(manager.Evict(k_Id1));
+	ASSERT_FALSE(manager.IsResident(k_Id1));
+	ASSERT_TRUE(manager.Contains(k_Id1));
+	ASSERT_EQ(manager.GetResidentSize().Total(), 0);
+
+	ASSERT_EQ(manager.Handle(k_Id1)->value, 5);
+	ASSERT_EQ(CounterLoader::diskLoads, 2);
+	ASSERT_EQ(manager.GetReloadCount(), 1);
+	ASSERT_EQ(manager.GetResidentSize().Total(), 3);
+}
+
+TEST_F(TestResourceResidency, OnlyUnusedReloadableResourcesAreEvicted)
+{
+	ResourceManager<CounterLoader> manager;
+
+	// Loaded from memory which is gone, until told how to load it again
+	manager.Load(k_Id2, CounterLoader::FromBufferTag {}, 2);
+	ASSERT_FALSE(manager.Evict(k_Id2));
+	manager.SetReload(k_Id2, CounterLoader::FromBufferTag {}, 2);
+	ASSERT_TRUE(manager.Evict(k_Id2));
+
+	manager.Load(k_Id3, CounterLoader::FromDiskTag {}, 3);
+	{
+		const auto held = manager.Handle(k_Id3);
+		ASSERT_FALSE(manager.Evict(k_Id3));
+	}
+	manager.Pin(k_Id3);
+	ASSERT_FALSE(manager.Evict(k_Id3));
+	ASSERT_EQ(manager.GetEvictionCount(), 1);
+}
+
+TEST_F(TestResourceResidency, HandleStampsTheFrame)
+{
+	ResourceManager<CounterLoader> manager;
+	manager.Load(k_Id4, CounterLoader::FromDiskTag {}, 4);
+	ASSERT_EQ(manager.GetResidency(k_Id4)->lastUsedFrame, 0);
+	manager.BeginFrame(10);
+	ASSERT_EQ(manager.Handle(k_Id4)->value, 4);
+	ASSERT_EQ(manager.GetResidency(k_Id4)->lastUsedFrame, 10);
+}
+
+TEST_F(TestResourceResidency, PackRangesAreReadFromTheArchive)
+{
+	if (spdlog::get("game") == nullptr)
+	{
+		spdlog::stdout_color_mt("game");
+	}
+	const auto gamePath = std::filesystem::path(TEST_BINARY_DIR) / "test_resource_residency_game";
+	std::filesystem::remove_all(gamePath);
+	std::filesystem::create_directories(gamePath);
+
+	std::vector<uint8_t> meshPack(64 * 1024);
+	std::iota(meshPack.begin(), meshPack.end(), uint8_t {0});
+	std::vector<uint8_t> animationPack(meshPack.rbegin(), meshPack.rend());
+	pack::AssetArchiveWriter writer;
+	ASSERT_EQ(writer.Add("Data/AllMeshes.g3d", meshPack, pack::ArchiveCompression::None), pack::ArchiveResult::Success);
+	ASSERT_EQ(writer.Add("Data/AllAnims.anm", animationPack, pack::ArchiveCompression::Zlib), pack::ArchiveResult::Success);
+	ASSERT_EQ(writer.Write(gamePath / filesystem::ArchiveFileSystem::k_ArchiveName), pack::ArchiveResult::Success);
+
+	Locator::filesystem::emplace<filesystem::ArchiveFileSystem>();
+	Locator::filesystem::value().SetGamePath(gamePath);
+	{
+		MeshManager meshes;
+		TextureManager textures;
+		ResidencyManager residency(meshes, textures);
+
+		// The same mesh read again after being evicted, then another one, without a loose copy of the pack to fall back on
+		const auto meshPath = gamePath / "Data" / "AllMeshes.g3d";
+		for (const auto range : {pack::PackRange {1000, 300}, pack::PackRange {1000, 300}, pack::PackRange {60000, 5536}})
+		{
+			const auto data = residency.ReadPackRange(meshPath, range);
+			ASSERT_TRUE(std::ranges::equal(data, std::span(meshPack).subspan(range.offset, range.size)));
+		}
+		// Stored packs are read from the archive a range at a time instead of being copied into memory whole
+		const auto stream = Locator::filesystem::value().Open(meshPath, filesystem::Stream::Mode::Read);
+		ASSERT_EQ(dynamic_cast<filesystem::MemoryStream*>(stream.get()), nullptr);
+		ASSERT_EQ(stream->Size(), meshPack.size());
+
+		// Compressed packs are read as well, if not as cheaply
+		const auto range = pack::PackRange {12, 34};
+		const auto animation = residency.ReadPackRange(gamePath / "Data" / "AllAnims.anm", range);
+		ASSERT_TRUE(std::ranges::equal(animation, std::span(animationPack).subspan(range.offset, range.size)));
+
+		ASSERT_THROW((void)residency.ReadPackRange(meshPath, {60000, 5537}), std::runtime_error);
+	}
+	Locator::filesystem::reset();
+}
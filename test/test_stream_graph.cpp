@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include <ECS/Components/Stream.h>
+#include <gtest/gtest.h>
+
+using openblack::ecs::components::Stream;
+
+namespace
+{
+std::vector<Stream::NodeIndex> EdgesOf(const Stream& stream, Stream::NodeIndex node)
+{
+	const auto edges = stream.Edges(node);
+	return {edges.begin(), edges.end()};
+}
+} // namespace
+
+TEST(TestStreamGraph, NodesLinkToTheClosestNodeWithinRange)
+{
+	Stream stream {};
+	stream.AddNode({0.0f, 0.0f, 0.0f});
+	stream.AddNode({50.0f, 0.0f, 0.0f});  // 50 from node 0
+	stream.AddNode({500.0f, 0.0f, 0.0f}); // 450 from node 1, too far
+	stream.AddNode({520.0f, 0.0f, 0.0f}); // 20 from node 2
+	stream.AddNode({60.0f, 0.0f, 5.0f});  // closer to node 1 than node 0
+	stream.AddNode({620.0f, 0.0f, 0.0f}); // exactly 100 from node 3, which isn't near enough
+
+	ASSERT_EQ(stream.nodes.size(), 6);
+	ASSERT_EQ(stream.edgeOffsets, (std::vector<uint32_t> {0, 0, 1, 1, 2, 3, 3}));
+	ASSERT_EQ(stream.edges, (std::vector<Stream::NodeIndex> {0, 2, 1}));
+	ASSERT_EQ(stream.EdgeCount(), 3);
+
+	ASSERT_TRUE(EdgesOf(stream, 0).empty());
+	ASSERT_EQ(EdgesOf(stream, 1), (std::vector<Stream::NodeIndex> {0}));
+	ASSERT_TRUE(EdgesOf(stream, 2).empty());
+	ASSERT_EQ(EdgesOf(stream, 3), (std::vector<Stream::NodeIndex> {2}));
+	ASSERT_EQ(EdgesOf(stream, 4), (std::vector<Stream::NodeIndex> {1}));
+	ASSERT_TRUE(EdgesOf(stream, 5).empty());
+}
+
+TEST(TestStreamGraph, EveryEdgeIsListedOnceUnderItsNode)
+{
+	// A line of nodes 10 apart, each links back to the one before it
+	Stream stream {};
+	constexpr Stream::NodeIndex k_NodeCount = 20;
+	for (Stream::NodeIndex i = 0; i < k_NodeCount; ++i)
+	{
+		stream.AddNode({static_cast<float>(i) * 10.0f, 0.0f, 0.0f});
+	}
+
+	ASSERT_EQ(stream.edgeOffsets.size(), k_NodeCount + 1);
+	ASSERT_TRUE(std::ranges::is_sorted(stream.edgeOffsets));
+	ASSERT_EQ(stream.edgeOffsets.back(), stream.EdgeCount());
+	ASSERT_EQ(stream.EdgeCount(), k_NodeCount - 1);
+	for (Stream::NodeIndex i = 1; i < k_NodeCount; ++i)
+	{
+		ASSERT_EQ(EdgesOf(stream, i), (std::vector<Stream::NodeIndex> {i - 1}));
+	}
+}
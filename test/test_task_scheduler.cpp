@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <Common/TaskScheduler.h>
+#include <gtest/gtest.h>
+
+using openblack::TaskScheduler;
+
+TEST(TestTaskScheduler, ParallelForVisitsEachIndexOnce)
+{
+	for (const uint32_t workers : {0u, 1u, 4u})
+	{
+		TaskScheduler scheduler(workers);
+		std::vector<std::atomic<int>> visits(1000);
+		scheduler.ParallelFor(0, visits.size(), 7, [&visits](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				++visits[i];
+			}
+		});
+		for (const auto& count : visits)
+		{
+			ASSERT_EQ(count, 1);
+		}
+	}
+}
+
+TEST(TestTaskScheduler, NestedParallelFor)
+{
+	TaskScheduler scheduler(2);
+	std::atomic<size_t> total = 0;
+	scheduler.ParallelFor(0, 16, 1, [&scheduler, &total](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			scheduler.ParallelFor(0, 100, 1, [&total](size_t innerBegin, size_t innerEnd) { total += innerEnd - innerBegin; });
+		}
+	});
+	ASSERT_EQ(total, 1600);
+}
+
+TEST(TestTaskScheduler, ExceptionsReachTheCaller)
+{
+	TaskScheduler scheduler(2);
+	ASSERT_THROW(scheduler.ParallelFor(0, 64, 1,
+	                                   [](size_t begin, size_t end) {
+		                                   if (begin <= 42 && 42 < end)
+		                                   {
+			                                   throw std::runtime_error("task failed");
+		                                   }
+	                                   }),
+	             std::runtime_error);
+
+	auto future = scheduler.Submit([]() { return 7; });
+	ASSERT_EQ(future.get(), 7);
+}
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2024 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include <Audio/AudioPlayer.h>
+#include <Audio/AudioPlayerInterface.h>
+#include <Audio/VoiceManager.h>
+#include <EngineConfig.h>
+#include <Game.h>
+#include <Locator.h>
+#include <PackFile.h>
+#include <Resources/Loaders.h>
+#include <Resources/ResourcesInterface.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#define LOCATOR_IMPLEMENTATIONS
+#include <Audio/AudioManager.h>
+
+using namespace openblack;
+using namespace openblack::audio;
+
+namespace
+{
+/// Counts the sources it hands out, nothing is played
+class FakeAudioPlayer final: public AudioPlayerInterface
+{
+public:
+	void Initialize() override {}
+	void UpdateListener(glm::vec3, glm::vec3, glm::vec3, glm::vec3) const override {}
+	BufferId CreateBuffer(ChannelLayout, const std::vector<int16_t>&, int) override { return 0; }
+	void SetBufferData(BufferId, ChannelLayout, const std::vector<int16_t>&, int) override {}
+	void QueueBuffer(SourceId, BufferId) override {}
+	std::vector<BufferId> UnqueueProcessedBuffers(SourceId) override { return {}; }
+	void DeleteBuffer(BufferId) override {}
+	SourceId CreateSource(float, bool) override
+	{
+		++created;
+		return static_cast<SourceId>(created);
+	}
+	void DeleteSource(SourceId) override { ++deleted; }
+	void ResetSource(SourceId, bool) override { ++reset; }
+	void SetOffset(SourceId, float) override {}
+	float GetOffset(SourceId) const override { return 0.0f; }
+	void UpdateSource(SourceId, glm::vec3, float, bool) override {}
+	void UpdateSource(SourceId, float, bool) override {}
+	void UpdateSources(const SourceBatch&) override {}
+	float GetDuration(BufferId) override { return 0.0f; }
+	void PlaySource(SourceId, glm::vec3, float, bool) override {}
+	void PlaySource(SourceId, float, bool) override {}
+	void PauseSource(SourceId) const override {}
+	void StopSource(SourceId) const override {}
+	void SetVolume(SourceId, float) override {}
+	float GetVolume() const override { return 0.0f; }
+	AudioStatus GetStatus(SourceId) const override { return AudioStatus::Initial; }
+	float GetProgress(size_t, SourceId) const override { return 0.0f; }
+
+	size_t created {0};
+	size_t deleted {0};
+	size_t reset {0};
+};
+
+class TestVoiceManager: public ::testing::Test
+{
+protected:
+	void SetUp() override { Locator::config::emplace().audioMaxVoices = 2; }
+	void TearDown() override { Locator::config::reset(); }
+};
+
+class TestVoiceManagerMapLoad: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .rendererType = bgfx::RendererType::Enum::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::debug);
+		game_ = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(game_->Initialize());
+		Locator::config::value().audioMaxVoices = 2;
+		// Whatever audio device is available, the emitters play on sources which are only counted
+		Locator::audio::emplace<AudioManager>(std::make_unique<FakeAudioPlayer>());
+	}
+	void TearDown() override { game_.reset(); }
+	std::unique_ptr<openblack::Game> game_;
+};
+} // namespace
+
+TEST_F(TestVoiceManager, PrioritiseByPriorityThenGain)
+{
+	FakeAudioPlayer player;
+	const VoiceManager voices(player);
+	std::vector<VoiceManager::Candidate> candidates = {
+	    {static_cast<entt::entity>(0), 0, 1.0f},
+	    {static_cast<entt::entity>(1), 5, 0.1f},
+	    {static_cast<entt::entity>(2), 0, 0.5f},
+	    {static_cast<entt::entity>(3), 5, 0.2f},
+	};
+	ASSERT_EQ(voices.Prioritise(candidates), 2);
+	ASSERT_EQ(candidates[0].entity, static_cast<entt::entity>(3));
+	ASSERT_EQ(candidates[1].entity, static_cast<entt::entity>(1));
+}
+
+TEST_F(TestVoiceManager, GainFallsOffWithDistance)
+{
+	ASSERT_FLOAT_EQ(VoiceManager::GetGain(0.5f, 0.5f, 0.0f), 0.5f);
+	ASSERT_FLOAT_EQ(VoiceManager::GetGain(1.0f, 4.0f, 0.0f), 0.25f);
+	ASSERT_FLOAT_EQ(VoiceManager::GetGain(1.0f, 4.0f, 3.0f), 0.0f);
+}
+
+TEST_F(TestVoiceManager, SourcesAreRecycled)
+{
+	FakeAudioPlayer player;
+	{
+		VoiceManager voices(player);
+		const auto first = voices.Acquire(false);
+		ASSERT_TRUE(voices.HasFreeVoice());
+		const auto second = voices.Acquire(true);
+		ASSERT_FALSE(voices.HasFreeVoice());
+		voices.Release(first);
+		voices.Release(second);
+		ASSERT_EQ(voices.GetStats().pooledSources, 2);
+
+		// Pooled sources are handed out again instead of creating new ones
+		const auto third = voices.Acquire(false);
+		ASSERT_TRUE(third == first || third == second);
+		ASSERT_EQ(player.created, 2);
+		voices.Release(third);
+
+		// Sources beyond a lowered limit are deleted rather than pooled
+		Locator::config::value().audioMaxVoices = 1;
+		const auto fourth = voices.Acquire(false);
+		voices.Release(fourth);
+		ASSERT_EQ(player.deleted, 1);
+	}
+	ASSERT_EQ(player.deleted, player.created);
+}
+
+TEST(TestAudioPlayer, BatchesUseDeferredUpdatesWhenAvailable)
+{
+	if (spdlog::get("audio") == nullptr)
+	{
+		spdlog::stdout_color_mt("audio");
+	}
+	std::unique_ptr<AudioPlayer> player;
+	try
+	{
+		player = std::make_unique<AudioPlayer>();
+	}
+	catch (const std::runtime_error& error)
+	{
+		GTEST_SKIP() << error.what();
+	}
+	player->Initialize();
+	// OpenAL Soft ignores alcSuspendContext, so the extension must be used whenever it is there
+	ASSERT_EQ(player->HasDeferredUpdates(), alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE);
+
+	SourceBatch batch;
+	const auto source = player->CreateSource(1.0f, false);
+	batch.Add(source, glm::vec3(1.0f, 2.0f, 3.0f), 0.5f, true);
+	player->UpdateSources(batch);
+	ALfloat gain = 0.0f;
+	alGetSourcef(source, AL_GAIN, &gain);
+	ASSERT_FLOAT_EQ(gain, 0.5f);
+	player->DeleteSource(source);
+}
+
+TEST_F(TestVoiceManagerMapLoad, VoicesReturnWhenMapIsLoaded)
+{
+	const entt::id_type id = entt::hashed_string("Test.sad/1");
+	auto& sounds = Locator::resources::value().GetSounds();
+	sounds.Load(id, resources::SoundLoader::FromBufferTag {}, pack::AudioBankSampleHeader {},
+	            std::vector<std::vector<uint8_t>> {});
+	// Pretend the sound is decoded so emitters get a voice as soon as they play
+	sounds.Handle(id)->bufferId = 1;
+
+	auto& audio = Locator::audio::value();
+	for (int i = 0; i < 2; ++i)
+	{
+		ASSERT_TRUE(game_->LoadMap("Land1.txt"));
+		ASSERT_EQ(audio.GetVoiceStats().realVoices, 0);
+		ASSERT_EQ(audio.GetSoundCacheStats().retainedCount, 0);
+
+		audio.PlaySound(id, PlayType::Repeat);
+		audio.PlaySound(id, PlayType::Repeat);
+		ASSERT_EQ(audio.GetVoiceStats().realVoices, 2);
+		ASSERT_EQ(audio.GetSoundCacheStats().retainedCount, 1);
+	}
+	ASSERT_TRUE(game_->LoadMap("Land1.txt"));
+	ASSERT_EQ(audio.GetVoiceStats().realVoices, 0);
+	ASSERT_EQ(audio.GetVoiceStats().pooledSources, 2);
+	// The sounds those emitters played can be evicted again
+	ASSERT_EQ(audio.GetSoundCacheStats().retainedCount, 0);
+}